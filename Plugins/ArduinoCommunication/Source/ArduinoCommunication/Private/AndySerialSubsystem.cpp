@@ -23,7 +23,7 @@ void UAndyPortEventHandler::BindToPort(UArduinoSerialPort* Port)
 		return;
 	}
 
-	Port->OnByteReceived.AddDynamic(this, &UAndyPortEventHandler::OnBytesReceived);
+	Port->OnBytesReceivedTimed.AddUObject(this, &UAndyPortEventHandler::OnBytesReceived);
 	Port->OnConnectionChanged.AddDynamic(this, &UAndyPortEventHandler::OnConnectionChanged);
 }
 
@@ -34,15 +34,15 @@ void UAndyPortEventHandler::UnbindFromPort(UArduinoSerialPort* Port)
 		return;
 	}
 
-	Port->OnByteReceived.RemoveDynamic(this, &UAndyPortEventHandler::OnBytesReceived);
+	Port->OnBytesReceivedTimed.RemoveAll(this);
 	Port->OnConnectionChanged.RemoveDynamic(this, &UAndyPortEventHandler::OnConnectionChanged);
 }
 
-void UAndyPortEventHandler::OnBytesReceived(const TArray<uint8>& Bytes)
+void UAndyPortEventHandler::OnBytesReceived(const TArray<uint8>& Bytes, double ReceiveTime)
 {
 	if (OwnerSubsystem)
 	{
-		OwnerSubsystem->HandleBytesReceived(ShipId, Bytes);
+		OwnerSubsystem->HandleBytesReceived(ShipId, Bytes, ReceiveTime);
 	}
 }
 
@@ -248,7 +248,7 @@ bool UAndySerialSubsystem::SendLine(FName ShipId, const FString& Line)
 	return Connection->SerialPort->SendLine(Line);
 }
 
-void UAndySerialSubsystem::HandleBytesReceived(FName ShipId, const TArray<uint8>& Bytes)
+void UAndySerialSubsystem::HandleBytesReceived(FName ShipId, const TArray<uint8>& Bytes, double ReceiveTime)
 {
 	FAndyPortConnection* Connection = Connections.Find(ShipId);
 	if (!Connection || !Connection->Parser)
@@ -264,13 +264,33 @@ void UAndySerialSubsystem::HandleBytesReceived(FName ShipId, const TArray<uint8>
 
 	int32 PacketCount = Connection->Parser->IngestAndParse(Bytes, Packets, BytesDropped, BadEndFrames, CrcMismatches);
 
+	if (ReceiveTime <= 0.0)
+	{
+		ReceiveTime = GetInputTime();
+	}
+
 	// Broadcast parsed packets
 	for (const FBenchPacket& Packet : Packets)
 	{
-		HandlePacketDecoded(ShipId, Packet);
+		HandlePacketDecoded(ShipId, Packet, ReceiveTime);
 	}
 }
 
+void UAndySerialSubsystem::InjectPacket(FName ShipId, const FBenchPacket& Packet, double ReceiveTime)
+{
+	HandlePacketDecoded(ShipId, Packet, ReceiveTime > 0.0 ? ReceiveTime : GetInputTime());
+}
+
+double UAndySerialSubsystem::GetInputTime() const
+{
+	return InputClock ? InputClock() : FPlatformTime::Seconds();
+}
+
+void UAndySerialSubsystem::SetInputClock(TFunction<double()> InClock)
+{
+	InputClock = MoveTemp(InClock);
+}
+
 void UAndySerialSubsystem::HandleConnectionChanged(FName ShipId, bool bConnected)
 {
 	// Broadcast on game thread
@@ -291,26 +311,25 @@ void UAndySerialSubsystem::HandleConnectionChanged(FName ShipId, bool bConnected
 	}
 }
 
-void UAndySerialSubsystem::HandlePacketDecoded(FName ShipId, const FBenchPacket& Packet)
+void UAndySerialSubsystem::HandlePacketDecoded(FName ShipId, const FBenchPacket& Packet, double ReceiveTime)
 {
 	// Broadcast on game thread
 	if (IsInGameThread())
 	{
+		OnFrameParsedTimed.Broadcast(ShipId, Packet, ReceiveTime);
 		OnFrameParsed.Broadcast(ShipId, Packet.Src, Packet.Type, Packet.Seq, Packet.Payload);
 	}
 	else
 	{
 		// Copy packet data for async task
-		TArray<uint8> PayloadCopy = Packet.Payload;
-		uint8 Src = Packet.Src;
-		uint8 Type = Packet.Type;
-		int32 Seq = Packet.Seq;
+		FBenchPacket PacketCopy = Packet;
 
-		AsyncTask(ENamedThreads::GameThread, [this, ShipId, Src, Type, Seq, PayloadCopy]()
+		AsyncTask(ENamedThreads::GameThread, [this, ShipId, PacketCopy, ReceiveTime]()
 		{
 			if (this && IsValid(this))
 			{
-				OnFrameParsed.Broadcast(ShipId, Src, Type, Seq, PayloadCopy);
+				OnFrameParsedTimed.Broadcast(ShipId, PacketCopy, ReceiveTime);
+				OnFrameParsed.Broadcast(ShipId, PacketCopy.Src, PacketCopy.Type, PacketCopy.Seq, PacketCopy.Payload);
 			}
 		});
 	}
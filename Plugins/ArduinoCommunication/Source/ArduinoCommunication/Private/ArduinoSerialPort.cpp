@@ -718,11 +718,12 @@ void UArduinoSerialPort::ProcessRawTap(const uint8* Buffer, int32 BytesRead)
 
 void UArduinoSerialPort::ProcessReceivedData()
 {
-	// Process raw bytes
-	TArray<uint8> Bytes;
-	while (ReceivedBytesQueue.Dequeue(Bytes))
+	// Process raw bytes (with the time they were read, so consumers can order input within the frame)
+	FTimedSerialBytes Chunk;
+	while (ReceivedBytesQueue.Dequeue(Chunk))
 	{
-		OnByteReceived.Broadcast(Bytes);
+		OnByteReceived.Broadcast(Chunk.Bytes);
+		OnBytesReceivedTimed.Broadcast(Chunk.Bytes, Chunk.ReceiveTime);
 	}
 
 	// Process complete lines
@@ -774,7 +775,7 @@ void UArduinoSerialPort::PollRead()
 		// Enqueue raw bytes for OnByteReceived
 		TArray<uint8> RawBytes;
 		RawBytes.Append(ReadBuffer, bytesRead);
-		ReceivedBytesQueue.Enqueue(RawBytes);
+		ReceivedBytesQueue.Enqueue(FTimedSerialBytes{ MoveTemp(RawBytes), FPlatformTime::Seconds() });
 
 		// If bypass parser mode is enabled, skip all line parsing
 		if (!bBypassParser)
@@ -825,7 +826,7 @@ void UArduinoSerialPort::PollRead()
 
 		TArray<uint8> RawBytes;
 		RawBytes.Append(ReadBuffer, bytesRead);
-		ReceivedBytesQueue.Enqueue(RawBytes);
+		ReceivedBytesQueue.Enqueue(FTimedSerialBytes{ MoveTemp(RawBytes), FPlatformTime::Seconds() });
 
 		if (!bBypassParser)
 		{
@@ -942,7 +943,7 @@ uint32 FSerialReadRunnable::Run()
 			// Enqueue raw bytes for OnByteReceived
 			TArray<uint8> RawBytes;
 			RawBytes.Append(ReadBuffer, bytesRead);
-			Owner->ReceivedBytesQueue.Enqueue(RawBytes);
+			Owner->ReceivedBytesQueue.Enqueue(FTimedSerialBytes{ MoveTemp(RawBytes), FPlatformTime::Seconds() });
 
 			// If bypass parser mode is enabled, skip all line parsing
 			if (!Owner->bBypassParser)
@@ -1012,7 +1013,7 @@ uint32 FSerialReadRunnable::Run()
 			// Enqueue raw bytes for OnByteReceived
 			TArray<uint8> RawBytes;
 			RawBytes.Append(ReadBuffer, bytesRead);
-			Owner->ReceivedBytesQueue.Enqueue(RawBytes);
+			Owner->ReceivedBytesQueue.Enqueue(FTimedSerialBytes{ MoveTemp(RawBytes), FPlatformTime::Seconds() });
 
 			// If bypass parser mode is enabled, skip all line parsing
 			if (!Owner->bBypassParser)
@@ -0,0 +1,223 @@
+// Arduino Communication Plugin - Display Capture Scheduler Implementation
+
+#include "DisplayCaptureScheduler.h"
+#include "MultiDisplayCameraComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+namespace DisplayCaptureScheduler
+{
+	static UDisplayCaptureScheduler* GetScheduler(UWorld* World)
+	{
+		return World ? World->GetSubsystem<UDisplayCaptureScheduler>() : nullptr;
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs BudgetCommand(
+		TEXT("MultiDisplay.Budget"),
+		TEXT("Set the maximum scene captures per frame across all displays. Usage: MultiDisplay.Budget <N> (0 = unlimited)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UDisplayCaptureScheduler* Scheduler = GetScheduler(World);
+			if (Scheduler && Args.Num() > 0)
+			{
+				Scheduler->MaxCapturesPerFrame = FMath::Max(FCString::Atoi(*Args[0]), 0);
+				UE_LOG(LogTemp, Log, TEXT("DisplayCaptureScheduler: Budget set to %d captures per frame"), Scheduler->MaxCapturesPerFrame);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs StatsCommand(
+		TEXT("MultiDisplay.Stats"),
+		TEXT("Log the achieved capture rate of every display and reset the counters"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UDisplayCaptureScheduler* Scheduler = GetScheduler(World))
+			{
+				Scheduler->LogStats();
+			}
+		}));
+}
+
+bool UDisplayCaptureScheduler::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UDisplayCaptureScheduler::Deinitialize()
+{
+	Displays.Empty();
+	Candidates.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UDisplayCaptureScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDisplayCaptureScheduler, STATGROUP_Tickables);
+}
+
+double UDisplayCaptureScheduler::GetNow() const
+{
+	// Real time: displays keep their rate under time dilation
+	const UWorld* World = GetWorld();
+	return World ? World->GetRealTimeSeconds() : 0.0;
+}
+
+// ============================================================================
+// DISPLAYS
+// ============================================================================
+
+void UDisplayCaptureScheduler::RegisterDisplay(UMultiDisplayCameraComponent* Display)
+{
+	if (!Display)
+	{
+		return;
+	}
+
+	for (const FScheduledDisplay& Scheduled : Displays)
+	{
+		if (Scheduled.Component.Get() == Display)
+		{
+			return;
+		}
+	}
+
+	FScheduledDisplay& Scheduled = Displays.AddDefaulted_GetRef();
+	Scheduled.Component = Display;
+
+	if (Displays.Num() == 1)
+	{
+		StatsStartTime = GetNow();
+	}
+}
+
+void UDisplayCaptureScheduler::UnregisterDisplay(UMultiDisplayCameraComponent* Display)
+{
+	Displays.RemoveAll([Display](const FScheduledDisplay& Scheduled)
+	{
+		return Scheduled.Component.Get() == Display;
+	});
+}
+
+void UDisplayCaptureScheduler::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Displays.Num() == 0)
+	{
+		return;
+	}
+
+	Displays.RemoveAll([](const FScheduledDisplay& Scheduled)
+	{
+		return !Scheduled.Component.IsValid();
+	});
+
+	const double Now = GetNow();
+
+	// A display is due when its interval would elapse before the middle of the next frame,
+	// so a 60 Hz display on a 60 fps frame does not skip frames on timing jitter
+	const double Slack = 0.5 * DeltaTime;
+
+	Candidates.Reset();
+
+	for (int32 Index = 0; Index < Displays.Num(); ++Index)
+	{
+		const FScheduledDisplay& Scheduled = Displays[Index];
+		const UMultiDisplayCameraComponent* Display = Scheduled.Component.Get();
+		if (!Display->IsDisplayActive() || !Display->TextureTarget)
+		{
+			continue;
+		}
+
+		FCaptureCandidate Candidate;
+		Candidate.DisplayIndex = Index;
+		Candidate.Priority = Display->CapturePriority;
+
+		if (Scheduled.LastCaptureTime < 0.0)
+		{
+			// Never captured: capture as soon as possible
+			Candidate.bStale = true;
+			Candidate.Lateness = DBL_MAX;
+			Candidates.Add(Candidate);
+			continue;
+		}
+
+		const double Elapsed = Now - Scheduled.LastCaptureTime;
+		const double Interval = Display->TargetCaptureRate > 0.0f ? 1.0 / Display->TargetCaptureRate : 0.0;
+		if (Elapsed + Slack < Interval)
+		{
+			continue;
+		}
+
+		Candidate.Lateness = Interval > 0.0 ? Elapsed / Interval : DBL_MAX;
+		Candidate.bStale = MaxCaptureAge > 0.0f && Elapsed >= MaxCaptureAge;
+		Candidates.Add(Candidate);
+	}
+
+	const int32 Budget = MaxCapturesPerFrame > 0 ? FMath::Min(MaxCapturesPerFrame, Candidates.Num()) : Candidates.Num();
+
+	if (Budget < Candidates.Num())
+	{
+		Candidates.Sort([](const FCaptureCandidate& A, const FCaptureCandidate& B)
+		{
+			if (A.bStale != B.bStale)
+			{
+				return A.bStale;
+			}
+			if (A.Priority != B.Priority)
+			{
+				return A.Priority > B.Priority;
+			}
+			return A.Lateness > B.Lateness;
+		});
+	}
+
+	for (int32 i = 0; i < Budget; ++i)
+	{
+		FScheduledDisplay& Scheduled = Displays[Candidates[i].DisplayIndex];
+
+		// Deferred: rendered together with the main view instead of as a separate scene render
+		Scheduled.Component->CaptureSceneDeferred();
+		Scheduled.LastCaptureTime = Now;
+		++Scheduled.CaptureCount;
+	}
+
+	++StatsFrames;
+	StatsCaptures += Budget;
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+float UDisplayCaptureScheduler::GetAverageCapturesPerFrame() const
+{
+	return StatsFrames > 0 ? (float)StatsCaptures / StatsFrames : 0.0f;
+}
+
+void UDisplayCaptureScheduler::LogStats()
+{
+	const double Now = GetNow();
+	const double Duration = FMath::Max(Now - StatsStartTime, (double)UE_SMALL_NUMBER);
+
+	UE_LOG(LogTemp, Log, TEXT("DisplayCaptureScheduler: %d displays, budget %d, %.2f captures per frame over %.1fs"),
+		Displays.Num(), MaxCapturesPerFrame, GetAverageCapturesPerFrame(), Duration);
+
+	for (FScheduledDisplay& Scheduled : Displays)
+	{
+		if (const UMultiDisplayCameraComponent* Display = Scheduled.Component.Get())
+		{
+			const AActor* Owner = Display->GetOwner();
+			UE_LOG(LogTemp, Log, TEXT("  Display %d (%s): target %.1f Hz, priority %d, achieved %.1f Hz"),
+				Display->GetTargetDisplay(), Owner ? *Owner->GetName() : TEXT("NoOwner"),
+				Display->TargetCaptureRate, Display->CapturePriority, Scheduled.CaptureCount / Duration);
+		}
+		Scheduled.CaptureCount = 0;
+	}
+
+	StatsStartTime = Now;
+	StatsFrames = 0;
+	StatsCaptures = 0;
+}
@@ -0,0 +1,127 @@
+// Arduino Communication Plugin - Hardware Input Net State Implementation
+
+#include "HardwareInputNetState.h"
+
+namespace HardwareInputNetState
+{
+	/** Largest magnitude of the three smallest components of a unit quaternion */
+	static constexpr float SmallestThreeRange = UE_INV_SQRT_2;
+
+	static constexpr uint32 QuatComponentMax = (1u << FHardwareInputNetState::QuatComponentBits) - 1;
+
+	static uint32 QuantizeComponent(float Value)
+	{
+		const float Normalized = FMath::Clamp((Value / SmallestThreeRange) * 0.5f + 0.5f, 0.0f, 1.0f);
+		return (uint32)FMath::RoundToInt(Normalized * QuatComponentMax);
+	}
+
+	static float DequantizeComponent(uint32 Value)
+	{
+		return ((float)Value / QuatComponentMax * 2.0f - 1.0f) * SmallestThreeRange;
+	}
+
+	/** Write or read a unit quaternion as the index of its largest component plus the other three */
+	static void SerializeQuat(FArchive& Ar, FQuat4f& Quat)
+	{
+		uint32 LargestIndex = 0;
+		uint32 Packed[3] = {};
+
+		if (Ar.IsSaving())
+		{
+			FQuat4f Q = Quat.GetNormalized();
+			float Components[4] = { Q.X, Q.Y, Q.Z, Q.W };
+
+			for (uint32 i = 1; i < 4; ++i)
+			{
+				if (FMath::Abs(Components[i]) > FMath::Abs(Components[LargestIndex]))
+				{
+					LargestIndex = i;
+				}
+			}
+
+			// q and -q are the same rotation, so make the dropped component positive
+			const float Sign = Components[LargestIndex] < 0.0f ? -1.0f : 1.0f;
+			for (uint32 i = 0, Out = 0; i < 4; ++i)
+			{
+				if (i != LargestIndex)
+				{
+					Packed[Out++] = QuantizeComponent(Components[i] * Sign);
+				}
+			}
+		}
+
+		Ar.SerializeBits(&LargestIndex, 2);
+		for (uint32& Value : Packed)
+		{
+			Ar.SerializeBits(&Value, FHardwareInputNetState::QuatComponentBits);
+		}
+
+		if (Ar.IsLoading())
+		{
+			float Components[4];
+			float SumSquares = 0.0f;
+			for (uint32 i = 0, In = 0; i < 4; ++i)
+			{
+				if (i != (LargestIndex & 3))
+				{
+					Components[i] = DequantizeComponent(Packed[In++]);
+					SumSquares += FMath::Square(Components[i]);
+				}
+			}
+			Components[LargestIndex & 3] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - SumSquares));
+
+			Quat = FQuat4f(Components[0], Components[1], Components[2], Components[3]).GetNormalized();
+		}
+	}
+}
+
+bool FHardwareInputNetState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << Sequence;
+
+	uint32 WeaponMask = WeaponValidMask;
+	uint32 WheelMask = WheelValidMask;
+	Ar.SerializeBits(&WeaponMask, NumWeapons);
+	Ar.SerializeBits(&WheelMask, NumWheels);
+	WeaponValidMask = (uint8)WeaponMask;
+	WheelValidMask = (uint8)WheelMask;
+
+	for (int32 Side = 0; Side < NumWeapons; ++Side)
+	{
+		if (WeaponValidMask & (1 << Side))
+		{
+			HardwareInputNetState::SerializeQuat(Ar, WeaponOrientation[Side]);
+			Ar << WeaponButtons[Side];
+		}
+	}
+
+	for (int32 Wheel = 0; Wheel < NumWheels; ++Wheel)
+	{
+		if (WheelValidMask & (1 << Wheel))
+		{
+			Ar << WheelCounts[Wheel];
+		}
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FHardwareInputNetState::HasSameInput(const FHardwareInputNetState& Other) const
+{
+	if (WeaponValidMask != Other.WeaponValidMask || WheelValidMask != Other.WheelValidMask)
+	{
+		return false;
+	}
+
+	for (int32 Side = 0; Side < NumWeapons; ++Side)
+	{
+		if (WeaponButtons[Side] != Other.WeaponButtons[Side]
+			|| !WeaponOrientation[Side].Equals(Other.WeaponOrientation[Side], 1.e-4f))
+		{
+			return false;
+		}
+	}
+
+	return FMemory::Memcmp(WheelCounts, Other.WheelCounts, sizeof(WheelCounts)) == 0;
+}
@@ -0,0 +1,561 @@
+// Arduino Communication Plugin - Hardware Input Recorder Implementation
+
+#include "HardwareInputRecorder.h"
+#include "AndySerialSubsystem.h"
+#include "ShipHardwareInputComponent.h"
+#include "HoverMovementComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectIterator.h"
+#include "Algo/BinarySearch.h"
+#include "RenderCore.h"
+
+namespace HardwareInputRecorder
+{
+	/** File magic ("HWRC") and format version */
+	static constexpr uint32 FileMagic = 0x43525748;
+	static constexpr int32 FileVersion = 1;
+
+	/** Value at percentile P (0-1) of a sorted array */
+	static float Percentile(const TArray<float>& Sorted, float P)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0f;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	static float Average(const TArray<float>& Values)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0f;
+		}
+		double Sum = 0.0;
+		for (float Value : Values)
+		{
+			Sum += Value;
+		}
+		return (float)(Sum / Values.Num());
+	}
+
+	static UHardwareInputRecorder* GetRecorder(UWorld* World)
+	{
+		return World ? World->GetSubsystem<UHardwareInputRecorder>() : nullptr;
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs RecordStartCommand(
+		TEXT("Andy.Record.Start"),
+		TEXT("Start recording decoded hardware input for every ship"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UHardwareInputRecorder* Recorder = GetRecorder(World))
+			{
+				Recorder->StartRecording();
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs RecordStopCommand(
+		TEXT("Andy.Record.Stop"),
+		TEXT("Stop recording and save. Usage: Andy.Record.Stop <Name>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UHardwareInputRecorder* Recorder = GetRecorder(World))
+			{
+				Recorder->StopRecording(Args.Num() > 0 ? Args[0] : FString(TEXT("HardwareInput")));
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs PlaybackCommand(
+		TEXT("Andy.Playback"),
+		TEXT("Play back a hardware input recording. Usage: Andy.Playback <Name> [quit]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UHardwareInputRecorder* Recorder = GetRecorder(World);
+			if (Recorder && Args.Num() > 0)
+			{
+				Recorder->StartPlayback(Args[0], Args.Num() > 1 && Args[1] == TEXT("quit"));
+			}
+		}));
+}
+
+bool UHardwareInputRecorder::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UHardwareInputRecorder::Deinitialize()
+{
+	if (SerialSubsystem && FrameParsedHandle.IsValid())
+	{
+		SerialSubsystem->OnFrameParsedTimed.Remove(FrameParsedHandle);
+	}
+	FrameParsedHandle.Reset();
+	if (SerialSubsystem && bPlayingBack)
+	{
+		SerialSubsystem->SetInputClock(nullptr);
+	}
+	SerialSubsystem = nullptr;
+
+	bRecording = false;
+	bPlayingBack = false;
+	Frames.Empty();
+	Ships.Empty();
+
+	Super::Deinitialize();
+}
+
+void UHardwareInputRecorder::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Automated runs: -HardwareInputPlayback=<Name> plays the recording and exits when done
+	FString PlaybackArg;
+	if (FParse::Value(FCommandLine::Get(), TEXT("HardwareInputPlayback="), PlaybackArg))
+	{
+		if (!StartPlayback(PlaybackArg, true))
+		{
+			UE_LOG(LogTemp, Error, TEXT("HardwareInputRecorder: Could not start playback '%s' from command line"), *PlaybackArg);
+			FPlatformMisc::RequestExit(false);
+		}
+	}
+}
+
+TStatId UHardwareInputRecorder::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHardwareInputRecorder, STATGROUP_Tickables);
+}
+
+UAndySerialSubsystem* UHardwareInputRecorder::GetSerialSubsystem()
+{
+	if (!SerialSubsystem)
+	{
+		UWorld* World = GetWorld();
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		SerialSubsystem = GameInstance ? GameInstance->GetSubsystem<UAndySerialSubsystem>() : nullptr;
+	}
+	return SerialSubsystem;
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+bool UHardwareInputRecorder::StartRecording()
+{
+	if (bRecording || bPlayingBack)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HardwareInputRecorder: Cannot start recording while %s"),
+			bRecording ? TEXT("already recording") : TEXT("playing back"));
+		return false;
+	}
+
+	UAndySerialSubsystem* Serial = GetSerialSubsystem();
+	if (!Serial)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HardwareInputRecorder: UAndySerialSubsystem not available"));
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	MapName = UWorld::RemovePIEPrefix(World->GetMapName());
+	Ships.Reset();
+	Frames.Reset();
+
+	// Start state: every ship in the world, whether or not it produces input
+	for (TObjectIterator<UShipHardwareInputComponent> It; It; ++It)
+	{
+		if (It->GetWorld() == World && It->GetOwner() && !It->ShipId.IsNone())
+		{
+			Ships[FindOrAddShip(It->ShipId)].StartTransform = It->GetOwner()->GetActorTransform();
+		}
+	}
+
+	FrameParsedHandle = Serial->OnFrameParsedTimed.AddUObject(this, &UHardwareInputRecorder::HandleFrameParsed);
+	RecordStartTime = Serial->GetInputTime();
+	bRecording = true;
+
+	UE_LOG(LogTemp, Log, TEXT("HardwareInputRecorder: Recording started on '%s' (%d ships)"), *MapName, Ships.Num());
+	return true;
+}
+
+bool UHardwareInputRecorder::StopRecording(const FString& Name)
+{
+	if (!bRecording)
+	{
+		return false;
+	}
+
+	if (SerialSubsystem)
+	{
+		SerialSubsystem->OnFrameParsedTimed.Remove(FrameParsedHandle);
+	}
+	FrameParsedHandle.Reset();
+	bRecording = false;
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	SerializeRecording(Writer);
+
+	const FString Path = GetRecordingPath(Name);
+	if (!FFileHelper::SaveArrayToFile(Data, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HardwareInputRecorder: Failed to write '%s'"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("HardwareInputRecorder: Saved %d frames from %d ships (%.1fs, %d bytes) to '%s'"),
+		Frames.Num(), Ships.Num(), Frames.Num() > 0 ? Frames.Last().Time : 0.0, Data.Num(), *Path);
+	return true;
+}
+
+void UHardwareInputRecorder::HandleFrameParsed(FName ShipId, const FBenchPacket& Packet, double ReceiveTime)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FRecordedFrame& Frame = Frames.AddDefaulted_GetRef();
+	Frame.Time = FMath::Max(0.0, ReceiveTime - RecordStartTime);
+	Frame.ShipIndex = FindOrAddShip(ShipId);
+	Frame.Packet = Packet;
+
+	// Frames from different ports can be delivered slightly out of receive order
+	for (int32 i = Frames.Num() - 1; i > 0 && Frames[i - 1].Time > Frames[i].Time; --i)
+	{
+		Frames.Swap(i - 1, i);
+	}
+}
+
+int32 UHardwareInputRecorder::FindOrAddShip(FName ShipId)
+{
+	const int32 Existing = Ships.IndexOfByPredicate([ShipId](const FRecordedShip& Ship) { return Ship.ShipId == ShipId; });
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+
+	FRecordedShip& Ship = Ships.AddDefaulted_GetRef();
+	Ship.ShipId = ShipId;
+	return Ships.Num() - 1;
+}
+
+// ============================================================================
+// PLAYBACK
+// ============================================================================
+
+bool UHardwareInputRecorder::StartPlayback(const FString& Name, bool bQuitWhenFinished)
+{
+	if (bRecording || bPlayingBack)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HardwareInputRecorder: Cannot start playback while %s"),
+			bRecording ? TEXT("recording") : TEXT("already playing back"));
+		return false;
+	}
+
+	if (!GetSerialSubsystem())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HardwareInputRecorder: UAndySerialSubsystem not available"));
+		return false;
+	}
+
+	const FString Path = GetRecordingPath(Name);
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HardwareInputRecorder: Failed to read '%s'"), *Path);
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	SerializeRecording(Reader);
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("HardwareInputRecorder: '%s' is not a valid recording"), *Path);
+		Frames.Reset();
+		Ships.Reset();
+		return false;
+	}
+
+	const FString CurrentMap = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	if (CurrentMap != MapName)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HardwareInputRecorder: '%s' was recorded on '%s' but the current map is '%s'"),
+			*Path, *MapName, *CurrentMap);
+		return false;
+	}
+
+	RestoreStartState();
+
+	PlaybackName = FPaths::GetBaseFilename(Path);
+	bQuitAfterPlayback = bQuitWhenFinished;
+	PlaybackElapsed = 0.0;
+	PlaybackCursor = 0;
+	PlaybackBaseTime = SerialSubsystem->GetInputTime();
+	PlaybackStartWallTime = FPlatformTime::Seconds();
+	LastTickWallTime = 0.0;
+	FrameTimesMs.Reset();
+	GameThreadTimesMs.Reset();
+	RenderThreadTimesMs.Reset();
+	bPlayingBack = true;
+
+	// Input is stamped and sampled on game time until playback finishes
+	TWeakObjectPtr<UHardwareInputRecorder> WeakThis(this);
+	SerialSubsystem->SetInputClock([WeakThis]()
+	{
+		const UHardwareInputRecorder* Recorder = WeakThis.Get();
+		return Recorder ? Recorder->PlaybackBaseTime + Recorder->PlaybackElapsed : FPlatformTime::Seconds();
+	});
+
+	UE_LOG(LogTemp, Log, TEXT("HardwareInputRecorder: Playing '%s' (%d frames, %d ships, %.1fs)"),
+		*PlaybackName, Frames.Num(), Ships.Num(), Frames.Num() > 0 ? Frames.Last().Time : 0.0);
+	return true;
+}
+
+void UHardwareInputRecorder::StopPlayback()
+{
+	if (bPlayingBack)
+	{
+		FinishPlayback();
+	}
+}
+
+void UHardwareInputRecorder::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bPlayingBack)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (LastTickWallTime > 0.0)
+	{
+		FrameTimesMs.Add((float)((Now - LastTickWallTime) * 1000.0));
+		GameThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+		RenderThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GRenderThreadTime));
+	}
+	LastTickWallTime = Now;
+
+	// Release frames on game time so a fixed time step gives the same frames on every run
+	PlaybackElapsed += DeltaTime;
+
+	while (PlaybackCursor < Frames.Num() && Frames[PlaybackCursor].Time <= PlaybackElapsed)
+	{
+		// Stamped on the playback clock at their recorded time, which is never ahead of it
+		const FRecordedFrame& Frame = Frames[PlaybackCursor++];
+		SerialSubsystem->InjectPacket(Ships[Frame.ShipIndex].ShipId, Frame.Packet, PlaybackBaseTime + Frame.Time);
+	}
+
+	const double EndTime = (Frames.Num() > 0 ? Frames.Last().Time : 0.0) + PlaybackTailTime;
+	if (PlaybackCursor >= Frames.Num() && PlaybackElapsed >= EndTime)
+	{
+		FinishPlayback();
+	}
+}
+
+void UHardwareInputRecorder::RestoreStartState()
+{
+	UWorld* World = GetWorld();
+
+	for (TObjectIterator<UShipHardwareInputComponent> It; It; ++It)
+	{
+		UShipHardwareInputComponent* Component = *It;
+		AActor* Owner = Component->GetOwner();
+		if (Component->GetWorld() != World || !Owner)
+		{
+			continue;
+		}
+
+		const FRecordedShip* Ship = Ships.FindByPredicate([Component](const FRecordedShip& Recorded) { return Recorded.ShipId == Component->ShipId; });
+		if (!Ship)
+		{
+			continue;
+		}
+
+		Owner->SetActorTransform(Ship->StartTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+		if (UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(Owner->GetRootComponent()))
+		{
+			if (Root->IsSimulatingPhysics())
+			{
+				Root->SetPhysicsLinearVelocity(FVector::ZeroVector);
+				Root->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+			}
+		}
+
+		if (UHoverMovementComponent* Movement = Owner->FindComponentByClass<UHoverMovementComponent>())
+		{
+			Movement->ResetInput();
+		}
+		Component->RecenterWheels();
+	}
+}
+
+void UHardwareInputRecorder::FinishPlayback()
+{
+	bPlayingBack = false;
+	if (SerialSubsystem)
+	{
+		SerialSubsystem->SetInputClock(nullptr);
+	}
+
+	FHardwarePlaybackStats Stats;
+	Stats.RecordingName = PlaybackName;
+	Stats.MapName = MapName;
+	Stats.NumShips = Ships.Num();
+	Stats.NumFrames = FrameTimesMs.Num();
+	Stats.Duration = (float)(FPlatformTime::Seconds() - PlaybackStartWallTime);
+
+	TArray<float> Sorted = FrameTimesMs;
+	Sorted.Sort();
+	Stats.AvgFrameMs = HardwareInputRecorder::Average(FrameTimesMs);
+	Stats.P50FrameMs = HardwareInputRecorder::Percentile(Sorted, 0.50f);
+	Stats.P95FrameMs = HardwareInputRecorder::Percentile(Sorted, 0.95f);
+	Stats.P99FrameMs = HardwareInputRecorder::Percentile(Sorted, 0.99f);
+	Stats.MaxFrameMs = Sorted.Num() > 0 ? Sorted.Last() : 0.0f;
+	Stats.HitchCount = Sorted.Num() - Algo::LowerBound(Sorted, HitchThresholdMs);
+
+	Sorted = GameThreadTimesMs;
+	Sorted.Sort();
+	Stats.AvgGameThreadMs = HardwareInputRecorder::Average(GameThreadTimesMs);
+	Stats.P95GameThreadMs = HardwareInputRecorder::Percentile(Sorted, 0.95f);
+	Stats.MaxGameThreadMs = Sorted.Num() > 0 ? Sorted.Last() : 0.0f;
+	Stats.AvgRenderThreadMs = HardwareInputRecorder::Average(RenderThreadTimesMs);
+
+	UE_LOG(LogTemp, Log, TEXT("HardwareInputRecorder: Playback '%s' on '%s' finished - %d ships, %d frames in %.1fs"),
+		*Stats.RecordingName, *Stats.MapName, Stats.NumShips, Stats.NumFrames, Stats.Duration);
+	UE_LOG(LogTemp, Log, TEXT("HardwareInputRecorder:   Frame ms avg %.2f p50 %.2f p95 %.2f p99 %.2f max %.2f, hitches (>%.1f ms) %d"),
+		Stats.AvgFrameMs, Stats.P50FrameMs, Stats.P95FrameMs, Stats.P99FrameMs, Stats.MaxFrameMs, HitchThresholdMs, Stats.HitchCount);
+	UE_LOG(LogTemp, Log, TEXT("HardwareInputRecorder:   Game thread ms avg %.2f p95 %.2f max %.2f, render thread ms avg %.2f"),
+		Stats.AvgGameThreadMs, Stats.P95GameThreadMs, Stats.MaxGameThreadMs, Stats.AvgRenderThreadMs);
+
+	// Machine-readable summary for the nightly job
+	const FString Json = FString::Printf(
+		TEXT("{\n")
+		TEXT("\t\"recording\": \"%s\",\n\t\"map\": \"%s\",\n\t\"ships\": %d,\n\t\"frames\": %d,\n\t\"duration_s\": %.3f,\n")
+		TEXT("\t\"frame_ms\": { \"avg\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n")
+		TEXT("\t\"game_thread_ms\": { \"avg\": %.3f, \"p95\": %.3f, \"max\": %.3f },\n")
+		TEXT("\t\"render_thread_ms\": { \"avg\": %.3f },\n")
+		TEXT("\t\"hitch_threshold_ms\": %.1f,\n\t\"hitches\": %d\n}\n"),
+		*Stats.RecordingName, *Stats.MapName, Stats.NumShips, Stats.NumFrames, Stats.Duration,
+		Stats.AvgFrameMs, Stats.P50FrameMs, Stats.P95FrameMs, Stats.P99FrameMs, Stats.MaxFrameMs,
+		Stats.AvgGameThreadMs, Stats.P95GameThreadMs, Stats.MaxGameThreadMs,
+		Stats.AvgRenderThreadMs,
+		HitchThresholdMs, Stats.HitchCount);
+
+	const FString StatsPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), TEXT("HardwareInputPlayback"),
+		FString::Printf(TEXT("%s_%s.json"), *Stats.RecordingName, *FDateTime::Now().ToString()));
+	if (FFileHelper::SaveStringToFile(Json, *StatsPath))
+	{
+		UE_LOG(LogTemp, Log, TEXT("HardwareInputRecorder: Stats written to '%s'"), *StatsPath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("HardwareInputRecorder: Failed to write stats to '%s'"), *StatsPath);
+	}
+
+	OnPlaybackFinished.Broadcast(Stats);
+
+	if (bQuitAfterPlayback)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+// ============================================================================
+// FILE FORMAT
+// ============================================================================
+
+FString UHardwareInputRecorder::GetRecordingPath(const FString& Name)
+{
+	FString Path = Name;
+	if (FPaths::GetExtension(Path).IsEmpty())
+	{
+		Path += TEXT(".hwrec");
+	}
+	if (FPaths::IsRelative(Path))
+	{
+		Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HardwareRecordings"), Path);
+	}
+	return Path;
+}
+
+void UHardwareInputRecorder::SerializeRecording(FArchive& Ar)
+{
+	uint32 Magic = HardwareInputRecorder::FileMagic;
+	int32 Version = HardwareInputRecorder::FileVersion;
+	Ar << Magic;
+	Ar << Version;
+	if (Magic != HardwareInputRecorder::FileMagic || Version != HardwareInputRecorder::FileVersion)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << MapName;
+
+	int32 NumShips = Ships.Num();
+	Ar << NumShips;
+	if (Ar.IsLoading())
+	{
+		if (NumShips < 0 || NumShips > 256)
+		{
+			Ar.SetError();
+			return;
+		}
+		Ships.SetNum(NumShips);
+	}
+
+	for (FRecordedShip& Ship : Ships)
+	{
+		FString ShipName = Ship.ShipId.ToString();
+		Ar << ShipName;
+		Ship.ShipId = FName(*ShipName);
+		Ar << Ship.StartTransform;
+	}
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+	if (Ar.IsLoading())
+	{
+		if (NumFrames < 0 || Ar.IsError())
+		{
+			Ar.SetError();
+			return;
+		}
+		Frames.SetNum(NumFrames);
+	}
+
+	for (FRecordedFrame& Frame : Frames)
+	{
+		Ar << Frame.Time;
+		Ar << Frame.ShipIndex;
+		Ar << Frame.Packet.Ver;
+		Ar << Frame.Packet.Src;
+		Ar << Frame.Packet.Type;
+		Ar << Frame.Packet.Seq;
+		Ar << Frame.Packet.Len;
+		Ar << Frame.Packet.Payload;
+
+		if (Ar.IsError() || !Ships.IsValidIndex(Frame.ShipIndex))
+		{
+			Ar.SetError();
+			return;
+		}
+	}
+}
@@ -0,0 +1,214 @@
+// Arduino Communication Plugin - Hardware Input Sampler Implementation
+
+#include "HardwareInputSampler.h"
+#include "AndySerialSubsystem.h"
+#include "ByteStreamPacketParser.h"
+#include "EspPacketBP.h"
+
+void UHardwareInputSampler::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SerialSubsystem = Collection.InitializeDependency<UAndySerialSubsystem>();
+	if (SerialSubsystem)
+	{
+		FrameParsedHandle = SerialSubsystem->OnFrameParsedTimed.AddUObject(this, &UHardwareInputSampler::IngestFrame);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("HardwareInputSampler: Initialized at %.0f Hz"), SampleRate);
+}
+
+void UHardwareInputSampler::Deinitialize()
+{
+	if (SerialSubsystem)
+	{
+		SerialSubsystem->OnFrameParsedTimed.Remove(FrameParsedHandle);
+		SerialSubsystem = nullptr;
+	}
+
+	Timelines.Empty();
+
+	Super::Deinitialize();
+}
+
+void UHardwareInputSampler::SetSampleRate(float NewSampleRate)
+{
+	SampleRate = FMath::Clamp(NewSampleRate, 30.0f, 1000.0f);
+
+	// Restart every grid at the new spacing
+	for (auto& Pair : Timelines)
+	{
+		Pair.Value.NextSampleTime = 0.0;
+	}
+}
+
+// ============================================================================
+// Ingest
+// ============================================================================
+
+void UHardwareInputSampler::IngestFrame(FName ShipId, const FBenchPacket& Packet, double ReceiveTime)
+{
+	FPendingInputEvent Event;
+	Event.Time = ReceiveTime;
+	Event.Type = Packet.Type;
+
+	switch (UEspPacketBP::ByteToMsgType(Packet.Type))
+	{
+	case EEspMsgType::WheelTurn:
+		{
+			FWheelTurnData WheelData;
+			if (!UEspPacketBP::ParseWheelTurnPayload(Packet.Payload, WheelData) || WheelData.WheelIndex >= FShipInputSample::MaxWheels)
+			{
+				return;
+			}
+			Event.Index = WheelData.WheelIndex;
+			Event.WheelDelta = WheelData.bRight ? 1 : -1;
+		}
+		break;
+
+	case EEspMsgType::WeaponImu:
+		{
+			FWeaponImuData ImuData;
+			if (!UEspPacketBP::ParseWeaponImuPayload(Packet.Payload, ImuData) || ImuData.Side >= FShipInputSample::MaxWeapons)
+			{
+				return;
+			}
+			Event.Index = ImuData.Side;
+			Event.Orientation = FQuat4f(ImuData.GetQuaternion());
+			Event.Buttons = ImuData.Buttons;
+		}
+		break;
+
+	default:
+		// Not part of the sampled state
+		return;
+	}
+
+	FShipTimeline& Timeline = Timelines.FindOrAdd(ShipId);
+
+	// Frames almost always arrive in order, so search for the insert point from the back
+	int32 InsertIndex = Timeline.PendingEvents.Num();
+	while (InsertIndex > 0 && Timeline.PendingEvents[InsertIndex - 1].Time > Event.Time)
+	{
+		--InsertIndex;
+	}
+	Timeline.PendingEvents.Insert(Event, InsertIndex);
+
+	// Nobody is reading this ship - fold events into the state so the queue stays bounded
+	if (Timeline.PendingEvents.Num() > SampleHistorySize)
+	{
+		AdvanceTimeline(Timeline, ReceiveTime);
+	}
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+int32 UHardwareInputSampler::GetSamples(FName ShipId, double AfterTime, double UpToTime, TArray<FShipInputSample>& OutSamples)
+{
+	OutSamples.Reset();
+
+	FShipTimeline& Timeline = Timelines.FindOrAdd(ShipId);
+	AdvanceTimeline(Timeline, UpToTime);
+
+	const int32 Num = Timeline.History.Num();
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const FShipInputSample& Sample = Timeline.History[(Timeline.HistoryHead + i) % Num];
+		if (Sample.Time > AfterTime && Sample.Time <= UpToTime)
+		{
+			OutSamples.Add(Sample);
+		}
+	}
+
+	return OutSamples.Num();
+}
+
+bool UHardwareInputSampler::GetLatestSample(FName ShipId, FShipInputSample& OutSample) const
+{
+	const FShipTimeline* Timeline = Timelines.Find(ShipId);
+	if (!Timeline || Timeline->History.Num() == 0)
+	{
+		return false;
+	}
+
+	const int32 Num = Timeline->History.Num();
+	OutSample = Timeline->History[(Timeline->HistoryHead + Num - 1) % Num];
+	return true;
+}
+
+// ============================================================================
+// Internal
+// ============================================================================
+
+void UHardwareInputSampler::AdvanceTimeline(FShipTimeline& Timeline, double UpToTime)
+{
+	const double Interval = 1.0 / SampleRate;
+
+	// The input clock was switched to one that is behind (playback started): nothing from the old clock applies
+	if (Timeline.NextSampleTime > UpToTime + Interval)
+	{
+		Timeline.History.Reset();
+		Timeline.HistoryHead = 0;
+		Timeline.PendingEvents.Reset();
+		Timeline.NextSampleTime = 0.0;
+	}
+
+	// Start (or restart after a long stall) on the grid just before UpToTime
+	const double OldestUseful = UpToTime - (SampleHistorySize - 1) * Interval;
+	if (Timeline.NextSampleTime <= 0.0 || Timeline.NextSampleTime < OldestUseful)
+	{
+		Timeline.NextSampleTime = FMath::CeilToDouble(FMath::Max(OldestUseful, UpToTime - Interval) / Interval) * Interval;
+	}
+
+	int32 EventIndex = 0;
+	while (Timeline.NextSampleTime <= UpToTime)
+	{
+		// Late events (older than the previous sample) land on the next sample
+		while (EventIndex < Timeline.PendingEvents.Num() && Timeline.PendingEvents[EventIndex].Time <= Timeline.NextSampleTime)
+		{
+			ApplyEvent(Timeline.State, Timeline.PendingEvents[EventIndex]);
+			++EventIndex;
+		}
+
+		Timeline.State.Time = Timeline.NextSampleTime;
+
+		if (Timeline.History.Num() < SampleHistorySize)
+		{
+			Timeline.History.Add(Timeline.State);
+		}
+		else
+		{
+			Timeline.History[Timeline.HistoryHead] = Timeline.State;
+			Timeline.HistoryHead = (Timeline.HistoryHead + 1) % SampleHistorySize;
+		}
+
+		Timeline.NextSampleTime += Interval;
+	}
+
+	if (EventIndex > 0)
+	{
+		Timeline.PendingEvents.RemoveAt(0, EventIndex, EAllowShrinking::No);
+	}
+}
+
+void UHardwareInputSampler::ApplyEvent(FShipInputSample& State, const FPendingInputEvent& Event)
+{
+	switch (UEspPacketBP::ByteToMsgType(Event.Type))
+	{
+	case EEspMsgType::WheelTurn:
+		State.WheelCounts[Event.Index] += Event.WheelDelta;
+		break;
+
+	case EEspMsgType::WeaponImu:
+		State.WeaponOrientation[Event.Index] = Event.Orientation;
+		State.WeaponButtons[Event.Index] = Event.Buttons;
+		State.LastImuSide = Event.Index;
+		State.bHasImu = true;
+		break;
+
+	default:
+		break;
+	}
+}
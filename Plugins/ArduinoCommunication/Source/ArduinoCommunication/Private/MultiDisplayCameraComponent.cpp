@@ -1,6 +1,12 @@
 // Multi-Display Camera Component - Implementation
 
 #include "MultiDisplayCameraComponent.h"
+#include "DisplayCaptureScheduler.h"
+#include "MultiDisplayViewportClient.h"
+#include "Engine/World.h"
+#include "RenderingThread.h"
+#include "Slate/SceneViewport.h"
+#include "Widgets/SViewport.h"
 #include "Engine/Engine.h"
 #include "Widgets/SWindow.h"
 #include "Widgets/Images/SImage.h"
@@ -16,7 +22,7 @@ UMultiDisplayCameraComponent::UMultiDisplayCameraComponent()
 	// Auto-activate on BeginPlay (inherited from UActorComponent)
 	bAutoActivate = true;
 
-	// Let the engine manage scene capture every frame.
+	// Capture every frame unless UDisplayCaptureScheduler takes over in BeginPlay.
 	// This is the standard pipeline and properly handles multiple
 	// SceneCaptureComponent2D instances rendering in the same frame.
 	bCaptureEveryFrame = true;
@@ -43,6 +49,12 @@ void UMultiDisplayCameraComponent::BeginPlay()
 	// during registration and properly sets up the GPU capture commands.
 	SetupRenderTarget();
 
+	// Hand captures over to the scheduler (or turn them off for a direct viewport) before the
+	// engine registers the capture, so it never starts capturing every frame on its own
+	ConfigureCapture();
+
+	UpdateTickGroup();
+
 	Super::BeginPlay();
 
 	UE_LOG(LogMultiDisplay, Log, TEXT("%s: BeginPlay (TextureTarget: %s, Resource: %s)"),
@@ -52,7 +64,7 @@ void UMultiDisplayCameraComponent::BeginPlay()
 
 	// Do an initial capture to pre-fill the render target with content.
 	// This ensures the render target has valid scene data before the deferred
-	// window open, supplementing the engine's bCaptureEveryFrame pipeline.
+	// window open, supplementing the scheduled or per-frame captures.
 	if (TextureTarget)
 	{
 		CaptureScene();
@@ -68,6 +80,15 @@ void UMultiDisplayCameraComponent::EndPlay(const EEndPlayReason::Type EndPlayRea
 {
 	UE_LOG(LogMultiDisplay, Log, TEXT("%s: EndPlay"), *GetDisplayLogPrefix());
 
+	if (bIsScheduled)
+	{
+		if (UDisplayCaptureScheduler* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UDisplayCaptureScheduler>() : nullptr)
+		{
+			Scheduler->UnregisterDisplay(this);
+		}
+		bIsScheduled = false;
+	}
+
 	DeactivateDisplay();
 	DestroySecondaryWindow();
 
@@ -86,8 +107,9 @@ void UMultiDisplayCameraComponent::TickComponent(float DeltaTime, ELevelTick Tic
 	// Deferred window open: wait N frames for the render target to have valid content
 	if (bPendingWindowOpen)
 	{
+		// A direct viewport has nothing to wait for
 		FrameDelayCounter++;
-		if (FrameDelayCounter >= WindowOpenDelay)
+		if (FrameDelayCounter >= (IsDirectViewport() ? 1 : WindowOpenDelay))
 		{
 			bPendingWindowOpen = false;
 			CreateSecondaryWindow();
@@ -100,6 +122,13 @@ void UMultiDisplayCameraComponent::TickComponent(float DeltaTime, ELevelTick Tic
 
 void UMultiDisplayCameraComponent::SetupRenderTarget()
 {
+	// A direct viewport renders into the window itself
+	if (IsDirectViewport())
+	{
+		TextureTarget = nullptr;
+		return;
+	}
+
 	int32 Width = RenderTargetWidth;
 	int32 Height = RenderTargetHeight;
 
@@ -138,6 +167,30 @@ void UMultiDisplayCameraComponent::SetupRenderTarget()
 		TextureTarget->GetResource() ? TEXT("valid") : TEXT("null"));
 }
 
+void UMultiDisplayCameraComponent::ConfigureCapture()
+{
+	UDisplayCaptureScheduler* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UDisplayCaptureScheduler>() : nullptr;
+	const bool bSchedule = !IsDirectViewport() && bUseCaptureScheduler && Scheduler != nullptr;
+
+	if (Scheduler && bSchedule != bIsScheduled)
+	{
+		if (bSchedule)
+		{
+			Scheduler->RegisterDisplay(this);
+		}
+		else
+		{
+			Scheduler->UnregisterDisplay(this);
+		}
+	}
+	bIsScheduled = bSchedule;
+
+	// Engine-driven captures only when nothing else presents the view
+	const bool bEngineCaptures = !IsDirectViewport() && !bIsScheduled;
+	bCaptureEveryFrame = bEngineCaptures;
+	bCaptureOnMovement = bEngineCaptures;
+}
+
 void UMultiDisplayCameraComponent::ActivateDisplay()
 {
 	if (bIsDisplayActive)
@@ -145,20 +198,20 @@ void UMultiDisplayCameraComponent::ActivateDisplay()
 		return;
 	}
 
-	if (!TextureTarget)
+	if (!TextureTarget && !IsDirectViewport())
 	{
 		UE_LOG(LogMultiDisplay, Warning, TEXT("%s: No render target, creating one"), *GetDisplayLogPrefix());
 		SetupRenderTarget();
 	}
 
 	// Defer window creation to let the engine capture several frames first.
-	// The engine's bCaptureEveryFrame=true will populate the render target
+	// The scheduler (or bCaptureEveryFrame) will populate the render target
 	// during these frames, ensuring the window shows content when it opens.
 	bPendingWindowOpen = true;
 	FrameDelayCounter = 0;
 	bIsDisplayActive = true;
 
-	UE_LOG(LogMultiDisplay, Log, TEXT("%s: Activated (window opens in %d frames)"), *GetDisplayLogPrefix(), WindowOpenDelay);
+	UE_LOG(LogMultiDisplay, Log, TEXT("%s: Activated (window opens in %d frames)"), *GetDisplayLogPrefix(), IsDirectViewport() ? 1 : WindowOpenDelay);
 }
 
 void UMultiDisplayCameraComponent::DeactivateDisplay()
@@ -280,6 +333,8 @@ void UMultiDisplayCameraComponent::RefreshDisplayConfiguration()
 	}
 
 	SetupRenderTarget();
+	ConfigureCapture();
+	UpdateTickGroup();
 
 	if (bWasActive)
 	{
@@ -287,6 +342,26 @@ void UMultiDisplayCameraComponent::RefreshDisplayConfiguration()
 	}
 }
 
+void UMultiDisplayCameraComponent::UpdateTickGroup()
+{
+	// Direct viewports render in their own pass after the world has finished moving
+	if (IsDirectViewport())
+	{
+		if (!bTickGroupOverridden)
+		{
+			OriginalTickGroup = PrimaryComponentTick.TickGroup;
+			bTickGroupOverridden = true;
+		}
+		SetTickGroup(TG_PostUpdateWork);
+	}
+	else if (bTickGroupOverridden)
+	{
+		// Back to whatever tick group was set before the override (e.g. in the editor)
+		SetTickGroup(OriginalTickGroup);
+		bTickGroupOverridden = false;
+	}
+}
+
 void UMultiDisplayCameraComponent::CreateSecondaryWindow()
 {
 	if (!FSlateApplication::IsInitialized())
@@ -331,11 +406,51 @@ void UMultiDisplayCameraComponent::CreateSecondaryWindow()
 	UE_LOG(LogMultiDisplay, Log, TEXT("%s: Creating window at (%d,%d) size %dx%d"),
 		*GetDisplayLogPrefix(), WindowX, WindowY, WindowWidth, WindowHeight);
 
+	TSharedPtr<SWidget> WindowContent = IsDirectViewport()
+		? CreateViewportContent()
+		: CreateRenderTargetContent(WindowWidth, WindowHeight);
+	if (!WindowContent.IsValid())
+	{
+		return;
+	}
+
+	// Build the Slate window with a title that identifies this camera
+	AActor* Owner = GetOwner();
+	FString OwnerName = Owner ? Owner->GetActorNameOrLabel() : TEXT("Camera");
+	FText WindowTitle = FText::FromString(FString::Printf(TEXT("Camera - Display %d (%s)"), TargetDisplayIndex, *OwnerName));
+
+	SecondaryWindow = SNew(SWindow)
+		.Title(WindowTitle)
+		.ClientSize(FVector2D(WindowWidth, WindowHeight))
+		.ScreenPosition(FVector2D(WindowX, WindowY))
+		.AutoCenter(EAutoCenter::None)
+		.SizingRule(bFullscreen ? ESizingRule::FixedSize : ESizingRule::UserSized)
+		.UseOSWindowBorder(!bFullscreen)
+		.FocusWhenFirstShown(false)
+		.SupportsMaximize(!bFullscreen)
+		.SupportsMinimize(!bFullscreen)
+		.HasCloseButton(!bFullscreen)
+		[
+			WindowContent.ToSharedRef()
+		];
+
+	FSlateApplication::Get().AddWindow(SecondaryWindow.ToSharedRef(), true);
+
+	if (bFullscreen)
+	{
+		SecondaryWindow->SetWindowMode(EWindowMode::WindowedFullscreen);
+	}
+
+	UE_LOG(LogMultiDisplay, Log, TEXT("%s: Window opened successfully"), *GetDisplayLogPrefix());
+}
+
+TSharedPtr<SWidget> UMultiDisplayCameraComponent::CreateRenderTargetContent(int32 WindowWidth, int32 WindowHeight)
+{
 	// Verify render target is ready
 	if (!TextureTarget)
 	{
 		UE_LOG(LogMultiDisplay, Error, TEXT("%s: No render target available!"), *GetDisplayLogPrefix());
-		return;
+		return nullptr;
 	}
 
 	if (!TextureTarget->GetResource())
@@ -385,38 +500,45 @@ void UMultiDisplayCameraComponent::CreateSecondaryWindow()
 	// widget geometry and paint are recalculated every single frame.
 	DisplayImage->ForceVolatile(true);
 
-	// Build the Slate window with a title that identifies this camera
-	AActor* Owner = GetOwner();
-	FString OwnerName = Owner ? Owner->GetActorNameOrLabel() : TEXT("Camera");
-	FText WindowTitle = FText::FromString(FString::Printf(TEXT("Camera - Display %d (%s)"), TargetDisplayIndex, *OwnerName));
+	return DisplayImage;
+}
 
-	SecondaryWindow = SNew(SWindow)
-		.Title(WindowTitle)
-		.ClientSize(FVector2D(WindowWidth, WindowHeight))
-		.ScreenPosition(FVector2D(WindowX, WindowY))
-		.AutoCenter(EAutoCenter::None)
-		.SizingRule(bFullscreen ? ESizingRule::FixedSize : ESizingRule::UserSized)
-		.UseOSWindowBorder(!bFullscreen)
-		.FocusWhenFirstShown(false)
-		.SupportsMaximize(!bFullscreen)
-		.SupportsMinimize(!bFullscreen)
-		.HasCloseButton(!bFullscreen)
-		[
-			DisplayImage.ToSharedRef()
-		];
+TSharedPtr<SWidget> UMultiDisplayCameraComponent::CreateViewportContent()
+{
+	// The viewport renders the shared world from this component's view straight into the
+	// window's back buffer: no render target, no extra copy, and the full game post-processing
+	ViewportClient = MakeShared<FMultiDisplayViewportClient>(this);
 
-	FSlateApplication::Get().AddWindow(SecondaryWindow.ToSharedRef(), true);
+	ViewportWidget = SNew(SViewport)
+		.RenderDirectlyToWindow(true)
+		.EnableGammaCorrection(false)
+		.EnableBlending(false)
+		.IgnoreTextureAlpha(true);
 
-	if (bFullscreen)
-	{
-		SecondaryWindow->SetWindowMode(EWindowMode::WindowedFullscreen);
-	}
+	SceneViewport = MakeShared<FSceneViewport>(ViewportClient.Get(), ViewportWidget);
+	ViewportWidget->SetViewportInterface(SceneViewport.ToSharedRef());
 
-	UE_LOG(LogMultiDisplay, Log, TEXT("%s: Window opened successfully"), *GetDisplayLogPrefix());
+	UE_LOG(LogMultiDisplay, Log, TEXT("%s: Direct viewport created"), *GetDisplayLogPrefix());
+
+	return ViewportWidget;
 }
 
 void UMultiDisplayCameraComponent::DestroySecondaryWindow()
 {
+	if (SceneViewport.IsValid())
+	{
+		// The render thread may still be drawing into the viewport
+		FlushRenderingCommands();
+
+		if (ViewportWidget.IsValid())
+		{
+			ViewportWidget->SetViewportInterface(nullptr);
+		}
+		SceneViewport.Reset();
+		ViewportClient.Reset();
+		ViewportWidget.Reset();
+	}
+
 	if (SecondaryWindow.IsValid())
 	{
 		if (FSlateApplication::IsInitialized())
@@ -433,6 +555,13 @@ void UMultiDisplayCameraComponent::DestroySecondaryWindow()
 
 void UMultiDisplayCameraComponent::UpdateWindowContent()
 {
+	// Direct viewport: render this frame's view into the window
+	if (SceneViewport.IsValid())
+	{
+		SceneViewport->Draw();
+		return;
+	}
+
 	if (!DisplayImage.IsValid() || !SecondaryWindow.IsValid())
 	{
 		return;
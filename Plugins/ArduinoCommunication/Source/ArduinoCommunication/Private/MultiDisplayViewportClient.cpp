@@ -0,0 +1,99 @@
+// Arduino Communication Plugin - Multi-Display Viewport Client Implementation
+
+#include "MultiDisplayViewportClient.h"
+#include "MultiDisplayCameraComponent.h"
+#include "CanvasTypes.h"
+#include "EngineModule.h"
+#include "LegacyScreenPercentageDriver.h"
+#include "SceneView.h"
+#include "SceneInterface.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+FMultiDisplayViewportClient::FMultiDisplayViewportClient(UMultiDisplayCameraComponent* InCamera)
+	: Camera(InCamera)
+{
+}
+
+UWorld* FMultiDisplayViewportClient::GetWorld() const
+{
+	const UMultiDisplayCameraComponent* CameraComponent = Camera.Get();
+	return CameraComponent ? CameraComponent->GetWorld() : nullptr;
+}
+
+void FMultiDisplayViewportClient::Draw(FViewport* InViewport, FCanvas* Canvas)
+{
+	UMultiDisplayCameraComponent* CameraComponent = Camera.Get();
+	UWorld* World = GetWorld();
+	const FIntPoint Size = InViewport->GetSizeXY();
+
+	if (!CameraComponent || !World || !World->Scene || Size.X <= 0 || Size.Y <= 0)
+	{
+		Canvas->Clear(FLinearColor::Black);
+		return;
+	}
+
+	if (!ViewState.GetReference())
+	{
+		ViewState.Allocate(World->GetFeatureLevel());
+	}
+
+	FSceneViewFamilyContext ViewFamily(FSceneViewFamily::ConstructionValues(InViewport, World->Scene, CameraComponent->ShowFlags)
+		.SetTime(World->GetTime())
+		.SetRealtimeUpdate(true));
+
+	ViewFamily.ViewMode = VMI_Lit;
+	EngineShowFlagOverride(ESFIM_Game, ViewFamily.ViewMode, ViewFamily.EngineShowFlags, false);
+	ViewFamily.SetScreenPercentageInterface(new FLegacyScreenPercentageDriver(ViewFamily, 1.0f));
+
+	const FVector ViewLocation = CameraComponent->GetComponentLocation();
+	const FRotator ViewRotation = CameraComponent->GetComponentRotation();
+	const float HalfFOVRadians = FMath::DegreesToRadians(FMath::Max(CameraComponent->FOVAngle, 0.001f)) * 0.5f;
+
+	FSceneViewInitOptions ViewInitOptions;
+	ViewInitOptions.SetViewRectangle(FIntRect(0, 0, Size.X, Size.Y));
+	ViewInitOptions.ViewFamily = &ViewFamily;
+	ViewInitOptions.ViewActor = CameraComponent->GetOwner();
+	ViewInitOptions.ViewOrigin = ViewLocation;
+
+	// Unreal's X-forward, Z-up world to the renderer's view space
+	ViewInitOptions.ViewRotationMatrix = FInverseRotationMatrix(ViewRotation) * FMatrix(
+		FPlane(0, 0, 1, 0),
+		FPlane(1, 0, 0, 0),
+		FPlane(0, 1, 0, 0),
+		FPlane(0, 0, 0, 1));
+	ViewInitOptions.ProjectionMatrix = FReversedZPerspectiveMatrix(HalfFOVRadians, (float)Size.X, (float)Size.Y, GNearClippingPlane);
+	ViewInitOptions.FOV = CameraComponent->FOVAngle;
+	ViewInitOptions.DesiredFOV = CameraComponent->FOVAngle;
+	ViewInitOptions.BackgroundColor = FLinearColor::Black;
+	ViewInitOptions.SceneViewStateInterface = ViewState.GetReference();
+
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Hidden : CameraComponent->HiddenComponents)
+	{
+		if (const UPrimitiveComponent* Primitive = Hidden.Get())
+		{
+			ViewInitOptions.HiddenPrimitives.Add(Primitive->GetPrimitiveSceneId());
+		}
+	}
+	for (const AActor* HiddenActor : CameraComponent->HiddenActors)
+	{
+		if (!HiddenActor)
+		{
+			continue;
+		}
+		HiddenActor->ForEachComponent<UPrimitiveComponent>(false, [&ViewInitOptions](const UPrimitiveComponent* Primitive)
+		{
+			ViewInitOptions.HiddenPrimitives.Add(Primitive->GetPrimitiveSceneId());
+		});
+	}
+
+	FSceneView* View = new FSceneView(ViewInitOptions);
+	ViewFamily.Views.Add(View);
+
+	View->StartFinalPostprocessSettings(ViewLocation);
+	View->OverridePostProcessSettings(CameraComponent->PostProcessSettings, CameraComponent->PostProcessBlendWeight);
+	View->EndFinalPostprocessSettings(ViewInitOptions);
+
+	GetRendererModule().BeginRenderingViewFamily(Canvas, &ViewFamily);
+}
@@ -0,0 +1,37 @@
+// Arduino Communication Plugin - Multi-Display Viewport Client
+// Renders a UMultiDisplayCameraComponent's view of the shared world into its own FSceneViewport
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealClient.h"
+#include "SceneTypes.h"
+
+class UMultiDisplayCameraComponent;
+
+/**
+ * Viewport client for the Direct Viewport present mode
+ *
+ * Builds a view family for the camera component every time the viewport is drawn and hands
+ * it to the renderer, which renders straight into the viewport (the window's back buffer).
+ * The view keeps its own view state, so temporal AA, eye adaptation and motion blur have
+ * history exactly like the main game view. Uses the component's FOV, ShowFlags,
+ * post-process settings and hidden actors/components.
+ */
+class FMultiDisplayViewportClient : public FViewportClient
+{
+public:
+	explicit FMultiDisplayViewportClient(UMultiDisplayCameraComponent* InCamera);
+
+	// === FViewportClient Interface ===
+	virtual void Draw(FViewport* InViewport, FCanvas* Canvas) override;
+	virtual UWorld* GetWorld() const override;
+	virtual bool RequiresHitProxyStorage() override { return false; }
+
+private:
+	/** Camera whose view is rendered */
+	TWeakObjectPtr<UMultiDisplayCameraComponent> Camera;
+
+	/** Per-view render state (temporal history, eye adaptation) */
+	FSceneViewStateReference ViewState;
+};
@@ -2,35 +2,45 @@
 
 #include "ShipHardwareInputComponent.h"
 #include "AndySerialSubsystem.h"
+#include "HardwareInputSampler.h"
 #include "EspPacketBP.h"
 #include "FiringComponent.h"
+#include "HoverMovementComponent.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 #include "GameFramework/Actor.h"
 
 UShipHardwareInputComponent::UShipHardwareInputComponent()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// Ticks only while bound to the subsystem (enabled in BindToSubsystem)
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
 	bWantsInitializeComponent = true;
 
 	// Default to requiring server authority
 	bServerOnly = true;
+
+	// Replicated so owning clients can forward their hardware through Server RPCs
+	SetIsReplicatedByDefault(true);
 }
 
 void UShipHardwareInputComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Forwarding follows the net role: a client without authority sends its hardware to the server
+	// (TickForwarding only sends while we own the ship), whether or not bServerOnly is set
+	AActor* Owner = GetOwner();
+	const bool bHasAuthority = !Owner || Owner->HasAuthority();
+	bIsForwarding = !bHasAuthority && bForwardToServer;
+
 	// Skip binding if server-only mode and we don't have authority
-	if (bServerOnly)
+	if (bServerOnly && !bHasAuthority && !bIsForwarding)
 	{
-		AActor* Owner = GetOwner();
-		if (Owner && !Owner->HasAuthority())
-		{
-			UE_LOG(LogTemp, Log, TEXT("ShipHardwareInputComponent: Skipping bind on client (no authority) for ShipId '%s'"),
-				*ShipId.ToString());
-			return;
-		}
+		UE_LOG(LogTemp, Log, TEXT("ShipHardwareInputComponent: Skipping bind on client (no authority) for ShipId '%s'"),
+			*ShipId.ToString());
+		return;
 	}
 
 	// Validate ShipId is set
@@ -51,6 +61,27 @@ void UShipHardwareInputComponent::EndPlay(const EEndPlayReason::Type EndPlayReas
 	Super::EndPlay(EndPlayReason);
 }
 
+void UShipHardwareInputComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bIsForwarding)
+	{
+		// The server is authoritative and applies the forwarded state; applying it here too would double it
+		TickForwarding();
+		return;
+	}
+
+	if (ShouldApplyPacketsDirectly())
+	{
+		ApplyPendingWheelDeltas(DeltaTime);
+	}
+	else
+	{
+		ConsumeTimelineSamples();
+	}
+}
+
 UAndySerialSubsystem* UShipHardwareInputComponent::GetSerialSubsystem() const
 {
 	if (CachedSubsystem)
@@ -121,6 +152,27 @@ void UShipHardwareInputComponent::BindToSubsystem()
 
 	bIsBound = true;
 
+	// Tick before the components we drive so they see this frame's wheel and sampled input
+	CachedSampler = bUseFixedRateSampling ? GameInstance->GetSubsystem<UHardwareInputSampler>() : nullptr;
+
+	if (!MovementComponent && GetOwner())
+	{
+		MovementComponent = GetOwner()->FindComponentByClass<UHoverMovementComponent>();
+	}
+	if (MovementComponent)
+	{
+		MovementComponent->AddTickPrerequisiteComponent(this);
+	}
+	if (FiringComponent)
+	{
+		FiringComponent->AddTickPrerequisiteComponent(this);
+	}
+
+	SampleCursor = 0.0;
+	bWheelCountsSeeded = false;
+	FMemory::Memzero(PendingWheelDeltas, sizeof(PendingWheelDeltas));
+	SetComponentTickEnabled(true);
+
 	UE_LOG(LogTemp, Log, TEXT("ShipHardwareInputComponent: Bound to subsystem for ShipId '%s'"),
 		*ShipId.ToString());
 }
@@ -137,6 +189,8 @@ void UShipHardwareInputComponent::UnbindFromSubsystem()
 
 	bIsBound = false;
 	CachedSubsystem = nullptr;
+	CachedSampler = nullptr;
+	SetComponentTickEnabled(false);
 
 	UE_LOG(LogTemp, Log, TEXT("ShipHardwareInputComponent: Unbound from subsystem for ShipId '%s'"),
 		*ShipId.ToString());
@@ -165,8 +219,15 @@ void UShipHardwareInputComponent::OnFrameParsedHandler(FName InShipId, uint8 Src
 				FVector EulerAngles = ImuData.EulerAngles;
 				OnWeaponImu.Broadcast(Src, Type, Seq, Orientation, EulerAngles, bTriggerHeld, Payload);
 
-				// Auto-apply IMU orientation to the FiringComponent
-				if (bAutoApplyImuRotation && FiringComponent)
+				if (bIsForwarding && ImuData.Side < FHardwareInputNetState::NumWeapons)
+				{
+					ForwardState.WeaponValidMask |= 1 << ImuData.Side;
+					ForwardState.WeaponOrientation[ImuData.Side] = FQuat4f(Orientation);
+					ForwardState.WeaponButtons[ImuData.Side] = ImuData.Buttons;
+				}
+
+				// Auto-apply IMU orientation to the FiringComponent (the sampled path applies it in TickComponent)
+				if (bAutoApplyImuRotation && FiringComponent && !bIsForwarding && ShouldApplyPacketsDirectly())
 				{
 					FiringComponent->ApplyImuOrientation(Orientation);
 				}
@@ -181,7 +242,23 @@ void UShipHardwareInputComponent::OnFrameParsedHandler(FName InShipId, uint8 Src
 			{
 				// Convert direction bool to delta: right/clockwise = +1, left/counter-clockwise = -1
 				int32 Delta = WheelData.bRight ? 1 : -1;
-				OnWheelTurn.Broadcast(Src, Type, Seq, WheelData.WheelIndex, Delta, Payload);
+
+				// Accumulate for the per-frame bindings (the sampled path reads counts from the timeline)
+				if (!bIsForwarding && ShouldApplyPacketsDirectly() && WheelData.WheelIndex < FShipInputSample::MaxWheels)
+				{
+					PendingWheelDeltas[WheelData.WheelIndex] += Delta;
+				}
+
+				if (bIsForwarding && WheelData.WheelIndex < FHardwareInputNetState::NumWheels)
+				{
+					ForwardState.WheelValidMask |= 1 << WheelData.WheelIndex;
+					ForwardState.WheelCounts[WheelData.WheelIndex] += Delta;
+				}
+
+				if (bBroadcastWheelDetents)
+				{
+					OnWheelTurn.Broadcast(Src, Type, Seq, WheelData.WheelIndex, Delta, Payload);
+				}
 			}
 		}
 		break;
@@ -209,13 +286,7 @@ void UShipHardwareInputComponent::OnFrameParsedHandler(FName InShipId, uint8 Src
 				{
 					WeaponTagInsertedState.Add(TagData.UID, TagData.bPresent);
 					// ReaderIndex: 0=Port Weapon, 1=Starboard Weapon (from TagData.Side)
-					EvtTagChanged.Broadcast(TagData.UID, TagData.bPresent, TagData.Side);
-
-					// Auto-apply weapon mag configuration when tag is inserted
-					if (bAutoApplyWeaponMag && TagData.bPresent)
-					{
-						ApplyWeaponMagByTagId(TagData.UID);
-					}
+					HandleTagTransition(TagData.UID, TagData.bPresent, TagData.Side);
 				}
 			}
 		}
@@ -234,13 +305,7 @@ void UShipHardwareInputComponent::OnFrameParsedHandler(FName InShipId, uint8 Src
 				{
 					ReloadTagInsertedState.Add(TagData.UID, TagData.bPresent);
 					// ReaderIndex: 2=Reload Box
-					EvtTagChanged.Broadcast(TagData.UID, TagData.bPresent, 2);
-
-					// Auto-apply weapon mag configuration when tag is inserted (reload box)
-					if (bAutoApplyWeaponMag && TagData.bPresent)
-					{
-						ApplyWeaponMagByTagId(TagData.UID);
-					}
+					HandleTagTransition(TagData.UID, TagData.bPresent, 2);
 				}
 			}
 		}
@@ -266,6 +331,371 @@ void UShipHardwareInputComponent::OnConnectionChangedHandler(FName InShipId, boo
 		*ShipId.ToString(), bConnected ? TEXT("Connected") : TEXT("Disconnected"));
 }
 
+void UShipHardwareInputComponent::HandleTagTransition(int64 TagId, bool bInserted, uint8 ReaderIndex)
+{
+	EvtTagChanged.Broadcast(TagId, bInserted, ReaderIndex);
+
+	// Auto-apply weapon mag configuration when tag is inserted (the server applies forwarded edges)
+	if (bAutoApplyWeaponMag && bInserted && !bIsForwarding)
+	{
+		ApplyWeaponMagByTagId(TagId);
+	}
+
+	if (bIsForwarding && GetOwnerRole() == ROLE_AutonomousProxy)
+	{
+		ServerReceiveTagEdge(TagId, bInserted, ReaderIndex);
+	}
+}
+
+// ============================================================================
+// NETWORK FORWARDING
+// ============================================================================
+
+void UShipHardwareInputComponent::TickForwarding()
+{
+	// Server RPCs only reach the server from the owning client
+	if (GetOwnerRole() != ROLE_AutonomousProxy)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World || (ForwardState.WeaponValidMask == 0 && ForwardState.WheelValidMask == 0))
+	{
+		return;
+	}
+
+	const double Now = World->GetTimeSeconds();
+	const double SinceLastSend = Now - LastForwardTime;
+	if (LastForwardTime >= 0.0 && SinceLastSend < 1.0 / FMath::Max(ForwardRate, 1.0f))
+	{
+		return;
+	}
+
+	// Latest-state: nothing to send unless the input changed or the keep-alive is due
+	const bool bChanged = LastForwardTime < 0.0 || !ForwardState.HasSameInput(LastSentState);
+	if (!bChanged && SinceLastSend < ForwardKeepAliveInterval)
+	{
+		return;
+	}
+
+	++ForwardState.Sequence;
+	ServerReceiveHardwareState(ForwardState);
+
+	LastSentState = ForwardState;
+	LastForwardTime = Now;
+}
+
+void UShipHardwareInputComponent::ServerReceiveHardwareState_Implementation(const FHardwareInputNetState& State)
+{
+	// Unreliable snapshots can arrive out of order; only the newest matters
+	if (bHasReceivedState && !FHardwareInputNetState::IsNewerSequence(State.Sequence, LastReceivedState.Sequence))
+	{
+		return;
+	}
+
+	ApplyForwardedState(State);
+}
+
+void UShipHardwareInputComponent::ServerReceiveTagEdge_Implementation(int64 TagId, bool bInserted, uint8 ReaderIndex)
+{
+	TMap<int64, bool>& InsertedState = ReaderIndex == 2 ? ReloadTagInsertedState : WeaponTagInsertedState;
+
+	bool* PreviousState = InsertedState.Find(TagId);
+	if (!PreviousState || *PreviousState != bInserted)
+	{
+		InsertedState.Add(TagId, bInserted);
+		HandleTagTransition(TagId, bInserted, ReaderIndex);
+	}
+}
+
+void UShipHardwareInputComponent::ApplyForwardedState(const FHardwareInputNetState& State)
+{
+	static const TArray<uint8> EmptyPayload;
+
+	const bool bFirstState = !bHasReceivedState;
+	const FHardwareInputNetState Previous = LastReceivedState;
+
+	LastReceivedState = State;
+	bHasReceivedState = true;
+
+	// The server may have no local port for this ship, so make sure the per-frame path runs
+	SetComponentTickEnabled(true);
+
+	const int32 Seq = State.Sequence;
+
+	for (int32 Side = 0; Side < FHardwareInputNetState::NumWeapons; ++Side)
+	{
+		if (!(State.WeaponValidMask & (1 << Side)))
+		{
+			continue;
+		}
+
+		const bool bSideChanged = bFirstState || !(Previous.WeaponValidMask & (1 << Side))
+			|| Previous.WeaponButtons[Side] != State.WeaponButtons[Side]
+			|| !Previous.WeaponOrientation[Side].Equals(State.WeaponOrientation[Side], 1.e-4f);
+		if (!bSideChanged)
+		{
+			continue;
+		}
+
+		const FQuat Orientation(State.WeaponOrientation[Side]);
+		const bool bTriggerHeld = (State.WeaponButtons[Side] & 0x01) != 0;
+		OnWeaponImu.Broadcast(Side, (uint8)EEspMsgType::WeaponImu, Seq, Orientation, Orientation.Euler(), bTriggerHeld, EmptyPayload);
+
+		if (bAutoApplyImuRotation && FiringComponent)
+		{
+			FiringComponent->ApplyImuOrientation(Orientation);
+		}
+		if (bAutoApplyTrigger && FiringComponent)
+		{
+			FiringComponent->SetFiring(bTriggerHeld);
+		}
+	}
+
+	for (int32 Wheel = 0; Wheel < FHardwareInputNetState::NumWheels; ++Wheel)
+	{
+		if (!(State.WheelValidMask & (1 << Wheel)))
+		{
+			continue;
+		}
+
+		// Client counts start at zero; if we missed the start of the stream, the first count is only a baseline
+		if (bFirstState && State.Sequence != 1)
+		{
+			continue;
+		}
+
+		const uint16 Baseline = (Previous.WheelValidMask & (1 << Wheel)) ? Previous.WheelCounts[Wheel] : 0;
+		const int32 Delta = (int16)(State.WheelCounts[Wheel] - Baseline);
+		if (Delta == 0)
+		{
+			continue;
+		}
+
+		PendingWheelDeltas[Wheel] += Delta;
+
+		if (bBroadcastWheelDetents)
+		{
+			const int32 Step = Delta > 0 ? 1 : -1;
+			for (int32 i = 0; i != Delta; i += Step)
+			{
+				OnWheelTurn.Broadcast(0, (uint8)EEspMsgType::WheelTurn, Seq, (uint8)Wheel, Step, EmptyPayload);
+			}
+		}
+	}
+}
+
+// ============================================================================
+// FIXED-RATE SAMPLING
+// ============================================================================
+
+bool UShipHardwareInputComponent::ShouldApplyPacketsDirectly() const
+{
+	// Forwarded state arrives without a local timeline, so it always takes the direct path
+	return !bUseFixedRateSampling || !bIsBound || !CachedSampler || bHasReceivedState;
+}
+
+void UShipHardwareInputComponent::ConsumeTimelineSamples()
+{
+	// Same clock the frames were stamped with, so recorded playback samples on game time
+	const double UpToTime = CachedSubsystem->GetInputTime() - SampleDelay;
+
+	// First frame (or the clock was switched back): only consume samples from this frame onwards
+	if (SampleCursor <= 0.0 || SampleCursor > UpToTime)
+	{
+		SampleCursor = UpToTime - GetWorld()->GetDeltaSeconds();
+	}
+
+	TArray<FShipInputSample> Samples;
+	if (CachedSampler->GetSamples(ShipId, SampleCursor, UpToTime, Samples) == 0)
+	{
+		return;
+	}
+	SampleCursor = Samples.Last().Time;
+
+	if (!bWheelCountsSeeded)
+	{
+		FMemory::Memcpy(LastWheelCounts, Samples[0].WheelCounts, sizeof(LastWheelCounts));
+		bWheelCountsSeeded = true;
+	}
+
+	const float SampleInterval = CachedSampler->GetSampleInterval();
+
+	// Wheels: step velocity estimates and axis bindings at every sample
+	const bool bDriveMovement = MovementComponent && WheelAxisBindings.Num() > 0;
+	int32 FrameStartCounts[FShipInputSample::MaxWheels];
+	FMemory::Memcpy(FrameStartCounts, LastWheelCounts, sizeof(FrameStartCounts));
+
+	TArray<FHoverInputSample> MovementSamples;
+	MovementSamples.Reserve(Samples.Num());
+
+	for (const FShipInputSample& Sample : Samples)
+	{
+		int32 Deltas[FShipInputSample::MaxWheels];
+		for (int32 Wheel = 0; Wheel < FShipInputSample::MaxWheels; ++Wheel)
+		{
+			Deltas[Wheel] = Sample.WheelCounts[Wheel] - LastWheelCounts[Wheel];
+			LastWheelCounts[Wheel] = Sample.WheelCounts[Wheel];
+		}
+
+		StepWheels(Deltas, SampleInterval, MovementSamples.AddDefaulted_GetRef());
+	}
+
+	if (bDriveMovement)
+	{
+		MovementComponent->QueueInputSamples(MovementSamples, SampleInterval);
+	}
+
+	int32 FrameDeltas[FShipInputSample::MaxWheels];
+	for (int32 Wheel = 0; Wheel < FShipInputSample::MaxWheels; ++Wheel)
+	{
+		FrameDeltas[Wheel] = LastWheelCounts[Wheel] - FrameStartCounts[Wheel];
+	}
+	BroadcastWheelFrameDeltas(FrameDeltas);
+
+	// Weapon: step aim (and optionally the trigger) through every sample
+	if (FiringComponent && bAutoApplyImuRotation)
+	{
+		TArray<FFiringAimSample> AimSamples;
+		AimSamples.Reserve(Samples.Num());
+
+		for (const FShipInputSample& Sample : Samples)
+		{
+			if (Sample.bHasImu)
+			{
+				FFiringAimSample& Out = AimSamples.AddDefaulted_GetRef();
+				Out.Orientation = Sample.GetLatestOrientation();
+				Out.bTriggerHeld = Sample.IsLatestTriggerHeld();
+			}
+		}
+
+		if (AimSamples.Num() > 0)
+		{
+			FiringComponent->QueueAimSamples(AimSamples, SampleInterval, bAutoApplyTrigger);
+		}
+	}
+}
+
+// ============================================================================
+// WHEEL BINDINGS
+// ============================================================================
+
+void UShipHardwareInputComponent::RecenterWheels()
+{
+	for (float& Position : WheelAxisPositions)
+	{
+		Position = 0.0f;
+	}
+}
+
+float UShipHardwareInputComponent::GetWheelVelocity(int32 WheelIndex) const
+{
+	return (WheelIndex >= 0 && WheelIndex < FShipInputSample::MaxWheels) ? WheelVelocities[WheelIndex] : 0.0f;
+}
+
+void UShipHardwareInputComponent::StepWheels(const int32* Deltas, float DeltaTime, FHoverInputSample& OutInput)
+{
+	DeltaTime = FMath::Max(DeltaTime, KINDA_SMALL_NUMBER);
+
+	// Exponential smoothing of the instantaneous rate; the blend depends on the step length so the
+	// estimate converges the same way whether it is stepped per frame or per sample
+	const float Alpha = WheelVelocitySmoothingTime > KINDA_SMALL_NUMBER
+		? 1.0f - FMath::Exp(-DeltaTime / WheelVelocitySmoothingTime)
+		: 1.0f;
+
+	for (int32 Wheel = 0; Wheel < FShipInputSample::MaxWheels; ++Wheel)
+	{
+		WheelVelocities[Wheel] = FMath::Lerp(WheelVelocities[Wheel], (float)Deltas[Wheel] / DeltaTime, Alpha);
+	}
+
+	WheelAxisPositions.SetNumZeroed(WheelAxisBindings.Num());
+
+	// Unbound axes are left to other input devices
+	OutInput.bHasThrottle = false;
+	OutInput.bHasSteering = false;
+	OutInput.bHasStrafe = false;
+
+	for (int32 i = 0; i < WheelAxisBindings.Num(); ++i)
+	{
+		const FWheelAxisBinding& Binding = WheelAxisBindings[i];
+		if (Binding.WheelIndex < 0 || Binding.WheelIndex >= FShipInputSample::MaxWheels)
+		{
+			continue;
+		}
+
+		const float Sign = Binding.bInvert ? -1.0f : 1.0f;
+		float& Value = WheelAxisPositions[i];
+
+		if (Binding.Mode == EWheelBindingMode::Velocity)
+		{
+			Value = FMath::Clamp(Sign * WheelVelocities[Binding.WheelIndex] / FMath::Max(Binding.DetentsPerSecondToFullScale, 1.0f), -1.0f, 1.0f);
+		}
+		else
+		{
+			const float Step = (float)Deltas[Binding.WheelIndex] / FMath::Max(Binding.DetentsToFullScale, 1.0f);
+			Value = FMath::Clamp(Value + Sign * Step, -1.0f, 1.0f);
+		}
+
+		switch (Binding.Axis)
+		{
+		case EHardwareWheelAxis::Throttle:	OutInput.Throttle += Value; OutInput.bHasThrottle = true; break;
+		case EHardwareWheelAxis::Steering:	OutInput.Steering += Value; OutInput.bHasSteering = true; break;
+		case EHardwareWheelAxis::Strafe:	OutInput.Strafe += Value; OutInput.bHasStrafe = true; break;
+		}
+	}
+
+	OutInput.Throttle = FMath::Clamp(OutInput.Throttle, -1.0f, 1.0f);
+	OutInput.Steering = FMath::Clamp(OutInput.Steering, -1.0f, 1.0f);
+	OutInput.Strafe = FMath::Clamp(OutInput.Strafe, -1.0f, 1.0f);
+}
+
+void UShipHardwareInputComponent::ApplyPendingWheelDeltas(float DeltaTime)
+{
+	int32 Deltas[FShipInputSample::MaxWheels];
+	FMemory::Memcpy(Deltas, PendingWheelDeltas, sizeof(Deltas));
+	FMemory::Memzero(PendingWheelDeltas, sizeof(PendingWheelDeltas));
+
+	FHoverInputSample Input;
+	StepWheels(Deltas, DeltaTime, Input);
+	BroadcastWheelFrameDeltas(Deltas);
+
+	if (!MovementComponent || WheelAxisBindings.Num() == 0)
+	{
+		return;
+	}
+
+	// Only write the axes that are bound so keyboard/gamepad input on the others is left alone
+	if (Input.bHasThrottle)
+	{
+		MovementComponent->SetThrottleInput(Input.Throttle);
+	}
+	if (Input.bHasSteering)
+	{
+		MovementComponent->SetSteeringInput(Input.Steering);
+	}
+	if (Input.bHasStrafe)
+	{
+		MovementComponent->SetStrafeInput(Input.Strafe);
+	}
+}
+
+void UShipHardwareInputComponent::BroadcastWheelFrameDeltas(const int32* Deltas)
+{
+	if (!OnWheelFrameDelta.IsBound())
+	{
+		return;
+	}
+
+	for (int32 Wheel = 0; Wheel < FShipInputSample::MaxWheels; ++Wheel)
+	{
+		if (Deltas[Wheel] != 0)
+		{
+			OnWheelFrameDelta.Broadcast((uint8)Wheel, Deltas[Wheel], WheelVelocities[Wheel]);
+		}
+	}
+}
+
 // ============================================================================
 // WEAPON MAG FUNCTIONS
 // ============================================================================
@@ -31,6 +31,14 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(
 	const TArray<uint8>&, Payload
 );
 
+/**
+ * Native delegate fired alongside OnFrameParsed with the time the frame's bytes were read
+ * @param ShipId - Identifier for the ship/port that received this frame
+ * @param Packet - The decoded packet
+ * @param ReceiveTime - FPlatformTime::Seconds() when the bytes were read from the port
+ */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnAndyFrameParsedTimed, FName /*ShipId*/, const FBenchPacket& /*Packet*/, double /*ReceiveTime*/);
+
 /**
  * Delegate fired when connection status changes for any port
  * @param ShipId - Identifier for the ship/port
@@ -65,8 +73,7 @@ public:
 	FName GetShipId() const { return ShipId; }
 
 protected:
-	UFUNCTION()
-	void OnBytesReceived(const TArray<uint8>& Bytes);
+	void OnBytesReceived(const TArray<uint8>& Bytes, double ReceiveTime);
 
 	UFUNCTION()
 	void OnConnectionChanged(bool bConnected);
@@ -219,6 +226,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Andy|Serial")
 	bool SendLine(FName ShipId, const FString& Line);
 
+	/**
+	 * Inject a decoded packet as if it had been parsed from a ship's port
+	 * Used for recorded playback; fires OnFrameParsedTimed and OnFrameParsed like a live frame.
+	 * @param ShipId - Ship the packet belongs to (does not need a registered port)
+	 * @param Packet - The decoded packet
+	 * @param ReceiveTime - Receive stamp on the input clock (0 = now)
+	 */
+	void InjectPacket(FName ShipId, const FBenchPacket& Packet, double ReceiveTime = 0.0);
+
+	// === Input Clock ===
+
+	/**
+	 * Current time on the clock input is stamped and sampled against
+	 * FPlatformTime::Seconds() unless a clock has been set with SetInputClock.
+	 * @return Seconds on the input clock
+	 */
+	double GetInputTime() const;
+
+	/**
+	 * Replace the input clock, e.g. with game time during recorded playback
+	 * Frames from live ports keep their own FPlatformTime::Seconds() stamps.
+	 * @param InClock - Returns the current input time; unset restores FPlatformTime::Seconds()
+	 */
+	void SetInputClock(TFunction<double()> InClock);
+
 	// === Events ===
 
 	/** Event fired when a frame is successfully parsed from any port */
@@ -229,13 +261,17 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Andy|Serial|Events")
 	FOnAndyConnectionChanged OnConnectionChanged;
 
+	/** Native event fired for every parsed frame with its receive timestamp (game thread) */
+	FOnAndyFrameParsedTimed OnFrameParsedTimed;
+
 	// === Internal Event Handlers (called by UAndyPortEventHandler) ===
 
 	/**
 	 * Internal handler for raw bytes received from a port
 	 * Routes bytes to the appropriate parser
+	 * @param ReceiveTime - FPlatformTime::Seconds() when the bytes were read (0 = now)
 	 */
-	void HandleBytesReceived(FName ShipId, const TArray<uint8>& Bytes);
+	void HandleBytesReceived(FName ShipId, const TArray<uint8>& Bytes, double ReceiveTime = 0.0);
 
 	/**
 	 * Internal handler for connection status changes
@@ -252,9 +288,12 @@ protected:
 	 * Internal handler for parsed packets
 	 * Broadcasts to OnFrameParsed delegate
 	 */
-	void HandlePacketDecoded(FName ShipId, const FBenchPacket& Packet);
+	void HandlePacketDecoded(FName ShipId, const FBenchPacket& Packet, double ReceiveTime);
 
 private:
 	/** Creates and configures a parser instance for a connection */
 	UByteStreamPacketParser* CreateParserForConnection(FName ShipId);
+
+	/** Input clock override (unset = FPlatformTime::Seconds) */
+	TFunction<double()> InputClock;
 };
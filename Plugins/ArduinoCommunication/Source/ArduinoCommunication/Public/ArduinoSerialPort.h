@@ -13,6 +13,16 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSerialLineReceived, const FString
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSerialConnectionChanged, bool, bConnected);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSerialError, const FString&, ErrorMessage);
 
+/** Native delegate for raw bytes along with the FPlatformTime::Seconds() at which they were read */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSerialBytesReceivedTimed, const TArray<uint8>& /*Bytes*/, double /*ReceiveTime*/);
+
+/** Raw bytes read from the port, stamped on the thread that read them */
+struct FTimedSerialBytes
+{
+	TArray<uint8> Bytes;
+	double ReceiveTime = 0.0;
+};
+
 /**
  * Serial Port Communication for Arduino ESP8266
  * Handles bidirectional text communication over COM ports
@@ -62,6 +72,9 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Arduino|Serial|Events")
 	FOnSerialByteReceived OnByteReceived;
 
+	/** Native event fired alongside OnByteReceived with the time the bytes were read from the port */
+	FOnSerialBytesReceivedTimed OnBytesReceivedTimed;
+
 	/** Event fired when a complete line is received from Arduino (parsed by LineEnding) */
 	UPROPERTY(BlueprintAssignable, Category = "Arduino|Serial|Events")
 	FOnSerialLineReceived OnLineReceived;
@@ -186,7 +199,7 @@ private:
 	TQueue<FString> ReceivedDataQueue;
 
 	/** Thread-safe queue for received raw bytes */
-	TQueue<TArray<uint8>> ReceivedBytesQueue;
+	TQueue<FTimedSerialBytes> ReceivedBytesQueue;
 
 	/** Critical section for thread safety */
 	FCriticalSection DataCriticalSection;
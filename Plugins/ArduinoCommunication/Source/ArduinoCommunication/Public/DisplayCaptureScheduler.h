@@ -0,0 +1,121 @@
+// Arduino Communication Plugin - Display Capture Scheduler
+// WorldSubsystem that decides which secondary display captures its scene each frame
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DisplayCaptureScheduler.generated.h"
+
+class UMultiDisplayCameraComponent;
+
+/**
+ * Display Capture Scheduler
+ *
+ * Owns the captures of every UMultiDisplayCameraComponent in the world. Instead of each
+ * display rendering a full scene capture every frame, every display asks for a target rate
+ * (TargetCaptureRate) and a priority (CapturePriority), and the scheduler captures the due
+ * ones, at most MaxCapturesPerFrame of them per frame once a budget is set (uncapped by default):
+ *   - A display is due once its capture interval has elapsed
+ *   - Due displays are ranked by priority, then by how late they are
+ *   - A display that has not been captured for MaxCaptureAge is ranked first, so
+ *     low-priority displays keep refreshing when the budget is tight
+ *
+ * Displays on the same rate fall out of phase after the first frames, so the capture cost
+ * is spread evenly across frames instead of spiking when they line up.
+ *
+ * Example cabinet (MultiDisplay.Budget 2): pilot view 60 Hz priority 10, radar 30 Hz, map
+ * screen 10 Hz renders about 1.7 captures per frame instead of 3.
+ *
+ * Console: MultiDisplay.Budget <N>, MultiDisplay.Stats
+ */
+UCLASS()
+class ARDUINOCOMMUNICATION_API UDisplayCaptureScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// === USubsystem / FTickableGameObject Interface ===
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Maximum scene captures per frame across all displays (0 = unlimited) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MultiDisplay|Scheduling", meta = (ClampMin = "0", ClampMax = "8"))
+	int32 MaxCapturesPerFrame = 0;
+
+	/** A display not captured for this long is captured ahead of higher priorities (in seconds, 0 = never) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MultiDisplay|Scheduling", meta = (ClampMin = "0.0"))
+	float MaxCaptureAge = 0.5f;
+
+	// ============================================================================
+	// DISPLAYS
+	// ============================================================================
+
+	/**
+	 * Hand a display's captures over to the scheduler
+	 * @param Display - Display to schedule
+	 */
+	void RegisterDisplay(UMultiDisplayCameraComponent* Display);
+
+	/**
+	 * Stop scheduling a display
+	 * @param Display - Display to remove
+	 */
+	void UnregisterDisplay(UMultiDisplayCameraComponent* Display);
+
+	/**
+	 * Get the number of scheduled displays
+	 * @return Registered display count
+	 */
+	UFUNCTION(BlueprintPure, Category = "MultiDisplay|Scheduling")
+	int32 GetNumDisplays() const { return Displays.Num(); }
+
+	/**
+	 * Get the average number of captures per frame since the stats were last reset
+	 * @return Captures per frame
+	 */
+	UFUNCTION(BlueprintPure, Category = "MultiDisplay|Scheduling")
+	float GetAverageCapturesPerFrame() const;
+
+	/** Log the achieved capture rate of every display and reset the counters */
+	void LogStats();
+
+private:
+	/** Scheduling state of one display */
+	struct FScheduledDisplay
+	{
+		TWeakObjectPtr<UMultiDisplayCameraComponent> Component;
+
+		/** Real time of the last capture (negative = never captured) */
+		double LastCaptureTime = -1.0;
+
+		/** Captures since the stats were last reset */
+		int32 CaptureCount = 0;
+	};
+
+	/** A display that is due this frame */
+	struct FCaptureCandidate
+	{
+		int32 DisplayIndex = INDEX_NONE;
+		int32 Priority = 0;
+		bool bStale = false;
+
+		/** Elapsed time over capture interval (>= 1 when due) */
+		double Lateness = 0.0;
+	};
+
+	TArray<FScheduledDisplay> Displays;
+
+	/** Scratch list of due displays */
+	TArray<FCaptureCandidate> Candidates;
+
+	/** Stats counters */
+	double StatsStartTime = 0.0;
+	int32 StatsFrames = 0;
+	int32 StatsCaptures = 0;
+
+	/** Current real time of the world */
+	double GetNow() const;
+};
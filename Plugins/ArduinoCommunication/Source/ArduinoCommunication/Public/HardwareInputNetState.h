@@ -0,0 +1,78 @@
+// Arduino Communication Plugin - Hardware Input Net State
+// Bit-packed snapshot of a ship's decoded hardware state, forwarded from client cabinets to the server
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HardwareInputNetState.generated.h"
+
+// ============================================================================
+// Hardware Input Net State Struct
+// ============================================================================
+
+/**
+ * Latest decoded hardware state of one ship, as sent by UShipHardwareInputComponent
+ * when the serial ports are attached to a client rather than the server.
+ *
+ * Serialized with a custom NetSerialize:
+ * - Sequence: 16 bits (older snapshots are dropped on receipt)
+ * - Per weapon side: 1 valid bit, smallest-three quaternion (2 + 3 x 11 bits), 8 button bits
+ * - Per wheel: 1 valid bit, 16-bit wrapping cumulative detent count
+ *
+ * Wheel counts are cumulative rather than per-send deltas so a dropped snapshot loses
+ * nothing: the receiver diffs against the last count it saw. A full snapshot is about
+ * 22 bytes, roughly 2.5 KB/s with RPC overhead at the default 60 Hz forward rate.
+ */
+USTRUCT()
+struct ARDUINOCOMMUNICATION_API FHardwareInputNetState
+{
+	GENERATED_BODY()
+
+	/** Number of weapon IMUs per ship (0 = Port, 1 = Starboard) */
+	static constexpr int32 NumWeapons = 2;
+
+	/** Number of encoder wheels per ship */
+	static constexpr int32 NumWheels = 4;
+
+	/** Bits per quantized quaternion component */
+	static constexpr int32 QuatComponentBits = 11;
+
+	/** Snapshot sequence number (wraps) */
+	uint16 Sequence = 0;
+
+	/** Bit per weapon side that has reported IMU data */
+	uint8 WeaponValidMask = 0;
+
+	/** Bit per wheel that has turned at least once */
+	uint8 WheelValidMask = 0;
+
+	/** Latest orientation per weapon side */
+	FQuat4f WeaponOrientation[NumWeapons] = { FQuat4f::Identity, FQuat4f::Identity };
+
+	/** Latest button bitfield per weapon side (bit0 = trigger) */
+	uint8 WeaponButtons[NumWeapons] = {};
+
+	/** Cumulative detent count per wheel (wraps at 16 bits) */
+	uint16 WheelCounts[NumWheels] = {};
+
+	/** Custom bit-packed serialization */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	/** Check whether two states would serialize the same (ignoring Sequence) */
+	bool HasSameInput(const FHardwareInputNetState& Other) const;
+
+	/** Check whether sequence A is newer than B, allowing for wraparound */
+	static bool IsNewerSequence(uint16 A, uint16 B)
+	{
+		return A != B && (uint16)(A - B) < 0x8000;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FHardwareInputNetState> : public TStructOpsTypeTraitsBase2<FHardwareInputNetState>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
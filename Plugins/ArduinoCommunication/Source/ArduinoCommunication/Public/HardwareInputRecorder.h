@@ -0,0 +1,273 @@
+// Arduino Communication Plugin - Hardware Input Recorder
+// WorldSubsystem that records the decoded hardware input stream and plays it back for repeatable perf runs
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ByteStreamPacketParser.h"
+#include "HardwareInputRecorder.generated.h"
+
+class UAndySerialSubsystem;
+
+/**
+ * Frame-time statistics gathered over one playback
+ */
+USTRUCT(BlueprintType)
+struct ARDUINOCOMMUNICATION_API FHardwarePlaybackStats
+{
+	GENERATED_BODY()
+
+	/** Recording that was played */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	FString RecordingName;
+
+	/** Map the playback ran on */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	FString MapName;
+
+	/** Number of ships in the recording */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	int32 NumShips = 0;
+
+	/** Number of frames measured */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	int32 NumFrames = 0;
+
+	/** Wall-clock duration of the playback (in seconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float Duration = 0.0f;
+
+	/** Average frame time (ms) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float AvgFrameMs = 0.0f;
+
+	/** Median frame time (ms) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float P50FrameMs = 0.0f;
+
+	/** 95th percentile frame time (ms) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float P95FrameMs = 0.0f;
+
+	/** 99th percentile frame time (ms) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float P99FrameMs = 0.0f;
+
+	/** Worst frame time (ms) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float MaxFrameMs = 0.0f;
+
+	/** Average game thread time (ms) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float AvgGameThreadMs = 0.0f;
+
+	/** 95th percentile game thread time (ms) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float P95GameThreadMs = 0.0f;
+
+	/** Worst game thread time (ms) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float MaxGameThreadMs = 0.0f;
+
+	/** Average render thread time (ms, 0 with -nullrhi) */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	float AvgRenderThreadMs = 0.0f;
+
+	/** Frames longer than the hitch threshold */
+	UPROPERTY(BlueprintReadOnly, Category = "Andy|Recording")
+	int32 HitchCount = 0;
+};
+
+/**
+ * Event fired when a playback finishes
+ * @param Stats - Frame-time statistics for the run
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+	FOnHardwarePlaybackFinished,
+	const FHardwarePlaybackStats&, Stats
+);
+
+/**
+ * Hardware Input Recorder
+ *
+ * Records every decoded frame from UAndySerialSubsystem (per ShipId, with its receive time)
+ * together with the map name and the start transform of every UShipHardwareInputComponent
+ * owner. Playback restores the start transforms and re-injects the frames through
+ * UAndySerialSubsystem::InjectPacket, so UShipHardwareInputComponent, UHardwareInputSampler
+ * and everything they drive run exactly as with live hardware - no devices needed.
+ *
+ * During playback the serial subsystem's input clock runs on game time, and frames are
+ * released and stamped on that clock, so with a fixed time step the same frames reach the
+ * same game frames and the same sampler steps on every run, however fast the machine is. Frame, game thread and render thread times are gathered
+ * during playback and written to Saved/Profiling/HardwareInputPlayback as JSON at the end.
+ *
+ * Nightly perf run (headless, no devices):
+ *   UnrealEditor-Cmd Unduinocpp.uproject HoverTrack -game -nullrhi -unattended -benchmark -fps=60
+ *     -HardwareInputPlayback=HoverTrack_8P
+ * The process exits when the playback finishes.
+ *
+ * Console: Andy.Record.Start, Andy.Record.Stop <Name>, Andy.Playback <Name>
+ */
+UCLASS()
+class ARDUINOCOMMUNICATION_API UHardwareInputRecorder : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// === USubsystem / FTickableGameObject Interface ===
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Frames longer than this count as hitches (in milliseconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Andy|Recording")
+	float HitchThresholdMs = 33.3f;
+
+	/** Time to keep measuring after the last recorded frame (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Andy|Recording")
+	float PlaybackTailTime = 1.0f;
+
+	// ============================================================================
+	// RECORDING
+	// ============================================================================
+
+	/**
+	 * Start recording the decoded input of every ship, capturing the current start state
+	 * @return True if recording started
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Andy|Recording")
+	bool StartRecording();
+
+	/**
+	 * Stop recording and save to disk
+	 * @param Name - Recording name or path (relative names go to Saved/HardwareRecordings)
+	 * @return True if the recording was saved
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Andy|Recording")
+	bool StopRecording(const FString& Name);
+
+	/**
+	 * Check if a recording is in progress
+	 * @return True while recording
+	 */
+	UFUNCTION(BlueprintPure, Category = "Andy|Recording")
+	bool IsRecording() const { return bRecording; }
+
+	// ============================================================================
+	// PLAYBACK
+	// ============================================================================
+
+	/**
+	 * Load a recording and start playing it back on the current map
+	 * @param Name - Recording name or path
+	 * @param bQuitWhenFinished - Request engine exit after the stats are written
+	 * @return True if playback started
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Andy|Recording")
+	bool StartPlayback(const FString& Name, bool bQuitWhenFinished = false);
+
+	/**
+	 * Stop playback early (stats are still reported)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Andy|Recording")
+	void StopPlayback();
+
+	/**
+	 * Check if a playback is in progress
+	 * @return True while playing back
+	 */
+	UFUNCTION(BlueprintPure, Category = "Andy|Recording")
+	bool IsPlayingBack() const { return bPlayingBack; }
+
+	/** Event fired when a playback finishes, with its statistics */
+	UPROPERTY(BlueprintAssignable, Category = "Andy|Recording")
+	FOnHardwarePlaybackFinished OnPlaybackFinished;
+
+private:
+	/** One recorded frame */
+	struct FRecordedFrame
+	{
+		/** Seconds since recording started */
+		double Time = 0.0;
+
+		/** Index into Ships */
+		int32 ShipIndex = 0;
+
+		FBenchPacket Packet;
+	};
+
+	/** A ship's identity and start state */
+	struct FRecordedShip
+	{
+		FName ShipId;
+		FTransform StartTransform;
+	};
+
+	/** Map the recording belongs to */
+	FString MapName;
+
+	/** Ships in the recording */
+	TArray<FRecordedShip> Ships;
+
+	/** Recorded frames in time order */
+	TArray<FRecordedFrame> Frames;
+
+	/** Serial subsystem frames are recorded from and injected into */
+	UPROPERTY()
+	TObjectPtr<UAndySerialSubsystem> SerialSubsystem;
+
+	/** Handle for the OnFrameParsedTimed binding while recording */
+	FDelegateHandle FrameParsedHandle;
+
+	bool bRecording = false;
+	bool bPlayingBack = false;
+	bool bQuitAfterPlayback = false;
+
+	/** Input clock time when recording started */
+	double RecordStartTime = 0.0;
+
+	/** Game time elapsed since playback started */
+	double PlaybackElapsed = 0.0;
+
+	/** Next frame to inject */
+	int32 PlaybackCursor = 0;
+
+	/** Input clock time playback started at; the playback clock is this plus PlaybackElapsed */
+	double PlaybackBaseTime = 0.0;
+
+	/** Name of the recording being played */
+	FString PlaybackName;
+
+	/** FPlatformTime::Seconds() at playback start and at the previous tick */
+	double PlaybackStartWallTime = 0.0;
+	double LastTickWallTime = 0.0;
+
+	/** Per-frame measurements (ms) */
+	TArray<float> FrameTimesMs;
+	TArray<float> GameThreadTimesMs;
+	TArray<float> RenderThreadTimesMs;
+
+	/** Record one frame from the serial subsystem */
+	void HandleFrameParsed(FName ShipId, const FBenchPacket& Packet, double ReceiveTime);
+
+	/** Find or add a ship to the recording */
+	int32 FindOrAddShip(FName ShipId);
+
+	/** Move every ship in the recording back to its start transform */
+	void RestoreStartState();
+
+	/** Compute, log and save stats, then notify listeners */
+	void FinishPlayback();
+
+	/** Resolve a recording name to a file path */
+	static FString GetRecordingPath(const FString& Name);
+
+	/** Write or read the recording file contents */
+	void SerializeRecording(FArchive& Ar);
+
+	/** Get the serial subsystem from the game instance */
+	UAndySerialSubsystem* GetSerialSubsystem();
+};
@@ -0,0 +1,172 @@
+// Arduino Communication Plugin - Hardware Input Sampler
+// GameInstanceSubsystem that resamples decoded hardware input onto a fixed-rate timeline per ship
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "HardwareInputSampler.generated.h"
+
+class UAndySerialSubsystem;
+struct FBenchPacket;
+
+/**
+ * Decoded hardware state of one ship at one point on the fixed-rate timeline
+ */
+struct ARDUINOCOMMUNICATION_API FShipInputSample
+{
+	/** Number of encoder wheels tracked per ship */
+	static constexpr int32 MaxWheels = 4;
+
+	/** Number of weapon IMUs per ship (0 = Port, 1 = Starboard) */
+	static constexpr int32 MaxWeapons = 2;
+
+	/** Sample time (UAndySerialSubsystem input clock) */
+	double Time = 0.0;
+
+	/** Cumulative encoder detent count per wheel since the timeline was created */
+	int32 WheelCounts[MaxWheels] = {};
+
+	/** Latest weapon orientation per side */
+	FQuat4f WeaponOrientation[MaxWeapons] = { FQuat4f::Identity, FQuat4f::Identity };
+
+	/** Latest weapon button bitfield per side (bit0 = trigger) */
+	uint8 WeaponButtons[MaxWeapons] = {};
+
+	/** Side of the most recent IMU packet */
+	uint8 LastImuSide = 0;
+
+	/** Whether any IMU packet has been received yet */
+	bool bHasImu = false;
+
+	/** Orientation of the most recently updated weapon */
+	FQuat GetLatestOrientation() const { return FQuat(WeaponOrientation[LastImuSide]); }
+
+	/** Trigger state of the most recently updated weapon */
+	bool IsLatestTriggerHeld() const { return (WeaponButtons[LastImuSide] & 0x01) != 0; }
+};
+
+/**
+ * Hardware Input Sampler
+ *
+ * Listens to UAndySerialSubsystem's timestamped frames and resamples wheel and IMU state
+ * onto a fixed-rate grid (240 Hz by default) per ShipId. Consumers such as
+ * UShipHardwareInputComponent read the samples that fall inside each game frame and step
+ * their simulation through them, so handling is the same at 30 or 144 FPS.
+ *
+ * Samples are generated lazily when read, and the last SampleHistorySize samples are kept
+ * per ship so several consumers can read the same range independently.
+ * Tag events are edges rather than state and are not part of the timeline.
+ */
+UCLASS()
+class ARDUINOCOMMUNICATION_API UHardwareInputSampler : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Number of generated samples kept per ship (~2 seconds at 240 Hz) */
+	static constexpr int32 SampleHistorySize = 512;
+
+	// === USubsystem Interface ===
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Set the timeline sample rate
+	 * @param NewSampleRate - Samples per second (clamped to 30-1000)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Andy|Sampler")
+	void SetSampleRate(float NewSampleRate);
+
+	/**
+	 * Get the timeline sample rate
+	 * @return Samples per second
+	 */
+	UFUNCTION(BlueprintPure, Category = "Andy|Sampler")
+	float GetSampleRate() const { return SampleRate; }
+
+	/**
+	 * Get the time between samples
+	 * @return Seconds per sample
+	 */
+	UFUNCTION(BlueprintPure, Category = "Andy|Sampler")
+	float GetSampleInterval() const { return 1.0f / SampleRate; }
+
+	/**
+	 * Collect all samples for a ship with AfterTime < Time <= UpToTime
+	 * Generates any missing samples up to UpToTime first.
+	 * @param ShipId - Ship to read
+	 * @param AfterTime - Exclusive start of the range (UAndySerialSubsystem::GetInputTime clock)
+	 * @param UpToTime - Inclusive end of the range
+	 * @param OutSamples - Receives the samples in time order
+	 * @return Number of samples written
+	 */
+	int32 GetSamples(FName ShipId, double AfterTime, double UpToTime, TArray<FShipInputSample>& OutSamples);
+
+	/**
+	 * Get the most recently generated sample for a ship
+	 * @param ShipId - Ship to read
+	 * @param OutSample - Receives the sample
+	 * @return True if the ship has produced any samples
+	 */
+	bool GetLatestSample(FName ShipId, FShipInputSample& OutSample) const;
+
+	/**
+	 * Feed a decoded frame into a ship's timeline
+	 * Called automatically for frames from UAndySerialSubsystem; exposed for replayed or forwarded input.
+	 * @param ShipId - Ship the frame belongs to
+	 * @param Packet - The decoded packet
+	 * @param ReceiveTime - When the frame was received (UAndySerialSubsystem::GetInputTime clock)
+	 */
+	void IngestFrame(FName ShipId, const FBenchPacket& Packet, double ReceiveTime);
+
+private:
+	/** A state change waiting to be folded into the timeline */
+	struct FPendingInputEvent
+	{
+		double Time = 0.0;
+		uint8 Type = 0;
+		uint8 Index = 0;
+		int32 WheelDelta = 0;
+		FQuat4f Orientation = FQuat4f::Identity;
+		uint8 Buttons = 0;
+	};
+
+	/** Per-ship timeline state */
+	struct FShipTimeline
+	{
+		/** State after all applied events */
+		FShipInputSample State;
+
+		/** Events not yet folded into a sample (sorted by time) */
+		TArray<FPendingInputEvent> PendingEvents;
+
+		/** Ring buffer of generated samples */
+		TArray<FShipInputSample> History;
+
+		/** Index of the oldest sample in History once it has wrapped */
+		int32 HistoryHead = 0;
+
+		/** Time of the next sample to generate (0 = not started) */
+		double NextSampleTime = 0.0;
+	};
+
+	/** Timeline per ship */
+	TMap<FName, FShipTimeline> Timelines;
+
+	/** Samples per second */
+	float SampleRate = 240.0f;
+
+	/** Serial subsystem we are bound to */
+	UPROPERTY()
+	TObjectPtr<UAndySerialSubsystem> SerialSubsystem;
+
+	/** Handle for the OnFrameParsedTimed binding */
+	FDelegateHandle FrameParsedHandle;
+
+	/** Generate samples on the fixed grid up to UpToTime */
+	void AdvanceTimeline(FShipTimeline& Timeline, double UpToTime);
+
+	/** Apply one event to a timeline state */
+	static void ApplyEvent(FShipInputSample& State, const FPendingInputEvent& Event);
+};
@@ -14,6 +14,10 @@
 // - "Display 0" = primary monitor, "Display 1" = second monitor, etc.
 // - The component auto-activates on BeginPlay.
 // - For best results, run as "Standalone Game" rather than PIE.
+// - Captures are scheduled by UDisplayCaptureScheduler: set "Target Capture Rate" and
+//   "Capture Priority" per display (e.g. pilot view 60 Hz, map screen 10 Hz).
+// - "Present Mode" = Direct Viewport renders the view straight into the window's back buffer
+//   instead of capturing to a render target (full post-processing, no copy, less latency).
 
 #pragma once
 
@@ -25,6 +29,22 @@
 
 class SWindow;
 class SImage;
+class SViewport;
+class FSceneViewport;
+class FMultiDisplayViewportClient;
+
+/**
+ * How a display's view reaches its window
+ */
+UENUM(BlueprintType)
+enum class EMultiDisplayPresentMode : uint8
+{
+	/** Scene capture into a render target, drawn by an SImage (scheduled by UDisplayCaptureScheduler) */
+	SceneCapture	UMETA(DisplayName = "Scene Capture"),
+
+	/** Own SViewport + FSceneViewport rendering the shared world directly to the window's back buffer, every frame */
+	DirectViewport	UMETA(DisplayName = "Direct Viewport")
+};
 
 /**
  * Multi-Display Camera Component
@@ -72,6 +92,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MultiDisplay|Settings", meta = (ClampMin = "1", ClampMax = "60"))
 	int32 WindowOpenDelay = 8;
 
+	/** How the view reaches the window (set before BeginPlay, or call RefreshDisplayConfiguration after changing it) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MultiDisplay|Settings")
+	EMultiDisplayPresentMode PresentMode = EMultiDisplayPresentMode::SceneCapture;
+
+	// === Capture Scheduling ===
+
+	/** Let UDisplayCaptureScheduler decide when this display captures (off = capture every frame, as before the scheduler existed) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MultiDisplay|Scheduling")
+	bool bUseCaptureScheduler = false;
+
+	/** Target captures per second when scheduled (0 = every frame), e.g. 60 for a pilot view, 10 for a map screen */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MultiDisplay|Scheduling", meta = (ClampMin = "0.0", ClampMax = "240.0"))
+	float TargetCaptureRate = 0.0f;
+
+	/** Displays with a higher priority capture first when the per-frame capture budget is exhausted */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MultiDisplay|Scheduling")
+	int32 CapturePriority = 0;
+
 	// === Functions ===
 
 	/** Activate this camera and open a window on the target display */
@@ -106,7 +144,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MultiDisplay")
 	static TArray<FString> GetAllDisplayNames();
 
-	/** Get the render target being used for this camera */
+	/** Get the render target being used for this camera (nullptr in Direct Viewport mode) */
 	UFUNCTION(BlueprintPure, Category = "MultiDisplay")
 	UTextureRenderTarget2D* GetRenderTarget() const { return TextureTarget; }
 
@@ -131,6 +169,18 @@ private:
 	/** Cached display resolution */
 	FIntPoint CachedDisplayResolution;
 
+	/** Whether captures are driven by UDisplayCaptureScheduler */
+	bool bIsScheduled = false;
+
+	/** Tick group in effect before a direct viewport moved the component to TG_PostUpdateWork */
+	TEnumAsByte<ETickingGroup> OriginalTickGroup = TG_DuringPhysics;
+
+	/** Whether the tick group is currently overridden for a direct viewport */
+	bool bTickGroupOverridden = false;
+
+	/** Move to TG_PostUpdateWork for a direct viewport, or restore the original tick group otherwise */
+	void UpdateTickGroup();
+
 	/** Create a new secondary window on the target display */
 	void CreateSecondaryWindow();
 
@@ -151,4 +201,19 @@ private:
 
 	/** Brush used to paint the render target into the SImage */
 	FSlateBrush RenderTargetBrush;
+
+	/** Direct Viewport mode: the window's viewport widget, its scene viewport and the client that renders the view */
+	TSharedPtr<SViewport> ViewportWidget;
+	TSharedPtr<FSceneViewport> SceneViewport;
+	TSharedPtr<FMultiDisplayViewportClient> ViewportClient;
+
+	/** Build the window content for the current present mode (nullptr on failure) */
+	TSharedPtr<SWidget> CreateRenderTargetContent(int32 WindowWidth, int32 WindowHeight);
+	TSharedPtr<SWidget> CreateViewportContent();
+
+	/** Check if the view is presented through a direct viewport */
+	bool IsDirectViewport() const { return PresentMode == EMultiDisplayPresentMode::DirectViewport; }
+
+	/** Hand captures to the scheduler (Scene Capture mode) or turn engine captures off (Direct Viewport) */
+	void ConfigureCapture();
 };
@@ -7,11 +7,72 @@
 #include "Components/ActorComponent.h"
 #include "EspPacketBP.h"
 #include "WeaponMag.h"
+#include "HardwareInputNetState.h"
+#include "HardwareInputSampler.h"
 #include "ShipHardwareInputComponent.generated.h"
 
 // Forward declarations
 class UAndySerialSubsystem;
 class UFiringComponent;
+class UHoverMovementComponent;
+struct FHoverInputSample;
+
+/**
+ * Movement axis an encoder wheel can drive
+ */
+UENUM(BlueprintType)
+enum class EHardwareWheelAxis : uint8
+{
+	Throttle	UMETA(DisplayName = "Throttle"),
+	Steering	UMETA(DisplayName = "Steering"),
+	Strafe		UMETA(DisplayName = "Strafe")
+};
+
+/**
+ * How encoder detents are turned into an axis value
+ */
+UENUM(BlueprintType)
+enum class EWheelBindingMode : uint8
+{
+	/** Axis follows the wheel's position relative to centre (helm) */
+	Position	UMETA(DisplayName = "Position"),
+
+	/** Axis follows the wheel's estimated spin rate and returns to zero when it stops (crank) */
+	Velocity	UMETA(DisplayName = "Velocity")
+};
+
+/**
+ * Maps an encoder wheel to a UHoverMovementComponent input axis
+ */
+USTRUCT(BlueprintType)
+struct FWheelAxisBinding
+{
+	GENERATED_BODY()
+
+	/** Encoder wheel index (as reported in WheelTurn packets) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels", meta = (ClampMin = "0", ClampMax = "3"))
+	int32 WheelIndex = 0;
+
+	/** Movement axis driven by this wheel */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels")
+	EHardwareWheelAxis Axis = EHardwareWheelAxis::Steering;
+
+	/** How detents become an axis value */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels")
+	EWheelBindingMode Mode = EWheelBindingMode::Position;
+
+	/** Detents from centre to full deflection (Position mode) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels", meta = (ClampMin = "1.0", EditCondition = "Mode == EWheelBindingMode::Position"))
+	float DetentsToFullScale = 12.0f;
+
+	/** Spin rate in detents per second that gives full deflection (Velocity mode) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels", meta = (ClampMin = "1.0", EditCondition = "Mode == EWheelBindingMode::Velocity"))
+	float DetentsPerSecondToFullScale = 30.0f;
+
+	/** Invert the wheel direction */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels")
+	bool bInvert = false;
+};
 
 // ============================================================================
 // Event Delegates - Friendly Blueprint events for ship hardware input
@@ -58,6 +119,19 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_SixParams(
 	const TArray<uint8>&, Payload
 );
 
+/**
+ * Event fired once per frame for each wheel that turned
+ * @param WheelIndex - Index of the wheel (0-based)
+ * @param Delta - Net detents turned this frame (positive = right/clockwise)
+ * @param Velocity - Estimated spin rate in detents per second
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(
+	FOnWheelFrameDelta,
+	uint8, WheelIndex,
+	int32, Delta,
+	float, Velocity
+);
+
 /**
  * Event fired when jack state changes
  * @param Src - Source identifier from the packet
@@ -146,10 +220,14 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(
  * - Filters frames by ShipId (only receives events for this ship)
  * - Parses packet payloads into typed, Blueprint-friendly events
  * - Server-only operation (respects authority for networked games)
+ * - Optional forwarding of hardware state from a client cabinet to the server
+ * - Optional fixed-rate sampling (UHardwareInputSampler) that steps UHoverMovementComponent
+ *   and UFiringComponent through sub-frame input so handling is frame-rate independent
  *
  * Exposed Events:
  * - OnWeaponImu: IMU orientation + trigger state from weapon controllers
- * - OnWheelTurn: Rotary encoder input from steering/helm wheels
+ * - OnWheelTurn: Rotary encoder input from steering/helm wheels (one event per detent, optional)
+ * - OnWheelFrameDelta: Net encoder delta and spin rate per wheel, once per frame
  * - OnJackState: Jack plug insertion/removal state
  * - OnWeaponTag: RFID/NFC weapon tag insertion/removal
  * - OnReloadTag: RFID/NFC reload tag insertion/removal
@@ -175,10 +253,28 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Config")
 	FName ShipId;
 
-	/** If true, only bind and process events on the server (HasAuthority check) */
+	/** If true, only bind and process events on the server (HasAuthority check); clients with bForwardToServer still bind to forward */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Config")
 	bool bServerOnly = true;
 
+	// === Network Forwarding ===
+
+	/**
+	 * If true, a client that owns this ship binds to its local serial ports and forwards the
+	 * decoded state to the server (for cabinets playing on a dedicated server). The client does
+	 * not apply the input itself; movement and firing follow the server.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Network")
+	bool bForwardToServer = false;
+
+	/** Maximum hardware state snapshots sent to the server per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Network", meta = (ClampMin = "5.0", ClampMax = "120.0", EditCondition = "bForwardToServer"))
+	float ForwardRate = 60.0f;
+
+	/** Resend an unchanged snapshot after this long (in seconds) so a dropped packet is recovered */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Network", meta = (ClampMin = "0.05", ClampMax = "2.0", EditCondition = "bForwardToServer"))
+	float ForwardKeepAliveInterval = 0.25f;
+
 	// === Weapon Magazine Configuration ===
 
 	/** Array of weapon magazine configurations mapped to RFID tag IDs */
@@ -197,12 +293,63 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Weapon Mags")
 	bool bAutoApplyWeaponMag = true;
 
+	// === Fixed-Rate Sampling ===
+
+	/**
+	 * Drive movement and aim from the fixed-rate input timeline instead of applying each packet as it arrives
+	 * Off by default: it changes how existing ships respond, so it is enabled per ship.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Sampling")
+	bool bUseFixedRateSampling = false;
+
+	/** Delay applied when reading the timeline (in seconds). Raising it absorbs delivery jitter at the cost of latency. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Sampling", meta = (ClampMin = "0.0", ClampMax = "0.1", EditCondition = "bUseFixedRateSampling"))
+	float SampleDelay = 0.0f;
+
+	/** If true, the weapon trigger drives FiringComponent->SetFiring from the sampled timeline */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Sampling", meta = (EditCondition = "bUseFixedRateSampling"))
+	bool bAutoApplyTrigger = false;
+
+	/** Movement component driven by WheelAxisBindings (found on the owner if not set) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels")
+	TObjectPtr<UHoverMovementComponent> MovementComponent;
+
+	/** Encoder wheel to movement axis mappings, applied natively once per frame (or per sample when sampling) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels")
+	TArray<FWheelAxisBinding> WheelAxisBindings;
+
+	/** Time constant of the wheel spin rate estimate (in seconds). Lower reacts faster but is noisier. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float WheelVelocitySmoothingTime = 0.08f;
+
+	/** If true, OnWheelTurn fires for every detent. Disable when only WheelAxisBindings or OnWheelFrameDelta are used. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ship Hardware|Wheels")
+	bool bBroadcastWheelDetents = true;
+
+	/**
+	 * Get the estimated spin rate of a wheel
+	 * @param WheelIndex - Index of the wheel (0-based)
+	 * @return Detents per second (positive = right/clockwise)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ship Hardware|Wheels")
+	float GetWheelVelocity(int32 WheelIndex) const;
+
+	/**
+	 * Treat the current wheel positions as centre (all bound axes return to zero)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ship Hardware|Wheels")
+	void RecenterWheels();
+
 	// === Events ===
 
 	/** Event fired when weapon IMU data is received (orientation + euler angles + trigger) */
 	UPROPERTY(BlueprintAssignable, Category = "Ship Hardware|Events")
 	FOnWeaponImu OnWeaponImu;
 
+	/** Event fired once per frame per wheel with the net delta and spin rate */
+	UPROPERTY(BlueprintAssignable, Category = "Ship Hardware|Events")
+	FOnWheelFrameDelta OnWheelFrameDelta;
+
 	/** Event fired when wheel turn input is received (includes WheelIndex) */
 	UPROPERTY(BlueprintAssignable, Category = "Ship Hardware|Events")
 	FOnWheelTurn OnWheelTurn;
@@ -236,6 +383,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Ship Hardware|Status")
 	bool IsConnected() const;
 
+	/**
+	 * Check if this component is forwarding local hardware to the server
+	 * @return True if bound on a client with bForwardToServer
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ship Hardware|Status")
+	bool IsForwardingToServer() const { return bIsForwarding; }
+
 	/**
 	 * Get the subsystem managing serial connections
 	 * @return The UAndySerialSubsystem instance, or nullptr if not available
@@ -275,6 +429,7 @@ protected:
 
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	// === Internal Event Handlers ===
 
@@ -286,6 +441,16 @@ protected:
 	UFUNCTION()
 	void OnConnectionChangedHandler(FName InShipId, bool bConnected);
 
+	// === Network Forwarding ===
+
+	/** Latest hardware state from the owning client (latest-state, drops are recovered by the next snapshot) */
+	UFUNCTION(Server, Unreliable)
+	void ServerReceiveHardwareState(const FHardwareInputNetState& State);
+
+	/** Tag insert/remove edge from the owning client (edges cannot be recovered from later state) */
+	UFUNCTION(Server, Reliable)
+	void ServerReceiveTagEdge(int64 TagId, bool bInserted, uint8 ReaderIndex);
+
 private:
 	/** Cached reference to the serial subsystem */
 	UPROPERTY()
@@ -294,6 +459,75 @@ private:
 	/** Whether we are currently bound to subsystem events */
 	bool bIsBound = false;
 
+	/** Whether local hardware is forwarded to the server instead of applied with authority */
+	bool bIsForwarding = false;
+
+	/** State being built from local packets for forwarding */
+	FHardwareInputNetState ForwardState;
+
+	/** Last state sent to the server */
+	FHardwareInputNetState LastSentState;
+
+	/** World time of the last forwarded snapshot (negative = never sent) */
+	double LastForwardTime = -1.0;
+
+	/** Last state received from the owning client (server side) */
+	FHardwareInputNetState LastReceivedState;
+
+	/** Whether the server has received forwarded state for this ship */
+	bool bHasReceivedState = false;
+
+	/** Send a snapshot to the server if due */
+	void TickForwarding();
+
+	/** Apply a forwarded snapshot as if its packets had arrived locally (server side) */
+	void ApplyForwardedState(const FHardwareInputNetState& State);
+
+	/** Broadcast a tag inserted state transition and apply its weapon mag */
+	void HandleTagTransition(int64 TagId, bool bInserted, uint8 ReaderIndex);
+
+	/** Cached reference to the fixed-rate sampler */
+	UPROPERTY()
+	TObjectPtr<UHardwareInputSampler> CachedSampler;
+
+	/** Time of the last timeline sample consumed (0 = not started) */
+	double SampleCursor = 0.0;
+
+	/** Wheel counts at the last consumed sample */
+	int32 LastWheelCounts[FShipInputSample::MaxWheels] = {};
+
+	/** Whether LastWheelCounts has been seeded from the timeline */
+	bool bWheelCountsSeeded = false;
+
+	/** Current deflection (-1 to +1) of each entry in WheelAxisBindings */
+	TArray<float> WheelAxisPositions;
+
+	/** Detents received from packets since the last tick (direct path) */
+	int32 PendingWheelDeltas[FShipInputSample::MaxWheels] = {};
+
+	/** Smoothed spin rate per wheel (detents per second) */
+	float WheelVelocities[FShipInputSample::MaxWheels] = {};
+
+	/**
+	 * Advance wheel velocity estimates and binding positions by one step
+	 * @param Deltas - Detents turned per wheel during the step
+	 * @param DeltaTime - Step length in seconds
+	 * @param OutInput - Receives the resulting movement axes; only bound axes are flagged as carried
+	 */
+	void StepWheels(const int32* Deltas, float DeltaTime, FHoverInputSample& OutInput);
+
+	/** Apply this frame's accumulated packet deltas to the movement component (direct path) */
+	void ApplyPendingWheelDeltas(float DeltaTime);
+
+	/** Broadcast OnWheelFrameDelta for every wheel that moved */
+	void BroadcastWheelFrameDeltas(const int32* Deltas);
+
+	/** Whether packets should be applied directly (sampling disabled or unavailable) */
+	bool ShouldApplyPacketsDirectly() const;
+
+	/** Consume this frame's timeline samples and queue them on the movement and firing components */
+	void ConsumeTimelineSamples();
+
 	/** Track previous weapon tag inserted state for change detection (keyed by TagId) */
 	TMap<int64, bool> WeaponTagInsertedState;
 
@@ -78,7 +78,7 @@ class ActorNameManager:
         # If we have a connection, check with Unreal Engine
         if unreal_connection:
             try:
-                response = unreal_connection.send_command("find_actors_by_name", {"pattern": name})
+                response = unreal_connection.send_command("find_actors_by_name", {"pattern": name, "fields": ["name"]})
                 if response and response.get("status") == "success" and "actors" in response:
                     actors = response.get("actors", [])
                     if isinstance(actors, list):
@@ -145,7 +145,9 @@ def safe_spawn_actor(unreal_connection, params: Dict[str, Any], auto_unique_name
     
     if auto_unique_name:
         # Generate unique name
-        unique_name = _global_actor_name_manager.generate_unique_name(original_name, unreal_connection)
+        # A batching connection only knows the local cache; querying Unreal would flush every spawn
+        lookup_connection = None if getattr(unreal_connection, "defers_commands", False) else unreal_connection
+        unique_name = _global_actor_name_manager.generate_unique_name(original_name, lookup_connection)
         params["name"] = unique_name
         
         # Log name change if it occurred
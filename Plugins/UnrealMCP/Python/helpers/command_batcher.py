@@ -0,0 +1,208 @@
+"""
+Command batching for Unreal MCP Server.
+Queues fire-and-forget commands (spawns, transforms, deletes) and sends them to Unreal
+as "batch" commands, so a structure with hundreds of actors costs a handful of
+game-thread tasks instead of one round trip per actor.
+"""
+
+import logging
+from concurrent.futures import TimeoutError as FutureTimeoutError
+from typing import Any, Dict, List, Optional
+
+from .actor_name_manager import get_global_actor_name_manager, get_unique_actor_name
+
+logger = logging.getLogger(__name__)
+
+
+class CommandBatcher:
+    """
+    Drop-in stand-in for UnrealConnection inside the structure helpers.
+
+    Commands in DEFERRED_COMMANDS are queued and answered immediately with a
+    provisional success ({"deferred": True}); every other command first flushes
+    the queue and waits for it, so commands still run in the order they were issued.
+    Full batches are sent without waiting, so the next batch is built while
+    Unreal runs the previous one.
+
+    With instance_name set, StaticMeshActor spawns are not sent as actors at all:
+    their transforms are grouped by mesh and sent as one spawn_instanced_meshes
+    command per flush, which builds a single actor with one instanced component
+    per mesh.
+
+    Usage:
+        with CommandBatcher(unreal) as batch:
+            build_outer_bailey_walls(batch, ...)
+        failed = batch.failed
+    """
+
+    # Commands whose responses the helpers only store, never inspect
+    DEFERRED_COMMANDS = {
+        "spawn_actor",
+        "spawn_blueprint_actor",
+        "set_actor_transform",
+        "delete_actor",
+        "set_mesh_material_color",
+        "apply_material_to_actor"
+    }
+
+    DEFAULT_BATCH_SIZE = 250
+
+    # Tells safe_spawn_actor not to query Unreal per actor while batching
+    defers_commands = True
+
+    def __init__(self, connection, batch_size: int = DEFAULT_BATCH_SIZE,
+                 stop_on_error: bool = False, description: str = None,
+                 instance_name: str = None):
+        self.connection = connection
+        self.batch_size = max(1, batch_size)
+        self.stop_on_error = stop_on_error
+        self.description = description
+        self.instance_name = instance_name
+        self._instances: Dict[str, List[Dict[str, Any]]] = {}  # static_mesh -> transforms
+        self._instance_actor: Optional[str] = None  # actor the collected instances go to
+        self._queue: List[Dict[str, Any]] = []
+        self._in_flight = []  # (commands, future) per sent batch
+        self.sent = 0
+        self.batches = 0
+        self.succeeded = 0
+        self.failed = 0
+        self.errors: List[Dict[str, Any]] = []
+        self.instanced = 0
+        self.draw_calls = 0
+        self.draw_calls_as_actors = 0
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.flush()
+        return False
+
+    def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
+        """Queue a deferred command, or flush and forward any other command."""
+        params = dict(params or {})
+        if command not in self.DEFERRED_COMMANDS:
+            self.flush()
+            return self.connection.send_command(command, params)
+
+        if self._collect_instance(command, params):
+            return {"status": "success", "result": {"instanced": True, "name": params.get("name"),
+                                                    "actor": self._instance_actor_name()}}
+
+        self._queue.append({"type": command, "params": params})
+        if len(self._queue) >= self.batch_size:
+            self._send_queue()
+
+        result = {"deferred": True}
+        if "name" in params:
+            result["name"] = params["name"]
+        return {"status": "success", "result": result}
+
+    def flush(self):
+        """Send the queued commands and wait for every batch in flight."""
+        self._queue_instances()
+        self._send_queue()
+
+        in_flight, self._in_flight = self._in_flight, []
+        for commands, future in in_flight:
+            self._collect(commands, future)
+
+    def summary(self) -> Dict[str, Any]:
+        """Counts for reporting in tool results."""
+        summary = {
+            "commands": self.sent,
+            "batches": self.batches,
+            "succeeded": self.succeeded,
+            "failed": self.failed,
+            "errors": self.errors[:10]
+        }
+        if self.instance_name:
+            summary["instanced"] = self.instanced
+            summary["draw_calls"] = self.draw_calls
+            summary["draw_calls_as_actors"] = self.draw_calls_as_actors
+        return summary
+
+    def _collect_instance(self, command: str, params: Dict[str, Any]) -> bool:
+        """Record a StaticMeshActor spawn as an instance of its mesh."""
+        if (not self.instance_name or command != "spawn_actor"
+                or params.get("type") != "StaticMeshActor" or not params.get("static_mesh")):
+            return False
+
+        transform = {"location": params.get("location", [0.0, 0.0, 0.0])}
+        if "rotation" in params:
+            transform["rotation"] = params["rotation"]
+        if "scale" in params:
+            transform["scale"] = params["scale"]
+        self._instances.setdefault(params["static_mesh"], []).append(transform)
+        return True
+
+    def _instance_actor_name(self) -> str:
+        # Every flush spawns its own actor, so each gets its own unique name
+        if self._instance_actor is None:
+            self._instance_actor = get_unique_actor_name(self.instance_name, self.connection)
+            get_global_actor_name_manager().mark_actor_created(self._instance_actor)
+        return self._instance_actor
+
+    def _queue_instances(self):
+        if not self._instances:
+            return
+
+        groups = [{"static_mesh": mesh, "transforms": transforms} for mesh, transforms in self._instances.items()]
+        self._instances = {}
+        self._queue.append({"type": "spawn_instanced_meshes",
+                            "params": {"name": self._instance_actor_name(), "groups": groups}})
+        self._instance_actor = None
+
+    def _send_queue(self):
+        if not self._queue:
+            return
+
+        commands, self._queue = self._queue, []
+        params = {"commands": commands, "stop_on_error": self.stop_on_error}
+        if self.description:
+            params["description"] = self.description
+
+        self.sent += len(commands)
+        self.batches += 1
+        try:
+            self._in_flight.append((commands, self.connection.send_command_async("batch", params)))
+        except ConnectionError as e:
+            self._record_batch_failure(commands, str(e))
+
+    def _collect(self, commands: List[Dict[str, Any]], future):
+        try:
+            response = future.result(timeout=self.connection._get_timeout_for_command("batch"))
+        except FutureTimeoutError:
+            self._record_batch_failure(commands, "Timeout waiting for batch response")
+            return
+        except Exception as e:
+            self._record_batch_failure(commands, str(e))
+            return
+
+        if response.get("status") != "success":
+            self._record_batch_failure(commands, response.get("error", "Unknown error"))
+            return
+
+        result = response.get("result", {})
+        self.succeeded += result.get("succeeded", 0)
+        self.failed += len(commands) - result.get("succeeded", 0)
+        for item in result.get("results", []):
+            if item.get("type") == "spawn_instanced_meshes" and item.get("status") == "success":
+                spawned = item.get("result", {})
+                self.instanced += spawned.get("instance_count", 0)
+                self.draw_calls += spawned.get("draw_calls", 0)
+                self.draw_calls_as_actors += spawned.get("draw_calls_as_actors", 0)
+            if item.get("status") != "success":
+                self.errors.append({
+                    "type": item.get("type"),
+                    "name": commands[item.get("index", 0)]["params"].get("name"),
+                    "error": item.get("error", "Unknown error")
+                })
+
+        logger.info(f"Batch of {len(commands)} commands: {result.get('succeeded', 0)} succeeded "
+                    f"in {result.get('elapsed_ms', 0):.1f} ms")
+
+    def _record_batch_failure(self, commands: List[Dict[str, Any]], error: str):
+        logger.error(f"Batch of {len(commands)} commands failed: {error}")
+        self.failed += len(commands)
+        self.errors.append({"type": "batch", "error": error})
@@ -9,13 +9,21 @@ import logging
 import socket
 import json
 import math
-import struct
+import select
 import time
 import threading
+import itertools
+import zlib
+from concurrent.futures import Future, TimeoutError as FutureTimeoutError
 from contextlib import asynccontextmanager
 from typing import AsyncIterator, Dict, Any, Optional, List
 from mcp.server.fastmcp import FastMCP
 
+try:
+    import msgpack
+except ImportError:  # Optional: responses fall back to JSON
+    msgpack = None
+
 from helpers.infrastructure_creation import (
     _create_street_grid, _create_street_lights, _create_town_vehicles, _create_town_decorations,
     _create_traffic_lights, _create_street_signage, _create_sidewalks_crosswalks, _create_urban_furniture,
@@ -35,6 +43,7 @@ from helpers.mansion_creation import (
     get_mansion_size_params, calculate_mansion_layout, build_mansion_main_structure,
     build_mansion_exterior, add_mansion_interior
 )
+from helpers.command_batcher import CommandBatcher
 from helpers.actor_utilities import spawn_blueprint_actor, get_blueprint_material_info
 from helpers.actor_name_manager import (
     safe_spawn_actor, safe_delete_actor
@@ -70,13 +79,21 @@ logger = logging.getLogger("UnrealMCP_Advanced")
 UNREAL_HOST = "127.0.0.1"
 UNREAL_PORT = 55557
 
+# Response body encoding requested from Unreal: "msgpack" (needs the msgpack package) or "json"
+RESPONSE_ENCODING = "msgpack" if msgpack else "json"
+# Response compression: "zlib" saves bandwidth on remote links, "none" saves CPU on localhost
+RESPONSE_COMPRESSION = "none"
+
 class UnrealConnection:
     """
-    Robust connection to Unreal Engine with automatic retry and reconnection.
+    Persistent, pipelined connection to Unreal Engine.
     
     Features:
+    - One TCP socket kept open across commands, reconnected automatically on failure
+    - Newline-delimited JSON messages tagged with a request id
+    - Optional MessagePack / zlib-compressed responses, sent as a header line plus body
+    - Many requests in flight per socket; a reader thread matches responses by id
     - Exponential backoff retry for connection attempts
-    - Automatic reconnection on failure
     - Configurable timeouts per command type
     - Thread-safe operations
     - Detailed logging for debugging
@@ -87,9 +104,10 @@ class UnrealConnection:
     BASE_RETRY_DELAY = 0.5  # seconds
     MAX_RETRY_DELAY = 5.0   # seconds
     CONNECT_TIMEOUT = 10    # seconds
+    SEND_TIMEOUT = 10       # seconds
     DEFAULT_RECV_TIMEOUT = 30  # seconds
     LARGE_OP_RECV_TIMEOUT = 300  # seconds for large operations
-    BUFFER_SIZE = 8192
+    BUFFER_SIZE = 65536
     
     # Commands that need longer timeouts
     LARGE_OPERATION_COMMANDS = {
@@ -99,14 +117,22 @@ class UnrealConnection:
         "construct_mansion",
         "create_suspension_bridge",
         "create_aqueduct",
-        "create_maze"
+        "create_maze",
+        "batch",
+        "end_edit_session",
+        "spawn_instanced_meshes"
     }
     
     def __init__(self):
         """Initialize the connection."""
         self.socket = None
         self.connected = False
-        self._lock = threading.RLock()  # RLock allows reentrant acquisition for retry logic
+        self._lock = threading.RLock()  # Guards socket state; RLock allows reentrant acquisition
+        self._send_lock = threading.Lock()  # Serializes writes so messages never interleave
+        self._pending: Dict[int, Future] = {}  # Request id -> future awaiting its response
+        self._pending_lock = threading.Lock()
+        self._request_ids = itertools.count(1)
+        self._reader_thread = None
         self._last_error = None
     
     def _create_socket(self) -> socket.socket:
@@ -115,21 +141,13 @@ class UnrealConnection:
         sock.settimeout(self.CONNECT_TIMEOUT)
         sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
         sock.setsockopt(socket.SOL_SOCKET, socket.SO_KEEPALIVE, 1)
-        sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 131072)  # 128KB
-        sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 131072)  # 128KB
-        
-        # Set linger to ensure clean socket closure (l_onoff=1, l_linger=0)
-        # struct linger is two 16-bit integers: l_onoff and l_linger
-        try:
-            sock.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack('hh', 1, 0))
-        except OSError:
-            pass
-        
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 262144)  # 256KB
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 262144)  # 256KB
         return sock
     
     def connect(self) -> bool:
         """
-        Connect to Unreal Engine with retry logic.
+        Connect to Unreal Engine with retry logic (no-op if already connected).
         
         Uses exponential backoff for retries. Sleep occurs outside the lock
         to avoid blocking other threads during retry delays.
@@ -140,17 +158,29 @@ class UnrealConnection:
         for attempt in range(self.MAX_RETRIES + 1):
             # Hold lock only during connection attempt, not during sleep
             with self._lock:
-                # Clean up any existing connection
+                if self.connected:
+                    return True
+                
+                # Clean up any previous connection
                 self._close_socket_unsafe()
                 
                 try:
                     logger.info(f"Connecting to Unreal at {UNREAL_HOST}:{UNREAL_PORT} (attempt {attempt + 1}/{self.MAX_RETRIES + 1})...")
                     
-                    self.socket = self._create_socket()
-                    self.socket.connect((UNREAL_HOST, UNREAL_PORT))
+                    sock = self._create_socket()
+                    sock.connect((UNREAL_HOST, UNREAL_PORT))
+                    
+                    # The reader thread blocks on recv; sends use their own timeout via select
+                    sock.settimeout(None)
+                    self.socket = sock
                     self.connected = True
                     self._last_error = None
                     
+                    self._reader_thread = threading.Thread(
+                        target=self._reader_loop, args=(sock,), name="UnrealMCPReader", daemon=True
+                    )
+                    self._reader_thread.start()
+                    
                     logger.info("Successfully connected to Unreal Engine")
                     return True
                     
@@ -168,7 +198,6 @@ class UnrealConnection:
                     logger.error(f"Unexpected connection error: {e} (attempt {attempt + 1})")
                 
                 self._close_socket_unsafe()
-                self.connected = False
             
             # Sleep OUTSIDE the lock to allow other threads to proceed
             if attempt < self.MAX_RETRIES:
@@ -180,7 +209,7 @@ class UnrealConnection:
         return False
     
     def _close_socket_unsafe(self):
-        """Close socket without lock (internal use only)."""
+        """Close socket without lock (internal use only). The reader thread exits and fails pending requests."""
         if self.socket:
             try:
                 self.socket.shutdown(socket.SHUT_RDWR)
@@ -198,6 +227,108 @@ class UnrealConnection:
         with self._lock:
             self._close_socket_unsafe()
             logger.debug("Disconnected from Unreal Engine")
+        self._fail_pending(ConnectionError("Disconnected"))
+
+    def _fail_pending(self, error: Exception):
+        """Fail every request still waiting for a response."""
+        with self._pending_lock:
+            pending = list(self._pending.values())
+            self._pending.clear()
+        for future in pending:
+            if not future.done():
+                future.set_exception(error)
+
+    def _reader_loop(self, sock: socket.socket):
+        """Read responses and resolve the matching requests."""
+        buffer = bytearray()
+        scan_from = 0
+        frame = None  # Header of a framed response whose body is still arriving
+        error = ConnectionError("Connection closed by Unreal")
+        
+        try:
+            while True:
+                chunk = sock.recv(self.BUFFER_SIZE)
+                if not chunk:
+                    break
+                buffer += chunk
+                
+                # Only the newly received bytes are searched for terminators, and the
+                # consumed lines are dropped once per read rather than once per line
+                line_start = 0
+                while True:
+                    if frame is not None:
+                        body_end = line_start + frame["size"]
+                        if len(buffer) < body_end:
+                            break
+                        self._dispatch_frame(frame, bytes(buffer[line_start:body_end]))
+                        line_start = scan_from = body_end
+                        frame = None
+                        continue
+                    newline = buffer.find(b"\n", scan_from)
+                    if newline < 0:
+                        break
+                    line = bytes(buffer[line_start:newline])
+                    line_start = scan_from = newline + 1
+                    if line.strip():
+                        frame = self._dispatch_response(line)
+                del buffer[:line_start]
+                scan_from = len(buffer)
+        except OSError as e:
+            error = ConnectionError(f"Connection error: {e}")
+        
+        with self._lock:
+            if self.socket is sock:
+                self._close_socket_unsafe()
+        self._fail_pending(error)
+        logger.debug("Reader thread exiting")
+
+    def _dispatch_response(self, line: bytes) -> Optional[Dict[str, Any]]:
+        """
+        Resolve the request a JSON response line belongs to.
+        
+        Returns:
+            The header when the line announces a framed response, whose body follows
+        """
+        try:
+            response = json.loads(line.decode("utf-8"))
+        except (json.JSONDecodeError, UnicodeDecodeError) as e:
+            logger.error(f"Invalid response from Unreal: {e}")
+            return None
+        
+        if "frame" in response and "size" in response:
+            return response
+        
+        self._resolve(response)
+        return None
+
+    def _dispatch_frame(self, header: Dict[str, Any], body: bytes):
+        """Decode a framed response body and resolve its request."""
+        try:
+            if header.get("compression") == "zlib":
+                body = zlib.decompress(body)
+            if header["frame"] == "msgpack":
+                response = msgpack.unpackb(body, raw=False, strict_map_key=False)
+            else:
+                response = json.loads(body.decode("utf-8"))
+        except Exception as e:
+            logger.error(f"Invalid {header.get('frame')} response from Unreal: {e}")
+            response = {"status": "error", "error": f"Could not decode response: {e}"}
+        
+        response["id"] = header.get("id")
+        logger.debug(f"Received {header['frame']} response (id {header.get('id')}, "
+                     f"{header['size']} bytes, {header.get('raw_size')} decoded)")
+        self._resolve(response)
+
+    def _resolve(self, response: Dict[str, Any]):
+        """Hand a decoded response to the future of its request."""
+        request_id = response.pop("id", None)
+        with self._pending_lock:
+            future = self._pending.pop(request_id, None)
+        
+        if future is None:
+            logger.warning(f"Response for unknown request id {request_id}")
+        elif not future.done():
+            future.set_result(response)
 
     def _get_timeout_for_command(self, command_type: str) -> int:
         """Get appropriate timeout for command type."""
@@ -205,97 +336,73 @@ class UnrealConnection:
             return self.LARGE_OP_RECV_TIMEOUT
         return self.DEFAULT_RECV_TIMEOUT
 
-    def _receive_response(self, command_type: str) -> bytes:
+    def send_command_async(self, command: str, params: Dict[str, Any] = None) -> Future:
         """
-        Receive complete JSON response from Unreal.
+        Send a command without waiting for its response.
+        
+        Any number of commands may be in flight; Unreal runs them in order and
+        each response resolves the future of the request with the same id.
         
         Args:
-            command_type: Type of command (used for timeout selection)
+            command: Command type string
+            params: Command parameters dictionary
             
         Returns:
-            Raw response bytes
+            Future resolving to the raw response dictionary
             
         Raises:
-            Exception: On timeout or connection error
+            ConnectionError: If the command could not be sent
         """
-        timeout = self._get_timeout_for_command(command_type)
-        self.socket.settimeout(timeout)
+        if not self.connect():
+            raise ConnectionError(f"Failed to connect to Unreal Engine: {self._last_error}")
         
-        chunks = []
-        total_bytes = 0
-        start_time = time.time()
+        request_id = next(self._request_ids)
+        future = Future()
+        with self._pending_lock:
+            self._pending[request_id] = future
         
-        try:
-            while True:
-                # Check for overall timeout
-                elapsed = time.time() - start_time
-                if elapsed > timeout:
-                    raise socket.timeout(f"Overall timeout after {elapsed:.1f}s")
-                
-                try:
-                    chunk = self.socket.recv(self.BUFFER_SIZE)
-                except socket.timeout:
-                    # Check if we have a complete response
-                    if chunks:
-                        data = b''.join(chunks)
-                        try:
-                            json.loads(data.decode('utf-8'))
-                            logger.info(f"Got complete response after recv timeout ({total_bytes} bytes)")
-                            return data
-                        except json.JSONDecodeError:
-                            pass
-                    raise
-                
-                if not chunk:
-                    # Connection closed by remote
-                    if not chunks:
-                        raise ConnectionError("Connection closed before receiving any data")
-                    break
-                
-                chunks.append(chunk)
-                total_bytes += len(chunk)
-                
-                # Try to parse accumulated data as JSON
-                data = b''.join(chunks)
-                try:
-                    decoded = data.decode('utf-8')
-                    json.loads(decoded)
-                    # Successfully parsed - we have complete response
-                    logger.info(f"Received complete response ({total_bytes} bytes) for {command_type}")
-                    return data
-                except json.JSONDecodeError:
-                    # Incomplete JSON, continue reading
-                    continue
-                except UnicodeDecodeError:
-                    # Incomplete UTF-8, continue reading
-                    continue
-                    
-        except socket.timeout:
-            elapsed = time.time() - start_time
-            if chunks:
-                data = b''.join(chunks)
-                try:
-                    json.loads(data.decode('utf-8'))
-                    logger.warning(f"Using response received before timeout ({total_bytes} bytes)")
-                    return data
-                except:
-                    pass
-            raise TimeoutError(f"Timeout after {elapsed:.1f}s waiting for response to {command_type} (received {total_bytes} bytes)")
-        
-        # If we get here, connection was closed
-        if chunks:
-            data = b''.join(chunks)
-            try:
-                json.loads(data.decode('utf-8'))
-                return data
-            except:
-                raise ConnectionError(f"Connection closed with incomplete data ({total_bytes} bytes)")
+        envelope = {"id": request_id, "type": command, "params": params or {}}
+        if RESPONSE_ENCODING != "json":
+            envelope["encoding"] = RESPONSE_ENCODING
+        if RESPONSE_COMPRESSION != "none":
+            envelope["compression"] = RESPONSE_COMPRESSION
+        message = json.dumps(envelope) + "\n"
         
-        raise ConnectionError("Connection closed without response")
+        try:
+            with self._send_lock:
+                sock = self.socket
+                if sock is None:
+                    raise ConnectionError("Connection closed")
+                _, writable, _ = select.select([], [sock], [], self.SEND_TIMEOUT)
+                if not writable:
+                    raise TimeoutError(f"Send timeout for {command}")
+                sock.sendall(message.encode("utf-8"))
+        except (OSError, ValueError) as e:
+            with self._pending_lock:
+                self._pending.pop(request_id, None)
+            self.disconnect()
+            raise ConnectionError(f"Failed to send {command}: {e}")
+        
+        logger.debug(f"Sent command {command} (id {request_id}, {len(message)} bytes)")
+        return future
+
+    def _normalize_response(self, command: str, response: Dict[str, Any]) -> Dict[str, Any]:
+        """Normalize error responses."""
+        if response.get("status") == "error":
+            error_msg = response.get("error") or response.get("message", "Unknown error")
+            logger.warning(f"Unreal returned error for {command}: {error_msg}")
+        elif response.get("success") is False:
+            error_msg = response.get("error") or response.get("message", "Unknown error")
+            response = {"status": "error", "error": error_msg}
+            logger.warning(f"Unreal returned failure for {command}: {error_msg}")
+        return response
 
     def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
         """
-        Send a command to Unreal Engine with automatic retry.
+        Send a command to Unreal Engine and wait for its response.
+        
+        Connection failures are retried with backoff. A timeout is not retried,
+        since the command may still be running in the editor.
         
         Args:
             command: Command type string
@@ -308,14 +415,17 @@ class UnrealConnection:
         
         for attempt in range(self.MAX_RETRIES + 1):
             try:
-                return self._send_command_once(command, params, attempt)
-            except (ConnectionError, TimeoutError, socket.error, OSError) as e:
+                future = self.send_command_async(command, params)
+                response = future.result(timeout=self._get_timeout_for_command(command))
+                logger.info(f"Command {command} completed")
+                return self._normalize_response(command, response)
+            except FutureTimeoutError:
+                logger.error(f"Timeout waiting for response to {command}")
+                return {"status": "error", "error": f"Timeout waiting for response to {command}"}
+            except (ConnectionError, OSError) as e:
                 last_error = str(e)
                 logger.warning(f"Command failed (attempt {attempt + 1}/{self.MAX_RETRIES + 1}): {e}")
                 
-                # Clean up and prepare for retry
-                self.disconnect()
-                
                 if attempt < self.MAX_RETRIES:
                     delay = min(self.BASE_RETRY_DELAY * (2 ** attempt), self.MAX_RETRY_DELAY)
                     logger.info(f"Retrying command in {delay:.1f}s...")
@@ -323,76 +433,71 @@ class UnrealConnection:
             except Exception as e:
                 # Unexpected error - don't retry
                 logger.error(f"Unexpected error sending command: {e}")
-                self.disconnect()
                 return {"status": "error", "error": str(e)}
         
         return {"status": "error", "error": f"Command failed after {self.MAX_RETRIES + 1} attempts: {last_error}"}
 
-    def _send_command_once(self, command: str, params: Dict[str, Any], attempt: int) -> Dict[str, Any]:
+    def send_commands(self, commands: List[tuple]) -> List[Dict[str, Any]]:
         """
-        Send command once (internal method).
+        Pipeline many commands over the connection and wait for all responses.
+        
+        Every command is sent before any response is awaited, so the editor runs
+        them back to back instead of paying a round trip per command.
         
         Args:
-            command: Command type
-            params: Command parameters
-            attempt: Current attempt number
+            commands: List of (command, params) tuples
             
         Returns:
-            Response dictionary
-            
-        Raises:
-            Various exceptions on failure
+            Response dictionaries in the same order as the commands
         """
-        # Hold lock for entire send-receive cycle to prevent race conditions
-        # where another thread could close/reconnect the socket mid-operation.
-        # RLock allows nested acquisition from connect()/disconnect() calls.
-        with self._lock:
-            # Connect (or reconnect)
-            if not self.connect():
-                raise ConnectionError(f"Failed to connect to Unreal Engine: {self._last_error}")
-            
+        futures = []
+        for command, params in commands:
             try:
-                # Build and send command
-                command_obj = {
-                    "type": command,
-                    "params": params or {}
-                }
-                command_json = json.dumps(command_obj)
-                
-                logger.info(f"Sending command (attempt {attempt + 1}): {command}")
-                logger.debug(f"Command payload: {command_json[:500]}...")
-                
-                # Send with timeout
-                self.socket.settimeout(10)  # 10 second send timeout
-                self.socket.sendall(command_json.encode('utf-8'))
-                
-                # Receive response
-                response_data = self._receive_response(command)
-                
-                # Parse response
-                try:
-                    response = json.loads(response_data.decode('utf-8'))
-                except json.JSONDecodeError as e:
-                    logger.error(f"JSON decode error: {e}")
-                    logger.debug(f"Raw response: {response_data[:500]}")
-                    raise ValueError(f"Invalid JSON response: {e}")
-                
-                logger.info(f"Command {command} completed successfully")
-                
-                # Normalize error responses
-                if response.get("status") == "error":
-                    error_msg = response.get("error") or response.get("message", "Unknown error")
-                    logger.warning(f"Unreal returned error: {error_msg}")
-                elif response.get("success") is False:
-                    error_msg = response.get("error") or response.get("message", "Unknown error")
-                    response = {"status": "error", "error": error_msg}
-                    logger.warning(f"Unreal returned failure: {error_msg}")
-                
-                return response
-                
-            finally:
-                # Always clean up connection after command
-                self._close_socket_unsafe()
+                futures.append((command, self.send_command_async(command, params)))
+            except ConnectionError as e:
+                futures.append((command, e))
+        
+        results = []
+        for command, future in futures:
+            if isinstance(future, Exception):
+                results.append({"status": "error", "error": str(future)})
+                continue
+            try:
+                response = future.result(timeout=self._get_timeout_for_command(command))
+                results.append(self._normalize_response(command, response))
+            except FutureTimeoutError:
+                results.append({"status": "error", "error": f"Timeout waiting for response to {command}"})
+            except Exception as e:
+                results.append({"status": "error", "error": str(e)})
+        return results
+
+    def send_batch(self, commands: List[tuple], stop_on_error: bool = False,
+                   description: str = None, defer_compile: bool = False) -> Dict[str, Any]:
+        """
+        Run many commands in a single game-thread task and one undo transaction.
+        
+        Unlike send_commands(), which still costs one editor task per command,
+        the whole list runs back to back inside Unreal.
+        
+        Args:
+            commands: List of (command, params) tuples
+            stop_on_error: Skip the remaining commands after the first failure
+            description: Undo history label for the batch
+            defer_compile: Compile each edited Blueprint once after the last command
+                instead of after every command; the report is under "compile"
+            
+        Returns:
+            Response whose result holds per-item "results" plus "succeeded"/"failed" counts
+        """
+        params = {
+            "commands": [{"type": command, "params": params or {}} for command, params in commands],
+            "stop_on_error": stop_on_error
+        }
+        if description:
+            params["description"] = description
+        if defer_compile:
+            params["defer_compile"] = True
+        return self.send_command("batch", params)
 
 # Global connection instance (singleton pattern)
 _unreal_connection: Optional[UnrealConnection] = None
@@ -446,30 +551,90 @@ mcp = FastMCP(
     lifespan=server_lifespan
 )
 
+@mcp.tool()
+def list_commands() -> Dict[str, Any]:
+    """List every command the editor accepts, with its parameters and whether it is read-only or batchable."""
+    unreal = get_unreal_connection()
+    if not unreal:
+        return {"success": False, "message": "Failed to connect to Unreal Engine"}
+    
+    try:
+        response = unreal.send_command("list_commands", {})
+        return response or {"success": False, "message": "No response from Unreal"}
+    except Exception as e:
+        logger.error(f"list_commands error: {e}")
+        return {"success": False, "message": str(e)}
+
+def _actor_query_params(name: str, label: str, class_name: str, tag: str,
+                        fields: Optional[List[str]], limit: int, cursor: str,
+                        include_total: bool = False) -> Dict[str, Any]:
+    """Build actor query parameters, leaving out unused filters so identical queries share a snapshot entry."""
+    params: Dict[str, Any] = {}
+    for key, value in (("name", name), ("label", label), ("class", class_name), ("tag", tag),
+                       ("cursor", cursor), ("limit", limit), ("include_total", include_total)):
+        if value:
+            params[key] = value
+    if fields:
+        params["fields"] = fields
+    return params
+
 # Essential Actor Management Tools
 @mcp.tool()
-def get_actors_in_level(random_string: str = "") -> Dict[str, Any]:
-    """Get a list of all actors in the current level."""
+def get_actors_in_level(
+    name: str = "",
+    label: str = "",
+    class_name: str = "",
+    tag: str = "",
+    fields: List[str] = None,
+    limit: int = 0,
+    cursor: str = "",
+    include_total: bool = False
+) -> Dict[str, Any]:
+    """
+    Get the actors in the current level, in name order.
+
+    Args:
+        name: Only actors whose name contains this text (case-insensitive)
+        label: Only actors whose editor label contains this text
+        class_name: Only actors of this exact class, e.g. "StaticMeshActor"
+        tag: Only actors with this tag
+        fields: Fields to return per actor, from name, label, class, path, location, rotation,
+                scale, tags (default: name, class, location, rotation, scale)
+        limit: Maximum number of actors to return (0 = all; 1000 when continuing from a cursor)
+        cursor: "next_cursor" from the previous page, to continue after it
+        include_total: Count every match even when name or label filters make that a full scan
+
+    Returns "total" matches (unless a name/label filter is used without include_total);
+    "next_cursor" is present while more remain.
+    """
     unreal = get_unreal_connection()
     if not unreal:
         return {"success": False, "message": "Failed to connect to Unreal Engine"}
     
     try:
-        response = unreal.send_command("get_actors_in_level", {})
+        response = unreal.send_command("get_actors_in_level", _actor_query_params(name, label, class_name, tag, fields, limit, cursor, include_total))
         return response or {"success": False, "message": "No response from Unreal"}
     except Exception as e:
         logger.error(f"get_actors_in_level error: {e}")
         return {"success": False, "message": str(e)}
 
 @mcp.tool()
-def find_actors_by_name(pattern: str) -> Dict[str, Any]:
-    """Find actors by name pattern."""
+def find_actors_by_name(
+    pattern: str,
+    fields: List[str] = None,
+    limit: int = 0,
+    cursor: str = "",
+    include_total: bool = False
+) -> Dict[str, Any]:
+    """Find actors whose name contains a pattern. Takes the same fields, limit, cursor and include_total as get_actors_in_level."""
     unreal = get_unreal_connection()
     if not unreal:
         return {"success": False, "message": "Failed to connect to Unreal Engine"}
     
     try:
-        response = unreal.send_command("find_actors_by_name", {"pattern": pattern})
+        params = _actor_query_params("", "", "", "", fields, limit, cursor, include_total)
+        params["pattern"] = pattern
+        response = unreal.send_command("find_actors_by_name", params)
         return response or {"success": False, "message": "No response from Unreal"}
     except Exception as e:
         logger.error(f"find_actors_by_name error: {e}")
@@ -519,6 +684,44 @@ def set_actor_transform(
         logger.error(f"set_actor_transform error: {e}")
         return {"success": False, "message": str(e)}
 
+@mcp.tool()
+def spawn_instanced_meshes(
+    name: str,
+    groups: List[Dict[str, Any]],
+    location: List[float] = None,
+    mode: str = "instanced"
+) -> Dict[str, Any]:
+    """
+    Spawn many static meshes in one command.
+    
+    Args:
+        name: Actor name (instanced mode) or name prefix for generated actor names (actors mode)
+        groups: List of {"static_mesh": path, "material": optional path,
+            "transforms": [{"location": [x, y, z], "rotation": [p, y, r], "scale": [x, y, z]}, ...],
+            "names": optional actor names for actors mode}
+        location: Origin of the instanced actor; transforms are always world space
+        mode: "instanced" for one actor with a hierarchical instanced mesh component per group,
+            "actors" for one StaticMeshActor per transform
+    
+    Returns:
+        Dictionary with per-group instance counts, "instance_count", "actors_spawned",
+        estimated "draw_calls" (and "draw_calls_as_actors" for comparison), "elapsed_ms"
+        and "instances_per_second"
+    """
+    unreal = get_unreal_connection()
+    if not unreal:
+        return {"success": False, "message": "Failed to connect to Unreal Engine"}
+    
+    try:
+        params = {"name": name, "groups": groups, "mode": mode}
+        if location is not None:
+            params["location"] = location
+        response = unreal.send_command("spawn_instanced_meshes", params)
+        return response or {"success": False, "message": "No response from Unreal"}
+    except Exception as e:
+        logger.error(f"spawn_instanced_meshes error: {e}")
+        return {"success": False, "message": str(e)}
+
 # Essential Blueprint Tools for Physics Actors
 @mcp.tool()
 def create_blueprint(name: str, parent_class: str) -> Dict[str, Any]:
@@ -638,6 +841,46 @@ def compile_blueprint(blueprint_name: str) -> Dict[str, Any]:
         logger.error(f"compile_blueprint error: {e}")
         return {"success": False, "message": str(e)}
 
+@mcp.tool()
+def begin_edit_session() -> Dict[str, Any]:
+    """
+    Start deferring Blueprint compiles.
+    
+    Until end_edit_session, graph and variable edits only record which Blueprints
+    need a refresh and a compile. Use it around long runs of node, pin and variable
+    edits; compile_blueprint still compiles at once. Sessions nest.
+    """
+    unreal = get_unreal_connection()
+    if not unreal:
+        return {"success": False, "message": "Failed to connect to Unreal Engine"}
+    
+    try:
+        response = unreal.send_command("begin_edit_session", {})
+        return response or {"success": False, "message": "No response from Unreal"}
+    except Exception as e:
+        logger.error(f"begin_edit_session error: {e}")
+        return {"success": False, "message": str(e)}
+
+@mcp.tool()
+def end_edit_session() -> Dict[str, Any]:
+    """
+    End an edit session, compiling each Blueprint it touched once.
+    
+    Returns:
+        Dictionary with "compiled" (per-Blueprint name, compile_ms, status, errors,
+        warnings, coalesced_requests), "count" and total "compile_ms"
+    """
+    unreal = get_unreal_connection()
+    if not unreal:
+        return {"success": False, "message": "Failed to connect to Unreal Engine"}
+    
+    try:
+        response = unreal.send_command("end_edit_session", {})
+        return response or {"success": False, "message": "No response from Unreal"}
+    except Exception as e:
+        logger.error(f"end_edit_session error: {e}")
+        return {"success": False, "message": str(e)}
+
 @mcp.tool()
 def read_blueprint_content(
     blueprint_path: str,
@@ -660,7 +903,9 @@ def read_blueprint_content(
         include_interfaces: Include implemented Blueprint interfaces
     
     Returns:
-        Dictionary containing complete Blueprint structure and content
+        Dictionary containing complete Blueprint structure and content; the event
+        graph and each function carry a "revision" for analyze_blueprint_graph's
+        since_revision
     """
     unreal = get_unreal_connection()
     if not unreal:
@@ -702,18 +947,28 @@ def analyze_blueprint_graph(
     graph_name: str = "EventGraph",
     include_node_details: bool = True,
     include_pin_connections: bool = True,
-    trace_execution_flow: bool = True
+    trace_execution_flow: bool = True,
+    since_revision: int = None
 ) -> Dict[str, Any]:
     """
     Analyze a specific graph within a Blueprint (EventGraph, functions, etc.)
     and provide detailed information about nodes, connections, and execution flow.
     
+    Every result carries the graph's "revision". To verify an edit without re-reading
+    the whole graph, pass the revision of an earlier read as since_revision: if
+    "incremental" is true, only "added_nodes", "modified_nodes" and "removed_nodes" are
+    returned, and "connections" holds the links of the added and modified nodes.
+    Update a cached copy by dropping every connection whose from_node is an added,
+    modified or removed node, then adding the returned ones. If "incremental" is
+    false, the full graph is returned as usual.
+    
     Args:
         blueprint_path: Full path to the Blueprint asset
         graph_name: Name of the graph to analyze ("EventGraph", function name, etc.)
         include_node_details: Include detailed node properties and settings
         include_pin_connections: Include all pin-to-pin connections
         trace_execution_flow: Trace the execution flow through the graph
+        since_revision: Revision from an earlier call; only report what changed since
     
     Returns:
         Dictionary with graph analysis including nodes, connections, and flow
@@ -730,6 +985,8 @@ def analyze_blueprint_graph(
             "include_pin_connections": include_pin_connections,
             "trace_execution_flow": trace_execution_flow
         }
+        if since_revision is not None:
+            params["since_revision"] = since_revision
         
         logger.info(f"Analyzing Blueprint graph: {blueprint_path} -> {graph_name}")
         response = unreal.send_command("analyze_blueprint_graph", params)
@@ -738,7 +995,13 @@ def analyze_blueprint_graph(
             graph_data = response.get("graph_data", {})
             logger.info(f"Graph analysis complete:")
             logger.info(f"  - Graph: {graph_data.get('graph_name', 'Unknown')}")
-            logger.info(f"  - Nodes: {len(graph_data.get('nodes', []))}")
+            if graph_data.get('incremental'):
+                logger.info(f"  - Changes since revision {graph_data.get('since_revision')}: "
+                            f"{len(graph_data.get('added_nodes', []))} added, "
+                            f"{len(graph_data.get('modified_nodes', []))} modified, "
+                            f"{len(graph_data.get('removed_nodes', []))} removed")
+            else:
+                logger.info(f"  - Nodes: {len(graph_data.get('nodes', []))}")
             logger.info(f"  - Connections: {len(graph_data.get('connections', []))}")
             if graph_data.get('execution_paths'):
                 logger.info(f"  - Execution paths: {len(graph_data['execution_paths'])}")
@@ -1090,16 +1353,29 @@ def construct_house(
     location: List[float] = [0.0, 0.0, 0.0],
     name_prefix: str = "House",
     mesh: str = "/Engine/BasicShapes/Cube.Cube",
-    house_style: str = "modern"  # "modern", "cottage"
+    house_style: str = "modern",  # "modern", "cottage"
+    instanced: bool = True
 ) -> Dict[str, Any]:
-    """Construct a realistic house with architectural details and multiple rooms."""
+    """
+    Construct a realistic house with architectural details and multiple rooms.
+    
+    With instanced (the default), the house is one actor with an instanced mesh
+    component per mesh; set it to False for one StaticMeshActor per part.
+    """
     try:
         unreal = get_unreal_connection()
         if not unreal:
             return {"success": False, "message": "Failed to connect to Unreal Engine"}
 
+        if not instanced:
+            return build_house(unreal, width, depth, height, location, name_prefix, mesh, house_style)
+
         # Use the helper function to build the house
-        return build_house(unreal, width, depth, height, location, name_prefix, mesh, house_style)
+        with CommandBatcher(unreal, description=f"Construct {name_prefix}", instance_name=name_prefix) as batch:
+            result = build_house(batch, width, depth, height, location, name_prefix, mesh, house_style)
+        if isinstance(result, dict):
+            result["batching"] = batch.summary()
+        return result
 
     except Exception as e:
         logger.error(f"construct_house error: {e}")
@@ -1111,11 +1387,15 @@ def construct_house(
 def construct_mansion(
     mansion_scale: str = "large",  # "small", "large", "epic", "legendary"
     location: List[float] = [0.0, 0.0, 0.0],
-    name_prefix: str = "Mansion"
+    name_prefix: str = "Mansion",
+    instanced: bool = True
 ) -> Dict[str, Any]:
     """
     Construct a magnificent mansion with multiple wings, grand rooms, gardens,
     fountains, and luxury features perfect for dramatic TikTok reveals.
+    
+    With instanced (the default), static meshes are merged into instanced mesh
+    components on one actor; set it to False for individual actors.
     """
     try:
         unreal = get_unreal_connection()
@@ -1129,16 +1409,19 @@ def construct_mansion(
         params = get_mansion_size_params(mansion_scale)
         layout = calculate_mansion_layout(params)
 
-        # Build mansion main structure
-        build_mansion_main_structure(unreal, name_prefix, location, layout, all_actors)
+        # Spawns are sent in batches instead of one round trip per actor
+        with CommandBatcher(unreal, description=f"Construct {name_prefix}",
+                            instance_name=name_prefix if instanced else None) as batch:
+            # Build mansion main structure
+            build_mansion_main_structure(batch, name_prefix, location, layout, all_actors)
 
-        # Build mansion exterior
-        build_mansion_exterior(unreal, name_prefix, location, layout, all_actors)
+            # Build mansion exterior
+            build_mansion_exterior(batch, name_prefix, location, layout, all_actors)
 
-        # Add luxurious interior
-        add_mansion_interior(unreal, name_prefix, location, layout, all_actors)
+            # Add luxurious interior
+            add_mansion_interior(batch, name_prefix, location, layout, all_actors)
 
-        logger.info(f"Mansion construction complete! Created {len(all_actors)} elements")
+        logger.info(f"Mansion construction complete! Created {batch.succeeded} elements in {batch.batches} batches")
 
         return {
             "success": True,
@@ -1153,7 +1436,8 @@ def construct_mansion(
                 "garden_size": layout["garden_size"],
                 "fountain_count": layout["fountain_count"],
                 "car_count": layout["car_count"],
-                "total_actors": len(all_actors)
+                "total_actors": len(all_actors),
+                "batching": batch.summary()
             }
         }
 
@@ -1370,9 +1654,25 @@ def create_maze(
 @mcp.tool()
 def get_available_materials(
     search_path: str = "/Game/",
-    include_engine_materials: bool = True
+    include_engine_materials: bool = True,
+    name_filter: str = "",
+    class_filter: str = "",
+    offset: int = 0,
+    limit: int = 1000
 ) -> Dict[str, Any]:
-    """Get a list of available materials in the project that can be applied to objects."""
+    """
+    Get a list of available materials in the project that can be applied to objects.
+
+    Args:
+        search_path: Content folder to list (default /Game/)
+        include_engine_materials: Also list materials under /Engine/
+        name_filter: Only materials whose name contains this text (case-insensitive)
+        class_filter: Only materials of this class, e.g. "Material" or "MaterialInstanceConstant"
+        offset: Index of the first material to return
+        limit: Maximum number of materials to return (0 = all)
+
+    Returns "total" matches; when more remain, pass "next_offset" as offset to get the next page.
+    """
     unreal = get_unreal_connection()
     if not unreal:
         return {"success": False, "message": "Failed to connect to Unreal Engine"}
@@ -1380,8 +1680,14 @@ def get_available_materials(
     try:
         params = {
             "search_path": search_path,
-            "include_engine_materials": include_engine_materials
+            "include_engine_materials": include_engine_materials,
+            "offset": offset,
+            "limit": limit
         }
+        if name_filter:
+            params["name_filter"] = name_filter
+        if class_filter:
+            params["class_filter"] = class_filter
         response = unreal.send_command("get_available_materials", params)
         return response or {"success": False, "message": "No response from Unreal"}
     except Exception as e:
@@ -1687,12 +1993,16 @@ def create_castle_fortress(
     name_prefix: str = "Castle",
     include_siege_weapons: bool = True,
     include_village: bool = True,
-    architectural_style: str = "medieval"  # "medieval", "fantasy", "gothic"
+    architectural_style: str = "medieval",  # "medieval", "fantasy", "gothic"
+    instanced: bool = True
 ) -> Dict[str, Any]:
     """
     Create a massive castle fortress with walls, towers, courtyards, throne room,
     and surrounding village. Perfect for dramatic TikTok reveals showing
     the scale and detail of a complete medieval fortress.
+    
+    With instanced (the default), static meshes are merged into instanced mesh
+    components on one actor; set it to False for individual actors.
     """
     try:
         unreal = get_unreal_connection()
@@ -1706,29 +2016,31 @@ def create_castle_fortress(
         params = get_castle_size_params(castle_size)
         dimensions = calculate_scaled_dimensions(params, scale_factor=2.0)
         
-        # Build castle components using helper functions
-        build_outer_bailey_walls(unreal, name_prefix, location, dimensions, all_actors)
-        build_inner_bailey_walls(unreal, name_prefix, location, dimensions, all_actors)
-        build_gate_complex(unreal, name_prefix, location, dimensions, all_actors)
-        build_corner_towers(unreal, name_prefix, location, dimensions, architectural_style, all_actors)
-        build_inner_corner_towers(unreal, name_prefix, location, dimensions, all_actors)
-        build_intermediate_towers(unreal, name_prefix, location, dimensions, all_actors)
-        build_central_keep(unreal, name_prefix, location, dimensions, all_actors)
-        build_courtyard_complex(unreal, name_prefix, location, dimensions, all_actors)
-        build_bailey_annexes(unreal, name_prefix, location, dimensions, all_actors)
-        
-        # Add optional components
-        if include_siege_weapons:
-            build_siege_weapons(unreal, name_prefix, location, dimensions, all_actors)
-        
-        if include_village:
-            build_village_settlement(unreal, name_prefix, location, dimensions, castle_size, all_actors)
-        
-        # Add final touches
-        build_drawbridge_and_moat(unreal, name_prefix, location, dimensions, all_actors)
-        add_decorative_flags(unreal, name_prefix, location, dimensions, all_actors)
+        # Build castle components using helper functions; spawns are sent in batches
+        with CommandBatcher(unreal, description=f"Create {name_prefix}",
+                            instance_name=name_prefix if instanced else None) as batch:
+            build_outer_bailey_walls(batch, name_prefix, location, dimensions, all_actors)
+            build_inner_bailey_walls(batch, name_prefix, location, dimensions, all_actors)
+            build_gate_complex(batch, name_prefix, location, dimensions, all_actors)
+            build_corner_towers(batch, name_prefix, location, dimensions, architectural_style, all_actors)
+            build_inner_corner_towers(batch, name_prefix, location, dimensions, all_actors)
+            build_intermediate_towers(batch, name_prefix, location, dimensions, all_actors)
+            build_central_keep(batch, name_prefix, location, dimensions, all_actors)
+            build_courtyard_complex(batch, name_prefix, location, dimensions, all_actors)
+            build_bailey_annexes(batch, name_prefix, location, dimensions, all_actors)
+            
+            # Add optional components
+            if include_siege_weapons:
+                build_siege_weapons(batch, name_prefix, location, dimensions, all_actors)
+            
+            if include_village:
+                build_village_settlement(batch, name_prefix, location, dimensions, castle_size, all_actors)
+            
+            # Add final touches
+            build_drawbridge_and_moat(batch, name_prefix, location, dimensions, all_actors)
+            add_decorative_flags(batch, name_prefix, location, dimensions, all_actors)
         
-        logger.info(f"Castle fortress creation complete! Created {len(all_actors)} actors")
+        logger.info(f"Castle fortress creation complete! Created {batch.succeeded} actors in {batch.batches} batches")
 
         
         return {
@@ -1742,7 +2054,8 @@ def create_castle_fortress(
                 "towers": dimensions["tower_count"],
                 "has_village": include_village,
                 "has_siege_weapons": include_siege_weapons,
-                "total_actors": len(all_actors)
+                "total_actors": len(all_actors),
+                "batching": batch.summary()
             }
         }
         
@@ -2007,6 +2320,204 @@ def create_aqueduct(
         return {"success": False, "message": str(e)}
 
 
+# ============================================================================
+# Native Structure Generators
+# ============================================================================
+# Placements are computed inside Unreal and emitted as instanced meshes on one
+# actor, so a structure costs one command instead of one per block.
+
+def _send_generator(command: str, params: Dict[str, Any]) -> Dict[str, Any]:
+    """Send a generator command, leaving out parameters that were not given."""
+    unreal = get_unreal_connection()
+    if not unreal:
+        return {"success": False, "message": "Failed to connect to Unreal Engine"}
+    
+    try:
+        response = unreal.send_command(command, {key: value for key, value in params.items() if value is not None})
+        return response or {"success": False, "message": "No response from Unreal"}
+    except Exception as e:
+        logger.error(f"{command} error: {e}")
+        return {"success": False, "message": str(e)}
+
+@mcp.tool()
+def generate_building(
+    name: str,
+    location: List[float] = [0.0, 0.0, 0.0],
+    rotation: List[float] = None,
+    width: float = 1200.0,
+    depth: float = 1000.0,
+    floors: int = 2,
+    floor_height: float = 300.0,
+    wall_style: str = "solid",
+    windows: bool = True,
+    window_density: float = 1.0,
+    roof: str = "flat",
+    seed: int = 0,
+    mesh: str = None,
+    material: str = None,
+    floor_material: str = None,
+    trim_material: str = None
+) -> Dict[str, Any]:
+    """
+    Generate a multi-storey building natively as one instanced actor.
+    
+    Args:
+        name: Actor name
+        location: Centre of the building's footprint at ground level
+        rotation: Optional [pitch, yaw, roll] of the whole building
+        width, depth: Footprint in cm
+        floors: Number of storeys
+        floor_height: Storey height in cm
+        wall_style: "solid" (slabs around the openings) or "brick" (running-bond courses)
+        windows: Cut windows into every wall; the ground floor front always gets a door
+        window_density: Share of window bays that are open (chosen by the seed)
+        roof: "flat" (slab and parapet) or "none"
+        seed: Random seed; the same parameters and seed give the same building
+        mesh: Block mesh (default the engine cube)
+        material, floor_material, trim_material: Optional materials for walls, floor slabs and parapet
+    
+    Returns:
+        Dictionary with the actor, per-component instance counts, "instance_count",
+        estimated "draw_calls", "placement_ms" and "elapsed_ms"
+    """
+    return _send_generator("generate_building", {
+        "name": name, "location": location, "rotation": rotation, "width": width, "depth": depth,
+        "floors": floors, "floor_height": floor_height, "wall_style": wall_style, "windows": windows,
+        "window_density": window_density, "roof": roof, "seed": seed, "mesh": mesh, "material": material,
+        "floor_material": floor_material, "trim_material": trim_material
+    })
+
+@mcp.tool()
+def generate_tower(
+    name: str,
+    location: List[float] = [0.0, 0.0, 0.0],
+    radius: float = 300.0,
+    levels: int = 12,
+    level_height: float = 100.0,
+    block_width: float = 100.0,
+    tower_style: str = "round",
+    twist: float = None,
+    taper: float = 0.0,
+    crenellations: bool = True,
+    seed: int = 0,
+    mesh: str = None,
+    material: str = None,
+    trim_material: str = None
+) -> Dict[str, Any]:
+    """
+    Generate a tower natively as one instanced actor.
+    
+    Args:
+        name: Actor name
+        location: Centre of the tower's base
+        radius: Outer radius (half the side for square towers) in cm
+        levels: Number of block courses
+        level_height: Course height in cm
+        block_width: Approximate block length in cm
+        tower_style: "round", "square" or "twisted"
+        twist: Degrees each course turns (default 5 for "twisted", else 0)
+        taper: Radius reduction at the top, 0 to 0.9
+        crenellations: Add a crenellated top course
+        seed: Random seed for window placement
+        mesh: Block mesh (default the engine cube)
+        material, trim_material: Optional materials for the walls and crenellations
+    
+    Returns:
+        Dictionary with the actor, instance counts, estimated "draw_calls" and timings
+    """
+    return _send_generator("generate_tower", {
+        "name": name, "location": location, "radius": radius, "levels": levels, "level_height": level_height,
+        "block_width": block_width, "tower_style": tower_style, "twist": twist, "taper": taper,
+        "crenellations": crenellations, "seed": seed, "mesh": mesh, "material": material,
+        "trim_material": trim_material
+    })
+
+@mcp.tool()
+def generate_wall(
+    name: str,
+    location: List[float] = [0.0, 0.0, 0.0],
+    rotation: List[float] = None,
+    length: float = 2000.0,
+    height: float = 400.0,
+    thickness: float = 60.0,
+    wall_style: str = "brick",
+    brick_size: List[float] = None,
+    crenellations: bool = True,
+    seed: int = 0,
+    jitter: float = 0.0,
+    mesh: str = None,
+    material: str = None
+) -> Dict[str, Any]:
+    """
+    Generate a straight curtain wall natively as one instanced actor.
+    
+    Args:
+        name: Actor name
+        location: Centre of the wall's base; the wall runs along X before rotation
+        rotation: Optional [pitch, yaw, roll]
+        length, height, thickness: Wall size in cm
+        wall_style: "brick" (running-bond courses) or "solid"
+        brick_size: [length, height] of a brick in cm (default [50, 25])
+        crenellations: Add merlons along the top
+        seed: Random seed for brick jitter
+        jitter: Maximum random offset of each brick from the wall plane, in cm
+        mesh: Block mesh (default the engine cube)
+        material: Optional material
+    
+    Returns:
+        Dictionary with the actor, instance counts, estimated "draw_calls" and timings
+    """
+    return _send_generator("generate_wall", {
+        "name": name, "location": location, "rotation": rotation, "length": length, "height": height,
+        "thickness": thickness, "wall_style": wall_style, "brick_size": brick_size,
+        "crenellations": crenellations, "seed": seed, "jitter": jitter, "mesh": mesh, "material": material
+    })
+
+@mcp.tool()
+def generate_aqueduct(
+    name: str,
+    location: List[float] = [0.0, 0.0, 0.0],
+    rotation: List[float] = None,
+    arches: int = 6,
+    tiers: int = 1,
+    span: float = 600.0,
+    pier_width: float = 150.0,
+    pier_height: float = 600.0,
+    thickness: float = 200.0,
+    arch_segments: int = 9,
+    channel: bool = True,
+    seed: int = 0,
+    mesh: str = None,
+    material: str = None
+) -> Dict[str, Any]:
+    """
+    Generate an arched aqueduct natively as one instanced actor.
+    
+    Args:
+        name: Actor name
+        location: Centre of the aqueduct's base; it runs along X before rotation
+        rotation: Optional [pitch, yaw, roll]
+        arches: Arches per tier
+        tiers: Stacked tiers of arches
+        span: Distance between pier starts in cm
+        pier_width, pier_height: Pier size in cm
+        thickness: Depth of piers, arches and deck in cm
+        arch_segments: Voussoirs per arch
+        channel: Add water channel walls on the top deck
+        seed: Random seed
+        mesh: Block mesh (default the engine cube)
+        material: Optional material
+    
+    Returns:
+        Dictionary with the actor, instance counts, estimated "draw_calls" and timings
+    """
+    return _send_generator("generate_aqueduct", {
+        "name": name, "location": location, "rotation": rotation, "arches": arches, "tiers": tiers,
+        "span": span, "pier_width": pier_width, "pier_height": pier_height, "thickness": thickness,
+        "arch_segments": arch_segments, "channel": channel, "seed": seed, "mesh": mesh, "material": material
+    })
+
+
 
 # ============================================================================
 # Blueprint Node Graph Tool
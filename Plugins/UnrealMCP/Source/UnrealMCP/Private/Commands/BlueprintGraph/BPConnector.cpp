@@ -1,12 +1,12 @@
 #include "Commands/BlueprintGraph/BPConnector.h"
 #include "Commands/EpicUnrealMCPCommonUtils.h"
+#include "Commands/EpicUnrealMCPEditSession.h"
+#include "Commands/BlueprintGraph/GraphNodeIndex.h"
 #include "Engine/Blueprint.h"
 #include "K2Node.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphPin.h"
 #include "EdGraphSchema_K2.h"
-#include "Kismet2/KismetEditorUtilities.h"
-#include "EditorAssetLibrary.h"
 
 TSharedPtr<FJsonObject> FBPConnector::ConnectNodes(const TSharedPtr<FJsonObject>& Params)
 {
@@ -23,34 +23,7 @@ TSharedPtr<FJsonObject> FBPConnector::ConnectNodes(const TSharedPtr<FJsonObject>
     Params->TryGetStringField(TEXT("function_name"), FunctionName);
 
     // Charger Blueprint - handle both full paths and simple names
-    UBlueprint* Blueprint = nullptr;
-    FString BlueprintPath = BlueprintName;
-
-    // If no path prefix, assume /Game/Blueprints/
-    if (!BlueprintPath.StartsWith(TEXT("/")))
-    {
-        BlueprintPath = TEXT("/Game/Blueprints/") + BlueprintPath;
-    }
-
-    // Add .Blueprint suffix if not present
-    if (!BlueprintPath.Contains(TEXT(".")))
-    {
-        BlueprintPath += TEXT(".") + FPaths::GetBaseFilename(BlueprintPath);
-    }
-
-    // Try to load the Blueprint
-    Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-
-    // If not found, try with UEditorAssetLibrary
-    if (!Blueprint)
-    {
-        FString AssetPath = BlueprintPath;
-        if (UEditorAssetLibrary::DoesAssetExist(AssetPath))
-        {
-            UObject* Asset = UEditorAssetLibrary::LoadAsset(AssetPath);
-            Blueprint = Cast<UBlueprint>(Asset);
-        }
-    }
+    UBlueprint* Blueprint = FEpicUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
 
     if (!Blueprint)
     {
@@ -150,7 +123,7 @@ TSharedPtr<FJsonObject> FBPConnector::ConnectNodes(const TSharedPtr<FJsonObject>
 
     // Recompile
     Blueprint->MarkPackageDirty();
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    FEpicUnrealMCPEditSession::RequestCompile(Blueprint);
 
     // Return
     Result->SetBoolField("success", true);
@@ -169,46 +142,13 @@ TSharedPtr<FJsonObject> FBPConnector::ConnectNodes(const TSharedPtr<FJsonObject>
 
 UK2Node* FBPConnector::FindNodeById(UEdGraph* Graph, const FString& NodeId)
 {
-    if (!Graph)
-    {
-        return nullptr;
-    }
-
-    for (UEdGraphNode* Node : Graph->Nodes)
-    {
-        if (!Node)
-        {
-            continue;
-        }
-
-        // Try matching by NodeGuid first
-        if (Node->NodeGuid.ToString().Equals(NodeId, ESearchCase::IgnoreCase))
-        {
-            UK2Node* K2Node = Cast<UK2Node>(Node);
-            return K2Node;  // Return even if nullptr (caller will handle)
-        }
-
-        // Try matching by GetName()
-        if (Node->GetName().Equals(NodeId, ESearchCase::IgnoreCase))
-        {
-            UK2Node* K2Node = Cast<UK2Node>(Node);
-            return K2Node;  // Return even if nullptr (caller will handle)
-        }
-    }
-
-    return nullptr;
+    // Return even if the node is not a K2 node (caller will handle)
+    return Cast<UK2Node>(FGraphNodeIndex::Get().FindNode(Graph, NodeId));
 }
 
 UEdGraphPin* FBPConnector::FindPinByName(UK2Node* Node, const FString& PinName, EEdGraphPinDirection Direction)
 {
-    for (UEdGraphPin* Pin : Node->Pins)
-    {
-        if (Pin->PinName.ToString() == PinName && Pin->Direction == Direction)
-        {
-            return Pin;
-        }
-    }
-    return nullptr;
+    return FGraphNodeIndex::Get().FindPin(Node, PinName, Direction);
 }
 
 bool FBPConnector::ArePinsCompatible(UEdGraphPin* SourcePin, UEdGraphPin* TargetPin)
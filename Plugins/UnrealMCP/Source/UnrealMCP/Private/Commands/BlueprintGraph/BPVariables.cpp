@@ -1,9 +1,9 @@
 #include "Commands/BlueprintGraph/BPVariables.h"
 #include "Commands/EpicUnrealMCPCommonUtils.h"
+#include "Commands/EpicUnrealMCPEditSession.h"
 #include "Engine/Blueprint.h"
 #include "EdGraphSchema_K2.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "Kismet2/KismetEditorUtilities.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "EditorSubsystem.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -74,7 +74,7 @@ TSharedPtr<FJsonObject> FBPVariables::CreateVariable(const TSharedPtr<FJsonObjec
             PropertyModule.NotifyCustomizationModuleChanged();
         }
 
-        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        FEpicUnrealMCPEditSession::RequestCompile(Blueprint);
 
         Result->SetBoolField("success", true);
 
@@ -383,7 +383,7 @@ TSharedPtr<FJsonObject> FBPVariables::SetVariableProperties(const TSharedPtr<FJs
         PropertyModule.NotifyCustomizationModuleChanged();
     }
 
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    FEpicUnrealMCPEditSession::RequestCompile(Blueprint);
 
     Result->SetBoolField("success", true);
     Result->SetStringField("variable_name", VariableName);
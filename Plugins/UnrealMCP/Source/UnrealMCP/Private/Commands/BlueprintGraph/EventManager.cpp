@@ -1,9 +1,9 @@
 #include "Commands/BlueprintGraph/EventManager.h"
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "K2Node_Event.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "EditorAssetLibrary.h"
 
 TSharedPtr<FJsonObject> FEventManager::AddEventNode(const TSharedPtr<FJsonObject>& Params)
 {
@@ -177,8 +177,8 @@ UK2Node_Event* FEventManager::CreateEventNode(UEdGraph* Graph, const FString& Ev
 	EventNode->NodePosY = static_cast<int32>(Position.Y);
 
 	// Add to graph and initialize
-	Graph->AddNode(EventNode, true, false);
 	EventNode->CreateNewGuid();
+	Graph->AddNode(EventNode, true, false);
 	EventNode->PostPlacedNewNode();
 	EventNode->AllocateDefaultPins();
 
@@ -248,36 +248,7 @@ UK2Node_Event* FEventManager::FindExistingEventNode(UEdGraph* Graph, const FStri
 
 UBlueprint* FEventManager::LoadBlueprint(const FString& BlueprintName)
 {
-	// Try direct path first
-	FString BlueprintPath = BlueprintName;
-
-	// If no path prefix, assume /Game/Blueprints/
-	if (!BlueprintPath.StartsWith(TEXT("/")))
-	{
-		BlueprintPath = TEXT("/Game/Blueprints/") + BlueprintPath;
-	}
-
-	// Add .Blueprint suffix if not present
-	if (!BlueprintPath.Contains(TEXT(".")))
-	{
-		BlueprintPath += TEXT(".") + FPaths::GetBaseFilename(BlueprintPath);
-	}
-
-	// Try to load the Blueprint
-	UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-
-	// If not found, try with UEditorAssetLibrary
-	if (!BP)
-	{
-		FString AssetPath = BlueprintPath;
-		if (UEditorAssetLibrary::DoesAssetExist(AssetPath))
-		{
-			UObject* Asset = UEditorAssetLibrary::LoadAsset(AssetPath);
-			BP = Cast<UBlueprint>(Asset);
-		}
-	}
-
-	return BP;
+	return FEpicUnrealMCPBlueprintResolver::Get().Resolve(BlueprintName);
 }
 
 TSharedPtr<FJsonObject> FEventManager::CreateSuccessResponse(const UK2Node_Event* EventNode)
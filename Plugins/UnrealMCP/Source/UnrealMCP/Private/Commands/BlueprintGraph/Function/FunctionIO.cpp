@@ -1,4 +1,5 @@
 #include "Commands/BlueprintGraph/Function/FunctionIO.h"
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraphSchema_K2.h"
@@ -7,7 +8,6 @@
 #include "K2Node_FunctionResult.h"
 #include "K2Node_FunctionEntry.h"
 #include "K2Node_CallFunction.h"
-#include "EditorAssetLibrary.h"
 #include "EdGraph/EdGraphNode.h"
 
 TSharedPtr<FJsonObject> FFunctionIO::AddFunctionIO(const TSharedPtr<FJsonObject>& Params)
@@ -286,20 +286,7 @@ bool FFunctionIO::AddFunctionParameter(
 
 UBlueprint* FFunctionIO::LoadBlueprint(const FString& BlueprintName)
 {
-	// Try direct load
-	UBlueprint* Blueprint = Cast<UBlueprint>(StaticLoadObject(UBlueprint::StaticClass(), nullptr, *BlueprintName));
-	if (Blueprint)
-	{
-		return Blueprint;
-	}
-
-	// Try EditorAssetLibrary
-	if (UEditorAssetLibrary::DoesAssetExist(BlueprintName))
-	{
-		return Cast<UBlueprint>(UEditorAssetLibrary::LoadAsset(BlueprintName));
-	}
-
-	return nullptr;
+	return FEpicUnrealMCPBlueprintResolver::Get().Resolve(BlueprintName);
 }
 
 FEdGraphPinType FFunctionIO::GetPropertyTypeFromString(const FString& TypeName)
@@ -1,9 +1,9 @@
 #include "Commands/BlueprintGraph/Function/FunctionManager.h"
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
+#include "Commands/EpicUnrealMCPEditSession.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "Kismet2/KismetEditorUtilities.h"
-#include "EditorAssetLibrary.h"
 #include "K2Node_FunctionEntry.h"
 #include "K2Node_FunctionResult.h"
 
@@ -122,7 +122,7 @@ TSharedPtr<FJsonObject> FFunctionManager::CreateFunction(const TSharedPtr<FJsonO
 	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
 	// Compile the Blueprint AFTER verifying nodes (like GenBlueprintUtils does)
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FEpicUnrealMCPEditSession::RequestCompile(Blueprint);
 
 	// Get the actual graph name that was created
 	FString ActualGraphName = NewGraph->GetFName().ToString();
@@ -266,29 +266,7 @@ TSharedPtr<FJsonObject> FFunctionManager::RenameFunction(const TSharedPtr<FJsonO
 
 UBlueprint* FFunctionManager::LoadBlueprint(const FString& BlueprintName)
 {
-	// Try direct load with _C suffix first (most reliable for Blueprint assets)
-	FString ClassPath = BlueprintName + TEXT("_C");
-	UClass* BlueprintClass = Cast<UClass>(StaticLoadObject(UClass::StaticClass(), nullptr, *ClassPath));
-	if (BlueprintClass)
-	{
-		// Get the Blueprint asset from the class
-		for (TObjectIterator<UBlueprint> It; It; ++It)
-		{
-			if (It->GetPathName().Contains(BlueprintName))
-			{
-				return *It;
-			}
-		}
-	}
-
-	// Try EditorAssetLibrary as fallback
-	if (UEditorAssetLibrary::DoesAssetExist(BlueprintName))
-	{
-		UObject* Asset = UEditorAssetLibrary::LoadAsset(BlueprintName);
-		return Cast<UBlueprint>(Asset);
-	}
-
-	return nullptr;
+	return FEpicUnrealMCPBlueprintResolver::Get().Resolve(BlueprintName);
 }
 
 bool FFunctionManager::ValidateFunctionName(const FString& FunctionName)
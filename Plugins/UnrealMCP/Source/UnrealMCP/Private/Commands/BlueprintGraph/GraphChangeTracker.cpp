@@ -0,0 +1,220 @@
+#include "Commands/BlueprintGraph/GraphChangeTracker.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Editor.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace GraphChangeTracker
+{
+	static TUniquePtr<FGraphChangeTracker> Instance;
+
+	/** Removed nodes kept beyond the live node count before the record is restarted */
+	static constexpr int32 MaxRemovedSlack = 256;
+}
+
+FGraphChangeTracker& FGraphChangeTracker::Get()
+{
+	check(IsInGameThread());
+
+	if (!GraphChangeTracker::Instance.IsValid())
+	{
+		GraphChangeTracker::Instance.Reset(new FGraphChangeTracker());
+	}
+
+	return *GraphChangeTracker::Instance;
+}
+
+void FGraphChangeTracker::Shutdown()
+{
+	GraphChangeTracker::Instance.Reset();
+}
+
+FGraphChangeTracker::FGraphChangeTracker()
+	: LastRevision(FDateTime::UtcNow().ToUnixTimestamp() * 1000)
+{
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FGraphChangeTracker::OnObjectModified);
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FGraphChangeTracker::OnUndoRedo);
+}
+
+FGraphChangeTracker::~FGraphChangeTracker()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	for (TPair<TWeakObjectPtr<UEdGraph>, FGraphEntry>& Pair : Graphs)
+	{
+		if (UEdGraph* Graph = Pair.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(Pair.Value.GraphChangedHandle);
+		}
+	}
+}
+
+FGraphChangeTracker::FGraphEntry& FGraphChangeTracker::GetEntry(UEdGraph* Graph)
+{
+	if (FGraphEntry* Existing = Graphs.Find(Graph))
+	{
+		return *Existing;
+	}
+
+	// Drop graphs that were destroyed since they were tracked
+	for (auto It = Graphs.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FGraphEntry& Entry = Graphs.Add(Graph);
+	Entry.Graph = Graph;
+	Entry.GraphChangedHandle = Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateRaw(this, &FGraphChangeTracker::OnGraphChanged));
+	Restart(Entry);
+	return Entry;
+}
+
+void FGraphChangeTracker::Restart(FGraphEntry& Entry)
+{
+	Entry.Nodes.Reset();
+	Entry.Revision = ++LastRevision;
+	Entry.BaseRevision = Entry.Revision;
+}
+
+FGraphChangeTracker::FNodeState& FGraphChangeTracker::Touch(FGraphEntry& Entry, const UEdGraphNode* Node)
+{
+	FNodeState& State = Entry.Nodes.FindOrAdd(const_cast<UEdGraphNode*>(Node));
+	State.NodeGuid = Node->NodeGuid;
+	State.Name = Node->GetName();
+
+	Entry.Revision = ++LastRevision;
+	State.ChangedRevision = Entry.Revision;
+	return State;
+}
+
+void FGraphChangeTracker::Compact(FGraphEntry& Entry)
+{
+	const UEdGraph* Graph = Entry.Graph.Get();
+	if (!Graph || Entry.Nodes.Num() <= Graph->Nodes.Num() + GraphChangeTracker::MaxRemovedSlack)
+	{
+		return;
+	}
+
+	Restart(Entry);
+}
+
+void FGraphChangeTracker::OnGraphChanged(const FEdGraphEditAction& Action)
+{
+	FGraphEntry* Entry = Graphs.Find(Action.Graph);
+	if (!Entry)
+	{
+		return;
+	}
+
+	// Other actions (selection, a bare NotifyGraphChanged) change no node that did not call Modify()
+	const bool bAdded = (Action.Action & GRAPHACTION_AddNode) != 0;
+	const bool bRemoved = (Action.Action & GRAPHACTION_RemoveNode) != 0;
+	if (!bAdded && !bRemoved)
+	{
+		return;
+	}
+
+	for (const UEdGraphNode* Node : Action.Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		FNodeState& State = Touch(*Entry, Node);
+		State.bRemoved = bRemoved;
+		if (bAdded)
+		{
+			State.AddedRevision = State.ChangedRevision;
+		}
+	}
+
+	if (bRemoved)
+	{
+		Compact(*Entry);
+	}
+}
+
+void FGraphChangeTracker::OnObjectModified(UObject* Object)
+{
+	// Called for every object the editor modifies, so untracked objects are rejected cheaply
+	if (Graphs.Num() == 0 || !IsInGameThread())
+	{
+		return;
+	}
+
+	const UEdGraphNode* Node = Cast<UEdGraphNode>(Object);
+	if (!Node)
+	{
+		return;
+	}
+
+	if (FGraphEntry* Entry = Graphs.Find(Node->GetGraph()))
+	{
+		Touch(*Entry, Node);
+	}
+}
+
+void FGraphChangeTracker::OnUndoRedo()
+{
+	for (TPair<TWeakObjectPtr<UEdGraph>, FGraphEntry>& Pair : Graphs)
+	{
+		Restart(Pair.Value);
+	}
+}
+
+int64 FGraphChangeTracker::GetRevision(UEdGraph* Graph)
+{
+	return Graph ? GetEntry(Graph).Revision : 0;
+}
+
+FGraphChanges FGraphChangeTracker::GetChangesSince(UEdGraph* Graph, int64 SinceRevision)
+{
+	FGraphChanges Changes;
+	if (!Graph)
+	{
+		return Changes;
+	}
+
+	FGraphEntry& Entry = GetEntry(Graph);
+	Changes.Revision = Entry.Revision;
+	Changes.bComplete = SinceRevision >= Entry.BaseRevision && SinceRevision <= Entry.Revision;
+	if (!Changes.bComplete)
+	{
+		return Changes;
+	}
+
+	for (const TPair<TWeakObjectPtr<UEdGraphNode>, FNodeState>& Pair : Entry.Nodes)
+	{
+		const FNodeState& State = Pair.Value;
+		if (State.ChangedRevision <= SinceRevision)
+		{
+			continue;
+		}
+
+		// Added after the token: new to the caller, or never seen by it if already removed again
+		const bool bNew = State.AddedRevision > SinceRevision;
+		UEdGraphNode* Node = Pair.Key.Get();
+		if (State.bRemoved || !Node || Node->GetGraph() != Graph)
+		{
+			if (!bNew)
+			{
+				Changes.Removed.Add({State.NodeGuid, State.Name});
+			}
+		}
+		else if (bNew)
+		{
+			Changes.Added.Add(Node);
+		}
+		else
+		{
+			Changes.Modified.Add(Node);
+		}
+	}
+
+	return Changes;
+}
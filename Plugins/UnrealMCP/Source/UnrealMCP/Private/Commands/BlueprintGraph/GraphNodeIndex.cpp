@@ -0,0 +1,337 @@
+#include "Commands/BlueprintGraph/GraphNodeIndex.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+
+namespace GraphNodeIndex
+{
+	static TUniquePtr<FGraphNodeIndex> Instance;
+
+	/** Added nodes remembered for re-keying before they are settled eagerly */
+	static constexpr int32 MaxAddedNodes = 256;
+}
+
+FGraphNodeIndex& FGraphNodeIndex::Get()
+{
+	check(IsInGameThread());
+
+	if (!GraphNodeIndex::Instance.IsValid())
+	{
+		GraphNodeIndex::Instance.Reset(new FGraphNodeIndex());
+	}
+
+	return *GraphNodeIndex::Instance;
+}
+
+void FGraphNodeIndex::Shutdown()
+{
+	GraphNodeIndex::Instance.Reset();
+}
+
+FGraphNodeIndex::~FGraphNodeIndex()
+{
+	for (TPair<TWeakObjectPtr<UEdGraph>, FGraphEntry>& Pair : Graphs)
+	{
+		if (UEdGraph* Graph = Pair.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(Pair.Value.GraphChangedHandle);
+		}
+	}
+}
+
+FGraphNodeIndex::FGraphEntry& FGraphNodeIndex::GetEntry(UEdGraph* Graph)
+{
+	if (FGraphEntry* Existing = Graphs.Find(Graph))
+	{
+		return *Existing;
+	}
+
+	// Drop graphs that were destroyed since they were indexed
+	for (auto It = Graphs.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FGraphEntry& Entry = Graphs.Add(Graph);
+	Entry.Graph = Graph;
+	Entry.GraphChangedHandle = Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateRaw(this, &FGraphNodeIndex::OnGraphChanged));
+	Rebuild(Entry);
+	return Entry;
+}
+
+void FGraphNodeIndex::Rebuild(FGraphEntry& Entry)
+{
+	Entry.ByGuid.Reset();
+	Entry.ByName.Reset();
+	Entry.Pins.Reset();
+	Entry.Added.Reset();
+	Entry.NodeCount = 0;
+
+	if (UEdGraph* Graph = Entry.Graph.Get())
+	{
+		Entry.NodeCount = Graph->Nodes.Num();
+		Entry.ByGuid.Reserve(Graph->Nodes.Num());
+		Entry.ByName.Reserve(Graph->Nodes.Num());
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			AddNode(Entry, Node);
+		}
+	}
+}
+
+void FGraphNodeIndex::AddNode(FGraphEntry& Entry, UEdGraphNode* Node)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	// The first node wins, as with the linear search this replaces
+	if (!Entry.ByGuid.Contains(Node->NodeGuid))
+	{
+		Entry.ByGuid.Add(Node->NodeGuid, Node);
+	}
+	if (!Entry.ByName.Contains(Node->GetFName()))
+	{
+		Entry.ByName.Add(Node->GetFName(), Node);
+	}
+}
+
+void FGraphNodeIndex::RemoveNode(FGraphEntry& Entry, UEdGraphNode* Node)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	if (const TWeakObjectPtr<UEdGraphNode>* Found = Entry.ByGuid.Find(Node->NodeGuid); Found && Found->Get() == Node)
+	{
+		Entry.ByGuid.Remove(Node->NodeGuid);
+	}
+	if (const TWeakObjectPtr<UEdGraphNode>* Found = Entry.ByName.Find(Node->GetFName()); Found && Found->Get() == Node)
+	{
+		Entry.ByName.Remove(Node->GetFName());
+	}
+	Entry.Pins.Remove(Node);
+}
+
+void FGraphNodeIndex::RekeyAddedNodes(FGraphEntry& Entry)
+{
+	for (const TPair<TWeakObjectPtr<UEdGraphNode>, FGuid>& Added : Entry.Added)
+	{
+		UEdGraphNode* Node = Added.Key.Get();
+		if (!Node || Node->NodeGuid == Added.Value)
+		{
+			continue;
+		}
+
+		if (const TWeakObjectPtr<UEdGraphNode>* Found = Entry.ByGuid.Find(Added.Value); Found && Found->Get() == Node)
+		{
+			Entry.ByGuid.Remove(Added.Value);
+		}
+		if (!Entry.ByGuid.Contains(Node->NodeGuid))
+		{
+			Entry.ByGuid.Add(Node->NodeGuid, Node);
+		}
+	}
+
+	// By the time a lookup misses, creators have assigned their GUIDs
+	Entry.Added.Reset();
+}
+
+void FGraphNodeIndex::IndexPins(FNodePins& NodePins, const UEdGraphNode* Node)
+{
+	NodePins.ByName.Reset();
+	for (int32 PinIndex = 0; PinIndex < Node->Pins.Num(); ++PinIndex)
+	{
+		if (const UEdGraphPin* Pin = Node->Pins[PinIndex])
+		{
+			NodePins.ByName.Add(Pin->PinName, PinIndex);
+		}
+	}
+}
+
+void FGraphNodeIndex::OnGraphChanged(const FEdGraphEditAction& Action)
+{
+	FGraphEntry* Entry = Graphs.Find(Action.Graph);
+	if (!Entry)
+	{
+		return;
+	}
+
+	const bool bAdded = (Action.Action & GRAPHACTION_AddNode) != 0;
+	const bool bRemoved = (Action.Action & GRAPHACTION_RemoveNode) != 0;
+	if (!bAdded && !bRemoved)
+	{
+		// A bare NotifyGraphChanged follows most edits; a lookup miss checks the node count instead
+		return;
+	}
+
+	for (const UEdGraphNode* Node : Action.Nodes)
+	{
+		UEdGraphNode* MutableNode = const_cast<UEdGraphNode*>(Node);
+		if (!MutableNode)
+		{
+			continue;
+		}
+
+		if (bRemoved)
+		{
+			RemoveNode(*Entry, MutableNode);
+			--Entry->NodeCount;
+		}
+		else
+		{
+			AddNode(*Entry, MutableNode);
+			Entry->Added.Emplace(MutableNode, MutableNode->NodeGuid);
+			++Entry->NodeCount;
+		}
+	}
+}
+
+UEdGraphNode* FGraphNodeIndex::FindNode(UEdGraph* Graph, const FString& NodeID)
+{
+	if (!Graph || NodeID.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	FGraphEntry& Entry = GetEntry(Graph);
+
+	// Keep the list short when lookups keep hitting by name
+	if (Entry.Added.Num() >= GraphNodeIndex::MaxAddedNodes)
+	{
+		RekeyAddedNodes(Entry);
+	}
+
+	FGuid Guid;
+	const bool bIsGuid = FGuid::Parse(NodeID, Guid);
+	const FName Name(*NodeID, FNAME_Find);
+
+	// Hits are checked against the live graph, so a stale entry is never returned. A removed
+	// node keeps the graph as its outer, so membership in Graph->Nodes is what proves it live
+	bool bStale = false;
+	auto IsLive = [Graph, &bStale](UEdGraphNode* Node) -> bool
+	{
+		if (Node && Node->GetGraph() == Graph && Graph->Nodes.Contains(Node))
+		{
+			return true;
+		}
+		bStale = true;
+		return false;
+	};
+
+	auto Lookup = [&Entry, &IsLive, bIsGuid, &Guid, &Name]() -> UEdGraphNode*
+	{
+		if (bIsGuid)
+		{
+			if (const TWeakObjectPtr<UEdGraphNode>* Found = Entry.ByGuid.Find(Guid))
+			{
+				UEdGraphNode* Node = Found->Get();
+				if (IsLive(Node) && Node->NodeGuid == Guid)
+				{
+					return Node;
+				}
+			}
+		}
+		if (!Name.IsNone())
+		{
+			if (const TWeakObjectPtr<UEdGraphNode>* Found = Entry.ByName.Find(Name))
+			{
+				UEdGraphNode* Node = Found->Get();
+				if (IsLive(Node) && Node->GetFName() == Name)
+				{
+					return Node;
+				}
+			}
+		}
+		return nullptr;
+	};
+
+	if (UEdGraphNode* Node = Lookup())
+	{
+		return Node;
+	}
+
+	// New nodes may have been indexed before their GUID was assigned
+	if (bIsGuid && Entry.Added.Num() > 0)
+	{
+		RekeyAddedNodes(Entry);
+		if (UEdGraphNode* Node = Lookup())
+		{
+			return Node;
+		}
+	}
+
+	// A stale hit or a node count that no longer adds up shows an edit without notification (an
+	// add and a remove can leave the count unchanged); an ID that matches nothing does not
+	// re-index the graph
+	if (bStale || Graph->Nodes.Num() != Entry.NodeCount)
+	{
+		Rebuild(Entry);
+		return Lookup();
+	}
+
+	return nullptr;
+}
+
+UEdGraphPin* FGraphNodeIndex::FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction)
+{
+	if (!Node)
+	{
+		return nullptr;
+	}
+
+	// Pin names are FNames, so a name that was never created matches no pin
+	const FName Name(*PinName, FNAME_Find);
+	if (Name.IsNone())
+	{
+		return nullptr;
+	}
+
+	UEdGraph* Graph = Node->GetGraph();
+	if (!Graph)
+	{
+		return Node->FindPin(Name, Direction);
+	}
+
+	FGraphEntry& Entry = GetEntry(Graph);
+	FNodePins* NodePins = Entry.Pins.Find(Node);
+	bool bFreshlyIndexed = false;
+	if (!NodePins)
+	{
+		NodePins = &Entry.Pins.Add(Node);
+		IndexPins(*NodePins, Node);
+		bFreshlyIndexed = true;
+	}
+
+	// Indices are checked against the live pins: reconstructing a node replaces them
+	auto Lookup = [NodePins, Node, &Name, Direction]() -> UEdGraphPin*
+	{
+		TArray<int32, TInlineAllocator<2>> PinIndices;
+		NodePins->ByName.MultiFind(Name, PinIndices);
+		for (const int32 PinIndex : PinIndices)
+		{
+			UEdGraphPin* Pin = Node->Pins.IsValidIndex(PinIndex) ? Node->Pins[PinIndex] : nullptr;
+			if (Pin && Pin->PinName == Name && (Direction == EGPD_MAX || Pin->Direction == Direction))
+			{
+				return Pin;
+			}
+		}
+		return nullptr;
+	};
+
+	if (UEdGraphPin* Pin = Lookup())
+	{
+		return Pin;
+	}
+	if (bFreshlyIndexed)
+	{
+		return nullptr;
+	}
+
+	IndexPins(*NodePins, Node);
+	return Lookup();
+}
@@ -1,9 +1,10 @@
 #include "Commands/BlueprintGraph/NodeDeleter.h"
+#include "Commands/BlueprintGraph/GraphNodeIndex.h"
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "EditorAssetLibrary.h"
 
 TSharedPtr<FJsonObject> FNodeDeleter::DeleteNode(const TSharedPtr<FJsonObject>& Params)
 {
@@ -107,32 +108,7 @@ UEdGraph* FNodeDeleter::GetGraph(UBlueprint* Blueprint, const FString& FunctionN
 
 UEdGraphNode* FNodeDeleter::FindNodeByID(UEdGraph* Graph, const FString& NodeID)
 {
-	if (!Graph)
-	{
-		return nullptr;
-	}
-
-	for (UEdGraphNode* Node : Graph->Nodes)
-	{
-		if (!Node)
-		{
-			continue;
-		}
-
-		// Try matching by NodeGuid
-		if (Node->NodeGuid.ToString().Equals(NodeID, ESearchCase::IgnoreCase))
-		{
-			return Node;
-		}
-
-		// Try matching by GetName()
-		if (Node->GetName().Equals(NodeID, ESearchCase::IgnoreCase))
-		{
-			return Node;
-		}
-	}
-
-	return nullptr;
+	return FGraphNodeIndex::Get().FindNode(Graph, NodeID);
 }
 
 bool FNodeDeleter::RemoveNode(UEdGraph* Graph, UEdGraphNode* Node)
@@ -153,36 +129,7 @@ bool FNodeDeleter::RemoveNode(UEdGraph* Graph, UEdGraphNode* Node)
 
 UBlueprint* FNodeDeleter::LoadBlueprint(const FString& BlueprintName)
 {
-	// Try direct path first
-	FString BlueprintPath = BlueprintName;
-
-	// If no path prefix, assume /Game/Blueprints/
-	if (!BlueprintPath.StartsWith(TEXT("/")))
-	{
-		BlueprintPath = TEXT("/Game/Blueprints/") + BlueprintName;
-	}
-
-	// Add .Blueprint suffix if not present
-	if (!BlueprintPath.Contains(TEXT(".")))
-	{
-		BlueprintPath += TEXT(".") + FPaths::GetBaseFilename(BlueprintPath);
-	}
-
-	// Try to load the Blueprint
-	UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-
-	// If not found, try with UEditorAssetLibrary
-	if (!BP)
-	{
-		FString AssetPath = BlueprintPath;
-		if (UEditorAssetLibrary::DoesAssetExist(AssetPath))
-		{
-			UObject* Asset = UEditorAssetLibrary::LoadAsset(AssetPath);
-			BP = Cast<UBlueprint>(Asset);
-		}
-	}
-
-	return BP;
+	return FEpicUnrealMCPBlueprintResolver::Get().Resolve(BlueprintName);
 }
 
 TSharedPtr<FJsonObject> FNodeDeleter::CreateSuccessResponse(const FString& DeletedNodeID)
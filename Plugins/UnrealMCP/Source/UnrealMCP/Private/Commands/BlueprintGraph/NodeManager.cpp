@@ -1,4 +1,5 @@
 #include "Commands/BlueprintGraph/NodeManager.h"
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
 #include "Commands/BlueprintGraph/Nodes/ControlFlowNodes.h"
 #include "Commands/BlueprintGraph/Nodes/DataNodes.h"
 #include "Commands/BlueprintGraph/Nodes/UtilityNodes.h"
@@ -18,7 +19,6 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "KismetCompiler.h"
-#include "EditorAssetLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
 
@@ -438,36 +438,7 @@ UK2Node* FBlueprintNodeManager::CreateVariableSetNode(UEdGraph* Graph, const TSh
 
 UBlueprint* FBlueprintNodeManager::LoadBlueprint(const FString& BlueprintName)
 {
-	// Try direct path first
-	FString BlueprintPath = BlueprintName;
-
-	// If no path prefix, assume /Game/Blueprints/
-	if (!BlueprintPath.StartsWith(TEXT("/")))
-	{
-		BlueprintPath = TEXT("/Game/Blueprints/") + BlueprintPath;
-	}
-
-	// Add .Blueprint suffix if not present
-	if (!BlueprintPath.Contains(TEXT(".")))
-	{
-		BlueprintPath += TEXT(".") + FPaths::GetBaseFilename(BlueprintPath);
-	}
-
-	// Try to load the Blueprint
-	UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-
-	// If not found, try with UEditorAssetLibrary
-	if (!BP)
-	{
-		FString AssetPath = BlueprintPath;
-		if (UEditorAssetLibrary::DoesAssetExist(AssetPath))
-		{
-			UObject* Asset = UEditorAssetLibrary::LoadAsset(AssetPath);
-			BP = Cast<UBlueprint>(Asset);
-		}
-	}
-
-	return BP;
+	return FEpicUnrealMCPBlueprintResolver::Get().Resolve(BlueprintName);
 }
 
 UK2Node* FBlueprintNodeManager::CreateCallFunctionNode(UEdGraph* Graph, const TSharedPtr<FJsonObject>& Params)
@@ -543,8 +514,8 @@ UK2Node* FBlueprintNodeManager::CreateComparisonNode(UEdGraph* Graph, const TSha
 	ComparisonNode->NodePosY = static_cast<int32>(PosY);
 
 	// Add to graph and initialize pins
-	Graph->AddNode(ComparisonNode, false, false);
 	ComparisonNode->CreateNewGuid();
+	Graph->AddNode(ComparisonNode, false, false);
 	ComparisonNode->PostPlacedNewNode();
 	ComparisonNode->AllocateDefaultPins();
 
@@ -627,8 +598,8 @@ UK2Node* FBlueprintNodeManager::CreateBranchNode(UEdGraph* Graph, const TSharedP
 	BranchNode->NodePosY = static_cast<int32>(PosY);
 
 	// Add to graph and initialize pins
-	Graph->AddNode(BranchNode, false, false);
 	BranchNode->CreateNewGuid();
+	Graph->AddNode(BranchNode, false, false);
 	BranchNode->PostPlacedNewNode();
 	BranchNode->AllocateDefaultPins();
 	return BranchNode;
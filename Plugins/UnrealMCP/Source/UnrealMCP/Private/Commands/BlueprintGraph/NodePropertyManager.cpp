@@ -1,4 +1,6 @@
 #include "Commands/BlueprintGraph/NodePropertyManager.h"
+#include "Commands/BlueprintGraph/GraphNodeIndex.h"
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
 #include "Commands/BlueprintGraph/Nodes/SwitchEnumEditor.h"
 #include "Commands/BlueprintGraph/Nodes/ExecutionSequenceEditor.h"
 #include "Commands/BlueprintGraph/Nodes/MakeArrayEditor.h"
@@ -23,7 +25,6 @@
 #include "K2Node_Event.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet/KismetSystemLibrary.h"
-#include "EditorAssetLibrary.h"
 #include "Json.h"
 
 TSharedPtr<FJsonObject> FNodePropertyManager::SetNodeProperty(const TSharedPtr<FJsonObject>& Params)
@@ -114,6 +115,9 @@ TSharedPtr<FJsonObject> FNodePropertyManager::SetNodeProperty(const TSharedPtr<F
 		return CreateErrorResponse(FString::Printf(TEXT("Node not found: %s"), *NodeID));
 	}
 
+	// Record the node for undo and change tracking before any setter touches it
+	Node->Modify();
+
 	// Attempt to set property based on node type
 	bool Success = false;
 
@@ -506,66 +510,12 @@ UEdGraph* FNodePropertyManager::GetGraph(UBlueprint* Blueprint, const FString& F
 
 UEdGraphNode* FNodePropertyManager::FindNodeByID(UEdGraph* Graph, const FString& NodeID)
 {
-	if (!Graph)
-	{
-		return nullptr;
-	}
-
-	for (UEdGraphNode* Node : Graph->Nodes)
-	{
-		if (!Node)
-		{
-			continue;
-		}
-
-		// Try matching by NodeGuid
-		if (Node->NodeGuid.ToString().Equals(NodeID, ESearchCase::IgnoreCase))
-		{
-			return Node;
-		}
-
-		// Try matching by GetName()
-		if (Node->GetName().Equals(NodeID, ESearchCase::IgnoreCase))
-		{
-			return Node;
-		}
-	}
-
-	return nullptr;
+	return FGraphNodeIndex::Get().FindNode(Graph, NodeID);
 }
 
 UBlueprint* FNodePropertyManager::LoadBlueprint(const FString& BlueprintName)
 {
-	// Try direct path first
-	FString BlueprintPath = BlueprintName;
-
-	// If no path prefix, assume /Game/Blueprints/
-	if (!BlueprintPath.StartsWith(TEXT("/")))
-	{
-		BlueprintPath = TEXT("/Game/Blueprints/") + BlueprintName;
-	}
-
-	// Add .Blueprint suffix if not present
-	if (!BlueprintPath.Contains(TEXT(".")))
-	{
-		BlueprintPath += TEXT(".") + FPaths::GetBaseFilename(BlueprintPath);
-	}
-
-	// Try to load the Blueprint
-	UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-
-	// If not found, try with UEditorAssetLibrary
-	if (!BP)
-	{
-		FString AssetPath = BlueprintPath;
-		if (UEditorAssetLibrary::DoesAssetExist(AssetPath))
-		{
-			UObject* Asset = UEditorAssetLibrary::LoadAsset(AssetPath);
-			BP = Cast<UBlueprint>(Asset);
-		}
-	}
-
-	return BP;
+	return FEpicUnrealMCPBlueprintResolver::Get().Resolve(BlueprintName);
 }
 
 TSharedPtr<FJsonObject> FNodePropertyManager::CreateSuccessResponse(const FString& PropertyName)
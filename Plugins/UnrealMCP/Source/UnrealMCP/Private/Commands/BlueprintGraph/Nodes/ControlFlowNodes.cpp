@@ -31,8 +31,8 @@ UK2Node* FControlFlowNodeCreator::CreateBranchNode(UEdGraph* Graph, const TShare
 	BranchNode->NodePosY = static_cast<int32>(PosY);
 
 	// Add to graph
-	Graph->AddNode(BranchNode, false, false);
 	BranchNode->CreateNewGuid();
+	Graph->AddNode(BranchNode, false, false);
 	BranchNode->PostPlacedNewNode();
 
 	// Initialize the node (AllocateDefaultPins + ReconstructNode + NotifyGraphChanged)
@@ -64,8 +64,8 @@ UK2Node* FControlFlowNodeCreator::CreateComparisonNode(UEdGraph* Graph, const TS
 	ComparisonNode->NodePosY = static_cast<int32>(PosY);
 
 	// Add to graph
-	Graph->AddNode(ComparisonNode, false, false);
 	ComparisonNode->CreateNewGuid();
+	Graph->AddNode(ComparisonNode, false, false);
 	ComparisonNode->PostPlacedNewNode();
 
 	// Initialize the node FIRST
@@ -146,8 +146,8 @@ UK2Node* FControlFlowNodeCreator::CreateSwitchNode(UEdGraph* Graph, const TShare
 	SwitchNode->NodePosX = static_cast<int32>(PosX);
 	SwitchNode->NodePosY = static_cast<int32>(PosY);
 
-	Graph->AddNode(SwitchNode, false, false);
 	SwitchNode->CreateNewGuid();
+	Graph->AddNode(SwitchNode, false, false);
 	SwitchNode->PostPlacedNewNode();
 	FNodeCreatorUtils::InitializeK2Node(SwitchNode, Graph);
 
@@ -173,8 +173,8 @@ UK2Node* FControlFlowNodeCreator::CreateSwitchEnumNode(UEdGraph* Graph, const TS
 	SwitchEnumNode->NodePosX = static_cast<int32>(PosX);
 	SwitchEnumNode->NodePosY = static_cast<int32>(PosY);
 
-	Graph->AddNode(SwitchEnumNode, false, false);
 	SwitchEnumNode->CreateNewGuid();
+	Graph->AddNode(SwitchEnumNode, false, false);
 	SwitchEnumNode->PostPlacedNewNode();
 	FNodeCreatorUtils::InitializeK2Node(SwitchEnumNode, Graph);
 
@@ -200,8 +200,8 @@ UK2Node* FControlFlowNodeCreator::CreateSwitchIntegerNode(UEdGraph* Graph, const
 	SwitchIntNode->NodePosX = static_cast<int32>(PosX);
 	SwitchIntNode->NodePosY = static_cast<int32>(PosY);
 
-	Graph->AddNode(SwitchIntNode, false, false);
 	SwitchIntNode->CreateNewGuid();
+	Graph->AddNode(SwitchIntNode, false, false);
 	SwitchIntNode->PostPlacedNewNode();
 	FNodeCreatorUtils::InitializeK2Node(SwitchIntNode, Graph);
 
@@ -227,8 +227,8 @@ UK2Node* FControlFlowNodeCreator::CreateSwitchByteNode(UEdGraph* Graph, const TS
 	SwitchByteNode->NodePosX = static_cast<int32>(PosX);
 	SwitchByteNode->NodePosY = static_cast<int32>(PosY);
 
-	Graph->AddNode(SwitchByteNode, false, false);
 	SwitchByteNode->CreateNewGuid();
+	Graph->AddNode(SwitchByteNode, false, false);
 	SwitchByteNode->PostPlacedNewNode();
 	FNodeCreatorUtils::InitializeK2Node(SwitchByteNode, Graph);
 
@@ -254,8 +254,8 @@ UK2Node* FControlFlowNodeCreator::CreateExecutionSequenceNode(UEdGraph* Graph, c
 	SeqNode->NodePosX = static_cast<int32>(PosX);
 	SeqNode->NodePosY = static_cast<int32>(PosY);
 
-	Graph->AddNode(SeqNode, false, false);
 	SeqNode->CreateNewGuid();
+	Graph->AddNode(SeqNode, false, false);
 	SeqNode->PostPlacedNewNode();
 	FNodeCreatorUtils::InitializeK2Node(SeqNode, Graph);
 
@@ -0,0 +1,450 @@
+#include "Commands/EpicUnrealMCPActorIndex.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace MCPActorIndex
+{
+    /** Page size when a request continues from a cursor without giving a limit */
+    static constexpr int32 DefaultLimit = 1000;
+
+    /** Fields a result can carry */
+    static constexpr uint8 FieldName = 1 << 0;
+    static constexpr uint8 FieldLabel = 1 << 1;
+    static constexpr uint8 FieldClass = 1 << 2;
+    static constexpr uint8 FieldPath = 1 << 3;
+    static constexpr uint8 FieldLocation = 1 << 4;
+    static constexpr uint8 FieldRotation = 1 << 5;
+    static constexpr uint8 FieldScale = 1 << 6;
+    static constexpr uint8 FieldTags = 1 << 7;
+
+    /** Same fields as FEpicUnrealMCPCommonUtils::ActorToJson */
+    static constexpr uint8 DefaultFields = FieldName | FieldClass | FieldLocation | FieldRotation | FieldScale;
+
+    static uint8 ParseFields(const TSharedPtr<FJsonObject>& Params)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* FieldArray = nullptr;
+        if (!Params->TryGetArrayField(TEXT("fields"), FieldArray))
+        {
+            return DefaultFields;
+        }
+
+        static const TPair<const TCHAR*, uint8> FieldNames[] = {
+            {TEXT("name"), FieldName},
+            {TEXT("label"), FieldLabel},
+            {TEXT("class"), FieldClass},
+            {TEXT("path"), FieldPath},
+            {TEXT("location"), FieldLocation},
+            {TEXT("rotation"), FieldRotation},
+            {TEXT("scale"), FieldScale},
+            {TEXT("tags"), FieldTags}
+        };
+
+        // Results are always identified by name
+        uint8 Fields = FieldName;
+        for (const TSharedPtr<FJsonValue>& Value : *FieldArray)
+        {
+            const FString Field = Value->AsString();
+            for (const TPair<const TCHAR*, uint8>& Known : FieldNames)
+            {
+                if (Field == Known.Key)
+                {
+                    Fields |= Known.Value;
+                }
+            }
+        }
+
+        return Fields;
+    }
+
+    static TArray<TSharedPtr<FJsonValue>> ToJsonArray(double X, double Y, double Z)
+    {
+        TArray<TSharedPtr<FJsonValue>> Array;
+        Array.Add(MakeShared<FJsonValueNumber>(X));
+        Array.Add(MakeShared<FJsonValueNumber>(Y));
+        Array.Add(MakeShared<FJsonValueNumber>(Z));
+        return Array;
+    }
+}
+
+FEpicUnrealMCPActorIndex::FEpicUnrealMCPActorIndex()
+{
+}
+
+FEpicUnrealMCPActorIndex::~FEpicUnrealMCPActorIndex()
+{
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+    }
+
+    FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+    FCoreUObjectDelegates::OnObjectRenamed.Remove(ObjectRenamedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+    FEditorDelegates::MapChange.Remove(MapChangeHandle);
+}
+
+void FEpicUnrealMCPActorIndex::EnsureBuilt()
+{
+    // Same world the commands listed before the index existed: the PIE world while it is current
+    UWorld* World = GWorld;
+    if (bBuilt && IndexedWorld.Get() == World)
+    {
+        return;
+    }
+
+    Entries.Reset();
+    ByClass.Reset();
+    ByTag.Reset();
+    SortedKeys.Reset();
+    bSortedKeysDirty = true;
+    IndexedWorld = World;
+
+    if (!World)
+    {
+        return;
+    }
+
+    if (!ActorAddedHandle.IsValid())
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FEpicUnrealMCPActorIndex::OnActorAdded);
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FEpicUnrealMCPActorIndex::OnActorDeleted);
+        ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddRaw(this, &FEpicUnrealMCPActorIndex::MarkDirty);
+        ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FEpicUnrealMCPActorIndex::OnActorLabelChanged);
+        ObjectRenamedHandle = FCoreUObjectDelegates::OnObjectRenamed.AddRaw(this, &FEpicUnrealMCPActorIndex::OnObjectRenamed);
+        PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FEpicUnrealMCPActorIndex::OnObjectPropertyChanged);
+        MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32) { MarkDirty(); });
+    }
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AddActor(*It);
+    }
+
+    bBuilt = true;
+    UE_LOG(LogTemp, Log, TEXT("ActorIndex: Indexed %d actors"), Entries.Num());
+}
+
+void FEpicUnrealMCPActorIndex::MarkDirty()
+{
+    bBuilt = false;
+}
+
+bool FEpicUnrealMCPActorIndex::IsIndexed(const AActor* Actor) const
+{
+    return bBuilt && Actor && Actor->GetWorld() == IndexedWorld.Get();
+}
+
+void FEpicUnrealMCPActorIndex::AddActor(AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    const TObjectKey<AActor> Key(Actor);
+    RemoveActor(Key);
+
+    FActorEntry& Entry = Entries.Add(Key);
+    Entry.Actor = Actor;
+    Entry.Name = Actor->GetName();
+    Entry.Path = Actor->GetPathName();
+    Entry.Label = Actor->GetActorLabel();
+    Entry.Class = Actor->GetClass()->GetFName();
+    Entry.Tags = Actor->Tags;
+
+    ByClass.FindOrAdd(Entry.Class).Add(Key);
+    for (const FName& Tag : Entry.Tags)
+    {
+        ByTag.FindOrAdd(Tag).Add(Key);
+    }
+
+    bSortedKeysDirty = true;
+}
+
+void FEpicUnrealMCPActorIndex::RemoveActor(TObjectKey<AActor> Key)
+{
+    FActorEntry Entry;
+    if (!Entries.RemoveAndCopyValue(Key, Entry))
+    {
+        return;
+    }
+
+    if (TSet<TObjectKey<AActor>>* ClassSet = ByClass.Find(Entry.Class))
+    {
+        ClassSet->Remove(Key);
+    }
+    for (const FName& Tag : Entry.Tags)
+    {
+        if (TSet<TObjectKey<AActor>>* TagSet = ByTag.Find(Tag))
+        {
+            TagSet->Remove(Key);
+        }
+    }
+
+    bSortedKeysDirty = true;
+}
+
+void FEpicUnrealMCPActorIndex::PruneStale()
+{
+    TArray<TObjectKey<AActor>> Stale;
+    for (const TPair<TObjectKey<AActor>, FActorEntry>& Pair : Entries)
+    {
+        if (!Pair.Value.Actor.IsValid())
+        {
+            Stale.Add(Pair.Key);
+        }
+    }
+
+    for (const TObjectKey<AActor>& Key : Stale)
+    {
+        RemoveActor(Key);
+    }
+}
+
+void FEpicUnrealMCPActorIndex::RefreshActor(AActor* Actor)
+{
+    const FActorEntry* Entry = Entries.Find(Actor);
+    if (Entry && (Entry->Label != Actor->GetActorLabel() || Entry->Tags != Actor->Tags))
+    {
+        AddActor(Actor);
+    }
+}
+
+void FEpicUnrealMCPActorIndex::OnActorAdded(AActor* Actor)
+{
+    if (IsIndexed(Actor))
+    {
+        AddActor(Actor);
+    }
+}
+
+void FEpicUnrealMCPActorIndex::OnActorDeleted(AActor* Actor)
+{
+    if (IsIndexed(Actor))
+    {
+        RemoveActor(Actor);
+    }
+}
+
+void FEpicUnrealMCPActorIndex::OnActorLabelChanged(AActor* Actor)
+{
+    if (IsIndexed(Actor))
+    {
+        RefreshActor(Actor);
+    }
+}
+
+void FEpicUnrealMCPActorIndex::OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+    // Re-read name and path; the entry stays keyed by the actor
+    AActor* Actor = Cast<AActor>(Object);
+    if (IsIndexed(Actor))
+    {
+        AddActor(Actor);
+    }
+}
+
+void FEpicUnrealMCPActorIndex::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+    // Tags have no dedicated notification
+    AActor* Actor = Cast<AActor>(Object);
+    if (IsIndexed(Actor))
+    {
+        RefreshActor(Actor);
+    }
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPActorIndex::Query(const TSharedPtr<FJsonObject>& Params, const FString& NamePattern)
+{
+    EnsureBuilt();
+
+    // Actors can go away without a notification (garbage collected with their level); they are
+    // neither listed nor counted
+    PruneStale();
+
+    auto PathLess = [this](const TObjectKey<AActor>& A, const TObjectKey<AActor>& B)
+    {
+        return Entries.FindChecked(A).Path < Entries.FindChecked(B).Path;
+    };
+
+    if (bSortedKeysDirty)
+    {
+        Entries.GenerateKeyArray(SortedKeys);
+        SortedKeys.Sort(PathLess);
+        bSortedKeysDirty = false;
+    }
+
+    FString NameFilter;
+    Params->TryGetStringField(TEXT("name"), NameFilter);
+
+    FString LabelFilter;
+    Params->TryGetStringField(TEXT("label"), LabelFilter);
+
+    FString ClassFilter;
+    Params->TryGetStringField(TEXT("class"), ClassFilter);
+
+    FString TagFilter;
+    Params->TryGetStringField(TEXT("tag"), TagFilter);
+
+    FString Cursor;
+    Params->TryGetStringField(TEXT("cursor"), Cursor);
+
+    // Without a limit or cursor the whole list is returned, as before paging existed
+    int32 Limit = Cursor.IsEmpty() ? 0 : MCPActorIndex::DefaultLimit;
+    Params->TryGetNumberField(TEXT("limit"), Limit);
+
+    bool bIncludeTotal = false;
+    Params->TryGetBoolField(TEXT("include_total"), bIncludeTotal);
+
+    const uint8 Fields = MCPActorIndex::ParseFields(Params);
+
+    // Class and tag filters narrow the candidates through the index instead of a scan. Names
+    // that were never created cannot be a class or tag of any actor.
+    TArray<TObjectKey<AActor>> Narrowed;
+    const TArray<TObjectKey<AActor>>* Candidates = &SortedKeys;
+    if (!ClassFilter.IsEmpty() || !TagFilter.IsEmpty())
+    {
+        static const TSet<TObjectKey<AActor>> NoActors;
+        const FName ClassName(*ClassFilter, FNAME_Find);
+        const FName TagName(*TagFilter, FNAME_Find);
+        const TSet<TObjectKey<AActor>>* ClassSet = (ClassFilter.IsEmpty() || ClassName.IsNone()) ? nullptr : ByClass.Find(ClassName);
+        const TSet<TObjectKey<AActor>>* TagSet = (TagFilter.IsEmpty() || TagName.IsNone()) ? nullptr : ByTag.Find(TagName);
+        if (!ClassFilter.IsEmpty() && !ClassSet)
+        {
+            ClassSet = &NoActors;
+        }
+        if (!TagFilter.IsEmpty() && !TagSet)
+        {
+            TagSet = &NoActors;
+        }
+
+        if (ClassSet && TagSet)
+        {
+            Narrowed = ClassSet->Intersect(*TagSet).Array();
+        }
+        else
+        {
+            Narrowed = (ClassSet ? ClassSet : TagSet)->Array();
+        }
+        Narrowed.Sort(PathLess);
+        Candidates = &Narrowed;
+    }
+
+    // Substring filters have no index, so they are checked per candidate; the scan below stops
+    // as soon as the page is full
+    const bool bTextFilter = !NamePattern.IsEmpty() || !NameFilter.IsEmpty() || !LabelFilter.IsEmpty();
+    auto Matches = [&](const FActorEntry& Entry)
+    {
+        return (NamePattern.IsEmpty() || Entry.Name.Contains(NamePattern))
+            && (NameFilter.IsEmpty() || Entry.Name.Contains(NameFilter))
+            && (LabelFilter.IsEmpty() || Entry.Label.Contains(LabelFilter));
+    };
+
+    // The total comes from the class/tag buckets when no substring filter applies; otherwise it
+    // needs a full scan, so it is only counted on request
+    int32 Total = INDEX_NONE;
+    if (!bTextFilter)
+    {
+        Total = Candidates->Num();
+    }
+    else if (bIncludeTotal)
+    {
+        Total = 0;
+        for (const TObjectKey<AActor>& Key : *Candidates)
+        {
+            if (Matches(Entries.FindChecked(Key)))
+            {
+                ++Total;
+            }
+        }
+    }
+
+    // Results continue after the cursor path, so actors added or removed meanwhile do not shift the pages
+    const int32 StartIndex = Cursor.IsEmpty() ? 0 : Algo::UpperBoundBy(*Candidates, Cursor,
+        [this](const TObjectKey<AActor>& Key) -> const FString& { return Entries.FindChecked(Key).Path; });
+
+    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    FString NextCursor;
+    const FActorEntry* LastEntry = nullptr;
+
+    for (int32 Index = StartIndex; Index < Candidates->Num(); ++Index)
+    {
+        const FActorEntry* Entry = &Entries.FindChecked((*Candidates)[Index]);
+        AActor* Actor = Entry->Actor.Get();
+        if (!Actor || !Matches(*Entry))
+        {
+            continue;
+        }
+
+        // One more match past a full page: there is a next page
+        if (Limit > 0 && ActorArray.Num() >= Limit)
+        {
+            NextCursor = LastEntry->Path;
+            break;
+        }
+        LastEntry = Entry;
+
+        TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
+        ActorObj->SetStringField(TEXT("name"), Entry->Name);
+        if (Fields & MCPActorIndex::FieldLabel)
+        {
+            ActorObj->SetStringField(TEXT("label"), Entry->Label);
+        }
+        if (Fields & MCPActorIndex::FieldClass)
+        {
+            ActorObj->SetStringField(TEXT("class"), Entry->Class.ToString());
+        }
+        if (Fields & MCPActorIndex::FieldPath)
+        {
+            ActorObj->SetStringField(TEXT("path"), Entry->Path);
+        }
+        if (Fields & MCPActorIndex::FieldLocation)
+        {
+            const FVector Location = Actor->GetActorLocation();
+            ActorObj->SetArrayField(TEXT("location"), MCPActorIndex::ToJsonArray(Location.X, Location.Y, Location.Z));
+        }
+        if (Fields & MCPActorIndex::FieldRotation)
+        {
+            const FRotator Rotation = Actor->GetActorRotation();
+            ActorObj->SetArrayField(TEXT("rotation"), MCPActorIndex::ToJsonArray(Rotation.Pitch, Rotation.Yaw, Rotation.Roll));
+        }
+        if (Fields & MCPActorIndex::FieldScale)
+        {
+            const FVector Scale = Actor->GetActorScale3D();
+            ActorObj->SetArrayField(TEXT("scale"), MCPActorIndex::ToJsonArray(Scale.X, Scale.Y, Scale.Z));
+        }
+        if (Fields & MCPActorIndex::FieldTags)
+        {
+            TArray<TSharedPtr<FJsonValue>> TagArray;
+            for (const FName& Tag : Entry->Tags)
+            {
+                TagArray.Add(MakeShared<FJsonValueString>(Tag.ToString()));
+            }
+            ActorObj->SetArrayField(TEXT("tags"), TagArray);
+        }
+
+        ActorArray.Add(MakeShared<FJsonValueObject>(ActorObj));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("actors"), ActorArray);
+    ResultObj->SetNumberField(TEXT("count"), ActorArray.Num());
+    if (Total != INDEX_NONE)
+    {
+        ResultObj->SetNumberField(TEXT("total"), Total);
+    }
+    if (!NextCursor.IsEmpty())
+    {
+        ResultObj->SetStringField(TEXT("next_cursor"), NextCursor);
+    }
+
+    return ResultObj;
+}
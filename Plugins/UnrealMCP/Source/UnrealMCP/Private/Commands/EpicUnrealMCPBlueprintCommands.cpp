@@ -1,5 +1,8 @@
 #include "Commands/EpicUnrealMCPBlueprintCommands.h"
 #include "Commands/EpicUnrealMCPCommonUtils.h"
+#include "Commands/EpicUnrealMCPEditSession.h"
+#include "Commands/EpicUnrealMCPMaterialCatalogue.h"
+#include "Commands/BlueprintGraph/GraphChangeTracker.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Factories/BlueprintFactory.h"
@@ -33,76 +36,48 @@ FEpicUnrealMCPBlueprintCommands::FEpicUnrealMCPBlueprintCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FEpicUnrealMCPBlueprintCommands::RegisterCommands(FEpicUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("create_blueprint"))
-    {
-        return HandleCreateBlueprint(Params);
-    }
-    else if (CommandType == TEXT("add_component_to_blueprint"))
-    {
-        return HandleAddComponentToBlueprint(Params);
-    }
-    else if (CommandType == TEXT("set_physics_properties"))
-    {
-        return HandleSetPhysicsProperties(Params);
-    }
-    else if (CommandType == TEXT("compile_blueprint"))
-    {
-        return HandleCompileBlueprint(Params);
-    }
-    else if (CommandType == TEXT("set_static_mesh_properties"))
-    {
-        return HandleSetStaticMeshProperties(Params);
-    }
-    else if (CommandType == TEXT("spawn_blueprint_actor"))
-    {
-        return HandleSpawnBlueprintActor(Params);
-    }
-    else if (CommandType == TEXT("set_mesh_material_color"))
-    {
-        return HandleSetMeshMaterialColor(Params);
-    }
-    // Material management commands
-    else if (CommandType == TEXT("get_available_materials"))
-    {
-        return HandleGetAvailableMaterials(Params);
-    }
-    else if (CommandType == TEXT("apply_material_to_actor"))
-    {
-        return HandleApplyMaterialToActor(Params);
-    }
-    else if (CommandType == TEXT("apply_material_to_blueprint"))
-    {
-        return HandleApplyMaterialToBlueprint(Params);
-    }
-    else if (CommandType == TEXT("get_actor_material_info"))
-    {
-        return HandleGetActorMaterialInfo(Params);
-    }
-    else if (CommandType == TEXT("get_blueprint_material_info"))
-    {
-        return HandleGetBlueprintMaterialInfo(Params);
-    }
-    // Blueprint analysis commands
-    else if (CommandType == TEXT("read_blueprint_content"))
-    {
-        return HandleReadBlueprintContent(Params);
-    }
-    else if (CommandType == TEXT("analyze_blueprint_graph"))
-    {
-        return HandleAnalyzeBlueprintGraph(Params);
-    }
-    else if (CommandType == TEXT("get_blueprint_variable_details"))
-    {
-        return HandleGetBlueprintVariableDetails(Params);
-    }
-    else if (CommandType == TEXT("get_blueprint_function_details"))
-    {
-        return HandleGetBlueprintFunctionDetails(Params);
-    }
-
-    return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint command: %s"), *CommandType));
+    const FString Category = TEXT("blueprint");
+    const EMCPCommandFlags Query = EMCPCommandFlags::GameThread | EMCPCommandFlags::ReadOnly | EMCPCommandFlags::Batchable;
+    const EMCPCommandFlags Edit = EMCPCommandFlags::GameThread | EMCPCommandFlags::Batchable;
+    const EMCPCommandFlags Inspect = Query | EMCPCommandFlags::Snapshot;
+
+    Registry.Register(TEXT("create_blueprint"), Category, Edit, {TEXT("name")}, {TEXT("folder_path"), TEXT("parent_class")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleCreateBlueprint(Params); });
+    Registry.Register(TEXT("add_component_to_blueprint"), Category, Edit, {TEXT("blueprint_name")}, {TEXT("component_type"), TEXT("component_name"), TEXT("location"), TEXT("rotation"), TEXT("scale")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddComponentToBlueprint(Params); });
+    Registry.Register(TEXT("set_physics_properties"), Category, Edit, {TEXT("blueprint_name"), TEXT("component_name")}, {TEXT("simulate_physics"), TEXT("mass"), TEXT("linear_damping"), TEXT("angular_damping")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetPhysicsProperties(Params); });
+    Registry.Register(TEXT("compile_blueprint"), Category, Edit, {TEXT("blueprint_name")}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleCompileBlueprint(Params); });
+    Registry.Register(TEXT("begin_edit_session"), Category, Edit, {}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleBeginEditSession(Params); });
+    Registry.Register(TEXT("end_edit_session"), Category, Edit, {}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleEndEditSession(Params); });
+    Registry.Register(TEXT("set_static_mesh_properties"), Category, Edit, {TEXT("blueprint_name"), TEXT("component_name")}, {TEXT("static_mesh"), TEXT("material")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetStaticMeshProperties(Params); });
+    Registry.Register(TEXT("set_mesh_material_color"), Category, Edit, {TEXT("blueprint_name"), TEXT("component_name")}, {TEXT("color"), TEXT("material_slot"), TEXT("parameter_name"), TEXT("material_path")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetMeshMaterialColor(Params); });
+    Registry.Register(TEXT("get_available_materials"), Category, Query, {},
+        {TEXT("search_path"), TEXT("include_engine_materials"), TEXT("name_filter"), TEXT("class_filter"), TEXT("offset"), TEXT("limit")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGetAvailableMaterials(Params); });
+    Registry.Register(TEXT("apply_material_to_actor"), Category, Edit, {TEXT("actor_name"), TEXT("material_path")}, {TEXT("material_slot")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleApplyMaterialToActor(Params); });
+    Registry.Register(TEXT("apply_material_to_blueprint"), Category, Edit, {TEXT("blueprint_name"), TEXT("component_name"), TEXT("material_path")}, {TEXT("material_slot")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleApplyMaterialToBlueprint(Params); });
+    Registry.Register(TEXT("get_actor_material_info"), Category, Inspect, {TEXT("actor_name")}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGetActorMaterialInfo(Params); });
+    Registry.Register(TEXT("get_blueprint_material_info"), Category, Inspect, {TEXT("blueprint_name"), TEXT("component_name")}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGetBlueprintMaterialInfo(Params); });
+    Registry.Register(TEXT("read_blueprint_content"), Category, Inspect, {TEXT("blueprint_path")}, {TEXT("include_event_graph"), TEXT("include_functions"), TEXT("include_variables"), TEXT("include_components"), TEXT("include_interfaces")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleReadBlueprintContent(Params); });
+    Registry.Register(TEXT("analyze_blueprint_graph"), Category, Inspect, {TEXT("blueprint_path")}, {TEXT("graph_name"), TEXT("include_node_details"), TEXT("include_pin_connections"), TEXT("trace_execution_flow"), TEXT("since_revision")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleAnalyzeBlueprintGraph(Params); });
+    Registry.Register(TEXT("get_blueprint_variable_details"), Category, Inspect, {TEXT("blueprint_path")}, {TEXT("variable_name")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGetBlueprintVariableDetails(Params); });
+    Registry.Register(TEXT("get_blueprint_function_details"), Category, Inspect, {TEXT("blueprint_path")}, {TEXT("function_name"), TEXT("include_graph")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGetBlueprintFunctionDetails(Params); });
 }
 
 TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -301,8 +276,8 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleAddComponentToBlu
         // Add to root if no parent specified
         Blueprint->SimpleConstructionScript->AddNode(NewNode);
 
-        // Compile the blueprint
-        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        // Compile the blueprint, or once at the end of the edit session
+        FEpicUnrealMCPEditSession::RequestCompile(Blueprint);
 
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("component_name"), ComponentName);
@@ -405,15 +380,34 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleCompileBlueprint(
         return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
-    // Compile the blueprint
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
-
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    // Compile now, settling whatever an open edit session had collected for this Blueprint
+    TSharedPtr<FJsonObject> ResultObj = FEpicUnrealMCPEditSession::Compile(Blueprint);
     ResultObj->SetStringField(TEXT("name"), BlueprintName);
     ResultObj->SetBoolField(TEXT("compiled"), true);
     return ResultObj;
 }
 
+TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleBeginEditSession(const TSharedPtr<FJsonObject>& Params)
+{
+    FEpicUnrealMCPEditSession::Begin();
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetBoolField(TEXT("active"), true);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleEndEditSession(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!FEpicUnrealMCPEditSession::IsActive())
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No edit session is open"));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = FEpicUnrealMCPEditSession::End();
+    ResultObj->SetBoolField(TEXT("active"), FEpicUnrealMCPEditSession::IsActive());
+    return ResultObj;
+}
+
 TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params)
 {
     UE_LOG(LogTemp, Warning, TEXT("HandleSpawnBlueprintActor: Starting blueprint actor spawn"));
@@ -713,131 +707,13 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleSetMeshMaterialCo
 
 TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleGetAvailableMaterials(const TSharedPtr<FJsonObject>& Params)
 {
-    // Get parameters - make search path completely dynamic
-    FString SearchPath;
-    if (!Params->TryGetStringField(TEXT("search_path"), SearchPath))
-    {
-        // Default to empty string to search everywhere
-        SearchPath = TEXT("");
-    }
-    
-    bool bIncludeEngineMaterials = true;
-    if (Params->HasField(TEXT("include_engine_materials")))
-    {
-        bIncludeEngineMaterials = Params->GetBoolField(TEXT("include_engine_materials"));
-    }
-
-    // Get asset registry module
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-    IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-    // Create filter for materials
-    FARFilter Filter;
-    Filter.ClassPaths.Add(UMaterialInterface::StaticClass()->GetClassPathName());
-    Filter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
-    Filter.ClassPaths.Add(UMaterialInstanceConstant::StaticClass()->GetClassPathName());
-    Filter.ClassPaths.Add(UMaterialInstanceDynamic::StaticClass()->GetClassPathName());
-    
-    // Add search paths dynamically
-    if (!SearchPath.IsEmpty())
-    {
-        // Ensure the path starts with /
-        if (!SearchPath.StartsWith(TEXT("/")))
-        {
-            SearchPath = TEXT("/") + SearchPath;
-        }
-        // Ensure the path ends with / for proper directory search
-        if (!SearchPath.EndsWith(TEXT("/")))
-        {
-            SearchPath += TEXT("/");
-        }
-        Filter.PackagePaths.Add(*SearchPath);
-        UE_LOG(LogTemp, Log, TEXT("Searching for materials in: %s"), *SearchPath);
-    }
-    else
-    {
-        // Search in common game content locations
-        Filter.PackagePaths.Add(TEXT("/Game/"));
-        UE_LOG(LogTemp, Log, TEXT("Searching for materials in all game content"));
-    }
-    
-    if (bIncludeEngineMaterials)
-    {
-        Filter.PackagePaths.Add(TEXT("/Engine/"));
-        UE_LOG(LogTemp, Log, TEXT("Including Engine materials in search"));
-    }
-    
-    Filter.bRecursivePaths = true;
-
-    // Get assets from registry
-    TArray<FAssetData> AssetDataArray;
-    AssetRegistry.GetAssets(Filter, AssetDataArray);
-    
-    UE_LOG(LogTemp, Log, TEXT("Asset registry found %d materials"), AssetDataArray.Num());
-
-    // Also try manual search using EditorAssetLibrary for more comprehensive results
-    TArray<FString> AllAssetPaths;
-    if (!SearchPath.IsEmpty())
-    {
-        AllAssetPaths = UEditorAssetLibrary::ListAssets(SearchPath, true, false);
-    }
-    else
+    // Built on first use from asset registry data, then kept current by registry events
+    if (!MaterialCatalogue.IsValid())
     {
-        AllAssetPaths = UEditorAssetLibrary::ListAssets(TEXT("/Game/"), true, false);
+        MaterialCatalogue = MakeShared<FEpicUnrealMCPMaterialCatalogue>();
     }
-    
-    // Filter for materials from the manual search
-    for (const FString& AssetPath : AllAssetPaths)
-    {
-        if (AssetPath.Contains(TEXT("Material")) && !AssetPath.Contains(TEXT(".uasset")))
-        {
-            UObject* Asset = UEditorAssetLibrary::LoadAsset(AssetPath);
-            if (Asset && Asset->IsA<UMaterialInterface>())
-            {
-                // Check if we already have this asset from registry search
-                bool bAlreadyFound = false;
-                for (const FAssetData& ExistingData : AssetDataArray)
-                {
-                    if (ExistingData.GetObjectPathString() == AssetPath)
-                    {
-                        bAlreadyFound = true;
-                        break;
-                    }
-                }
-                
-                if (!bAlreadyFound)
-                {
-                    // Create FAssetData manually for this asset
-                    FAssetData ManualAssetData(Asset);
-                    AssetDataArray.Add(ManualAssetData);
-                }
-            }
-        }
-    }
-
-    UE_LOG(LogTemp, Log, TEXT("Total materials found after manual search: %d"), AssetDataArray.Num());
 
-    // Convert to JSON
-    TArray<TSharedPtr<FJsonValue>> MaterialArray;
-    for (const FAssetData& AssetData : AssetDataArray)
-    {
-        TSharedPtr<FJsonObject> MaterialObj = MakeShared<FJsonObject>();
-        MaterialObj->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-        MaterialObj->SetStringField(TEXT("path"), AssetData.GetObjectPathString());
-        MaterialObj->SetStringField(TEXT("package"), AssetData.PackageName.ToString());
-        MaterialObj->SetStringField(TEXT("class"), AssetData.AssetClassPath.ToString());
-        
-        MaterialArray.Add(MakeShared<FJsonValueObject>(MaterialObj));
-        
-        UE_LOG(LogTemp, Verbose, TEXT("Found material: %s at %s"), *AssetData.AssetName.ToString(), *AssetData.GetObjectPathString());
-    }
-
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("materials"), MaterialArray);
-    ResultObj->SetNumberField(TEXT("count"), MaterialArray.Num());
-    ResultObj->SetStringField(TEXT("search_path_used"), SearchPath.IsEmpty() ? TEXT("/Game/") : SearchPath);
-    
-    return ResultObj;
+    return MaterialCatalogue->Query(Params);
 }
 
 TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleApplyMaterialToActor(const TSharedPtr<FJsonObject>& Params)
@@ -1170,6 +1046,63 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleGetBlueprintMater
     return ResultObj;
 }
 
+namespace MCPGraphAnalysis
+{
+    /** Describe one node for analyze_blueprint_graph, appending the links of its pins to Connections */
+    static TSharedPtr<FJsonObject> DescribeNode(UEdGraphNode* Node, bool bIncludeNodeDetails, bool bIncludePinConnections,
+        TArray<TSharedPtr<FJsonValue>>& Connections)
+    {
+        TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
+        NodeObj->SetStringField(TEXT("name"), Node->GetName());
+        NodeObj->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
+        NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
+        NodeObj->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+
+        if (bIncludeNodeDetails)
+        {
+            NodeObj->SetNumberField(TEXT("pos_x"), Node->NodePosX);
+            NodeObj->SetNumberField(TEXT("pos_y"), Node->NodePosY);
+            NodeObj->SetBoolField(TEXT("can_rename"), Node->bCanRenameNode);
+        }
+
+        // Include pin information if requested
+        if (bIncludePinConnections)
+        {
+            TArray<TSharedPtr<FJsonValue>> PinArray;
+            for (UEdGraphPin* Pin : Node->Pins)
+            {
+                if (Pin)
+                {
+                    TSharedPtr<FJsonObject> PinObj = MakeShared<FJsonObject>();
+                    PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
+                    PinObj->SetStringField(TEXT("type"), Pin->PinType.PinCategory.ToString());
+                    PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
+                    PinObj->SetNumberField(TEXT("connections"), Pin->LinkedTo.Num());
+
+                    // Record connections for this pin
+                    for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+                    {
+                        if (LinkedPin && LinkedPin->GetOwningNode())
+                        {
+                            TSharedPtr<FJsonObject> ConnObj = MakeShared<FJsonObject>();
+                            ConnObj->SetStringField(TEXT("from_node"), Node->GetName());
+                            ConnObj->SetStringField(TEXT("from_pin"), Pin->PinName.ToString());
+                            ConnObj->SetStringField(TEXT("to_node"), LinkedPin->GetOwningNode()->GetName());
+                            ConnObj->SetStringField(TEXT("to_pin"), LinkedPin->PinName.ToString());
+                            Connections.Add(MakeShared<FJsonValueObject>(ConnObj));
+                        }
+                    }
+
+                    PinArray.Add(MakeShared<FJsonValueObject>(PinObj));
+                }
+            }
+            NodeObj->SetArrayField(TEXT("pins"), PinArray);
+        }
+
+        return NodeObj;
+    }
+}
+
 TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleReadBlueprintContent(const TSharedPtr<FJsonObject>& Params)
 {
     // Get required parameters
@@ -1231,6 +1164,7 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleReadBlueprintCont
                 TSharedPtr<FJsonObject> FuncObj = MakeShared<FJsonObject>();
                 FuncObj->SetStringField(TEXT("name"), Graph->GetName());
                 FuncObj->SetStringField(TEXT("graph_type"), TEXT("Function"));
+                FuncObj->SetNumberField(TEXT("revision"), FGraphChangeTracker::Get().GetRevision(Graph));
                 
                 // Count nodes in function
                 int32 NodeCount = Graph->Nodes.Num();
@@ -1254,6 +1188,7 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleReadBlueprintCont
             {
                 EventGraphObj->SetStringField(TEXT("name"), Graph->GetName());
                 EventGraphObj->SetNumberField(TEXT("node_count"), Graph->Nodes.Num());
+                EventGraphObj->SetNumberField(TEXT("revision"), FGraphChangeTracker::Get().GetRevision(Graph));
                 
                 // Get basic node information
                 TArray<TSharedPtr<FJsonValue>> NodeArray;
@@ -1377,65 +1312,67 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintCommands::HandleAnalyzeBlueprintG
     GraphData->SetStringField(TEXT("graph_name"), TargetGraph->GetName());
     GraphData->SetStringField(TEXT("graph_type"), TargetGraph->GetClass()->GetName());
 
-    // Analyze nodes
-    TArray<TSharedPtr<FJsonValue>> NodeArray;
+    // With since_revision only the nodes changed after it are described; a revision the
+    // tracker cannot answer for falls back to the full graph
+    FGraphChanges Changes;
+    int64 SinceRevision = 0;
+    if (Params->TryGetNumberField(TEXT("since_revision"), SinceRevision))
+    {
+        Changes = FGraphChangeTracker::Get().GetChangesSince(TargetGraph, SinceRevision);
+    }
+    else
+    {
+        Changes.Revision = FGraphChangeTracker::Get().GetRevision(TargetGraph);
+    }
+
+    GraphData->SetNumberField(TEXT("revision"), Changes.Revision);
+    GraphData->SetBoolField(TEXT("incremental"), Changes.bComplete);
+
     TArray<TSharedPtr<FJsonValue>> ConnectionArray;
 
-    for (UEdGraphNode* Node : TargetGraph->Nodes)
+    if (Changes.bComplete)
     {
-        if (Node)
+        TArray<TSharedPtr<FJsonValue>> AddedArray;
+        for (UEdGraphNode* Node : Changes.Added)
         {
-            TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-            NodeObj->SetStringField(TEXT("name"), Node->GetName());
-            NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-            NodeObj->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+            AddedArray.Add(MakeShared<FJsonValueObject>(MCPGraphAnalysis::DescribeNode(Node, bIncludeNodeDetails, bIncludePinConnections, ConnectionArray)));
+        }
 
-            if (bIncludeNodeDetails)
-            {
-                NodeObj->SetNumberField(TEXT("pos_x"), Node->NodePosX);
-                NodeObj->SetNumberField(TEXT("pos_y"), Node->NodePosY);
-                NodeObj->SetBoolField(TEXT("can_rename"), Node->bCanRenameNode);
-            }
+        TArray<TSharedPtr<FJsonValue>> ModifiedArray;
+        for (UEdGraphNode* Node : Changes.Modified)
+        {
+            ModifiedArray.Add(MakeShared<FJsonValueObject>(MCPGraphAnalysis::DescribeNode(Node, bIncludeNodeDetails, bIncludePinConnections, ConnectionArray)));
+        }
 
-            // Include pin information if requested
-            if (bIncludePinConnections)
+        TArray<TSharedPtr<FJsonValue>> RemovedArray;
+        for (const FGraphChanges::FRemovedNode& Removed : Changes.Removed)
+        {
+            TSharedPtr<FJsonObject> RemovedObj = MakeShared<FJsonObject>();
+            RemovedObj->SetStringField(TEXT("name"), Removed.Name);
+            RemovedObj->SetStringField(TEXT("id"), Removed.NodeGuid.ToString());
+            RemovedArray.Add(MakeShared<FJsonValueObject>(RemovedObj));
+        }
+
+        GraphData->SetNumberField(TEXT("since_revision"), SinceRevision);
+        GraphData->SetArrayField(TEXT("added_nodes"), AddedArray);
+        GraphData->SetArrayField(TEXT("modified_nodes"), ModifiedArray);
+        GraphData->SetArrayField(TEXT("removed_nodes"), RemovedArray);
+    }
+    else
+    {
+        TArray<TSharedPtr<FJsonValue>> NodeArray;
+        for (UEdGraphNode* Node : TargetGraph->Nodes)
+        {
+            if (Node)
             {
-                TArray<TSharedPtr<FJsonValue>> PinArray;
-                for (UEdGraphPin* Pin : Node->Pins)
-                {
-                    if (Pin)
-                    {
-                        TSharedPtr<FJsonObject> PinObj = MakeShared<FJsonObject>();
-                        PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
-                        PinObj->SetStringField(TEXT("type"), Pin->PinType.PinCategory.ToString());
-                        PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
-                        PinObj->SetNumberField(TEXT("connections"), Pin->LinkedTo.Num());
-                        
-                        // Record connections for this pin
-                        for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-                        {
-                            if (LinkedPin && LinkedPin->GetOwningNode())
-                            {
-                                TSharedPtr<FJsonObject> ConnObj = MakeShared<FJsonObject>();
-                                ConnObj->SetStringField(TEXT("from_node"), Pin->GetOwningNode()->GetName());
-                                ConnObj->SetStringField(TEXT("from_pin"), Pin->PinName.ToString());
-                                ConnObj->SetStringField(TEXT("to_node"), LinkedPin->GetOwningNode()->GetName());
-                                ConnObj->SetStringField(TEXT("to_pin"), LinkedPin->PinName.ToString());
-                                ConnectionArray.Add(MakeShared<FJsonValueObject>(ConnObj));
-                            }
-                        }
-                        
-                        PinArray.Add(MakeShared<FJsonValueObject>(PinObj));
-                    }
-                }
-                NodeObj->SetArrayField(TEXT("pins"), PinArray);
+                NodeArray.Add(MakeShared<FJsonValueObject>(MCPGraphAnalysis::DescribeNode(Node, bIncludeNodeDetails, bIncludePinConnections, ConnectionArray)));
             }
-
-            NodeArray.Add(MakeShared<FJsonValueObject>(NodeObj));
         }
+        GraphData->SetArrayField(TEXT("nodes"), NodeArray);
     }
 
-    GraphData->SetArrayField(TEXT("nodes"), NodeArray);
+    // Links are listed from the node that owns each pin; in an incremental read they are the
+    // links of the added and modified nodes only
     GraphData->SetArrayField(TEXT("connections"), ConnectionArray);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -17,58 +17,36 @@ FEpicUnrealMCPBlueprintGraphCommands::~FEpicUnrealMCPBlueprintGraphCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintGraphCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FEpicUnrealMCPBlueprintGraphCommands::RegisterCommands(FEpicUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("add_blueprint_node"))
-    {
-        return HandleAddBlueprintNode(Params);
-    }
-    else if (CommandType == TEXT("connect_nodes"))
-    {
-        return HandleConnectNodes(Params);
-    }
-    else if (CommandType == TEXT("create_variable"))
-    {
-        return HandleCreateVariable(Params);
-    }
-    else if (CommandType == TEXT("set_blueprint_variable_properties"))
-    {
-        return HandleSetVariableProperties(Params);
-    }
-    else if (CommandType == TEXT("add_event_node"))
-    {
-        return HandleAddEventNode(Params);
-    }
-    else if (CommandType == TEXT("delete_node"))
-    {
-        return HandleDeleteNode(Params);
-    }
-    else if (CommandType == TEXT("set_node_property"))
-    {
-        return HandleSetNodeProperty(Params);
-    }
-    else if (CommandType == TEXT("create_function"))
-    {
-        return HandleCreateFunction(Params);
-    }
-    else if (CommandType == TEXT("add_function_input"))
-    {
-        return HandleAddFunctionInput(Params);
-    }
-    else if (CommandType == TEXT("add_function_output"))
-    {
-        return HandleAddFunctionOutput(Params);
-    }
-    else if (CommandType == TEXT("delete_function"))
-    {
-        return HandleDeleteFunction(Params);
-    }
-    else if (CommandType == TEXT("rename_function"))
-    {
-        return HandleRenameFunction(Params);
-    }
-
-    return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint graph command: %s"), *CommandType));
+    const FString Category = TEXT("blueprint_graph");
+    const EMCPCommandFlags Edit = EMCPCommandFlags::GameThread | EMCPCommandFlags::Batchable;
+
+    Registry.Register(TEXT("add_blueprint_node"), Category, Edit, {TEXT("blueprint_name"), TEXT("node_type")}, {TEXT("node_params"), TEXT("pos_x"), TEXT("pos_y")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddBlueprintNode(Params); });
+    Registry.Register(TEXT("connect_nodes"), Category, Edit, {TEXT("blueprint_name"), TEXT("source_node_id"), TEXT("source_pin_name"), TEXT("target_node_id"), TEXT("target_pin_name")}, {TEXT("function_name")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleConnectNodes(Params); });
+    Registry.Register(TEXT("create_variable"), Category, Edit, {TEXT("blueprint_name"), TEXT("variable_name"), TEXT("variable_type")}, {TEXT("default_value"), TEXT("is_public"), TEXT("tooltip"), TEXT("category")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleCreateVariable(Params); });
+    Registry.Register(TEXT("set_blueprint_variable_properties"), Category, Edit, {TEXT("blueprint_name"), TEXT("variable_name")},
+        {TEXT("var_name"), TEXT("var_type"), TEXT("is_blueprint_writable"), TEXT("is_editable_in_instance"), TEXT("is_private"), TEXT("is_config"), TEXT("expose_on_spawn"), TEXT("expose_to_cinematics"), TEXT("tooltip"), TEXT("category"), TEXT("default_value"), TEXT("friendly_name"), TEXT("replication_enabled"), TEXT("replication_condition"), TEXT("units"), TEXT("slider_range_min"), TEXT("slider_range_max"), TEXT("value_range_min"), TEXT("value_range_max"), TEXT("bitmask"), TEXT("bitmask_enum")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetVariableProperties(Params); });
+    Registry.Register(TEXT("add_event_node"), Category, Edit, {TEXT("blueprint_name"), TEXT("event_name")}, {TEXT("pos_x"), TEXT("pos_y")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddEventNode(Params); });
+    Registry.Register(TEXT("delete_node"), Category, Edit, {TEXT("blueprint_name"), TEXT("node_id")}, {TEXT("function_name")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleDeleteNode(Params); });
+    Registry.Register(TEXT("set_node_property"), Category, Edit, {TEXT("blueprint_name"), TEXT("node_id"), TEXT("property_name")}, {TEXT("property_value"), TEXT("action"), TEXT("function_name"), TEXT("pin_name"), TEXT("enum_type"), TEXT("enum_path"), TEXT("num_elements")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetNodeProperty(Params); });
+    Registry.Register(TEXT("create_function"), Category, Edit, {TEXT("blueprint_name"), TEXT("function_name")}, {TEXT("return_type")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleCreateFunction(Params); });
+    Registry.Register(TEXT("add_function_input"), Category, Edit, {TEXT("blueprint_name"), TEXT("function_name"), TEXT("param_name")}, {TEXT("param_type"), TEXT("is_array")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddFunctionInput(Params); });
+    Registry.Register(TEXT("add_function_output"), Category, Edit, {TEXT("blueprint_name"), TEXT("function_name"), TEXT("param_name")}, {TEXT("param_type"), TEXT("is_array")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddFunctionOutput(Params); });
+    Registry.Register(TEXT("delete_function"), Category, Edit, {TEXT("blueprint_name"), TEXT("function_name")}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleDeleteFunction(Params); });
+    Registry.Register(TEXT("rename_function"), Category, Edit, {TEXT("blueprint_name"), TEXT("old_function_name"), TEXT("new_function_name")}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleRenameFunction(Params); });
 }
 
 TSharedPtr<FJsonObject> FEpicUnrealMCPBlueprintGraphCommands::HandleAddBlueprintNode(const TSharedPtr<FJsonObject>& Params)
@@ -0,0 +1,213 @@
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Misc/Paths.h"
+#include "UObject/PackageReload.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace MCPBlueprintResolver
+{
+    static TUniquePtr<FEpicUnrealMCPBlueprintResolver> Instance;
+
+    /** Remembered misses before the list is started over */
+    static constexpr int32 MaxMisses = 1024;
+}
+
+FEpicUnrealMCPBlueprintResolver& FEpicUnrealMCPBlueprintResolver::Get()
+{
+    check(IsInGameThread());
+
+    if (!MCPBlueprintResolver::Instance.IsValid())
+    {
+        MCPBlueprintResolver::Instance.Reset(new FEpicUnrealMCPBlueprintResolver());
+    }
+
+    return *MCPBlueprintResolver::Instance;
+}
+
+void FEpicUnrealMCPBlueprintResolver::Shutdown()
+{
+    MCPBlueprintResolver::Instance.Reset();
+}
+
+FEpicUnrealMCPBlueprintResolver::FEpicUnrealMCPBlueprintResolver()
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FEpicUnrealMCPBlueprintResolver::OnAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FEpicUnrealMCPBlueprintResolver::OnAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FEpicUnrealMCPBlueprintResolver::OnAssetRenamed);
+
+    PackageReloadedHandle = FCoreUObjectDelegates::OnPackageReloaded.AddRaw(this, &FEpicUnrealMCPBlueprintResolver::OnPackageReloaded);
+}
+
+FEpicUnrealMCPBlueprintResolver::~FEpicUnrealMCPBlueprintResolver()
+{
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+
+    FCoreUObjectDelegates::OnPackageReloaded.Remove(PackageReloadedHandle);
+}
+
+UBlueprint* FEpicUnrealMCPBlueprintResolver::Resolve(const FString& BlueprintName)
+{
+    if (BlueprintName.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    if (const TWeakObjectPtr<UBlueprint>* Cached = Cache.Find(BlueprintName))
+    {
+        // Null once the Blueprint was garbage collected or marked as garbage
+        if (UBlueprint* Blueprint = Cached->Get())
+        {
+            return Blueprint;
+        }
+        Cache.Remove(BlueprintName);
+    }
+
+    // A name that found nothing keeps finding nothing until an asset is added or renamed
+    if (Misses.Contains(BlueprintName))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("BlueprintResolver: No blueprint named %s (cached)"), *BlueprintName);
+        return nullptr;
+    }
+
+    UBlueprint* Blueprint = ResolveUncached(BlueprintName);
+    if (Blueprint)
+    {
+        Cache.Add(BlueprintName, Blueprint);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("BlueprintResolver: Failed to find or load blueprint: %s"), *BlueprintName);
+
+        if (Misses.Num() >= MCPBlueprintResolver::MaxMisses)
+        {
+            Misses.Reset();
+        }
+        Misses.Add(BlueprintName);
+    }
+
+    return Blueprint;
+}
+
+void FEpicUnrealMCPBlueprintResolver::Invalidate()
+{
+    Cache.Reset();
+    Misses.Reset();
+}
+
+FString FEpicUnrealMCPBlueprintResolver::MakeObjectPath(const FString& BlueprintName)
+{
+    // The object path of a Blueprint asset is /Game/Path/AssetName.AssetName
+    FString ObjectPath = BlueprintName;
+    if (!ObjectPath.StartsWith(TEXT("/")))
+    {
+        ObjectPath = TEXT("/Game/Blueprints/") + ObjectPath;
+    }
+    if (!ObjectPath.Contains(TEXT(".")))
+    {
+        ObjectPath += TEXT(".") + FPaths::GetBaseFilename(ObjectPath);
+    }
+
+    return ObjectPath;
+}
+
+UBlueprint* FEpicUnrealMCPBlueprintResolver::ResolveUncached(const FString& BlueprintName)
+{
+    const FString ObjectPath = MakeObjectPath(BlueprintName);
+
+    // Already in memory, or on disk where the name says
+    if (UBlueprint* Blueprint = FindObject<UBlueprint>(nullptr, *ObjectPath))
+    {
+        return Blueprint;
+    }
+    if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn))
+    {
+        return Blueprint;
+    }
+
+    // The asset registry also knows assets created this session that were never saved
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(ObjectPath));
+    if (AssetData.IsValid())
+    {
+        if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset()))
+        {
+            return Blueprint;
+        }
+    }
+
+    // A bare name outside /Game/Blueprints/: look it up by asset name
+    if (!BlueprintName.StartsWith(TEXT("/")))
+    {
+        FARFilter Filter;
+        Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+        Filter.bRecursiveClasses = true;
+
+        TArray<FAssetData> Blueprints;
+        AssetRegistry.GetAssets(Filter, Blueprints);
+
+        const FName AssetName(*FPaths::GetBaseFilename(BlueprintName));
+        for (const FAssetData& Candidate : Blueprints)
+        {
+            if (Candidate.AssetName == AssetName)
+            {
+                return Cast<UBlueprint>(Candidate.GetAsset());
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void FEpicUnrealMCPBlueprintResolver::OnAssetAdded(const FAssetData& AssetData)
+{
+    // Any new asset may be what a missed name was looking for (its class is not known before it loads)
+    Misses.Reset();
+}
+
+void FEpicUnrealMCPBlueprintResolver::OnAssetRemoved(const FAssetData& AssetData)
+{
+    const FString ObjectPath = AssetData.GetObjectPathString();
+    for (auto It = Cache.CreateIterator(); It; ++It)
+    {
+        const UBlueprint* Blueprint = It->Value.Get();
+        if (!Blueprint || Blueprint->GetPathName() == ObjectPath)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FEpicUnrealMCPBlueprintResolver::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    // The renamed Blueprint keeps its object, so names that resolved to it must be looked up again,
+    // and its new name may be one that missed before
+    Misses.Reset();
+
+    const FString ObjectPath = AssetData.GetObjectPathString();
+    for (auto It = Cache.CreateIterator(); It; ++It)
+    {
+        const UBlueprint* Blueprint = It->Value.Get();
+        if (!Blueprint || Blueprint->GetPathName() == ObjectPath || Blueprint->GetPathName() == OldObjectPath)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FEpicUnrealMCPBlueprintResolver::OnPackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event)
+{
+    // Reloaded packages replace their objects
+    if (Phase == EPackageReloadPhase::PostPackageFixup)
+    {
+        Invalidate();
+    }
+}
@@ -0,0 +1,72 @@
+#include "Commands/EpicUnrealMCPCommandRegistry.h"
+
+void FEpicUnrealMCPCommandRegistry::Register(FName Name, const FString& Category, EMCPCommandFlags Flags,
+    TArray<FString> RequiredParams, TArray<FString> OptionalParams, FMCPCommandHandler Handler)
+{
+    if (Commands.Contains(Name))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("EpicUnrealMCPCommandRegistry: Command '%s' registered twice, replacing it"), *Name.ToString());
+    }
+
+    FMCPCommandInfo& Info = Commands.Add(Name);
+    Info.Name = Name;
+    Info.Category = Category;
+    Info.Flags = Flags;
+    Info.RequiredParams = MoveTemp(RequiredParams);
+    Info.OptionalParams = MoveTemp(OptionalParams);
+    Info.Handler = MoveTemp(Handler);
+}
+
+const FMCPCommandInfo* FEpicUnrealMCPCommandRegistry::Find(const FString& CommandType) const
+{
+    // FNAME_Find: an unknown command never adds an entry to the name table
+    const FName Name(*CommandType, FNAME_Find);
+    return Name.IsNone() ? nullptr : Commands.Find(Name);
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPCommandRegistry::DescribeCommands() const
+{
+    TArray<const FMCPCommandInfo*> Sorted;
+    Sorted.Reserve(Commands.Num());
+    for (const TPair<FName, FMCPCommandInfo>& Pair : Commands)
+    {
+        Sorted.Add(&Pair.Value);
+    }
+    Sorted.Sort([](const FMCPCommandInfo& A, const FMCPCommandInfo& B)
+    {
+        return A.Category != B.Category ? A.Category < B.Category : A.Name.LexicalLess(B.Name);
+    });
+
+    auto ToJsonArray = [](const TArray<FString>& Strings)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        for (const FString& String : Strings)
+        {
+            Values.Add(MakeShared<FJsonValueString>(String));
+        }
+        return Values;
+    };
+
+    TArray<TSharedPtr<FJsonValue>> CommandArray;
+    for (const FMCPCommandInfo* Info : Sorted)
+    {
+        TSharedPtr<FJsonObject> ParamsJson = MakeShared<FJsonObject>();
+        ParamsJson->SetArrayField(TEXT("required"), ToJsonArray(Info->RequiredParams));
+        ParamsJson->SetArrayField(TEXT("optional"), ToJsonArray(Info->OptionalParams));
+
+        TSharedPtr<FJsonObject> CommandJson = MakeShared<FJsonObject>();
+        CommandJson->SetStringField(TEXT("name"), Info->Name.ToString());
+        CommandJson->SetStringField(TEXT("category"), Info->Category);
+        CommandJson->SetBoolField(TEXT("game_thread"), Info->RequiresGameThread());
+        CommandJson->SetBoolField(TEXT("read_only"), Info->IsReadOnly());
+        CommandJson->SetBoolField(TEXT("batchable"), Info->IsBatchable());
+        CommandJson->SetBoolField(TEXT("snapshot"), Info->IsSnapshot());
+        CommandJson->SetObjectField(TEXT("params"), ParamsJson);
+        CommandArray.Add(MakeShared<FJsonValueObject>(CommandJson));
+    }
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetArrayField(TEXT("commands"), CommandArray);
+    ResultJson->SetNumberField(TEXT("count"), CommandArray.Num());
+    return ResultJson;
+}
@@ -1,4 +1,5 @@
 #include "Commands/EpicUnrealMCPCommonUtils.h"
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
@@ -153,54 +154,7 @@ UBlueprint* FEpicUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintNam
 
 UBlueprint* FEpicUnrealMCPCommonUtils::FindBlueprintByName(const FString& BlueprintName)
 {
-    // The correct object path for a Blueprint asset is /Game/Path/AssetName.AssetName
-    FString ObjectPath;
-
-    // Check if BlueprintName is already a full path (starts with /)
-    if (BlueprintName.StartsWith(TEXT("/")))
-    {
-        // It's already a full path, use it directly with the class suffix
-        FString AssetName = FPaths::GetBaseFilename(BlueprintName);
-        ObjectPath = FString::Printf(TEXT("%s.%s"), *BlueprintName, *AssetName);
-    }
-    else
-    {
-        // It's just a name, add the default /Game/Blueprints/ prefix
-        ObjectPath = FString::Printf(TEXT("/Game/Blueprints/%s.%s"), *BlueprintName, *BlueprintName);
-    }
-
-    // First, try to load the object directly, as it's the fastest method.
-    UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *ObjectPath);
-    if (Blueprint)
-    {
-        return Blueprint;
-    }
-
-    // If direct loading fails, try to find the asset using the Asset Registry.
-    // This is more robust for newly created assets.
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-    FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(ObjectPath));
-
-    if (AssetData.IsValid())
-    {
-        Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-        if (Blueprint)
-        {
-            return Blueprint;
-        }
-    }
-
-    // Fallback for cases where the asset is in memory but not yet fully saved,
-    // where it might be found via its package path.
-    FString PackagePath = TEXT("/Game/Blueprints/") + BlueprintName;
-    Blueprint = FindObject<UBlueprint>(nullptr, *PackagePath);
-
-    if (!Blueprint)
-    {
-         UE_LOG(LogTemp, Error, TEXT("FindBlueprintByName: Failed to find or load blueprint: %s"), *BlueprintName);
-    }
-
-    return Blueprint;
+    return FEpicUnrealMCPBlueprintResolver::Get().Resolve(BlueprintName);
 }
 
 UEdGraph* FEpicUnrealMCPCommonUtils::FindOrCreateEventGraph(UBlueprint* Blueprint)
@@ -289,8 +243,8 @@ UK2Node_CallFunction* FEpicUnrealMCPCommonUtils::CreateFunctionCallNode(UEdGraph
     FunctionNode->SetFromFunction(Function);
     FunctionNode->NodePosX = Position.X;
     FunctionNode->NodePosY = Position.Y;
-    Graph->AddNode(FunctionNode, true);
     FunctionNode->CreateNewGuid();
+    Graph->AddNode(FunctionNode, true);
     FunctionNode->PostPlacedNewNode();
     FunctionNode->AllocateDefaultPins();
     
@@ -362,8 +316,8 @@ UK2Node_InputAction* FEpicUnrealMCPCommonUtils::CreateInputActionNode(UEdGraph*
     InputActionNode->InputActionName = FName(*ActionName);
     InputActionNode->NodePosX = Position.X;
     InputActionNode->NodePosY = Position.Y;
-    Graph->AddNode(InputActionNode, true);
     InputActionNode->CreateNewGuid();
+    Graph->AddNode(InputActionNode, true);
     InputActionNode->PostPlacedNewNode();
     InputActionNode->AllocateDefaultPins();
     
@@ -380,8 +334,8 @@ UK2Node_Self* FEpicUnrealMCPCommonUtils::CreateSelfReferenceNode(UEdGraph* Graph
     UK2Node_Self* SelfNode = NewObject<UK2Node_Self>(Graph);
     SelfNode->NodePosX = Position.X;
     SelfNode->NodePosY = Position.Y;
-    Graph->AddNode(SelfNode, true);
     SelfNode->CreateNewGuid();
+    Graph->AddNode(SelfNode, true);
     SelfNode->PostPlacedNewNode();
     SelfNode->AllocateDefaultPins();
     
@@ -0,0 +1,289 @@
+#include "Commands/EpicUnrealMCPEditSession.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+namespace MCPEditSession
+{
+    struct FPendingBlueprint
+    {
+        TWeakObjectPtr<UBlueprint> Blueprint;
+        bool bStructural = false;
+        bool bCompile = false;
+
+        /** Compile and refresh requests folded into this entry */
+        int32 Requests = 0;
+    };
+
+    /** Open sessions of one client */
+    struct FClientSessions
+    {
+        int32 Depth = 0;
+
+        /** Blueprints touched during the session, in first-touched order */
+        TArray<FPendingBlueprint> Pending;
+    };
+
+    /** Sessions by client id; 0 stands for commands from outside any connection */
+    static TMap<int32, FClientSessions> Clients;
+
+    /** Client whose command is running */
+    static int32 CurrentClientId = 0;
+
+    static FClientSessions* FindCurrent()
+    {
+        return Clients.Find(CurrentClientId);
+    }
+
+    static FPendingBlueprint& FindOrAddPending(FClientSessions& Sessions, UBlueprint* Blueprint)
+    {
+        TArray<FPendingBlueprint>& Pending = Sessions.Pending;
+        FPendingBlueprint* Entry = Pending.FindByPredicate([Blueprint](const FPendingBlueprint& Candidate)
+        {
+            return Candidate.Blueprint.Get() == Blueprint;
+        });
+
+        if (!Entry)
+        {
+            Entry = &Pending.AddDefaulted_GetRef();
+            Entry->Blueprint = Blueprint;
+        }
+
+        ++Entry->Requests;
+        return *Entry;
+    }
+
+    static const TCHAR* StatusToString(EBlueprintStatus Status)
+    {
+        switch (Status)
+        {
+        case BS_UpToDate:
+            return TEXT("up_to_date");
+        case BS_UpToDateWithWarnings:
+            return TEXT("up_to_date_with_warnings");
+        case BS_Error:
+            return TEXT("error");
+        default:
+            return TEXT("dirty");
+        }
+    }
+
+    /** Structural refresh (if one is pending), compile, and report */
+    static TSharedPtr<FJsonObject> CompileNow(UBlueprint* Blueprint, bool bStructural, int32 Requests)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+
+        if (bStructural)
+        {
+            FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+        }
+
+        FCompilerResultsLog Results;
+        FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::None, &Results);
+
+        const double CompileMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        UE_LOG(LogTemp, Display, TEXT("EditSession: Compiled %s in %.1f ms (%d requests)"), *Blueprint->GetName(), CompileMs, Requests);
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetStringField(TEXT("name"), Blueprint->GetName());
+        ResultObj->SetStringField(TEXT("path"), Blueprint->GetPathName());
+        ResultObj->SetNumberField(TEXT("compile_ms"), CompileMs);
+        ResultObj->SetStringField(TEXT("status"), MCPEditSession::StatusToString(Blueprint->Status));
+        ResultObj->SetNumberField(TEXT("errors"), Results.NumErrors);
+        ResultObj->SetNumberField(TEXT("warnings"), Results.NumWarnings);
+        ResultObj->SetNumberField(TEXT("coalesced_requests"), Requests);
+        return ResultObj;
+    }
+
+    /** Compile (or just refresh) pending Blueprints in order */
+    static TSharedPtr<FJsonObject> CompilePending(TArray<FPendingBlueprint>&& ToCompile)
+    {
+        TArray<TSharedPtr<FJsonValue>> CompiledArray;
+        double TotalMs = 0.0;
+
+        for (const FPendingBlueprint& Entry : ToCompile)
+        {
+            UBlueprint* Blueprint = Entry.Blueprint.Get();
+            if (!Blueprint)
+            {
+                continue;
+            }
+
+            if (!Entry.bCompile)
+            {
+                // Only a refresh was asked for
+                FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+                continue;
+            }
+
+            TSharedPtr<FJsonObject> CompileObj = CompileNow(Blueprint, Entry.bStructural, Entry.Requests);
+            TotalMs += CompileObj->GetNumberField(TEXT("compile_ms"));
+            CompiledArray.Add(MakeShared<FJsonValueObject>(CompileObj));
+        }
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetArrayField(TEXT("compiled"), CompiledArray);
+        ResultObj->SetNumberField(TEXT("count"), CompiledArray.Num());
+        ResultObj->SetNumberField(TEXT("compile_ms"), TotalMs);
+        return ResultObj;
+    }
+}
+
+FEpicUnrealMCPEditSession::FScopedClient::FScopedClient(int32 ClientId)
+    : PreviousClientId(MCPEditSession::CurrentClientId)
+{
+    check(IsInGameThread());
+    MCPEditSession::CurrentClientId = ClientId;
+}
+
+FEpicUnrealMCPEditSession::FScopedClient::~FScopedClient()
+{
+    MCPEditSession::CurrentClientId = PreviousClientId;
+}
+
+void FEpicUnrealMCPEditSession::Begin()
+{
+    check(IsInGameThread());
+    ++MCPEditSession::Clients.FindOrAdd(MCPEditSession::CurrentClientId).Depth;
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPEditSession::End()
+{
+    check(IsInGameThread());
+
+    MCPEditSession::FClientSessions* Sessions = MCPEditSession::FindCurrent();
+
+    TSharedPtr<FJsonObject> ResultObj;
+    if (Sessions && Sessions->Depth > 0 && --Sessions->Depth > 0)
+    {
+        // An outer session still collects the changes
+        ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetArrayField(TEXT("compiled"), TArray<TSharedPtr<FJsonValue>>());
+        ResultObj->SetNumberField(TEXT("count"), 0);
+        ResultObj->SetNumberField(TEXT("compile_ms"), 0.0);
+    }
+    else
+    {
+        ResultObj = Flush();
+    }
+
+    Sessions = MCPEditSession::FindCurrent();
+    const int32 Depth = Sessions ? Sessions->Depth : 0;
+    if (Sessions && Depth == 0 && Sessions->Pending.Num() == 0)
+    {
+        MCPEditSession::Clients.Remove(MCPEditSession::CurrentClientId);
+    }
+
+    ResultObj->SetNumberField(TEXT("session_depth"), Depth);
+    return ResultObj;
+}
+
+bool FEpicUnrealMCPEditSession::IsActive()
+{
+    const MCPEditSession::FClientSessions* Sessions = MCPEditSession::FindCurrent();
+    return Sessions && Sessions->Depth > 0;
+}
+
+void FEpicUnrealMCPEditSession::RequestCompile(UBlueprint* Blueprint)
+{
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    if (!IsActive())
+    {
+        Compile(Blueprint);
+        return;
+    }
+
+    MCPEditSession::FindOrAddPending(*MCPEditSession::FindCurrent(), Blueprint).bCompile = true;
+}
+
+void FEpicUnrealMCPEditSession::MarkStructurallyModified(UBlueprint* Blueprint)
+{
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    if (!IsActive())
+    {
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+        return;
+    }
+
+    MCPEditSession::FindOrAddPending(*MCPEditSession::FindCurrent(), Blueprint).bStructural = true;
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPEditSession::Compile(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+
+    // Whatever any session had collected for this Blueprint is settled by this compile
+    int32 Requests = 0;
+    bool bStructural = false;
+    for (TPair<int32, MCPEditSession::FClientSessions>& Pair : MCPEditSession::Clients)
+    {
+        TArray<MCPEditSession::FPendingBlueprint>& Pending = Pair.Value.Pending;
+        const int32 PendingIndex = Pending.IndexOfByPredicate([Blueprint](const MCPEditSession::FPendingBlueprint& Candidate)
+        {
+            return Candidate.Blueprint.Get() == Blueprint;
+        });
+        if (PendingIndex != INDEX_NONE)
+        {
+            Requests += Pending[PendingIndex].Requests;
+            bStructural |= Pending[PendingIndex].bStructural;
+            Pending.RemoveAt(PendingIndex);
+        }
+    }
+
+    return MCPEditSession::CompileNow(Blueprint, bStructural, FMath::Max(Requests, 1));
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPEditSession::Flush()
+{
+    check(IsInGameThread());
+
+    TArray<MCPEditSession::FPendingBlueprint> ToCompile;
+    if (MCPEditSession::FClientSessions* Sessions = MCPEditSession::FindCurrent())
+    {
+        ToCompile = MoveTemp(Sessions->Pending);
+        Sessions->Pending.Reset();
+    }
+
+    return MCPEditSession::CompilePending(MoveTemp(ToCompile));
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPEditSession::EndClient(int32 ClientId)
+{
+    check(IsInGameThread());
+
+    MCPEditSession::FClientSessions Sessions;
+    if (!MCPEditSession::Clients.RemoveAndCopyValue(ClientId, Sessions))
+    {
+        return MCPEditSession::CompilePending({});
+    }
+
+    if (Sessions.Depth > 0)
+    {
+        UE_LOG(LogTemp, Display, TEXT("EditSession: Client %d left %d edit session(s) open, compiling %d pending blueprint(s)"),
+            ClientId, Sessions.Depth, Sessions.Pending.Num());
+    }
+
+    return MCPEditSession::CompilePending(MoveTemp(Sessions.Pending));
+}
+
+void FEpicUnrealMCPEditSession::EndAll()
+{
+    check(IsInGameThread());
+
+    TArray<int32> ClientIds;
+    MCPEditSession::Clients.GetKeys(ClientIds);
+    for (const int32 ClientId : ClientIds)
+    {
+        EndClient(ClientId);
+    }
+}
@@ -1,5 +1,7 @@
 #include "Commands/EpicUnrealMCPEditorCommands.h"
 #include "Commands/EpicUnrealMCPCommonUtils.h"
+#include "Commands/EpicUnrealMCPActorIndex.h"
+#include "Commands/EpicUnrealMCPInstancedMeshActor.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
@@ -16,6 +18,7 @@
 #include "Engine/SpotLight.h"
 #include "Camera/CameraActor.h"
 #include "Components/StaticMeshComponent.h"
+#include "Materials/MaterialInterface.h"
 #include "EditorSubsystem.h"
 #include "Subsystems/EditorActorSubsystem.h"
 #include "Engine/Blueprint.h"
@@ -28,61 +31,36 @@ FEpicUnrealMCPEditorCommands::FEpicUnrealMCPEditorCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FEpicUnrealMCPEditorCommands::RegisterCommands(FEpicUnrealMCPCommandRegistry& Registry)
 {
-    // Actor manipulation commands
-    if (CommandType == TEXT("get_actors_in_level"))
-    {
-        return HandleGetActorsInLevel(Params);
-    }
-    else if (CommandType == TEXT("find_actors_by_name"))
-    {
-        return HandleFindActorsByName(Params);
-    }
-    else if (CommandType == TEXT("spawn_actor"))
-    {
-        return HandleSpawnActor(Params);
-    }
-    else if (CommandType == TEXT("delete_actor"))
-    {
-        return HandleDeleteActor(Params);
-    }
-    else if (CommandType == TEXT("set_actor_transform"))
-    {
-        return HandleSetActorTransform(Params);
-    }
-    // Blueprint actor spawning
-    else if (CommandType == TEXT("spawn_blueprint_actor"))
-    {
-        return HandleSpawnBlueprintActor(Params);
-    }
-    // Asset management
-    else if (CommandType == TEXT("save_all"))
-    {
-        return HandleSaveAll(Params);
-    }
+    const FString Category = TEXT("editor");
+    const EMCPCommandFlags Query = EMCPCommandFlags::GameThread | EMCPCommandFlags::ReadOnly | EMCPCommandFlags::Batchable;
+    const EMCPCommandFlags Edit = EMCPCommandFlags::GameThread | EMCPCommandFlags::Batchable;
+    const EMCPCommandFlags Inspect = Query | EMCPCommandFlags::Snapshot;
 
-    return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
+    const TArray<FString> ActorQueryParams = {TEXT("name"), TEXT("label"), TEXT("class"), TEXT("tag"), TEXT("fields"), TEXT("limit"), TEXT("cursor"), TEXT("include_total")};
+
+    Registry.Register(TEXT("get_actors_in_level"), Category, Inspect, {}, ActorQueryParams,
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGetActorsInLevel(Params); });
+    Registry.Register(TEXT("find_actors_by_name"), Category, Inspect, {TEXT("pattern")}, ActorQueryParams,
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleFindActorsByName(Params); });
+    Registry.Register(TEXT("spawn_actor"), Category, Edit, {TEXT("type"), TEXT("name")}, {TEXT("location"), TEXT("rotation"), TEXT("scale"), TEXT("static_mesh")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSpawnActor(Params); });
+    Registry.Register(TEXT("delete_actor"), Category, Edit, {TEXT("name")}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleDeleteActor(Params); });
+    Registry.Register(TEXT("set_actor_transform"), Category, Edit, {TEXT("name")}, {TEXT("location"), TEXT("rotation"), TEXT("scale")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetActorTransform(Params); });
+    Registry.Register(TEXT("spawn_instanced_meshes"), Category, Edit, {TEXT("name"), TEXT("groups")}, {TEXT("location"), TEXT("mode")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSpawnInstancedMeshes(Params); });
+    Registry.Register(TEXT("spawn_blueprint_actor"), Category, Edit, {TEXT("blueprint_name"), TEXT("actor_name")}, {TEXT("location"), TEXT("rotation")},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSpawnBlueprintActor(Params); });
+    Registry.Register(TEXT("save_all"), Category, Edit, {}, {},
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleSaveAll(Params); });
 }
 
 TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
 {
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    TArray<TSharedPtr<FJsonValue>> ActorArray;
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor)
-        {
-            ActorArray.Add(FEpicUnrealMCPCommonUtils::ActorToJson(Actor));
-        }
-    }
-    
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("actors"), ActorArray);
-    
-    return ResultObj;
+    return GetActorIndex().Query(Params);
 }
 
 TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params)
@@ -92,23 +70,19 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleFindActorsByName(con
     {
         return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
     }
-    
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    TArray<TSharedPtr<FJsonValue>> MatchingActors;
-    for (AActor* Actor : AllActors)
+
+    return GetActorIndex().Query(Params, Pattern);
+}
+
+FEpicUnrealMCPActorIndex& FEpicUnrealMCPEditorCommands::GetActorIndex()
+{
+    // Built on first use, then kept current by actor notifications
+    if (!ActorIndex.IsValid())
     {
-        if (Actor && Actor->GetName().Contains(Pattern))
-        {
-            MatchingActors.Add(FEpicUnrealMCPCommonUtils::ActorToJson(Actor));
-        }
+        ActorIndex = MakeShared<FEpicUnrealMCPActorIndex>();
     }
-    
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("actors"), MatchingActors);
-    
-    return ResultObj;
+
+    return *ActorIndex;
 }
 
 TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleSpawnActor(const TSharedPtr<FJsonObject>& Params)
@@ -306,11 +280,203 @@ TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleSetActorTransform(co
     return FEpicUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
 }
 
+namespace MCPInstancedSpawn
+{
+    static FTransform TransformFromJson(const TSharedPtr<FJsonObject>& TransformObj)
+    {
+        FVector Scale(1.0f, 1.0f, 1.0f);
+        if (TransformObj->HasField(TEXT("scale")))
+        {
+            Scale = FEpicUnrealMCPCommonUtils::GetVectorFromJson(TransformObj, TEXT("scale"));
+        }
+
+        return FTransform(
+            FEpicUnrealMCPCommonUtils::GetRotatorFromJson(TransformObj, TEXT("rotation")),
+            FEpicUnrealMCPCommonUtils::GetVectorFromJson(TransformObj, TEXT("location")),
+            Scale);
+    }
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleSpawnInstancedMeshes(const TSharedPtr<FJsonObject>& Params)
+{
+    FString ActorName;
+    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* GroupsJson = nullptr;
+    if (!Params->TryGetArrayField(TEXT("groups"), GroupsJson))
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'groups' array"));
+    }
+
+    FString Mode = TEXT("instanced");
+    Params->TryGetStringField(TEXT("mode"), Mode);
+    const bool bInstanced = Mode == TEXT("instanced");
+    if (!bInstanced && Mode != TEXT("actors"))
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown mode: %s (expected 'instanced' or 'actors')"), *Mode));
+    }
+
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Parse and load everything first, so a bad group spawns nothing
+    TArray<FMCPInstancedMeshGroup> Groups;
+    TArray<TArray<FString>> GroupNames;
+    Groups.Reserve(GroupsJson->Num());
+    GroupNames.Reserve(GroupsJson->Num());
+    int32 InstanceCount = 0;
+    for (int32 GroupIndex = 0; GroupIndex < GroupsJson->Num(); ++GroupIndex)
+    {
+        const TSharedPtr<FJsonObject>* GroupObj = nullptr;
+        if (!(*GroupsJson)[GroupIndex]->TryGetObject(GroupObj))
+        {
+            return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Group %d is not an object"), GroupIndex));
+        }
+
+        FMCPInstancedMeshGroup& Group = Groups.AddDefaulted_GetRef();
+        if (!(*GroupObj)->TryGetStringField(TEXT("static_mesh"), Group.MeshPath))
+        {
+            return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Group %d is missing 'static_mesh'"), GroupIndex));
+        }
+
+        Group.Mesh = Cast<UStaticMesh>(UEditorAssetLibrary::LoadAsset(Group.MeshPath));
+        if (!Group.Mesh)
+        {
+            return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Could not find static mesh at path: %s"), *Group.MeshPath));
+        }
+
+        if ((*GroupObj)->TryGetStringField(TEXT("material"), Group.MaterialPath) && !Group.MaterialPath.IsEmpty())
+        {
+            Group.Material = Cast<UMaterialInterface>(UEditorAssetLibrary::LoadAsset(Group.MaterialPath));
+            if (!Group.Material)
+            {
+                return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Could not find material at path: %s"), *Group.MaterialPath));
+            }
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* TransformsJson = nullptr;
+        if (!(*GroupObj)->TryGetArrayField(TEXT("transforms"), TransformsJson))
+        {
+            return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Group %d is missing 'transforms'"), GroupIndex));
+        }
+
+        Group.Transforms.Reserve(TransformsJson->Num());
+        for (const TSharedPtr<FJsonValue>& TransformValue : *TransformsJson)
+        {
+            const TSharedPtr<FJsonObject>* TransformObj = nullptr;
+            if (!TransformValue->TryGetObject(TransformObj))
+            {
+                return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Group %d has a transform that is not an object"), GroupIndex));
+            }
+            Group.Transforms.Add(MCPInstancedSpawn::TransformFromJson(*TransformObj));
+        }
+        InstanceCount += Group.Transforms.Num();
+
+        // Optional actor names for actors mode, one per transform
+        TArray<FString>& Names = GroupNames.AddDefaulted_GetRef();
+        const TArray<TSharedPtr<FJsonValue>>* NamesJson = nullptr;
+        if ((*GroupObj)->TryGetArrayField(TEXT("names"), NamesJson))
+        {
+            for (const TSharedPtr<FJsonValue>& NameValue : *NamesJson)
+            {
+                Names.Add(NameValue->AsString());
+            }
+        }
+    }
+
+    TSharedPtr<FJsonObject> ResultObj;
+    if (bInstanced)
+    {
+        // Instance transforms are world space; the actor sits at the optional location
+        const FTransform ActorTransform(FEpicUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location")));
+        ResultObj = FEpicUnrealMCPInstancedMeshActor::Spawn(World, ActorName, ActorTransform, Groups, true);
+        if (ResultObj->HasField(TEXT("success")))
+        {
+            return ResultObj;
+        }
+    }
+    else
+    {
+        // Individual StaticMeshActors, named from the group's names or <name>_<group>_<index>
+        TArray<TSharedPtr<FJsonValue>> ActorNames;
+        TArray<TSharedPtr<FJsonValue>> GroupResults;
+        ActorNames.Reserve(InstanceCount);
+        int32 DrawCalls = 0;
+        for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+        {
+            const FMCPInstancedMeshGroup& Group = Groups[GroupIndex];
+            const TArray<FString>& Names = GroupNames[GroupIndex];
+            int32 GroupSpawned = 0;
+
+            for (int32 Index = 0; Index < Group.Transforms.Num(); ++Index)
+            {
+                const FString InstanceName = Names.IsValidIndex(Index) && !Names[Index].IsEmpty()
+                    ? Names[Index]
+                    : FString::Printf(TEXT("%s_%d_%d"), *ActorName, GroupIndex, Index);
+                if (FindObject<AActor>(World->PersistentLevel, *InstanceName))
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("spawn_instanced_meshes: Actor with name '%s' already exists, skipped"), *InstanceName);
+                    continue;
+                }
+
+                FActorSpawnParameters SpawnParams;
+                SpawnParams.Name = *InstanceName;
+                AStaticMeshActor* MeshActor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Group.Transforms[Index], SpawnParams);
+                if (!MeshActor)
+                {
+                    continue;
+                }
+
+                MeshActor->GetStaticMeshComponent()->SetStaticMesh(Group.Mesh);
+                FEpicUnrealMCPInstancedMeshActor::ApplyMaterial(MeshActor->GetStaticMeshComponent(), Group.Material);
+
+                ActorNames.Add(MakeShared<FJsonValueString>(MeshActor->GetName()));
+                ++GroupSpawned;
+            }
+
+            DrawCalls += FEpicUnrealMCPInstancedMeshActor::DrawCallsPerCopy(Group.Mesh) * GroupSpawned;
+
+            TSharedPtr<FJsonObject> GroupResult = MakeShared<FJsonObject>();
+            GroupResult->SetStringField(TEXT("static_mesh"), Group.MeshPath);
+            GroupResult->SetStringField(TEXT("material"), Group.MaterialPath);
+            GroupResult->SetNumberField(TEXT("instances"), GroupSpawned);
+            GroupResults.Add(MakeShared<FJsonValueObject>(GroupResult));
+        }
+
+        ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetArrayField(TEXT("actors"), ActorNames);
+        ResultObj->SetArrayField(TEXT("groups"), GroupResults);
+        ResultObj->SetNumberField(TEXT("instance_count"), InstanceCount);
+        ResultObj->SetNumberField(TEXT("actors_spawned"), ActorNames.Num());
+        ResultObj->SetNumberField(TEXT("draw_calls"), DrawCalls);
+        ResultObj->SetNumberField(TEXT("draw_calls_as_actors"), DrawCalls);
+    }
+
+    const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    ResultObj->SetStringField(TEXT("mode"), Mode);
+    ResultObj->SetNumberField(TEXT("elapsed_ms"), ElapsedSeconds * 1000.0);
+    ResultObj->SetNumberField(TEXT("instances_per_second"), ElapsedSeconds > 0.0 ? InstanceCount / ElapsedSeconds : 0.0);
+
+    UE_LOG(LogTemp, Display, TEXT("spawn_instanced_meshes: %d instances in %d groups as %d actors (%d draw calls instead of %d) in %.1f ms"),
+        InstanceCount, Groups.Num(), (int32)ResultObj->GetNumberField(TEXT("actors_spawned")),
+        (int32)ResultObj->GetNumberField(TEXT("draw_calls")), (int32)ResultObj->GetNumberField(TEXT("draw_calls_as_actors")), ElapsedSeconds * 1000.0);
+
+    return ResultObj;
+}
+
 TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params)
 {
     // This function will now correctly call the implementation in BlueprintCommands
     FEpicUnrealMCPBlueprintCommands BlueprintCommands;
-    return BlueprintCommands.HandleCommand(TEXT("spawn_blueprint_actor"), Params);
+    return BlueprintCommands.HandleSpawnBlueprintActor(Params);
 }
 
 TSharedPtr<FJsonObject> FEpicUnrealMCPEditorCommands::HandleSaveAll(const TSharedPtr<FJsonObject>& Params)
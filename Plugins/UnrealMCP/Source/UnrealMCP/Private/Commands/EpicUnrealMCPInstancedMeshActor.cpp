@@ -0,0 +1,100 @@
+#include "Commands/EpicUnrealMCPInstancedMeshActor.h"
+#include "Commands/EpicUnrealMCPCommonUtils.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInterface.h"
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPInstancedMeshActor::Spawn(UWorld* World, const FString& ActorName, const FTransform& ActorTransform,
+    const TArray<FMCPInstancedMeshGroup>& Groups, bool bWorldSpace)
+{
+    if (!World)
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    if (FindObject<AActor>(World->PersistentLevel, *ActorName))
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Name = *ActorName;
+    AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), ActorTransform, SpawnParams);
+    if (!Actor)
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to create actor"));
+    }
+
+    // A plain actor has no root, so the spawn transform is applied once the root exists
+    USceneComponent* Root = NewObject<USceneComponent>(Actor, TEXT("Root"), RF_Transactional);
+    Actor->SetRootComponent(Root);
+    Actor->AddInstanceComponent(Root);
+    Root->RegisterComponent();
+    Root->SetWorldTransform(ActorTransform);
+
+    TArray<TSharedPtr<FJsonValue>> GroupResults;
+    int32 InstanceCount = 0;
+    int32 DrawCalls = 0;
+    int32 DrawCallsAsActors = 0;
+
+    for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+    {
+        const FMCPInstancedMeshGroup& Group = Groups[GroupIndex];
+        if (!Group.Mesh || Group.Transforms.Num() == 0)
+        {
+            continue;
+        }
+
+        const FName ComponentName(*FString::Printf(TEXT("%s_%d"), *Group.Mesh->GetName(), GroupIndex));
+        UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(Actor, ComponentName, RF_Transactional);
+        Component->SetStaticMesh(Group.Mesh);
+        ApplyMaterial(Component, Group.Material);
+        Component->SetupAttachment(Root);
+        Actor->AddInstanceComponent(Component);
+        Component->RegisterComponent();
+        Component->AddInstances(Group.Transforms, false, bWorldSpace);
+
+        const int32 Sections = DrawCallsPerCopy(Group.Mesh);
+        InstanceCount += Group.Transforms.Num();
+        DrawCalls += Sections;
+        DrawCallsAsActors += Sections * Group.Transforms.Num();
+
+        TSharedPtr<FJsonObject> GroupResult = MakeShared<FJsonObject>();
+        GroupResult->SetStringField(TEXT("component"), ComponentName.ToString());
+        GroupResult->SetStringField(TEXT("static_mesh"), Group.MeshPath);
+        GroupResult->SetStringField(TEXT("material"), Group.MaterialPath);
+        GroupResult->SetNumberField(TEXT("instances"), Component->GetInstanceCount());
+        GroupResults.Add(MakeShared<FJsonValueObject>(GroupResult));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("actor"), Actor->GetName());
+    ResultObj->SetArrayField(TEXT("groups"), GroupResults);
+    ResultObj->SetNumberField(TEXT("instance_count"), InstanceCount);
+    ResultObj->SetNumberField(TEXT("actors_spawned"), 1);
+    // Estimates: one draw per mesh section per component, before culling and LOD
+    ResultObj->SetNumberField(TEXT("draw_calls"), DrawCalls);
+    ResultObj->SetNumberField(TEXT("draw_calls_as_actors"), DrawCallsAsActors);
+    return ResultObj;
+}
+
+int32 FEpicUnrealMCPInstancedMeshActor::DrawCallsPerCopy(const UStaticMesh* Mesh)
+{
+    return Mesh ? FMath::Max(1, Mesh->GetNumSections(0)) : 0;
+}
+
+void FEpicUnrealMCPInstancedMeshActor::ApplyMaterial(UStaticMeshComponent* Component, UMaterialInterface* Material)
+{
+    if (!Component || !Material)
+    {
+        return;
+    }
+
+    for (int32 SlotIndex = 0; SlotIndex < FMath::Max(1, Component->GetNumMaterials()); ++SlotIndex)
+    {
+        Component->SetMaterial(SlotIndex, Material);
+    }
+}
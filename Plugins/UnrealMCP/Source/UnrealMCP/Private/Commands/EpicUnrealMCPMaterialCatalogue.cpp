@@ -0,0 +1,221 @@
+#include "Commands/EpicUnrealMCPMaterialCatalogue.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Materials/MaterialInterface.h"
+
+namespace MCPMaterialCatalogue
+{
+    /** Page size when the request gives no limit */
+    static constexpr int32 DefaultLimit = 1000;
+
+    static IAssetRegistry& GetAssetRegistry()
+    {
+        return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    }
+}
+
+FEpicUnrealMCPMaterialCatalogue::FEpicUnrealMCPMaterialCatalogue()
+{
+}
+
+FEpicUnrealMCPMaterialCatalogue::~FEpicUnrealMCPMaterialCatalogue()
+{
+    if (!AssetAddedHandle.IsValid() || !FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")))
+    {
+        return;
+    }
+
+    IAssetRegistry& AssetRegistry = MCPMaterialCatalogue::GetAssetRegistry();
+    AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+    AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+    AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+    AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+}
+
+void FEpicUnrealMCPMaterialCatalogue::EnsureBuilt()
+{
+    if (bBuilt)
+    {
+        return;
+    }
+
+    IAssetRegistry& AssetRegistry = MCPMaterialCatalogue::GetAssetRegistry();
+
+    const FTopLevelAssetPath MaterialInterfacePath = UMaterialInterface::StaticClass()->GetClassPathName();
+    MaterialClasses.Reset();
+    AssetRegistry.GetDerivedClassNames({MaterialInterfacePath}, {}, MaterialClasses);
+    MaterialClasses.Add(MaterialInterfacePath);
+
+    // Registry data only: nothing is loaded
+    FARFilter Filter;
+    Filter.ClassPaths.Add(MaterialInterfacePath);
+    Filter.bRecursiveClasses = true;
+
+    TArray<FAssetData> AssetDataArray;
+    AssetRegistry.GetAssets(Filter, AssetDataArray);
+
+    Entries.Reset();
+    Entries.Reserve(AssetDataArray.Num());
+    for (const FAssetData& AssetData : AssetDataArray)
+    {
+        AddAsset(AssetData);
+    }
+    bSortedPathsDirty = true;
+
+    if (!AssetAddedHandle.IsValid())
+    {
+        AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FEpicUnrealMCPMaterialCatalogue::OnAssetAdded);
+        AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FEpicUnrealMCPMaterialCatalogue::OnAssetRemoved);
+        AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FEpicUnrealMCPMaterialCatalogue::OnAssetRenamed);
+        FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FEpicUnrealMCPMaterialCatalogue::OnFilesLoaded);
+    }
+
+    bBuilt = true;
+    UE_LOG(LogTemp, Log, TEXT("MaterialCatalogue: Built with %d materials%s"), Entries.Num(),
+           AssetRegistry.IsLoadingAssets() ? TEXT(" (asset registry still scanning)") : TEXT(""));
+}
+
+void FEpicUnrealMCPMaterialCatalogue::AddAsset(const FAssetData& AssetData)
+{
+    if (!MaterialClasses.Contains(AssetData.AssetClassPath))
+    {
+        return;
+    }
+
+    FMaterialEntry Entry;
+    Entry.Name = AssetData.AssetName.ToString();
+    Entry.Path = AssetData.GetObjectPathString();
+    Entry.Package = AssetData.PackageName.ToString();
+    Entry.Class = AssetData.AssetClassPath.ToString();
+
+    if (!Entries.Contains(Entry.Path))
+    {
+        bSortedPathsDirty = true;
+    }
+    Entries.Add(Entry.Path, MoveTemp(Entry));
+}
+
+void FEpicUnrealMCPMaterialCatalogue::OnAssetAdded(const FAssetData& AssetData)
+{
+    AddAsset(AssetData);
+}
+
+void FEpicUnrealMCPMaterialCatalogue::OnAssetRemoved(const FAssetData& AssetData)
+{
+    if (Entries.Remove(AssetData.GetObjectPathString()) > 0)
+    {
+        bSortedPathsDirty = true;
+    }
+}
+
+void FEpicUnrealMCPMaterialCatalogue::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    if (Entries.Remove(OldObjectPath) > 0)
+    {
+        bSortedPathsDirty = true;
+    }
+    AddAsset(AssetData);
+}
+
+void FEpicUnrealMCPMaterialCatalogue::OnFilesLoaded()
+{
+    // The initial scan has finished: rebuild once with the complete class hierarchy
+    bBuilt = false;
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPMaterialCatalogue::Query(const TSharedPtr<FJsonObject>& Params)
+{
+    EnsureBuilt();
+
+    if (bSortedPathsDirty)
+    {
+        Entries.GenerateKeyArray(SortedPaths);
+        SortedPaths.Sort();
+        bSortedPathsDirty = false;
+    }
+
+    // Same path rules as before: one content root (default /Game/), plus /Engine/ unless excluded
+    FString SearchPath;
+    Params->TryGetStringField(TEXT("search_path"), SearchPath);
+    if (!SearchPath.IsEmpty())
+    {
+        if (!SearchPath.StartsWith(TEXT("/")))
+        {
+            SearchPath = TEXT("/") + SearchPath;
+        }
+        if (!SearchPath.EndsWith(TEXT("/")))
+        {
+            SearchPath += TEXT("/");
+        }
+    }
+
+    bool bIncludeEngineMaterials = true;
+    Params->TryGetBoolField(TEXT("include_engine_materials"), bIncludeEngineMaterials);
+
+    TArray<FString, TInlineAllocator<2>> Roots;
+    Roots.Add(SearchPath.IsEmpty() ? TEXT("/Game/") : SearchPath);
+    if (bIncludeEngineMaterials)
+    {
+        Roots.AddUnique(TEXT("/Engine/"));
+    }
+
+    FString NameFilter;
+    Params->TryGetStringField(TEXT("name_filter"), NameFilter);
+
+    FString ClassFilter;
+    Params->TryGetStringField(TEXT("class_filter"), ClassFilter);
+
+    int32 Offset = 0;
+    Params->TryGetNumberField(TEXT("offset"), Offset);
+    Offset = FMath::Max(Offset, 0);
+
+    int32 Limit = MCPMaterialCatalogue::DefaultLimit;
+    Params->TryGetNumberField(TEXT("limit"), Limit);
+
+    TArray<TSharedPtr<FJsonValue>> MaterialArray;
+    int32 Total = 0;
+
+    for (const FString& Path : SortedPaths)
+    {
+        const FMaterialEntry& Entry = Entries.FindChecked(Path);
+
+        // Package paths are compared with a trailing slash so /Game/Mat does not match /Game/Materials
+        const FString PackageFolder = Entry.Package + TEXT("/");
+        if (!Roots.ContainsByPredicate([&PackageFolder](const FString& Root) { return PackageFolder.StartsWith(Root); }))
+        {
+            continue;
+        }
+        if (!NameFilter.IsEmpty() && !Entry.Name.Contains(NameFilter))
+        {
+            continue;
+        }
+        if (!ClassFilter.IsEmpty() && !Entry.Class.Equals(ClassFilter) && !Entry.Class.EndsWith(TEXT(".") + ClassFilter))
+        {
+            continue;
+        }
+
+        if (Total >= Offset && (Limit <= 0 || MaterialArray.Num() < Limit))
+        {
+            TSharedPtr<FJsonObject> MaterialObj = MakeShared<FJsonObject>();
+            MaterialObj->SetStringField(TEXT("name"), Entry.Name);
+            MaterialObj->SetStringField(TEXT("path"), Entry.Path);
+            MaterialObj->SetStringField(TEXT("package"), Entry.Package);
+            MaterialObj->SetStringField(TEXT("class"), Entry.Class);
+            MaterialArray.Add(MakeShared<FJsonValueObject>(MaterialObj));
+        }
+        ++Total;
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("materials"), MaterialArray);
+    ResultObj->SetNumberField(TEXT("count"), MaterialArray.Num());
+    ResultObj->SetNumberField(TEXT("total"), Total);
+    ResultObj->SetNumberField(TEXT("offset"), Offset);
+    if (Offset + MaterialArray.Num() < Total)
+    {
+        ResultObj->SetNumberField(TEXT("next_offset"), Offset + MaterialArray.Num());
+    }
+    ResultObj->SetStringField(TEXT("search_path_used"), Roots[0]);
+
+    return ResultObj;
+}
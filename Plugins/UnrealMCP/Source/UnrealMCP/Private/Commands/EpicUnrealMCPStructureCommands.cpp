@@ -0,0 +1,724 @@
+#include "Commands/EpicUnrealMCPStructureCommands.h"
+#include "Commands/EpicUnrealMCPCommonUtils.h"
+#include "Commands/EpicUnrealMCPInstancedMeshActor.h"
+#include "Async/ParallelFor.h"
+#include "Editor.h"
+#include "EditorAssetLibrary.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+
+namespace MCPStructure
+{
+    /** What a placement is part of; each role becomes one instanced component */
+    enum ERole : int32
+    {
+        Walls,
+        Floors,
+        Trim,
+        NumRoles
+    };
+
+    /** Upper bound on any count parameter, so a typo cannot generate millions of instances */
+    static constexpr int32 MaxCount = 500;
+
+    /** Upper bound on the instances one structure may place; sizes are checked against it before generating */
+    static constexpr int32 MaxInstances = 500000;
+
+    /** Placements of one unit of work (a floor, a course, an arch) */
+    struct FChunk
+    {
+        TArray<FTransform> Roles[NumRoles];
+    };
+
+    /** Mesh sizes the placement code scales against; read-only during generation */
+    struct FContext
+    {
+        FVector MeshSize[NumRoles];
+
+        /** Add a box of the given size centred at Center */
+        void AddBox(FChunk& Chunk, ERole Role, const FVector& Center, const FVector& Size, const FRotator& Rotation = FRotator::ZeroRotator) const
+        {
+            Chunk.Roles[Role].Emplace(Rotation, Center, Size / MeshSize[Role]);
+        }
+    };
+
+    /** A hole in a wall, in wall-local coordinates */
+    struct FOpening
+    {
+        float Center = 0.0f;
+        float Width = 0.0f;
+        float Bottom = 0.0f;
+        float Top = 0.0f;
+
+        float Left() const { return Center - Width * 0.5f; }
+        float Right() const { return Center + Width * 0.5f; }
+    };
+
+    /** How a straight wall is laid */
+    struct FWallStyle
+    {
+        bool bBrick = false;
+        FVector2D BrickSize = FVector2D(50.0f, 25.0f);
+        float Mortar = 1.0f;
+        float Jitter = 0.0f;
+
+        /** Course index of the wall's first course, so stacked walls keep the running bond */
+        int32 FirstCourse = 0;
+    };
+
+    /**
+     * Lay a straight wall from Start along Direction
+     * Start is the base of the wall's centre line; openings are cut out of it.
+     */
+    static void AddWall(const FContext& Context, FChunk& Chunk, ERole Role, const FVector& Start, const FVector& Direction,
+        float Length, float Height, float Thickness, const FWallStyle& Style, TArray<FOpening> Openings, FRandomStream& Rng)
+    {
+        if (Length <= KINDA_SMALL_NUMBER || Height <= KINDA_SMALL_NUMBER)
+        {
+            return;
+        }
+
+        const FRotator Rotation(0.0f, FMath::RadiansToDegrees(FMath::Atan2(Direction.Y, Direction.X)), 0.0f);
+        const FVector Normal(-Direction.Y, Direction.X, 0.0f);
+        Openings.Sort([](const FOpening& A, const FOpening& B) { return A.Center < B.Center; });
+
+        // A horizontal run [X0, X1] x [Z0, Z1] of the wall, minus the openings it crosses
+        auto AddSpan = [&](float X0, float X1, float Z0, float Z1, float Depth)
+        {
+            float Cursor = X0;
+            for (const FOpening& Opening : Openings)
+            {
+                if (Opening.Right() <= Cursor || Opening.Left() >= X1 || Opening.Top <= Z0 || Opening.Bottom >= Z1)
+                {
+                    continue;
+                }
+                if (Opening.Left() > Cursor)
+                {
+                    const float Mid = (Cursor + Opening.Left()) * 0.5f;
+                    Context.AddBox(Chunk, Role, Start + Direction * Mid + Normal * Depth + FVector(0.0f, 0.0f, (Z0 + Z1) * 0.5f),
+                        FVector(Opening.Left() - Cursor, Thickness, Z1 - Z0), Rotation);
+                }
+                Cursor = FMath::Max(Cursor, Opening.Right());
+            }
+            if (X1 - Cursor > KINDA_SMALL_NUMBER)
+            {
+                const float Mid = (Cursor + X1) * 0.5f;
+                Context.AddBox(Chunk, Role, Start + Direction * Mid + Normal * Depth + FVector(0.0f, 0.0f, (Z0 + Z1) * 0.5f),
+                    FVector(X1 - Cursor, Thickness, Z1 - Z0), Rotation);
+            }
+        };
+
+        if (!Style.bBrick)
+        {
+            // Full-height piers between openings, then the parts below and above each opening
+            float Cursor = 0.0f;
+            for (const FOpening& Opening : Openings)
+            {
+                if (Opening.Left() > Cursor)
+                {
+                    AddSpan(Cursor, Opening.Left(), 0.0f, Height, 0.0f);
+                }
+                const float Left = FMath::Max(Opening.Left(), Cursor);
+                const float Right = FMath::Min(Opening.Right(), Length);
+                if (Right > Left)
+                {
+                    if (Opening.Bottom > 0.0f)
+                    {
+                        Context.AddBox(Chunk, Role, Start + Direction * ((Left + Right) * 0.5f) + FVector(0.0f, 0.0f, Opening.Bottom * 0.5f),
+                            FVector(Right - Left, Thickness, Opening.Bottom), Rotation);
+                    }
+                    if (Opening.Top < Height)
+                    {
+                        Context.AddBox(Chunk, Role, Start + Direction * ((Left + Right) * 0.5f) + FVector(0.0f, 0.0f, (Opening.Top + Height) * 0.5f),
+                            FVector(Right - Left, Thickness, Height - Opening.Top), Rotation);
+                    }
+                }
+                Cursor = FMath::Max(Cursor, Opening.Right());
+            }
+            if (Cursor < Length)
+            {
+                AddSpan(Cursor, Length, 0.0f, Height, 0.0f);
+            }
+            return;
+        }
+
+        // Running bond: every other course starts half a brick in
+        const int32 Courses = FMath::Max(1, FMath::RoundToInt(Height / Style.BrickSize.Y));
+        const float CourseHeight = Height / Courses;
+        for (int32 Course = 0; Course < Courses; ++Course)
+        {
+            const float Z0 = Course * CourseHeight;
+            const float Offset = ((Style.FirstCourse + Course) % 2) ? Style.BrickSize.X * 0.5f : 0.0f;
+            for (float X = -Offset; X < Length; X += Style.BrickSize.X)
+            {
+                const float X0 = FMath::Max(X, 0.0f) + Style.Mortar * 0.5f;
+                const float X1 = FMath::Min(X + Style.BrickSize.X, Length) - Style.Mortar * 0.5f;
+                if (X1 - X0 > KINDA_SMALL_NUMBER)
+                {
+                    const float Depth = Style.Jitter > 0.0f ? Rng.FRandRange(-Style.Jitter, Style.Jitter) : 0.0f;
+                    AddSpan(X0, X1, Z0 + Style.Mortar * 0.5f, Z0 + CourseHeight - Style.Mortar * 0.5f, Depth);
+                }
+            }
+        }
+    }
+
+    static float GetNumber(const TSharedPtr<FJsonObject>& Params, const TCHAR* Field, float Default)
+    {
+        double Value = Default;
+        Params->TryGetNumberField(Field, Value);
+        return (float)Value;
+    }
+
+    static int32 GetInt(const TSharedPtr<FJsonObject>& Params, const TCHAR* Field, int32 Default)
+    {
+        int32 Value = Default;
+        Params->TryGetNumberField(Field, Value);
+        return Value;
+    }
+
+    static bool GetBool(const TSharedPtr<FJsonObject>& Params, const TCHAR* Field, bool Default)
+    {
+        bool Value = Default;
+        Params->TryGetBoolField(Field, Value);
+        return Value;
+    }
+
+    static FWallStyle GetWallStyle(const TSharedPtr<FJsonObject>& Params)
+    {
+        FWallStyle Style;
+        FString StyleName = TEXT("solid");
+        Params->TryGetStringField(TEXT("wall_style"), StyleName);
+        Style.bBrick = StyleName == TEXT("brick");
+        if (Params->HasField(TEXT("brick_size")))
+        {
+            Style.BrickSize = FEpicUnrealMCPCommonUtils::GetVector2DFromJson(Params, TEXT("brick_size"));
+        }
+        Style.BrickSize.X = FMath::Max(Style.BrickSize.X, 5.0f);
+        Style.BrickSize.Y = FMath::Max(Style.BrickSize.Y, 5.0f);
+        Style.Mortar = FMath::Max(0.0f, GetNumber(Params, TEXT("mortar"), 1.0f));
+        Style.Jitter = FMath::Max(0.0f, GetNumber(Params, TEXT("jitter"), 0.0f));
+        return Style;
+    }
+
+    /** Distance between window bays, leaving room between windows */
+    static float WindowBaySpacing(float Spacing, float Width)
+    {
+        return FMath::Max3(Spacing, Width + 20.0f, 1.0f);
+    }
+
+    /**
+     * Upper bound on the boxes AddWall lays for a wall
+     * @param Openings - Most openings the wall can have
+     */
+    static double EstimateWallInstances(float Length, float Height, const FWallStyle& Style, double Openings)
+    {
+        if (!Style.bBrick)
+        {
+            // A pier before each opening, the parts below and above it, and the last pier
+            return 3.0 * Openings + 1.0;
+        }
+
+        // Each course: the bricks, one partial brick at either end, and a split brick per opening
+        const double Courses = FMath::Max(1.0, FMath::RoundToDouble((double)Height / Style.BrickSize.Y));
+        return Courses * ((double)Length / Style.BrickSize.X + 2.0 + Openings);
+    }
+
+    /** Window and door openings spread evenly over a wall, each kept with probability Density */
+    static TArray<FOpening> MakeWindows(float Length, float Spacing, float Width, float Sill, float WindowHeight, float Density,
+        bool bDoor, float DoorWidth, float DoorHeight, FRandomStream& Rng)
+    {
+        TArray<FOpening> Openings;
+        const int32 Bays = FMath::FloorToInt(Length / WindowBaySpacing(Spacing, Width));
+        for (int32 Bay = 0; Bay < Bays; ++Bay)
+        {
+            const float Center = (Bay + 0.5f) * Length / Bays;
+            if (bDoor && Bay == Bays / 2)
+            {
+                Openings.Add({Center, DoorWidth, 0.0f, DoorHeight});
+            }
+            else if (Rng.FRand() < Density)
+            {
+                Openings.Add({Center, Width, Sill, Sill + WindowHeight});
+            }
+        }
+        if (bDoor && Bays == 0)
+        {
+            Openings.Add({Length * 0.5f, FMath::Min(DoorWidth, Length * 0.8f), 0.0f, DoorHeight});
+        }
+        return Openings;
+    }
+
+    /**
+     * Run a generator and spawn its output
+     * Units are generated in parallel, each with its own random stream derived from the seed,
+     * and merged in unit order, so the result only depends on the parameters.
+     * @param EstimatedInstances - Upper bound on the instances the units place; over MaxInstances is an error
+     */
+    static TSharedPtr<FJsonObject> Generate(const TSharedPtr<FJsonObject>& Params, const FString& GeneratorName, int32 NumUnits, double EstimatedInstances,
+        const TCHAR* DefaultFloorMesh, TFunctionRef<void(const FContext&, int32, FChunk&, FRandomStream&)> GenerateUnit)
+    {
+        if (!(EstimatedInstances <= MaxInstances))
+        {
+            return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+                TEXT("%s would place up to %.0f instances (limit %d); reduce the size or use larger blocks"), *GeneratorName, EstimatedInstances, MaxInstances));
+        }
+
+        FString ActorName;
+        if (!Params->TryGetStringField(TEXT("name"), ActorName))
+        {
+            return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+        }
+
+        UWorld* World = GEditor->GetEditorWorldContext().World();
+        if (!World)
+        {
+            return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+
+        // Per-role mesh and material; floors and trim fall back to the wall mesh and material
+        const TCHAR* MeshFields[NumRoles] = {TEXT("mesh"), TEXT("floor_mesh"), TEXT("trim_mesh")};
+        const TCHAR* MaterialFields[NumRoles] = {TEXT("material"), TEXT("floor_material"), TEXT("trim_material")};
+        TArray<FMCPInstancedMeshGroup> Groups;
+        Groups.SetNum(NumRoles);
+        FContext Context;
+        for (int32 Role = 0; Role < NumRoles; ++Role)
+        {
+            FMCPInstancedMeshGroup& Group = Groups[Role];
+            if (!Params->TryGetStringField(MeshFields[Role], Group.MeshPath))
+            {
+                Group.MeshPath = Role == Floors && DefaultFloorMesh ? DefaultFloorMesh : Groups[Walls].MeshPath;
+                if (Group.MeshPath.IsEmpty())
+                {
+                    Group.MeshPath = TEXT("/Engine/BasicShapes/Cube.Cube");
+                }
+            }
+            Group.Mesh = Cast<UStaticMesh>(UEditorAssetLibrary::LoadAsset(Group.MeshPath));
+            if (!Group.Mesh)
+            {
+                return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Could not find static mesh at path: %s"), *Group.MeshPath));
+            }
+
+            if (!Params->TryGetStringField(MaterialFields[Role], Group.MaterialPath))
+            {
+                Group.MaterialPath = Groups[Walls].MaterialPath;
+            }
+            if (!Group.MaterialPath.IsEmpty())
+            {
+                Group.Material = Cast<UMaterialInterface>(UEditorAssetLibrary::LoadAsset(Group.MaterialPath));
+                if (!Group.Material)
+                {
+                    return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Could not find material at path: %s"), *Group.MaterialPath));
+                }
+            }
+
+            // Boxes are sized against the mesh bounds (100 units for the engine's basic shapes)
+            const FVector BoundsSize = Group.Mesh->GetBoundingBox().GetSize();
+            Context.MeshSize[Role] = FVector(
+                BoundsSize.X > KINDA_SMALL_NUMBER ? BoundsSize.X : 100.0f,
+                BoundsSize.Y > KINDA_SMALL_NUMBER ? BoundsSize.Y : 100.0f,
+                BoundsSize.Z > KINDA_SMALL_NUMBER ? BoundsSize.Z : 100.0f);
+        }
+
+        const int32 Seed = GetInt(Params, TEXT("seed"), 0);
+        TArray<FChunk> Chunks;
+        Chunks.SetNum(NumUnits);
+        ParallelFor(NumUnits, [&](int32 Unit)
+        {
+            FRandomStream Rng((int32)HashCombine(GetTypeHash(Seed), GetTypeHash(Unit)));
+            GenerateUnit(Context, Unit, Chunks[Unit], Rng);
+        });
+
+        for (int32 Role = 0; Role < NumRoles; ++Role)
+        {
+            int32 Count = 0;
+            for (const FChunk& Chunk : Chunks)
+            {
+                Count += Chunk.Roles[Role].Num();
+            }
+            Groups[Role].Transforms.Reserve(Count);
+            for (FChunk& Chunk : Chunks)
+            {
+                Groups[Role].Transforms.Append(MoveTemp(Chunk.Roles[Role]));
+            }
+        }
+        const double PlacementSeconds = FPlatformTime::Seconds() - StartTime;
+
+        const FTransform ActorTransform(
+            FEpicUnrealMCPCommonUtils::GetRotatorFromJson(Params, TEXT("rotation")),
+            FEpicUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location")));
+        TSharedPtr<FJsonObject> ResultObj = FEpicUnrealMCPInstancedMeshActor::Spawn(World, ActorName, ActorTransform, Groups, false);
+        if (ResultObj->HasField(TEXT("success")))
+        {
+            return ResultObj;
+        }
+
+        const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+        const int32 InstanceCount = (int32)ResultObj->GetNumberField(TEXT("instance_count"));
+        ResultObj->SetStringField(TEXT("generator"), GeneratorName);
+        ResultObj->SetNumberField(TEXT("seed"), Seed);
+        ResultObj->SetNumberField(TEXT("units"), NumUnits);
+        ResultObj->SetNumberField(TEXT("placement_ms"), PlacementSeconds * 1000.0);
+        ResultObj->SetNumberField(TEXT("elapsed_ms"), ElapsedSeconds * 1000.0);
+        ResultObj->SetNumberField(TEXT("instances_per_second"), ElapsedSeconds > 0.0 ? InstanceCount / ElapsedSeconds : 0.0);
+
+        UE_LOG(LogTemp, Display, TEXT("%s: %d instances from %d units in %.1f ms (placement %.1f ms)"),
+            *GeneratorName, InstanceCount, NumUnits, ElapsedSeconds * 1000.0, PlacementSeconds * 1000.0);
+
+        return ResultObj;
+    }
+}
+
+FEpicUnrealMCPStructureCommands::FEpicUnrealMCPStructureCommands()
+{
+}
+
+void FEpicUnrealMCPStructureCommands::RegisterCommands(FEpicUnrealMCPCommandRegistry& Registry)
+{
+    const FString Category = TEXT("structure");
+    const EMCPCommandFlags Edit = EMCPCommandFlags::GameThread | EMCPCommandFlags::Batchable;
+
+    // Parameters every generator understands
+    const TArray<FString> Common = {TEXT("location"), TEXT("rotation"), TEXT("seed"),
+        TEXT("mesh"), TEXT("material"), TEXT("floor_mesh"), TEXT("floor_material"), TEXT("trim_mesh"), TEXT("trim_material"),
+        TEXT("wall_style"), TEXT("brick_size"), TEXT("mortar"), TEXT("jitter")};
+
+    TArray<FString> BuildingParams = Common;
+    BuildingParams.Append({TEXT("width"), TEXT("depth"), TEXT("floors"), TEXT("floor_height"), TEXT("wall_thickness"), TEXT("windows"),
+        TEXT("window_width"), TEXT("window_height"), TEXT("window_sill"), TEXT("window_spacing"), TEXT("window_density"), TEXT("roof")});
+    Registry.Register(TEXT("generate_building"), Category, Edit, {TEXT("name")}, BuildingParams,
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGenerateBuilding(Params); });
+
+    TArray<FString> TowerParams = Common;
+    TowerParams.Append({TEXT("radius"), TEXT("levels"), TEXT("level_height"), TEXT("block_width"), TEXT("wall_thickness"), TEXT("tower_style"),
+        TEXT("twist"), TEXT("taper"), TEXT("window_every"), TEXT("window_density"), TEXT("floor_every"), TEXT("crenellations")});
+    Registry.Register(TEXT("generate_tower"), Category, Edit, {TEXT("name")}, TowerParams,
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGenerateTower(Params); });
+
+    TArray<FString> WallParams = Common;
+    WallParams.Append({TEXT("length"), TEXT("height"), TEXT("thickness"), TEXT("crenellations"), TEXT("merlon_width"), TEXT("merlon_height")});
+    Registry.Register(TEXT("generate_wall"), Category, Edit, {TEXT("name")}, WallParams,
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGenerateWall(Params); });
+
+    TArray<FString> AqueductParams = Common;
+    AqueductParams.Append({TEXT("arches"), TEXT("span"), TEXT("pier_width"), TEXT("pier_height"), TEXT("thickness"), TEXT("tiers"),
+        TEXT("arch_segments"), TEXT("deck_thickness"), TEXT("channel")});
+    Registry.Register(TEXT("generate_aqueduct"), Category, Edit, {TEXT("name")}, AqueductParams,
+        [this](const TSharedPtr<FJsonObject>& Params) { return HandleGenerateAqueduct(Params); });
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPStructureCommands::HandleGenerateBuilding(const TSharedPtr<FJsonObject>& Params)
+{
+    using namespace MCPStructure;
+
+    const float Width = FMath::Max(100.0f, GetNumber(Params, TEXT("width"), 1200.0f));
+    const float Depth = FMath::Max(100.0f, GetNumber(Params, TEXT("depth"), 1000.0f));
+    const int32 FloorCount = GetInt(Params, TEXT("floors"), 2);
+    const float FloorHeight = FMath::Max(100.0f, GetNumber(Params, TEXT("floor_height"), 300.0f));
+    const float Thickness = FMath::Clamp(GetNumber(Params, TEXT("wall_thickness"), 20.0f), 1.0f, FMath::Min(Width, Depth) * 0.25f);
+    const bool bWindows = GetBool(Params, TEXT("windows"), true);
+    const float WindowWidth = GetNumber(Params, TEXT("window_width"), 120.0f);
+    const float WindowHeight = GetNumber(Params, TEXT("window_height"), 140.0f);
+    const float WindowSill = GetNumber(Params, TEXT("window_sill"), 90.0f);
+    const float WindowSpacing = GetNumber(Params, TEXT("window_spacing"), 300.0f);
+    const float WindowDensity = GetNumber(Params, TEXT("window_density"), 1.0f);
+    FString Roof = TEXT("flat");
+    Params->TryGetStringField(TEXT("roof"), Roof);
+
+    if (FloorCount < 1 || FloorCount > MaxCount)
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'floors' must be between 1 and %d"), MaxCount));
+    }
+
+    const FWallStyle BaseStyle = GetWallStyle(Params);
+    const float Slab = FMath::Min(20.0f, FloorHeight * 0.1f);
+    const bool bRoof = Roof != TEXT("none");
+
+    // Per floor: the slab and four walls with a window bay (or the door) each; the roof is a slab and four parapet walls
+    const float FloorWallHeight = FloorHeight - Slab;
+    const float SideWallLength = Depth - 2.0f * Thickness;
+    const double BaySpacing = WindowBaySpacing(WindowSpacing, WindowWidth);
+    const double FloorInstances = 1.0
+        + 2.0 * EstimateWallInstances(Width, FloorWallHeight, BaseStyle, Width / BaySpacing + 1.0)
+        + 2.0 * EstimateWallInstances(SideWallLength, FloorWallHeight, BaseStyle, SideWallLength / BaySpacing + 1.0);
+    const double EstimatedInstances = FloorCount * FloorInstances + (bRoof ? 5.0 : 0.0);
+
+    // One unit per floor, plus the roof
+    return Generate(Params, TEXT("generate_building"), FloorCount + (bRoof ? 1 : 0), EstimatedInstances, nullptr,
+        [=](const FContext& Context, int32 Unit, FChunk& Chunk, FRandomStream& Rng)
+        {
+            const float BaseZ = Unit * FloorHeight;
+            Context.AddBox(Chunk, Floors, FVector(0.0f, 0.0f, BaseZ + Slab * 0.5f), FVector(Width, Depth, Slab));
+
+            if (Unit == FloorCount)
+            {
+                // Roof: the slab above plus a parapet
+                FWallStyle Parapet;
+                const float ParapetHeight = FMath::Min(60.0f, FloorHeight * 0.3f);
+                const float Z = BaseZ + Slab;
+                AddWall(Context, Chunk, Trim, FVector(-Width * 0.5f, -Depth * 0.5f + Thickness * 0.5f, Z), FVector(1, 0, 0), Width, ParapetHeight, Thickness, Parapet, {}, Rng);
+                AddWall(Context, Chunk, Trim, FVector(-Width * 0.5f, Depth * 0.5f - Thickness * 0.5f, Z), FVector(1, 0, 0), Width, ParapetHeight, Thickness, Parapet, {}, Rng);
+                AddWall(Context, Chunk, Trim, FVector(-Width * 0.5f + Thickness * 0.5f, -Depth * 0.5f + Thickness, Z), FVector(0, 1, 0), Depth - 2.0f * Thickness, ParapetHeight, Thickness, Parapet, {}, Rng);
+                AddWall(Context, Chunk, Trim, FVector(Width * 0.5f - Thickness * 0.5f, -Depth * 0.5f + Thickness, Z), FVector(0, 1, 0), Depth - 2.0f * Thickness, ParapetHeight, Thickness, Parapet, {}, Rng);
+                return;
+            }
+
+            const float WallZ = BaseZ + Slab;
+            const float WallHeight = FloorHeight - Slab;
+            FWallStyle Style = BaseStyle;
+            Style.FirstCourse = Unit * FMath::Max(1, FMath::RoundToInt(WallHeight / Style.BrickSize.Y));
+
+            // Front and back span the full width; the sides fit between them
+            const float SideLength = Depth - 2.0f * Thickness;
+            auto Windows = [&](float Length, bool bDoor)
+            {
+                return bWindows || bDoor
+                    ? MakeWindows(Length, WindowSpacing, WindowWidth, WindowSill, FMath::Max(0.0f, FMath::Min(WindowHeight, WallHeight - WindowSill - 20.0f)),
+                        bWindows ? WindowDensity : 0.0f, bDoor, 120.0f, FMath::Min(240.0f, WallHeight - 20.0f), Rng)
+                    : TArray<FOpening>();
+            };
+            AddWall(Context, Chunk, Walls, FVector(-Width * 0.5f, -Depth * 0.5f + Thickness * 0.5f, WallZ), FVector(1, 0, 0), Width, WallHeight, Thickness, Style, Windows(Width, Unit == 0), Rng);
+            AddWall(Context, Chunk, Walls, FVector(-Width * 0.5f, Depth * 0.5f - Thickness * 0.5f, WallZ), FVector(1, 0, 0), Width, WallHeight, Thickness, Style, Windows(Width, false), Rng);
+            AddWall(Context, Chunk, Walls, FVector(-Width * 0.5f + Thickness * 0.5f, -Depth * 0.5f + Thickness, WallZ), FVector(0, 1, 0), SideLength, WallHeight, Thickness, Style, Windows(SideLength, false), Rng);
+            AddWall(Context, Chunk, Walls, FVector(Width * 0.5f - Thickness * 0.5f, -Depth * 0.5f + Thickness, WallZ), FVector(0, 1, 0), SideLength, WallHeight, Thickness, Style, Windows(SideLength, false), Rng);
+        });
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPStructureCommands::HandleGenerateTower(const TSharedPtr<FJsonObject>& Params)
+{
+    using namespace MCPStructure;
+
+    const float Radius = FMath::Max(50.0f, GetNumber(Params, TEXT("radius"), 300.0f));
+    const int32 Levels = GetInt(Params, TEXT("levels"), 12);
+    const float LevelHeight = FMath::Max(10.0f, GetNumber(Params, TEXT("level_height"), 100.0f));
+    const float BlockWidth = FMath::Max(10.0f, GetNumber(Params, TEXT("block_width"), 100.0f));
+    const float Thickness = FMath::Clamp(GetNumber(Params, TEXT("wall_thickness"), 60.0f), 1.0f, Radius);
+    const float Taper = FMath::Clamp(GetNumber(Params, TEXT("taper"), 0.0f), 0.0f, 0.9f);
+    const int32 WindowEvery = GetInt(Params, TEXT("window_every"), 4);
+    const float WindowDensity = GetNumber(Params, TEXT("window_density"), 1.0f);
+    const int32 FloorEvery = GetInt(Params, TEXT("floor_every"), 4);
+    const bool bCrenellations = GetBool(Params, TEXT("crenellations"), true);
+    const float Mortar = FMath::Max(0.0f, GetNumber(Params, TEXT("mortar"), 1.0f));
+    const float Jitter = FMath::Max(0.0f, GetNumber(Params, TEXT("jitter"), 0.0f));
+    FString TowerStyle = TEXT("round");
+    Params->TryGetStringField(TEXT("tower_style"), TowerStyle);
+    const float Twist = GetNumber(Params, TEXT("twist"), TowerStyle == TEXT("twisted") ? 5.0f : 0.0f);
+    const bool bSquare = TowerStyle == TEXT("square");
+
+    if (Levels < 1 || Levels > MaxCount)
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'levels' must be between 1 and %d"), MaxCount));
+    }
+    if (TowerStyle != TEXT("round") && TowerStyle != TEXT("twisted") && !bSquare)
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown tower_style: %s (expected 'round', 'square' or 'twisted')"), *TowerStyle));
+    }
+
+    // Per level: a floor and either a ring of blocks or four one-course walls (windows and merlons split bricks)
+    const double BlocksPerSide = 2.0 * Radius / BlockWidth;
+    const double LevelInstances = 1.0 + (bSquare
+        ? 4.0 * (BlocksPerSide + 2.0 + BlocksPerSide * 0.5 + 2.0)
+        : FMath::Max(6.0, 2.0 * PI * Radius / BlockWidth + 1.0));
+    const double EstimatedInstances = (Levels + (bCrenellations ? 1 : 0)) * LevelInstances;
+
+    // One unit per level, plus the crenellations
+    return Generate(Params, TEXT("generate_tower"), Levels + (bCrenellations ? 1 : 0), EstimatedInstances, bSquare ? nullptr : TEXT("/Engine/BasicShapes/Cylinder.Cylinder"),
+        [=](const FContext& Context, int32 Level, FChunk& Chunk, FRandomStream& Rng)
+        {
+            const bool bTop = Level == Levels;
+            const float LevelRadius = Radius * (1.0f - Taper * FMath::Min(Level, Levels - 1) / FMath::Max(1, Levels - 1));
+            const float Z = Level * LevelHeight;
+            const float Yaw = Twist * Level;
+            const bool bWindowLevel = !bTop && WindowEvery > 0 && Level % WindowEvery == WindowEvery / 2;
+
+            if (!bTop && FloorEvery > 0 && Level % FloorEvery == 0)
+            {
+                const float Size = 2.0f * (LevelRadius - Thickness * 0.5f);
+                Context.AddBox(Chunk, Floors, FVector(0.0f, 0.0f, Z + LevelHeight * 0.05f), FVector(Size, Size, LevelHeight * 0.1f), FRotator(0.0f, Yaw, 0.0f));
+            }
+
+            if (bSquare)
+            {
+                // Four walls of one course each, rotated by the twist
+                const FRotator Rotation(0.0f, Yaw, 0.0f);
+                const float Side = 2.0f * LevelRadius;
+                const float Height = bTop ? LevelHeight * 0.8f : LevelHeight;
+                FWallStyle Style;
+                Style.bBrick = true;
+                Style.BrickSize = FVector2D(BlockWidth, Height);
+                Style.Mortar = Mortar;
+                Style.Jitter = Jitter;
+                Style.FirstCourse = Level;
+
+                const FVector Corners[4] = {FVector(-1, -1, 0), FVector(1, -1, 0), FVector(1, 1, 0), FVector(-1, 1, 0)};
+                for (int32 WallIndex = 0; WallIndex < 4; ++WallIndex)
+                {
+                    const FVector Direction = Rotation.RotateVector((Corners[(WallIndex + 1) % 4] - Corners[WallIndex]).GetSafeNormal());
+                    const FVector Inward = FVector(-Direction.Y, Direction.X, 0.0f);
+                    const FVector Start = Rotation.RotateVector(Corners[WallIndex] * LevelRadius) + Inward * (Thickness * 0.5f) + FVector(0.0f, 0.0f, Z);
+
+                    TArray<FOpening> Openings;
+                    if (bWindowLevel && Rng.FRand() < WindowDensity)
+                    {
+                        Openings.Add({Side * 0.5f, BlockWidth, 0.0f, Height});
+                    }
+                    if (bTop)
+                    {
+                        // Merlons: every other block of the top course
+                        for (float X = BlockWidth * 1.5f; X < Side; X += BlockWidth * 2.0f)
+                        {
+                            Openings.Add({X, BlockWidth, 0.0f, Height});
+                        }
+                    }
+                    AddWall(Context, Chunk, bTop ? Trim : Walls, Start, Direction, Side, Height, Thickness, Style, Openings, Rng);
+                }
+                return;
+            }
+
+            // Round: a ring of blocks, every other level offset by half a block
+            const int32 Blocks = FMath::Max(6, FMath::RoundToInt(2.0f * PI * LevelRadius / BlockWidth));
+            const float Step = 360.0f / Blocks;
+            const float Offset = Yaw + ((Level % 2) ? Step * 0.5f : 0.0f);
+            const float Chord = 2.0f * LevelRadius * FMath::Sin(PI / Blocks) - Mortar;
+            const int32 Quarter = FMath::Max(1, Blocks / 4);
+            for (int32 Block = 0; Block < Blocks; ++Block)
+            {
+                if (bTop && Block % 2)
+                {
+                    continue;
+                }
+                if (bWindowLevel && Block % Quarter == 0 && Rng.FRand() < WindowDensity)
+                {
+                    continue;
+                }
+
+                const float Angle = Offset + Block * Step;
+                const float BlockRadius = LevelRadius - Thickness * 0.5f + (Jitter > 0.0f ? Rng.FRandRange(-Jitter, Jitter) : 0.0f);
+                const float Height = (bTop ? LevelHeight * 0.8f : LevelHeight) - Mortar;
+                const FVector Center(BlockRadius * FMath::Cos(FMath::DegreesToRadians(Angle)), BlockRadius * FMath::Sin(FMath::DegreesToRadians(Angle)), Z + Mortar * 0.5f + Height * 0.5f);
+                Context.AddBox(Chunk, bTop ? Trim : Walls, Center, FVector(Chord, Thickness, Height), FRotator(0.0f, Angle + 90.0f, 0.0f));
+            }
+        });
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPStructureCommands::HandleGenerateWall(const TSharedPtr<FJsonObject>& Params)
+{
+    using namespace MCPStructure;
+
+    const float Length = FMath::Max(10.0f, GetNumber(Params, TEXT("length"), 2000.0f));
+    const float Height = FMath::Max(10.0f, GetNumber(Params, TEXT("height"), 400.0f));
+    const float Thickness = FMath::Max(1.0f, GetNumber(Params, TEXT("thickness"), 60.0f));
+    const bool bCrenellations = GetBool(Params, TEXT("crenellations"), true);
+    const float MerlonWidth = FMath::Max(10.0f, GetNumber(Params, TEXT("merlon_width"), 100.0f));
+    const float MerlonHeight = FMath::Max(10.0f, GetNumber(Params, TEXT("merlon_height"), 80.0f));
+    const FWallStyle BaseStyle = GetWallStyle(Params);
+
+    // Brick walls are generated a course at a time; solid walls are one unit
+    const int32 Courses = BaseStyle.bBrick ? FMath::Max(1, FMath::RoundToInt(Height / BaseStyle.BrickSize.Y)) : 1;
+    const double EstimatedInstances = EstimateWallInstances(Length, Height, BaseStyle, 0.0)
+        + (bCrenellations ? (double)Length / (2.0 * MerlonWidth) + 1.0 : 0.0);
+
+    const float CourseHeight = Height / Courses;
+    return Generate(Params, TEXT("generate_wall"), Courses + (bCrenellations ? 1 : 0), EstimatedInstances, nullptr,
+        [=](const FContext& Context, int32 Unit, FChunk& Chunk, FRandomStream& Rng)
+        {
+            // The wall runs along X, centred on the actor
+            const FVector Start(-Length * 0.5f, 0.0f, 0.0f);
+            if (Unit == Courses)
+            {
+                // Merlons along the top, with gaps of the same width
+                for (float X = MerlonWidth * 0.5f; X + MerlonWidth * 0.5f <= Length; X += MerlonWidth * 2.0f)
+                {
+                    Context.AddBox(Chunk, Trim, Start + FVector(X, 0.0f, Height + MerlonHeight * 0.5f), FVector(MerlonWidth, Thickness, MerlonHeight));
+                }
+                return;
+            }
+
+            FWallStyle Style = BaseStyle;
+            Style.FirstCourse = Unit;
+            AddWall(Context, Chunk, Walls, Start + FVector(0.0f, 0.0f, Unit * CourseHeight), FVector(1, 0, 0), Length, BaseStyle.bBrick ? CourseHeight : Height, Thickness, Style, {}, Rng);
+        });
+}
+
+TSharedPtr<FJsonObject> FEpicUnrealMCPStructureCommands::HandleGenerateAqueduct(const TSharedPtr<FJsonObject>& Params)
+{
+    using namespace MCPStructure;
+
+    const int32 Arches = GetInt(Params, TEXT("arches"), 6);
+    const int32 Tiers = GetInt(Params, TEXT("tiers"), 1);
+    const float Span = FMath::Max(100.0f, GetNumber(Params, TEXT("span"), 600.0f));
+    const float PierWidth = FMath::Clamp(GetNumber(Params, TEXT("pier_width"), 150.0f), 10.0f, Span * 0.8f);
+    const float PierHeight = FMath::Max(0.0f, GetNumber(Params, TEXT("pier_height"), 600.0f));
+    const float Thickness = FMath::Max(10.0f, GetNumber(Params, TEXT("thickness"), 200.0f));
+    const int32 Segments = FMath::Clamp(GetInt(Params, TEXT("arch_segments"), 9), 3, 64);
+    const float DeckThickness = FMath::Max(1.0f, GetNumber(Params, TEXT("deck_thickness"), 40.0f));
+    const bool bChannel = GetBool(Params, TEXT("channel"), true);
+    const float Jitter = FMath::Max(0.0f, GetNumber(Params, TEXT("jitter"), 0.0f));
+
+    if (Arches < 1 || Arches > MaxCount || Tiers < 1 || Tiers > 10)
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'arches' must be between 1 and %d and 'tiers' between 1 and 10"), MaxCount));
+    }
+
+    // Each tier: piers, a semicircular arch between each pair, and a deck on top
+    const float ArchRadius = (Span - PierWidth) * 0.5f;
+    const float VoussoirDepth = FMath::Max(PierWidth * 0.4f, 20.0f);
+    const float TierHeight = PierHeight + ArchRadius + VoussoirDepth + DeckThickness;
+    const float TotalLength = Arches * Span;
+
+    // Per arch: two piers at most, the voussoirs, the spandrel, the deck and two channel walls
+    const double EstimatedInstances = (double)Arches * Tiers * (Segments + 6);
+
+    return Generate(Params, TEXT("generate_aqueduct"), Arches * Tiers, EstimatedInstances, nullptr,
+        [=](const FContext& Context, int32 Unit, FChunk& Chunk, FRandomStream& Rng)
+        {
+            const int32 Tier = Unit / Arches;
+            const int32 Arch = Unit % Arches;
+            const float BaseZ = Tier * TierHeight;
+            const float X0 = -TotalLength * 0.5f + Arch * Span;
+            const float FillHeight = TierHeight - DeckThickness;
+
+            // Pier at the start of the arch (and at the end of the last one), up to the deck
+            Context.AddBox(Chunk, Walls, FVector(X0 + PierWidth * 0.5f, 0.0f, BaseZ + FillHeight * 0.5f), FVector(PierWidth, Thickness, FillHeight));
+            if (Arch == Arches - 1)
+            {
+                Context.AddBox(Chunk, Walls, FVector(X0 + Span + PierWidth * 0.5f, 0.0f, BaseZ + FillHeight * 0.5f), FVector(PierWidth, Thickness, FillHeight));
+            }
+
+            // Voussoirs around the semicircle, from the left springing point over to the right
+            const FVector ArchCenter(X0 + PierWidth + ArchRadius, 0.0f, BaseZ + PierHeight);
+            const float RingRadius = ArchRadius + VoussoirDepth * 0.5f;
+            const float Chord = 2.0f * RingRadius * FMath::Sin(PI / (2.0f * Segments)) * 1.02f;
+            for (int32 Segment = 0; Segment < Segments; ++Segment)
+            {
+                const float Angle = 180.0f - (Segment + 0.5f) * 180.0f / Segments;
+                const float Radians = FMath::DegreesToRadians(Angle);
+                const float Offset = Jitter > 0.0f ? Rng.FRandRange(-Jitter, Jitter) : 0.0f;
+                const FVector Center = ArchCenter + FVector(FMath::Cos(Radians) * RingRadius, Offset, FMath::Sin(Radians) * RingRadius);
+                Context.AddBox(Chunk, Walls, Center, FVector(Chord, Thickness, VoussoirDepth), FRotator(Angle - 90.0f, 0.0f, 0.0f));
+            }
+
+            // Spandrel fill between the arch crown and the deck
+            const float CrownTop = PierHeight + ArchRadius + VoussoirDepth;
+            if (FillHeight > CrownTop)
+            {
+                Context.AddBox(Chunk, Walls, FVector(ArchCenter.X, 0.0f, BaseZ + (CrownTop + FillHeight) * 0.5f), FVector(Span - PierWidth, Thickness, FillHeight - CrownTop));
+            }
+
+            Context.AddBox(Chunk, Floors, FVector(X0 + Span * 0.5f + (Arch == Arches - 1 ? PierWidth * 0.5f : 0.0f), 0.0f, BaseZ + FillHeight + DeckThickness * 0.5f),
+                FVector(Span + (Arch == Arches - 1 ? PierWidth : 0.0f), Thickness, DeckThickness));
+
+            // Water channel walls along the top tier
+            if (bChannel && Tier == Tiers - 1)
+            {
+                const float WallThickness = FMath::Min(30.0f, Thickness * 0.2f);
+                const float WallHeight = 60.0f;
+                const float Length = Span + (Arch == Arches - 1 ? PierWidth : 0.0f);
+                const float CenterX = X0 + Length * 0.5f;
+                const float Z = BaseZ + TierHeight + WallHeight * 0.5f;
+                Context.AddBox(Chunk, Trim, FVector(CenterX, -(Thickness - WallThickness) * 0.5f, Z), FVector(Length, WallThickness, WallHeight));
+                Context.AddBox(Chunk, Trim, FVector(CenterX, (Thickness - WallThickness) * 0.5f, Z), FVector(Length, WallThickness, WallHeight));
+            }
+        });
+}
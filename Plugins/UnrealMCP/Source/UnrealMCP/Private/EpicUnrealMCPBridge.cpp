@@ -1,5 +1,7 @@
 #include "EpicUnrealMCPBridge.h"
 #include "MCPServerRunnable.h"
+#include "MCPCommandScheduler.h"
+#include "MCPEditorSnapshot.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "HAL/RunnableThread.h"
@@ -22,6 +24,7 @@
 #include "Engine/Selection.h"
 #include "Kismet/GameplayStatics.h"
 #include "Async/Async.h"
+#include "ScopedTransaction.h"
 // Add Blueprint related includes
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -54,7 +57,9 @@
 #include "Commands/EpicUnrealMCPEditorCommands.h"
 #include "Commands/EpicUnrealMCPBlueprintCommands.h"
 #include "Commands/EpicUnrealMCPBlueprintGraphCommands.h"
+#include "Commands/EpicUnrealMCPStructureCommands.h"
 #include "Commands/EpicUnrealMCPCommonUtils.h"
+#include "Commands/EpicUnrealMCPEditSession.h"
 
 // Default settings
 #define MCP_SERVER_HOST "127.0.0.1"
@@ -65,6 +70,14 @@ UEpicUnrealMCPBridge::UEpicUnrealMCPBridge()
     EditorCommands = MakeShared<FEpicUnrealMCPEditorCommands>();
     BlueprintCommands = MakeShared<FEpicUnrealMCPBlueprintCommands>();
     BlueprintGraphCommands = MakeShared<FEpicUnrealMCPBlueprintGraphCommands>();
+    StructureCommands = MakeShared<FEpicUnrealMCPStructureCommands>();
+
+    CommandRegistry = MakeShared<FEpicUnrealMCPCommandRegistry>();
+    RegisterBridgeCommands();
+    EditorCommands->RegisterCommands(*CommandRegistry);
+    BlueprintCommands->RegisterCommands(*CommandRegistry);
+    BlueprintGraphCommands->RegisterCommands(*CommandRegistry);
+    StructureCommands->RegisterCommands(*CommandRegistry);
 }
 
 UEpicUnrealMCPBridge::~UEpicUnrealMCPBridge()
@@ -72,6 +85,8 @@ UEpicUnrealMCPBridge::~UEpicUnrealMCPBridge()
     EditorCommands.Reset();
     BlueprintCommands.Reset();
     BlueprintGraphCommands.Reset();
+    StructureCommands.Reset();
+    CommandRegistry.Reset();
 }
 
 // Initialize subsystem
@@ -81,11 +96,31 @@ void UEpicUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
     
     bIsRunning = false;
     ListenerSocket = nullptr;
-    ConnectionSocket = nullptr;
     ServerThread = nullptr;
     Port = MCP_SERVER_PORT;
     FIPv4Address::Parse(MCP_SERVER_HOST, ServerAddress);
 
+    EditorSnapshot = MakeShared<FMCPEditorSnapshot>();
+
+    CommandScheduler = MakeShared<FMCPCommandScheduler>([this](int32 ClientId, const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+    {
+        // Edit sessions opened by this command belong to its client
+        FEpicUnrealMCPEditSession::FScopedClient SessionClient(ClientId);
+        TSharedPtr<FJsonObject> Response = ExecuteCommandOnGameThread(CommandType, Params);
+
+        // Edits make the snapshot stale; inspection results feed it
+        const FMCPCommandInfo* Command = CommandRegistry->Find(CommandType);
+        if (Command && !Command->IsReadOnly())
+        {
+            EditorSnapshot->Invalidate();
+        }
+        else if (Command && Command->IsSnapshot())
+        {
+            EditorSnapshot->StoreResponse(CommandType, Params, Response);
+        }
+        return Response;
+    });
+
     // Start the server automatically
     StartServer();
 }
@@ -95,6 +130,10 @@ void UEpicUnrealMCPBridge::Deinitialize()
 {
     UE_LOG(LogTemp, Display, TEXT("EpicUnrealMCPBridge: Shutting down"));
     StopServer();
+    // Do not leave edits of an unfinished edit session uncompiled
+    FEpicUnrealMCPEditSession::EndAll();
+    CommandScheduler.Reset();
+    EditorSnapshot.Reset();
 }
 
 // Start the MCP server
@@ -134,8 +173,8 @@ void UEpicUnrealMCPBridge::StartServer()
         return;
     }
 
-    // Start listening
-    if (!NewListenerSocket->Listen(5))
+    // Start listening (several agents may connect at once)
+    if (!NewListenerSocket->Listen(16))
     {
         UE_LOG(LogTemp, Error, TEXT("EpicUnrealMCPBridge: Failed to start listening"));
         return;
@@ -178,13 +217,7 @@ void UEpicUnrealMCPBridge::StopServer()
         ServerThread = nullptr;
     }
 
-    // Close sockets
-    if (ConnectionSocket.IsValid())
-    {
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ConnectionSocket.Get());
-        ConnectionSocket.Reset();
-    }
-
+    // Close the listener; client sockets were closed by their threads
     if (ListenerSocket.IsValid())
     {
         ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenerSocket.Get());
@@ -194,124 +227,303 @@ void UEpicUnrealMCPBridge::StopServer()
     UE_LOG(LogTemp, Display, TEXT("EpicUnrealMCPBridge: Server stopped"));
 }
 
-// Execute a command received from a client
-FString UEpicUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+// Queue a command on the game thread; the response is handed to OnComplete there
+void UEpicUnrealMCPBridge::ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TFunction<void(TSharedPtr<FJsonObject>)> OnComplete, int32 ClientId)
 {
-    UE_LOG(LogTemp, Display, TEXT("EpicUnrealMCPBridge: Executing command: %s"), *CommandType);
-    
-    // Create a promise to wait for the result
-    TPromise<FString> Promise;
-    TFuture<FString> Future = Promise.GetFuture();
-    
-    // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
+    if (!CommandScheduler.IsValid())
     {
         TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        ResponseJson->SetStringField(TEXT("error"), TEXT("MCP bridge is shutting down"));
+        OnComplete(ResponseJson);
+        return;
+    }
+
+    // Inspection commands are answered on this thread from the snapshot, unless the client still
+    // has earlier commands in flight that the answer would have to reflect
+    const FMCPCommandInfo* Command = CommandRegistry->Find(CommandType);
+    if (Command && Command->IsSnapshot() && !CommandScheduler->HasOutstanding(ClientId))
+    {
+        TSharedPtr<FJsonObject> SnapshotResponse;
+        if (EditorSnapshot->TryGetResponse(CommandType, Params, SnapshotResponse))
+        {
+            OnComplete(SnapshotResponse);
+            return;
+        }
+    }
+
+    // Clients take turns on the game thread, within a per-frame budget
+    CommandScheduler->Enqueue(ClientId, CommandType, Params, MoveTemp(OnComplete));
+}
+
+// Close what a departed client left open, after its last queued command has run
+void UEpicUnrealMCPBridge::HandleClientDisconnected(int32 ClientId)
+{
+    if (!CommandScheduler.IsValid())
+    {
+        return;
+    }
+
+    CommandScheduler->EnqueueTask(ClientId, [ClientId]()
+    {
+        FEpicUnrealMCPEditSession::EndClient(ClientId);
+    });
+}
+
+TSharedPtr<FJsonObject> UEpicUnrealMCPBridge::ExecuteCommandOnGameThread(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    UE_LOG(LogTemp, Verbose, TEXT("EpicUnrealMCPBridge: Executing command: %s"), *CommandType);
+
+    TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+    
+    try
+    {
+        const FMCPCommandInfo* Command = CommandRegistry->Find(CommandType);
+        if (!Command)
+        {
+            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+            ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+            return ResponseJson;
+        }
+
+        TSharedPtr<FJsonObject> ResultJson = Command->Handler(Params);
+        
+        // Check if the result contains an error
+        bool bSuccess = true;
+        FString ErrorMessage;
         
-        try
+        if (ResultJson->HasField(TEXT("success")))
         {
-            TSharedPtr<FJsonObject> ResultJson;
-            
-            if (CommandType == TEXT("ping"))
-            {
-                ResultJson = MakeShareable(new FJsonObject);
-                ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-            }
-            // Editor Commands (including actor manipulation)
-            else if (CommandType == TEXT("get_actors_in_level") ||
-                     CommandType == TEXT("find_actors_by_name") ||
-                     CommandType == TEXT("spawn_actor") ||
-                     CommandType == TEXT("delete_actor") ||
-                     CommandType == TEXT("set_actor_transform") ||
-                     CommandType == TEXT("spawn_blueprint_actor") ||
-                     CommandType == TEXT("save_all"))
+            bSuccess = ResultJson->GetBoolField(TEXT("success"));
+            if (!bSuccess && ResultJson->HasField(TEXT("error")))
             {
-                ResultJson = EditorCommands->HandleCommand(CommandType, Params);
+                ErrorMessage = ResultJson->GetStringField(TEXT("error"));
             }
-            // Blueprint Commands
-            else if (CommandType == TEXT("create_blueprint") ||
-                     CommandType == TEXT("add_component_to_blueprint") ||
-                     CommandType == TEXT("set_physics_properties") ||
-                     CommandType == TEXT("compile_blueprint") ||
-                     CommandType == TEXT("set_static_mesh_properties") ||
-                     CommandType == TEXT("set_mesh_material_color") ||
-                     CommandType == TEXT("get_available_materials") ||
-                     CommandType == TEXT("apply_material_to_actor") ||
-                     CommandType == TEXT("apply_material_to_blueprint") ||
-                     CommandType == TEXT("get_actor_material_info") ||
-                     CommandType == TEXT("get_blueprint_material_info") ||
-                     CommandType == TEXT("read_blueprint_content") ||
-                     CommandType == TEXT("analyze_blueprint_graph") ||
-                     CommandType == TEXT("get_blueprint_variable_details") ||
-                     CommandType == TEXT("get_blueprint_function_details"))
-            {
-                ResultJson = BlueprintCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Graph Commands
-            else if (CommandType == TEXT("add_blueprint_node") ||
-                     CommandType == TEXT("connect_nodes") ||
-                     CommandType == TEXT("create_variable") ||
-                     CommandType == TEXT("set_blueprint_variable_properties") ||
-                     CommandType == TEXT("add_event_node") ||
-                     CommandType == TEXT("delete_node") ||
-                     CommandType == TEXT("set_node_property") ||
-                     CommandType == TEXT("create_function") ||
-                     CommandType == TEXT("add_function_input") ||
-                     CommandType == TEXT("add_function_output") ||
-                     CommandType == TEXT("delete_function") ||
-                     CommandType == TEXT("rename_function"))
-            {
-                ResultJson = BlueprintGraphCommands->HandleCommand(CommandType, Params);
-            }
-            else
-            {
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
-                
-                FString ResultString;
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-                Promise.SetValue(ResultString);
-                return;
-            }
-            
-            // Check if the result contains an error
-            bool bSuccess = true;
-            FString ErrorMessage;
-            
-            if (ResultJson->HasField(TEXT("success")))
-            {
-                bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                if (!bSuccess && ResultJson->HasField(TEXT("error")))
-                {
-                    ErrorMessage = ResultJson->GetStringField(TEXT("error"));
-                }
-            }
-            
-            if (bSuccess)
+        }
+        
+        if (bSuccess)
+        {
+            // Set success status and include the result
+            ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+            ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+        }
+        else
+        {
+            // Set error status and include the error message
+            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+            ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+    }
+
+    return ResponseJson;
+}
+
+// Commands implemented by the bridge itself
+void UEpicUnrealMCPBridge::RegisterBridgeCommands()
+{
+    const FString Category = TEXT("bridge");
+
+    CommandRegistry->Register(TEXT("ping"), Category, EMCPCommandFlags::ReadOnly | EMCPCommandFlags::Batchable, {}, {},
+        [](const TSharedPtr<FJsonObject>& Params)
+        {
+            TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+            ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
+            return ResultJson;
+        });
+
+    CommandRegistry->Register(TEXT("list_commands"), Category, EMCPCommandFlags::ReadOnly | EMCPCommandFlags::Batchable, {}, {},
+        [this](const TSharedPtr<FJsonObject>& Params)
+        {
+            return CommandRegistry->DescribeCommands();
+        });
+
+    // Not batchable: batches do not nest
+    CommandRegistry->Register(TEXT("batch"), Category, EMCPCommandFlags::GameThread, {TEXT("commands")}, {TEXT("stop_on_error"), TEXT("transaction"), TEXT("description"), TEXT("defer_compile")},
+        [this](const TSharedPtr<FJsonObject>& Params)
+        {
+            return ExecuteBatch(Params);
+        });
+}
+
+// Run an ordered list of commands back to back in this game thread task
+TSharedPtr<FJsonObject> UEpicUnrealMCPBridge::ExecuteBatch(const TSharedPtr<FJsonObject>& Params)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+    if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("commands"), Commands))
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'commands' array"));
+    }
+
+    bool bStopOnError = false;
+    Params->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+
+    bool bUseTransaction = true;
+    Params->TryGetBoolField(TEXT("transaction"), bUseTransaction);
+
+    FString Description = TEXT("MCP Batch");
+    Params->TryGetStringField(TEXT("description"), Description);
+
+    bool bDeferCompile = false;
+    Params->TryGetBoolField(TEXT("defer_compile"), bDeferCompile);
+
+    // Edit sessions must open and close within the batch, so none is left open behind it
+    int32 SessionDepth = 0;
+    for (int32 Index = 0; Index < Commands->Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* Command = nullptr;
+        FString SubCommandType;
+        if (!(*Commands)[Index]->TryGetObject(Command) ||
+            !((*Command)->TryGetStringField(TEXT("type"), SubCommandType) || (*Command)->TryGetStringField(TEXT("command"), SubCommandType)))
+        {
+            continue;
+        }
+
+        if (SubCommandType == TEXT("begin_edit_session"))
+        {
+            ++SessionDepth;
+        }
+        else if (SubCommandType == TEXT("end_edit_session") && --SessionDepth < 0)
+        {
+            return FEpicUnrealMCPCommonUtils::CreateErrorResponse(
+                FString::Printf(TEXT("Batch item %d ends an edit session the batch did not begin"), Index));
+        }
+    }
+
+    if (SessionDepth != 0)
+    {
+        return FEpicUnrealMCPCommonUtils::CreateErrorResponse(
+            FString::Printf(TEXT("Batch leaves %d edit session(s) open; end every begin_edit_session in the same batch"), SessionDepth));
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // One undo step for the whole batch. Failed items may still have modified objects before
+    // failing, so watch for any modification rather than counting successes.
+    TUniquePtr<FScopedTransaction> Transaction;
+    bool bModifiedObjects = false;
+    FDelegateHandle ObjectModifiedHandle;
+    if (bUseTransaction)
+    {
+        Transaction = MakeUnique<FScopedTransaction>(FText::FromString(Description));
+        ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddLambda([&bModifiedObjects](UObject*)
+        {
+            bModifiedObjects = true;
+        });
+    }
+
+    // Blueprints edited by the batch compile once, after the last item
+    if (bDeferCompile)
+    {
+        FEpicUnrealMCPEditSession::Begin();
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Results;
+    Results.Reserve(Commands->Num());
+    int32 Succeeded = 0;
+    int32 Failed = 0;
+    int32 StoppedAt = INDEX_NONE;
+    int32 OpenSessions = 0;
+
+    for (int32 Index = 0; Index < Commands->Num(); ++Index)
+    {
+        TSharedPtr<FJsonObject> ItemJson = MakeShareable(new FJsonObject);
+        ItemJson->SetNumberField(TEXT("index"), Index);
+
+        const TSharedPtr<FJsonObject>* Command = nullptr;
+        FString SubCommandType;
+        if (!(*Commands)[Index]->TryGetObject(Command) ||
+            !((*Command)->TryGetStringField(TEXT("type"), SubCommandType) || (*Command)->TryGetStringField(TEXT("command"), SubCommandType)))
+        {
+            ItemJson->SetStringField(TEXT("status"), TEXT("error"));
+            ItemJson->SetStringField(TEXT("error"), TEXT("Batch item must be an object with a 'type' field"));
+        }
+        else if (const FMCPCommandInfo* SubCommand = CommandRegistry->Find(SubCommandType); SubCommand && !SubCommand->IsBatchable())
+        {
+            ItemJson->SetStringField(TEXT("type"), SubCommandType);
+            ItemJson->SetStringField(TEXT("status"), TEXT("error"));
+            ItemJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Command '%s' cannot run in a batch"), *SubCommandType));
+        }
+        else
+        {
+            const TSharedPtr<FJsonObject>* SubParams = nullptr;
+            TSharedPtr<FJsonObject> SubParamsJson = (*Command)->TryGetObjectField(TEXT("params"), SubParams) ? *SubParams : MakeShareable(new FJsonObject);
+
+            TSharedPtr<FJsonObject> SubResponse = ExecuteCommandOnGameThread(SubCommandType, SubParamsJson);
+            if (SubResponse->GetStringField(TEXT("status")) == TEXT("success"))
             {
-                // Set success status and include the result
-                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+                OpenSessions += SubCommandType == TEXT("begin_edit_session") ? 1 : SubCommandType == TEXT("end_edit_session") ? -1 : 0;
             }
-            else
+            ItemJson->SetStringField(TEXT("type"), SubCommandType);
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : SubResponse->Values)
             {
-                // Set error status and include the error message
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+                ItemJson->SetField(Field.Key, Field.Value);
             }
         }
-        catch (const std::exception& e)
+
+        const bool bItemSucceeded = ItemJson->GetStringField(TEXT("status")) == TEXT("success");
+        if (bItemSucceeded)
         {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+            ++Succeeded;
         }
-        
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-        Promise.SetValue(ResultString);
-    });
-    
-    return Future.Get();
-}
\ No newline at end of file
+        else
+        {
+            ++Failed;
+        }
+        Results.Add(MakeShareable(new FJsonValueObject(ItemJson)));
+
+        if (!bItemSucceeded && bStopOnError)
+        {
+            StoppedAt = Index;
+            break;
+        }
+    }
+
+    // A batch stopped between begin and end still closes what it opened
+    for (; OpenSessions > 0; --OpenSessions)
+    {
+        FEpicUnrealMCPEditSession::End();
+    }
+
+    TSharedPtr<FJsonObject> CompileJson;
+    if (bDeferCompile)
+    {
+        CompileJson = FEpicUnrealMCPEditSession::End();
+    }
+
+    // Keep the undo step if anything was touched, even by failed items; cancel only an empty one
+    if (Transaction.IsValid())
+    {
+        FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+        if (!bModifiedObjects)
+        {
+            Transaction->Cancel();
+        }
+    }
+    Transaction.Reset();
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetArrayField(TEXT("results"), Results);
+    ResultJson->SetNumberField(TEXT("count"), Commands->Num());
+    ResultJson->SetNumberField(TEXT("succeeded"), Succeeded);
+    ResultJson->SetNumberField(TEXT("failed"), Failed);
+    if (StoppedAt != INDEX_NONE)
+    {
+        ResultJson->SetNumberField(TEXT("stopped_at"), StoppedAt);
+    }
+    if (CompileJson.IsValid())
+    {
+        ResultJson->SetObjectField(TEXT("compile"), CompileJson);
+    }
+    ResultJson->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    UE_LOG(LogTemp, Display, TEXT("EpicUnrealMCPBridge: Batch ran %d of %d commands (%d failed) in %.1f ms"),
+        Results.Num(), Commands->Num(), Failed, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    // The batch itself succeeds even when items fail; per-item status is in "results"
+    return ResultJson;
+}
@@ -1,5 +1,8 @@
 #include "EpicUnrealMCPModule.h"
 #include "EpicUnrealMCPBridge.h"
+#include "Commands/EpicUnrealMCPBlueprintResolver.h"
+#include "Commands/BlueprintGraph/GraphChangeTracker.h"
+#include "Commands/BlueprintGraph/GraphNodeIndex.h"
 #include "Modules/ModuleManager.h"
 #include "EditorSubsystem.h"
 #include "Editor.h"
@@ -13,6 +16,9 @@ void FEpicUnrealMCPModule::StartupModule()
 
 void FEpicUnrealMCPModule::ShutdownModule()
 {
+	FGraphNodeIndex::Shutdown();
+	FGraphChangeTracker::Shutdown();
+	FEpicUnrealMCPBlueprintResolver::Shutdown();
 	UE_LOG(LogTemp, Display, TEXT("Epic Unreal MCP Module has shut down"));
 }
 
@@ -0,0 +1,155 @@
+#include "MCPCommandScheduler.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace MCPCommandScheduler
+{
+    static float CommandBudgetMs = 20.0f;
+    static FAutoConsoleVariableRef CVarCommandBudgetMs(
+        TEXT("MCP.CommandBudgetMs"),
+        CommandBudgetMs,
+        TEXT("Game thread time per frame spent on queued MCP commands, in milliseconds (at least one command always runs)"));
+}
+
+FMCPCommandScheduler::FMCPCommandScheduler(FExecuteFunction InExecute)
+    : Execute(MoveTemp(InExecute))
+{
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPCommandScheduler::Tick));
+}
+
+FMCPCommandScheduler::~FMCPCommandScheduler()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    // Responses of commands that never ran are dropped with their connections
+    FScopeLock Lock(&QueueLock);
+    Queues.Empty();
+    Outstanding.Empty();
+    NumPending = 0;
+}
+
+void FMCPCommandScheduler::Enqueue(int32 ClientId, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FCompletionFunction OnComplete)
+{
+    FScopeLock Lock(&QueueLock);
+    Push(FQueuedCommand{ClientId, CommandType, Params, MoveTemp(OnComplete)});
+}
+
+void FMCPCommandScheduler::EnqueueTask(int32 ClientId, TFunction<void()> Task)
+{
+    FQueuedCommand Command;
+    Command.ClientId = ClientId;
+    Command.Task = MoveTemp(Task);
+
+    FScopeLock Lock(&QueueLock);
+    Push(MoveTemp(Command));
+}
+
+void FMCPCommandScheduler::Push(FQueuedCommand&& Command)
+{
+    const int32 ClientId = Command.ClientId;
+    FClientQueue* Queue = Queues.FindByPredicate([ClientId](const FClientQueue& Candidate)
+    {
+        return Candidate.ClientId == ClientId;
+    });
+
+    if (!Queue)
+    {
+        Queue = &Queues.AddDefaulted_GetRef();
+        Queue->ClientId = ClientId;
+    }
+
+    Queue->Commands.EmplaceLast(MoveTemp(Command));
+    ++NumPending;
+    ++Outstanding.FindOrAdd(ClientId);
+}
+
+int32 FMCPCommandScheduler::GetNumPending() const
+{
+    FScopeLock Lock(&QueueLock);
+    return NumPending;
+}
+
+bool FMCPCommandScheduler::HasOutstanding(int32 ClientId) const
+{
+    FScopeLock Lock(&QueueLock);
+    return Outstanding.Contains(ClientId);
+}
+
+bool FMCPCommandScheduler::PopNext(FQueuedCommand& OutCommand)
+{
+    // Queues are removed once empty, so every queue here has work
+    if (Queues.Num() == 0)
+    {
+        return false;
+    }
+
+    if (NextQueue >= Queues.Num())
+    {
+        NextQueue = 0;
+    }
+
+    FClientQueue& Queue = Queues[NextQueue];
+    OutCommand = MoveTemp(Queue.Commands.First());
+    Queue.Commands.PopFirst();
+    --NumPending;
+
+    if (Queue.Commands.IsEmpty())
+    {
+        // The following queue slides into this slot and is next in turn
+        Queues.RemoveAt(NextQueue);
+    }
+    else
+    {
+        ++NextQueue;
+    }
+
+    return true;
+}
+
+bool FMCPCommandScheduler::Tick(float DeltaTime)
+{
+    const double Budget = FMath::Max(MCPCommandScheduler::CommandBudgetMs, 0.0f) / 1000.0;
+    const double StartTime = FPlatformTime::Seconds();
+
+    while (true)
+    {
+        FQueuedCommand Command;
+        {
+            FScopeLock Lock(&QueueLock);
+            if (!PopNext(Command))
+            {
+                break;
+            }
+        }
+
+        // Run outside the lock: commands may be queued from other threads meanwhile
+        if (Command.Task)
+        {
+            Command.Task();
+        }
+        else
+        {
+            TSharedPtr<FJsonObject> Response = Execute(Command.ClientId, Command.CommandType, Command.Params);
+            if (Command.OnComplete)
+            {
+                Command.OnComplete(Response);
+            }
+        }
+
+        {
+            FScopeLock Lock(&QueueLock);
+            if (int32* Count = Outstanding.Find(Command.ClientId); Count && --(*Count) <= 0)
+            {
+                Outstanding.Remove(Command.ClientId);
+            }
+        }
+
+        if (FPlatformTime::Seconds() - StartTime >= Budget)
+        {
+            break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,164 @@
+#include "MCPEditorSnapshot.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace MCPEditorSnapshot
+{
+    /** The snapshot is dropped rather than grown past this many results */
+    static constexpr int32 MaxResponses = 512;
+}
+
+FMCPEditorSnapshot::FMCPEditorSnapshot()
+{
+    BindEditorDelegates();
+}
+
+FMCPEditorSnapshot::~FMCPEditorSnapshot()
+{
+    UnbindEditorDelegates();
+}
+
+bool FMCPEditorSnapshot::AffectsSnapshot(const UObject* Object)
+{
+    if (!Object)
+    {
+        return false;
+    }
+
+    // Actors and components of the level being edited (not PIE copies, previews or thumbnails)
+    if (Object->IsA<AActor>() || Object->IsA<UActorComponent>())
+    {
+        const UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+        if (EditorWorld && Object->GetWorld() == EditorWorld)
+        {
+            return true;
+        }
+    }
+
+    // Blueprints and what they own: graphs, nodes, variables, component templates
+    return Object->IsA<UBlueprint>() || Object->GetTypedOuter<UBlueprint>() || Object->GetTypedOuter<UBlueprintGeneratedClass>();
+}
+
+void FMCPEditorSnapshot::BindEditorDelegates()
+{
+    if (GEngine)
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddLambda([this](AActor*) { Invalidate(); });
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddLambda([this](AActor*) { Invalidate(); });
+        ActorMovedHandle = GEngine->OnActorMoved().AddLambda([this](AActor*) { Invalidate(); });
+    }
+
+    if (GEditor)
+    {
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([this]() { Invalidate(); });
+    }
+
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([this](UObject*, FPropertyChangedEvent&) { Invalidate(); });
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddLambda([this](UObject* Object)
+    {
+        // Called for every object the editor modifies, most of which no snapshot result reads
+        if (AffectsSnapshot(Object))
+        {
+            Invalidate();
+        }
+    });
+    UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddLambda([this]() { Invalidate(); });
+    MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32) { Invalidate(); });
+    BeginPIEHandle = FEditorDelegates::BeginPIE.AddLambda([this](bool) { Invalidate(); });
+    EndPIEHandle = FEditorDelegates::EndPIE.AddLambda([this](bool) { Invalidate(); });
+}
+
+void FMCPEditorSnapshot::UnbindEditorDelegates()
+{
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        GEngine->OnActorMoved().Remove(ActorMovedHandle);
+    }
+
+    if (GEditor)
+    {
+        GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+    }
+
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+    FEditorDelegates::MapChange.Remove(MapChangeHandle);
+    FEditorDelegates::BeginPIE.Remove(BeginPIEHandle);
+    FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+}
+
+FString FMCPEditorSnapshot::MakeKey(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    FString Key = CommandType;
+    Key += TEXT(":");
+
+    if (Params.IsValid() && Params->Values.Num() > 0)
+    {
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Key);
+        FJsonSerializer::Serialize(Params.ToSharedRef(), Writer);
+    }
+
+    return Key;
+}
+
+bool FMCPEditorSnapshot::TryGetResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TSharedPtr<FJsonObject>& OutResponse)
+{
+    const FString Key = MakeKey(CommandType, Params);
+
+    TSharedPtr<FJsonObject> Cached;
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (const TSharedPtr<FJsonObject>* Found = Responses.Find(Key))
+        {
+            Cached = *Found;
+        }
+    }
+
+    if (!Cached.IsValid())
+    {
+        return false;
+    }
+
+    // Shared by every reader; nothing modifies a response once it is stored
+    OutResponse = Cached;
+    return true;
+}
+
+void FMCPEditorSnapshot::StoreResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& Response)
+{
+    check(IsInGameThread());
+
+    if (!Response.IsValid() || Response->GetStringField(TEXT("status")) != TEXT("success"))
+    {
+        return;
+    }
+
+    const FString Key = MakeKey(CommandType, Params);
+
+    FWriteScopeLock WriteLock(Lock);
+    if (Responses.Num() >= MCPEditorSnapshot::MaxResponses)
+    {
+        Responses.Reset();
+    }
+    Responses.Add(Key, Response);
+}
+
+void FMCPEditorSnapshot::Invalidate()
+{
+    FWriteScopeLock WriteLock(Lock);
+    if (Responses.Num() > 0)
+    {
+        Responses.Reset();
+    }
+}
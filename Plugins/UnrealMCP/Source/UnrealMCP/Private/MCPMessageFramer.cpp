@@ -0,0 +1,99 @@
+#include "MCPMessageFramer.h"
+
+FMCPMessageFramer::FMCPMessageFramer(int32 InMaxMessageSize)
+    : MaxMessageSize(FMath::Max(InMaxMessageSize, 1))
+{
+}
+
+void FMCPMessageFramer::ResetScanner()
+{
+    Depth = 0;
+    bInString = false;
+    bEscaped = false;
+    bHasContent = false;
+}
+
+void FMCPMessageFramer::Feed(const uint8* Data, int32 Size, TFunctionRef<void(FString&&)> OnMessage, TFunctionRef<void(int32 MaxSize)> OnOversized)
+{
+    Buffer.Append(Data, Size);
+
+    int32 MessageStart = 0;
+
+    for (int32 Index = ScanOffset; Index < Buffer.Num(); ++Index)
+    {
+        const uint8 Byte = Buffer[Index];
+        int32 MessageEnd = INDEX_NONE;
+
+        if (Byte == '\n' && Depth <= 0 && !bInString)
+        {
+            // Newline ends a message only between top-level values, so pretty-printed JSON spans
+            // lines. The same holds while discarding an oversized message: its inner lines are
+            // never taken for messages of their own.
+            MessageEnd = Index;
+        }
+        else if (bInString)
+        {
+            if (bEscaped)
+            {
+                bEscaped = false;
+            }
+            else if (Byte == '\\')
+            {
+                bEscaped = true;
+            }
+            else if (Byte == '"')
+            {
+                bInString = false;
+            }
+        }
+        else if (Byte == '"')
+        {
+            bInString = true;
+            bHasContent = true;
+        }
+        else if (Byte == '{' || Byte == '[')
+        {
+            ++Depth;
+            bHasContent = true;
+        }
+        else if (Byte == '}' || Byte == ']')
+        {
+            bHasContent = true;
+            if (--Depth == 0)
+            {
+                // Top-level value closed: complete even if no newline follows
+                MessageEnd = Index + 1;
+            }
+        }
+        else if (!FChar::IsWhitespace((TCHAR)Byte))
+        {
+            bHasContent = true;
+        }
+
+        if (MessageEnd != INDEX_NONE)
+        {
+            if (!bDiscarding && bHasContent)
+            {
+                FUTF8ToTCHAR Converter((const ANSICHAR*)Buffer.GetData() + MessageStart, MessageEnd - MessageStart);
+                OnMessage(FString(Converter.Length(), Converter.Get()));
+            }
+
+            bDiscarding = false;
+            ResetScanner();
+            MessageStart = Index + 1;
+        }
+        else if (!bDiscarding && Index - MessageStart >= MaxMessageSize)
+        {
+            OnOversized(MaxMessageSize);
+            bDiscarding = true;
+        }
+    }
+
+    // Keep only the message in progress (nothing at all of an oversized one)
+    const int32 Consumed = bDiscarding ? Buffer.Num() : MessageStart;
+    if (Consumed > 0)
+    {
+        Buffer.RemoveAt(0, Consumed, EAllowShrinking::No);
+    }
+    ScanOffset = Buffer.Num();
+}
@@ -0,0 +1,484 @@
+#include "MCPResponseEncoder.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/Compression.h"
+
+namespace MCPResponseEncoder
+{
+    /** Bodies smaller than this are not worth compressing */
+    static constexpr int32 MinCompressSize = 16 * 1024;
+
+    /** Largest double that still holds every integer below it exactly */
+    static constexpr double MaxSafeInteger = 9007199254740992.0;
+
+    static bool IsSafeInteger(double Value)
+    {
+        return FMath::Abs(Value) <= MaxSafeInteger && Value == FMath::FloorToDouble(Value);
+    }
+
+    static void AppendAnsi(const ANSICHAR* Text, TArray<uint8>& Out)
+    {
+        Out.Append((const uint8*)Text, FCStringAnsi::Strlen(Text));
+    }
+
+    /** Byte length of a string once converted to UTF-8 */
+    static int32 Utf8Length(const FString& Str)
+    {
+        return Str.IsEmpty() ? 0 : FPlatformString::ConvertedLength<UTF8CHAR>(*Str, Str.Len());
+    }
+
+    /** Append a string converted to UTF-8; Utf8Len comes from Utf8Length */
+    static void AppendUtf8(const FString& Str, int32 Utf8Len, TArray<uint8>& Out)
+    {
+        if (Utf8Len > 0)
+        {
+            const int32 Start = Out.AddUninitialized(Utf8Len);
+            FPlatformString::Convert((UTF8CHAR*)Out.GetData() + Start, Utf8Len, *Str, Str.Len());
+        }
+    }
+
+    template <typename T>
+    static void AppendBigEndian(T Value, TArray<uint8>& Out)
+    {
+        for (int32 Shift = (sizeof(T) - 1) * 8; Shift >= 0; Shift -= 8)
+        {
+            Out.Add((uint8)((uint64)Value >> Shift));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // JSON
+    // ------------------------------------------------------------------------
+
+    static bool NeedsEscape(uint8 Byte)
+    {
+        return Byte < 0x20 || Byte == '"' || Byte == '\\';
+    }
+
+    static void AppendEscaped(uint8 Byte, TArray<uint8>& Out)
+    {
+        switch (Byte)
+        {
+        case '"':  AppendAnsi("\\\"", Out); return;
+        case '\\': AppendAnsi("\\\\", Out); return;
+        case '\n': AppendAnsi("\\n", Out); return;
+        case '\r': AppendAnsi("\\r", Out); return;
+        case '\t': AppendAnsi("\\t", Out); return;
+        case '\b': AppendAnsi("\\b", Out); return;
+        case '\f': AppendAnsi("\\f", Out); return;
+        default:
+            break;
+        }
+
+        if (Byte < 0x20)
+        {
+            ANSICHAR Buffer[8];
+            FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "\\u%04x", Byte);
+            AppendAnsi(Buffer, Out);
+        }
+        else
+        {
+            Out.Add(Byte);
+        }
+    }
+
+    static void WriteJsonString(const FString& Str, TArray<uint8>& Out)
+    {
+        Out.Add('"');
+
+        const int32 Start = Out.Num();
+        AppendUtf8(Str, Utf8Length(Str), Out);
+
+        // Most strings need no escaping; only the tail after the first special byte is rewritten
+        int32 Index = Start;
+        while (Index < Out.Num() && !NeedsEscape(Out[Index]))
+        {
+            ++Index;
+        }
+
+        if (Index < Out.Num())
+        {
+            TArray<uint8> Tail(Out.GetData() + Index, Out.Num() - Index);
+            Out.SetNum(Index, EAllowShrinking::No);
+            for (uint8 Byte : Tail)
+            {
+                AppendEscaped(Byte, Out);
+            }
+        }
+
+        Out.Add('"');
+    }
+
+    static void WriteJsonNumber(double Value, TArray<uint8>& Out)
+    {
+        if (!FMath::IsFinite(Value))
+        {
+            // Not representable in JSON
+            AppendAnsi("null", Out);
+            return;
+        }
+
+        ANSICHAR Buffer[40];
+        if (IsSafeInteger(Value))
+        {
+            FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%lld", (long long)Value);
+        }
+        else
+        {
+            FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.17g", Value);
+        }
+        AppendAnsi(Buffer, Out);
+    }
+
+    static void WriteJsonObject(const FJsonObject& Object, TArray<uint8>& Out);
+
+    static void WriteJsonValue(const TSharedPtr<FJsonValue>& Value, TArray<uint8>& Out)
+    {
+        if (!Value.IsValid())
+        {
+            AppendAnsi("null", Out);
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::Boolean:
+            AppendAnsi(Value->AsBool() ? "true" : "false", Out);
+            break;
+
+        case EJson::Number:
+            WriteJsonNumber(Value->AsNumber(), Out);
+            break;
+
+        case EJson::String:
+            WriteJsonString(Value->AsString(), Out);
+            break;
+
+        case EJson::Array:
+        {
+            Out.Add('[');
+            bool bFirst = true;
+            for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+            {
+                if (!bFirst)
+                {
+                    Out.Add(',');
+                }
+                bFirst = false;
+                WriteJsonValue(Element, Out);
+            }
+            Out.Add(']');
+            break;
+        }
+
+        case EJson::Object:
+        {
+            const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+            if (Object.IsValid())
+            {
+                WriteJsonObject(*Object, Out);
+            }
+            else
+            {
+                AppendAnsi("null", Out);
+            }
+            break;
+        }
+
+        default:
+            AppendAnsi("null", Out);
+            break;
+        }
+    }
+
+    static void WriteJsonObject(const FJsonObject& Object, TArray<uint8>& Out)
+    {
+        Out.Add('{');
+        bool bFirst = true;
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+        {
+            if (!bFirst)
+            {
+                Out.Add(',');
+            }
+            bFirst = false;
+            WriteJsonString(Field.Key, Out);
+            Out.Add(':');
+            WriteJsonValue(Field.Value, Out);
+        }
+        Out.Add('}');
+    }
+
+    // ------------------------------------------------------------------------
+    // MESSAGEPACK
+    // ------------------------------------------------------------------------
+
+    /** Write a container or string header: fixed form, then 8/16/32-bit length forms */
+    static void WriteMsgPackLength(uint32 Length, uint8 FixPrefix, uint32 FixMax, uint8 Code8, uint8 Code16, uint8 Code32, TArray<uint8>& Out)
+    {
+        if (Length <= FixMax)
+        {
+            Out.Add(FixPrefix | (uint8)Length);
+        }
+        else if (Code8 != 0 && Length <= MAX_uint8)
+        {
+            Out.Add(Code8);
+            Out.Add((uint8)Length);
+        }
+        else if (Length <= MAX_uint16)
+        {
+            Out.Add(Code16);
+            AppendBigEndian<uint16>((uint16)Length, Out);
+        }
+        else
+        {
+            Out.Add(Code32);
+            AppendBigEndian<uint32>(Length, Out);
+        }
+    }
+
+    static void WriteMsgPackString(const FString& Str, TArray<uint8>& Out)
+    {
+        const int32 Utf8Len = Utf8Length(Str);
+        WriteMsgPackLength((uint32)Utf8Len, 0xa0, 31, 0xd9, 0xda, 0xdb, Out);
+        AppendUtf8(Str, Utf8Len, Out);
+    }
+
+    static void WriteMsgPackNumber(double Value, TArray<uint8>& Out)
+    {
+        if (!IsSafeInteger(Value))
+        {
+            uint64 Bits;
+            FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+            Out.Add(0xcb);
+            AppendBigEndian<uint64>(Bits, Out);
+            return;
+        }
+
+        const int64 Integer = (int64)Value;
+        if (Integer >= 0)
+        {
+            if (Integer <= 0x7f)
+            {
+                Out.Add((uint8)Integer);
+            }
+            else if (Integer <= MAX_uint8)
+            {
+                Out.Add(0xcc);
+                Out.Add((uint8)Integer);
+            }
+            else if (Integer <= MAX_uint16)
+            {
+                Out.Add(0xcd);
+                AppendBigEndian<uint16>((uint16)Integer, Out);
+            }
+            else if (Integer <= MAX_uint32)
+            {
+                Out.Add(0xce);
+                AppendBigEndian<uint32>((uint32)Integer, Out);
+            }
+            else
+            {
+                Out.Add(0xcf);
+                AppendBigEndian<uint64>((uint64)Integer, Out);
+            }
+        }
+        else if (Integer >= -32)
+        {
+            Out.Add((uint8)(int8)Integer);
+        }
+        else if (Integer >= MIN_int8)
+        {
+            Out.Add(0xd0);
+            Out.Add((uint8)(int8)Integer);
+        }
+        else if (Integer >= MIN_int16)
+        {
+            Out.Add(0xd1);
+            AppendBigEndian<uint16>((uint16)(int16)Integer, Out);
+        }
+        else if (Integer >= MIN_int32)
+        {
+            Out.Add(0xd2);
+            AppendBigEndian<uint32>((uint32)(int32)Integer, Out);
+        }
+        else
+        {
+            Out.Add(0xd3);
+            AppendBigEndian<uint64>((uint64)Integer, Out);
+        }
+    }
+
+    static void WriteMsgPackObject(const FJsonObject& Object, TArray<uint8>& Out);
+
+    static void WriteMsgPackValue(const TSharedPtr<FJsonValue>& Value, TArray<uint8>& Out)
+    {
+        if (!Value.IsValid())
+        {
+            Out.Add(0xc0);
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::Boolean:
+            Out.Add(Value->AsBool() ? 0xc3 : 0xc2);
+            break;
+
+        case EJson::Number:
+            WriteMsgPackNumber(Value->AsNumber(), Out);
+            break;
+
+        case EJson::String:
+            WriteMsgPackString(Value->AsString(), Out);
+            break;
+
+        case EJson::Array:
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+            WriteMsgPackLength((uint32)Elements.Num(), 0x90, 15, 0, 0xdc, 0xdd, Out);
+            for (const TSharedPtr<FJsonValue>& Element : Elements)
+            {
+                WriteMsgPackValue(Element, Out);
+            }
+            break;
+        }
+
+        case EJson::Object:
+        {
+            const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+            if (Object.IsValid())
+            {
+                WriteMsgPackObject(*Object, Out);
+            }
+            else
+            {
+                Out.Add(0xc0);
+            }
+            break;
+        }
+
+        default:
+            Out.Add(0xc0);
+            break;
+        }
+    }
+
+    static void WriteMsgPackObject(const FJsonObject& Object, TArray<uint8>& Out)
+    {
+        WriteMsgPackLength((uint32)Object.Values.Num(), 0x80, 15, 0, 0xde, 0xdf, Out);
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+        {
+            WriteMsgPackString(Field.Key, Out);
+            WriteMsgPackValue(Field.Value, Out);
+        }
+    }
+
+    /** Zlib-compress a body; false when it does not get smaller */
+    static bool Compress(const TArray<uint8>& Body, TArray<uint8>& OutCompressed)
+    {
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Body.Num());
+        OutCompressed.SetNumUninitialized(CompressedSize);
+
+        if (!FCompression::CompressMemory(NAME_Zlib, OutCompressed.GetData(), CompressedSize, Body.GetData(), Body.Num()) ||
+            CompressedSize >= Body.Num())
+        {
+            return false;
+        }
+
+        OutCompressed.SetNum(CompressedSize, EAllowShrinking::No);
+        return true;
+    }
+}
+
+FMCPResponseFormat FMCPResponseFormat::FromRequest(const FJsonObject& Message)
+{
+    FMCPResponseFormat Format;
+
+    FString Encoding;
+    if (Message.TryGetStringField(TEXT("encoding"), Encoding) &&
+        (Encoding.Equals(TEXT("msgpack"), ESearchCase::IgnoreCase) || Encoding.Equals(TEXT("messagepack"), ESearchCase::IgnoreCase)))
+    {
+        Format.Encoding = EMCPResponseEncoding::MessagePack;
+    }
+
+    FString Compression;
+    if (Message.TryGetStringField(TEXT("compression"), Compression) &&
+        (Compression.Equals(TEXT("zlib"), ESearchCase::IgnoreCase) || Compression.Equals(TEXT("deflate"), ESearchCase::IgnoreCase)))
+    {
+        Format.Compression = EMCPResponseCompression::Zlib;
+    }
+
+    return Format;
+}
+
+FMCPResponseEncoder::FStats FMCPResponseEncoder::EncodeMessage(const FJsonObject& Response, const TSharedPtr<FJsonValue>& RequestId, const FMCPResponseFormat& Format, TArray<uint8>& OutMessage)
+{
+    FStats Stats;
+    OutMessage.Reset();
+
+    if (!Format.IsFramed())
+    {
+        WriteJson(Response, OutMessage);
+        Stats.RawSize = OutMessage.Num();
+        OutMessage.Add('\n');
+        Stats.WireSize = OutMessage.Num();
+        return Stats;
+    }
+
+    TArray<uint8> Body;
+    if (Format.Encoding == EMCPResponseEncoding::MessagePack)
+    {
+        WriteMessagePack(Response, Body);
+    }
+    else
+    {
+        WriteJson(Response, Body);
+    }
+    Stats.RawSize = Body.Num();
+
+    TArray<uint8> Compressed;
+    if (Format.Compression == EMCPResponseCompression::Zlib && Body.Num() >= MCPResponseEncoder::MinCompressSize &&
+        MCPResponseEncoder::Compress(Body, Compressed))
+    {
+        Stats.Compression = EMCPResponseCompression::Zlib;
+    }
+    const TArray<uint8>& Payload = Stats.Compression == EMCPResponseCompression::None ? Body : Compressed;
+
+    FJsonObject Header;
+    if (RequestId.IsValid())
+    {
+        Header.SetField(TEXT("id"), RequestId);
+    }
+    Header.SetStringField(TEXT("frame"), LexToString(Format.Encoding));
+    Header.SetStringField(TEXT("compression"), LexToString(Stats.Compression));
+    Header.SetNumberField(TEXT("size"), Payload.Num());
+    Header.SetNumberField(TEXT("raw_size"), Stats.RawSize);
+
+    OutMessage.Reserve(Payload.Num() + 128);
+    WriteJson(Header, OutMessage);
+    OutMessage.Add('\n');
+    OutMessage.Append(Payload);
+    Stats.WireSize = OutMessage.Num();
+    return Stats;
+}
+
+void FMCPResponseEncoder::WriteJson(const FJsonObject& Object, TArray<uint8>& Out)
+{
+    MCPResponseEncoder::WriteJsonObject(Object, Out);
+}
+
+void FMCPResponseEncoder::WriteMessagePack(const FJsonObject& Object, TArray<uint8>& Out)
+{
+    MCPResponseEncoder::WriteMsgPackObject(Object, Out);
+}
+
+const TCHAR* FMCPResponseEncoder::LexToString(EMCPResponseEncoding Encoding)
+{
+    return Encoding == EMCPResponseEncoding::MessagePack ? TEXT("msgpack") : TEXT("json");
+}
+
+const TCHAR* FMCPResponseEncoder::LexToString(EMCPResponseCompression Compression)
+{
+    return Compression == EMCPResponseCompression::Zlib ? TEXT("zlib") : TEXT("none");
+}
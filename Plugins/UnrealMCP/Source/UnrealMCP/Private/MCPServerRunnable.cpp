@@ -1,4 +1,5 @@
 #include "MCPServerRunnable.h"
+#include "MCPMessageFramer.h"
 #include "EpicUnrealMCPBridge.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
@@ -10,18 +11,156 @@
 #include "JsonObjectConverter.h"
 #include "Misc/ScopeLock.h"
 #include "HAL/PlatformTime.h"
+#include "Async/Async.h"
+#include "HAL/RunnableThread.h"
+
+namespace MCPServer
+{
+    /** How long socket waits block before re-checking for shutdown */
+    static const FTimespan WaitInterval = FTimespan::FromMilliseconds(250);
+
+    /** Size of each socket read */
+    static constexpr int32 ReadChunkSize = 65536;
+
+    /** Largest accepted request; batches of thousands of commands stay well below this */
+    static constexpr int32 MaxMessageSize = 64 * 1024 * 1024;
+
+    /** Connected clients served at once; further connections are refused */
+    static constexpr int32 MaxClients = 16;
+}
+
+// ============================================================================
+// CLIENT CONNECTION
+// ============================================================================
+
+FMCPClientConnection::FMCPClientConnection(FSocket* InSocket, int32 InConnectionId)
+    : Socket(InSocket)
+    , ConnectionId(InConnectionId)
+    , bOpen(InSocket != nullptr)
+    , bCloseRequested(false)
+{
+}
+
+FMCPClientConnection::~FMCPClientConnection()
+{
+    Close();
+
+    if (Socket)
+    {
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+}
+
+bool FMCPClientConnection::SendMessage(const TArray<uint8>& Message)
+{
+    FScopeLock Lock(&SendLock);
+
+    if (!IsOpen())
+    {
+        return false;
+    }
+
+    return SendAll(Message.GetData(), Message.Num());
+}
+
+bool FMCPClientConnection::SendAll(const uint8* Data, int32 Size)
+{
+    int32 TotalBytesSent = 0;
+
+    // Send all data in a loop (TCP may not send everything at once)
+    while (TotalBytesSent < Size)
+    {
+        int32 BytesSent = 0;
+        if (!Socket->Send(Data + TotalBytesSent, Size - TotalBytesSent, BytesSent))
+        {
+            const ESocketErrors LastError = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+            if (LastError == SE_EWOULDBLOCK)
+            {
+                // A client that stopped reading must not hold up shutdown
+                if (bCloseRequested)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Client %d: closing with %d/%d bytes sent"),
+                           ConnectionId, TotalBytesSent, Size);
+                    return false;
+                }
+
+                Socket->Wait(ESocketWaitConditions::WaitForWrite, MCPServer::WaitInterval);
+                continue;
+            }
+
+            // Part of a message may be on the wire: nothing sent after it could be framed correctly
+            UE_LOG(LogTemp, Error, TEXT("MCPServerRunnable: Client %d: failed to send after %d/%d bytes - Error code: %d, closing"),
+                   ConnectionId, TotalBytesSent, Size, (int32)LastError);
+            RequestClose();
+            return false;
+        }
+
+        TotalBytesSent += BytesSent;
+    }
+
+    return true;
+}
+
+void FMCPClientConnection::Close()
+{
+    FScopeLock Lock(&SendLock);
+
+    if (bOpen)
+    {
+        bOpen = false;
+        Socket->Close();
+    }
+}
+
+// ============================================================================
+// CLIENT THREAD
+// ============================================================================
+
+FMCPClientRunnable::FMCPClientRunnable(FMCPServerRunnable* InServer, const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& InConnection)
+    : Server(InServer)
+    , Connection(InConnection)
+    , bFinished(false)
+{
+}
+
+uint32 FMCPClientRunnable::Run()
+{
+    Server->HandleClientConnection(Connection);
+
+    Connection->Close();
+    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client %d disconnected"), Connection->GetConnectionId());
+
+    // Edit sessions the client left open are closed and their compiles run
+    Server->HandleClientDisconnected(Connection->GetConnectionId());
+
+    bFinished = true;
+    return 0;
+}
+
+void FMCPClientRunnable::Stop()
+{
+    // Ends the read loop on its next wait timeout, and any blocked send; queued responses are dropped.
+    // The socket itself is closed by this client's thread once Run() returns.
+    Connection->RequestClose();
+}
+
+// ============================================================================
+// SERVER
+// ============================================================================
 
 FMCPServerRunnable::FMCPServerRunnable(UEpicUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket)
     : Bridge(InBridge)
     , ListenerSocket(InListenerSocket)
     , bRunning(true)
+    , NextConnectionId(1)
 {
     UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Created server runnable"));
 }
 
 FMCPServerRunnable::~FMCPServerRunnable()
 {
-    // Note: We don't delete the sockets here as they're owned by the bridge
+    // Note: We don't delete the listener socket here as it's owned by the bridge
 }
 
 bool FMCPServerRunnable::Init()
@@ -32,157 +171,107 @@ bool FMCPServerRunnable::Init()
 uint32 FMCPServerRunnable::Run()
 {
     UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Server thread starting..."));
-    
+
     while (bRunning)
     {
-        // UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Waiting for client connection..."));
-        
+        ReapFinishedClients();
+
+        // Block until a client connects (no sleep-polling: accept is immediate)
         bool bPending = false;
-        if (ListenerSocket->HasPendingConnection(bPending) && bPending)
+        if (!ListenerSocket->WaitForPendingConnection(bPending, MCPServer::WaitInterval) || !bPending)
         {
-            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client connection pending, accepting..."));
-            
-            ClientSocket = MakeShareable(ListenerSocket->Accept(TEXT("MCPClient")));
-            if (ClientSocket.IsValid())
-            {
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client connection accepted"));
-                
-                // Set socket options to improve connection stability
-                ClientSocket->SetNoDelay(true);
-                int32 SocketBufferSize = 65536;  // 64KB buffer
-                ClientSocket->SetSendBufferSize(SocketBufferSize, SocketBufferSize);
-                ClientSocket->SetReceiveBufferSize(SocketBufferSize, SocketBufferSize);
-                
-                uint8 Buffer[8192];
-                while (bRunning)
-                {
-                    int32 BytesRead = 0;
-                    if (ClientSocket->Recv(Buffer, sizeof(Buffer) - 1, BytesRead))
-                    {
-                        if (BytesRead == 0)
-                        {
-                            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client disconnected (zero bytes)"));
-                            break;
-                        }
-
-                        // Convert received data to string
-                        Buffer[BytesRead] = '\0';
-                        FString ReceivedText = UTF8_TO_TCHAR(Buffer);
-                        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Received: %s"), *ReceivedText);
-
-                        // Parse JSON
-                        TSharedPtr<FJsonObject> JsonObject;
-                        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ReceivedText);
-                        
-                        if (FJsonSerializer::Deserialize(Reader, JsonObject))
-                        {
-                            // Get command type
-                            FString CommandType;
-                            if (JsonObject->TryGetStringField(TEXT("type"), CommandType))
-                            {
-                                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Executing command: %s"), *CommandType);
-
-                                // Execute command
-                                FString Response = Bridge->ExecuteCommand(CommandType, JsonObject->GetObjectField(TEXT("params")));
-
-                                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Command executed, response length: %d"), Response.Len());
-
-                                // Log response for debugging (truncated for large responses)
-                                FString LogResponse = Response.Len() > 200 ? Response.Left(200) + TEXT("...") : Response;
-                                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Sending response (%d bytes): %s"),
-                                       Response.Len(), *LogResponse);
-
-                                // Convert to UTF8 once
-                                FTCHARToUTF8 UTF8Response(*Response);
-                                const uint8* DataToSend = (const uint8*)UTF8Response.Get();
-                                int32 TotalDataSize = UTF8Response.Length();
-                                int32 TotalBytesSent = 0;
-                                bool bSuccess = true;
-
-                                // Send all data in a loop (TCP may not send everything at once)
-                                while (TotalBytesSent < TotalDataSize)
-                                {
-                                    int32 BytesSent = 0;
-                                    bool bSendResult = ClientSocket->Send(DataToSend + TotalBytesSent,
-                                                                          TotalDataSize - TotalBytesSent,
-                                                                          BytesSent);
-
-                                    if (!bSendResult)
-                                    {
-                                        int32 LastError = (int32)ISocketSubsystem::Get()->GetLastErrorCode();
-                                        UE_LOG(LogTemp, Error, TEXT("MCPServerRunnable: Failed to send response after %d/%d bytes - Error code: %d"),
-                                               TotalBytesSent, TotalDataSize, LastError);
-                                        bSuccess = false;
-                                        break;
-                                    }
-
-                                    TotalBytesSent += BytesSent;
-                                    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Sent %d bytes (%d/%d total)"),
-                                           BytesSent, TotalBytesSent, TotalDataSize);
-                                }
-
-                                if (bSuccess)
-                                {
-                                    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Response sent successfully (%d bytes)"),
-                                           TotalBytesSent);
-                                }
-                            }
-                            else
-                            {
-                                UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Missing 'type' field in command"));
-                            }
-                        }
-                        else
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to parse JSON from: %s"), *ReceivedText);
-                        }
-                    }
-                    else
-                    {
-                        int32 LastError = (int32)ISocketSubsystem::Get()->GetLastErrorCode();
-                        // Don't break the connection for WouldBlock error, which is normal for non-blocking sockets
-                        bool bShouldBreak = true;
-                        
-                        // Check for "would block" error which isn't a real error for non-blocking sockets
-                        if (LastError == SE_EWOULDBLOCK) 
-                        {
-                            UE_LOG(LogTemp, Verbose, TEXT("MCPServerRunnable: Socket would block, continuing..."));
-                            bShouldBreak = false;
-                            // Small sleep to prevent tight loop when no data
-                            FPlatformProcess::Sleep(0.01f);
-                        }
-                        // Check for other transient errors we might want to tolerate
-                        else if (LastError == SE_EINTR) // Interrupted system call
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Socket read interrupted, continuing..."));
-                            bShouldBreak = false;
-                        }
-                        else 
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Client disconnected or error. Last error code: %d"), LastError);
-                        }
-                        
-                        if (bShouldBreak)
-                        {
-                            break;
-                        }
-                    }
-                }
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to accept client connection"));
-            }
+            continue;
         }
-        
-        // Small sleep to prevent tight loop
-        FPlatformProcess::Sleep(0.1f);
+
+        FSocket* AcceptedSocket = ListenerSocket->Accept(TEXT("MCPClient"));
+        if (!AcceptedSocket)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to accept client connection"));
+            continue;
+        }
+
+        StartClient(AcceptedSocket);
     }
-    
+
+    StopAllClients();
+
     UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Server thread stopping"));
     return 0;
 }
 
+void FMCPServerRunnable::StartClient(FSocket* AcceptedSocket)
+{
+    // Set socket options to improve connection stability
+    AcceptedSocket->SetNonBlocking(true);
+    AcceptedSocket->SetNoDelay(true);
+    int32 SocketBufferSize = 262144;  // 256KB buffer
+    AcceptedSocket->SetSendBufferSize(SocketBufferSize, SocketBufferSize);
+    AcceptedSocket->SetReceiveBufferSize(SocketBufferSize, SocketBufferSize);
+
+    TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe> Connection = MakeShared<FMCPClientConnection, ESPMode::ThreadSafe>(AcceptedSocket, NextConnectionId++);
+
+    if (Clients.Num() >= MCPServer::MaxClients)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Refusing client %d, %d clients already connected"),
+               Connection->GetConnectionId(), Clients.Num());
+
+        TSharedPtr<FJsonObject> ErrorResponse = MakeShareable(new FJsonObject);
+        ErrorResponse->SetStringField(TEXT("status"), TEXT("error"));
+        ErrorResponse->SetStringField(TEXT("error"), FString::Printf(TEXT("Too many clients (limit %d)"), MCPServer::MaxClients));
+
+        TArray<uint8> Message;
+        FMCPResponseEncoder::EncodeMessage(*ErrorResponse, nullptr, FMCPResponseFormat(), Message);
+        Connection->SendMessage(Message);
+        Connection->Close();
+        return;
+    }
+
+    FClientThread& Client = Clients.AddDefaulted_GetRef();
+    Client.Runnable = MakeUnique<FMCPClientRunnable>(this, Connection);
+    Client.Thread = FRunnableThread::Create(Client.Runnable.Get(),
+        *FString::Printf(TEXT("UnrealMCPClientThread%d"), Connection->GetConnectionId()), 0, TPri_Normal);
+
+    if (!Client.Thread)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPServerRunnable: Failed to create thread for client %d"), Connection->GetConnectionId());
+        Connection->Close();
+        Clients.Pop();
+        return;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client %d connected (%d clients)"), Connection->GetConnectionId(), Clients.Num());
+}
+
+void FMCPServerRunnable::ReapFinishedClients()
+{
+    for (int32 Index = Clients.Num() - 1; Index >= 0; --Index)
+    {
+        if (Clients[Index].Runnable->IsFinished())
+        {
+            Clients[Index].Thread->WaitForCompletion();
+            delete Clients[Index].Thread;
+            Clients.RemoveAtSwap(Index);
+        }
+    }
+}
+
+void FMCPServerRunnable::StopAllClients()
+{
+    // Ask every client to stop first so they wind down together, then wait for each.
+    // Every wait and send in a client thread is bounded by WaitInterval, so this cannot hang.
+    for (FClientThread& Client : Clients)
+    {
+        Client.Runnable->Stop();
+    }
+
+    for (FClientThread& Client : Clients)
+    {
+        Client.Thread->Kill(true);
+        delete Client.Thread;
+    }
+    Clients.Empty();
+}
+
 void FMCPServerRunnable::Stop()
 {
     bRunning = false;
@@ -192,178 +281,159 @@ void FMCPServerRunnable::Exit()
 {
 }
 
-void FMCPServerRunnable::HandleClientConnection(TSharedPtr<FSocket> InClientSocket)
+void FMCPServerRunnable::HandleClientDisconnected(int32 ClientId)
 {
-    if (!InClientSocket.IsValid())
-    {
-        UE_LOG(LogTemp, Error, TEXT("MCPServerRunnable: Invalid client socket passed to HandleClientConnection"));
-        return;
-    }
+    Bridge->HandleClientDisconnected(ClientId);
+}
+
+void FMCPServerRunnable::HandleClientConnection(const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& Connection)
+{
+    FSocket* Socket = Connection->GetSocket();
+
+    FMCPMessageFramer Framer(MCPServer::MaxMessageSize);
+
+    // Replies to unreadable messages use the format of the client's last readable request
+    FMCPResponseFormat ClientFormat;
+    TArray<uint8> ReadChunk;
+    ReadChunk.SetNumUninitialized(MCPServer::ReadChunkSize);
 
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Starting to handle client connection"));
-    
-    // Set socket options for better connection stability
-    InClientSocket->SetNonBlocking(false);
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Set socket to blocking mode"));
-    
-    // Properly read full message with timeout
-    const int32 MaxBufferSize = 4096;
-    uint8 Buffer[MaxBufferSize];
-    FString MessageBuffer;
-    
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Starting message receive loop"));
-    
-    while (bRunning && InClientSocket.IsValid())
+    while (bRunning && Connection->IsOpen())
     {
-        // Log socket state
-        bool bIsConnected = InClientSocket->GetConnectionState() == SCS_Connected;
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Socket state - Connected: %s"), 
-               bIsConnected ? TEXT("true") : TEXT("false"));
-        
-        // Log pending data status before receive
-        uint32 PendingDataSize = 0;
-        bool HasPendingData = InClientSocket->HasPendingData(PendingDataSize);
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Before Recv - HasPendingData=%s, Size=%d"), 
-               HasPendingData ? TEXT("true") : TEXT("false"), PendingDataSize);
-        
-        // Try to receive data with timeout
-        int32 BytesRead = 0;
-        bool bReadSuccess = false;
-        
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Attempting to receive data..."));
-        bReadSuccess = InClientSocket->Recv(Buffer, MaxBufferSize - 1, BytesRead, ESocketReceiveFlags::None);
-        
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Recv attempt complete - Success=%s, BytesRead=%d"), 
-               bReadSuccess ? TEXT("true") : TEXT("false"), BytesRead);
-        
-        if (BytesRead > 0)
+        // Wake as soon as data arrives; the timeout only bounds how long shutdown takes
+        if (!Socket->Wait(ESocketWaitConditions::WaitForRead, MCPServer::WaitInterval))
         {
-            // Log raw data for debugging
-            FString HexData;
-            for (int32 i = 0; i < FMath::Min(BytesRead, 50); ++i)
-            {
-                HexData += FString::Printf(TEXT("%02X "), Buffer[i]);
-            }
-            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Raw data (first 50 bytes hex): %s%s"), 
-                   *HexData, BytesRead > 50 ? TEXT("...") : TEXT(""));
-            
-            // Convert and log received data
-            Buffer[BytesRead] = 0; // Null terminate
-            FString ReceivedData = UTF8_TO_TCHAR(Buffer);
-            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Received data as string: '%s'"), *ReceivedData);
-            
-            // Append to message buffer
-            MessageBuffer.Append(ReceivedData);
-            
-            // Process complete messages (messages are terminated with newline)
-            if (MessageBuffer.Contains(TEXT("\n")))
+            if (Socket->GetConnectionState() == SCS_ConnectionError)
             {
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Newline detected in buffer, processing messages"));
-                
-                TArray<FString> Messages;
-                MessageBuffer.ParseIntoArray(Messages, TEXT("\n"), true);
-                
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Found %d message(s) in buffer"), Messages.Num());
-                
-                // Process all complete messages
-                for (int32 i = 0; i < Messages.Num() - 1; ++i)
-                {
-                    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Processing message %d: '%s'"), 
-                           i + 1, *Messages[i]);
-                    ProcessMessage(InClientSocket, Messages[i]);
-                }
-                
-                // Keep any incomplete message in the buffer
-                MessageBuffer = Messages.Last();
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Remaining buffer after processing: %s"), 
-                       *MessageBuffer);
+                break;
             }
-            else
+            continue;
+        }
+
+        int32 BytesRead = 0;
+        if (!Socket->Recv(ReadChunk.GetData(), ReadChunk.Num(), BytesRead))
+        {
+            const ESocketErrors LastError = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+            if (LastError == SE_EWOULDBLOCK || LastError == SE_EINTR)
             {
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: No complete message yet (no newline detected)"));
+                continue;
             }
+
+            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client %d: connection closed (error code %d)"),
+                   Connection->GetConnectionId(), (int32)LastError);
+            break;
         }
-        else if (!bReadSuccess)
+
+        if (BytesRead == 0)
         {
-            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Connection closed or error occurred - Last error: %d"), 
-                   (int32)ISocketSubsystem::Get()->GetLastErrorCode());
+            // Readable with no data: the client closed the connection
             break;
         }
-        
-        // Small sleep to prevent tight loop
-        FPlatformProcess::Sleep(0.01f);
+
+        Framer.Feed(ReadChunk.GetData(), BytesRead,
+            [this, &Connection, &ClientFormat](FString&& Message)
+            {
+                ProcessMessage(Connection, Message, ClientFormat);
+            },
+            [&Connection, &ClientFormat](int32 MaxSize)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Client %d: message exceeds %d bytes, discarding it"),
+                       Connection->GetConnectionId(), MaxSize);
+
+                TSharedPtr<FJsonObject> ErrorResponse = MakeShareable(new FJsonObject);
+                ErrorResponse->SetStringField(TEXT("status"), TEXT("error"));
+                ErrorResponse->SetStringField(TEXT("error"), FString::Printf(TEXT("Message exceeds the %d byte limit"), MaxSize));
+                SendResponse(Connection, ErrorResponse, nullptr, ClientFormat);
+            });
     }
-    
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Exited message receive loop"));
 }
 
-void FMCPServerRunnable::ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message)
+void FMCPServerRunnable::ProcessMessage(const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, const FString& Message, FMCPResponseFormat& ClientFormat)
 {
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Processing message: %s"), *Message);
-    
     // Parse message as JSON
     TSharedPtr<FJsonObject> JsonMessage;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
-    
+
     if (!FJsonSerializer::Deserialize(Reader, JsonMessage) || !JsonMessage.IsValid())
     {
-        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to parse message as JSON"));
+        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Client %d: failed to parse message as JSON (%d chars)"),
+               Connection->GetConnectionId(), Message.Len());
+
+        TSharedPtr<FJsonObject> ErrorResponse = MakeShareable(new FJsonObject);
+        ErrorResponse->SetStringField(TEXT("status"), TEXT("error"));
+        ErrorResponse->SetStringField(TEXT("error"), TEXT("Invalid JSON message"));
+        SendResponse(Connection, ErrorResponse, nullptr, ClientFormat);
         return;
     }
-    
-    // Extract command type and parameters using MCP protocol format
+
+    // Optional request id, echoed back so pipelined responses can be matched
+    TSharedPtr<FJsonValue> RequestId = JsonMessage->TryGetField(TEXT("id"));
+
+    // Optional response encoding and compression
+    const FMCPResponseFormat Format = FMCPResponseFormat::FromRequest(*JsonMessage);
+    ClientFormat = Format;
+
+    // Command type ("type", or "command" in the MCP protocol format)
     FString CommandType;
-    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
-    
-    if (!JsonMessage->TryGetStringField(TEXT("command"), CommandType))
+    if (!JsonMessage->TryGetStringField(TEXT("type"), CommandType) &&
+        !JsonMessage->TryGetStringField(TEXT("command"), CommandType))
     {
-        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Message missing 'command' field"));
+        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Client %d: message missing 'type' field"), Connection->GetConnectionId());
+
+        TSharedPtr<FJsonObject> ErrorResponse = MakeShareable(new FJsonObject);
+        ErrorResponse->SetStringField(TEXT("status"), TEXT("error"));
+        ErrorResponse->SetStringField(TEXT("error"), TEXT("Missing 'type' field in command"));
+        SendResponse(Connection, ErrorResponse, RequestId, Format);
         return;
     }
-    
-    // Parameters are optional in MCP protocol
-    if (JsonMessage->HasField(TEXT("params")))
+
+    // Parameters are optional
+    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
+    const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+    if (JsonMessage->TryGetObjectField(TEXT("params"), ParamsObject) && ParamsObject)
+    {
+        Params = *ParamsObject;
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("MCPServerRunnable: Client %d: dispatching %s"), Connection->GetConnectionId(), *CommandType);
+
+    // Dispatch without waiting: the next request is read while this one runs
+    Bridge->ExecuteCommandAsync(CommandType, Params, [Connection, RequestId, Format](TSharedPtr<FJsonObject> Response)
     {
-        TSharedPtr<FJsonValue> ParamsValue = JsonMessage->TryGetField(TEXT("params"));
-        if (ParamsValue.IsValid() && ParamsValue->Type == EJson::Object)
-        {
-            Params = ParamsValue->AsObject();
-        }
+        SendResponse(Connection, Response, RequestId, Format);
+    }, Connection->GetConnectionId());
+}
+
+void FMCPServerRunnable::SendResponse(const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, TSharedPtr<FJsonObject> Response, TSharedPtr<FJsonValue> RequestId,
+    const FMCPResponseFormat& Format)
+{
+    // The handler's result may be shared (the editor snapshot caches it), so the id goes on a copy
+    if (RequestId.IsValid())
+    {
+        TSharedPtr<FJsonObject> Tagged = MakeShareable(new FJsonObject);
+        Tagged->Values = Response->Values;
+        Tagged->SetField(TEXT("id"), RequestId);
+        Response = Tagged;
     }
-    
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Executing command: %s"), *CommandType);
-    
-    // Execute command
-    FString Response = Bridge->ExecuteCommand(CommandType, Params);
-    
-    // Send response with newline terminator
-    Response += TEXT("\n");
-
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Sending response (%d bytes): %s"),
-           Response.Len(), *Response);
-
-    // Convert to UTF8 once
-    FTCHARToUTF8 UTF8Response(*Response);
-    const uint8* DataToSend = (const uint8*)UTF8Response.Get();
-    int32 TotalDataSize = UTF8Response.Length();
-    int32 TotalBytesSent = 0;
 
-    // Send all data in a loop (TCP may not send everything at once)
-    while (TotalBytesSent < TotalDataSize)
+    // Encode and send on a worker so the game thread is never blocked on the socket
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Connection, Response, RequestId, Format]()
     {
-        int32 BytesSent = 0;
-        if (!Client->Send(DataToSend + TotalBytesSent, TotalDataSize - TotalBytesSent, BytesSent))
+        const double StartTime = FPlatformTime::Seconds();
+
+        TArray<uint8> Message;
+        const FMCPResponseEncoder::FStats Stats = FMCPResponseEncoder::EncodeMessage(*Response, RequestId, Format, Message);
+
+        const double EncodeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        if (!Connection->SendMessage(Message))
         {
-            UE_LOG(LogTemp, Error, TEXT("MCPServerRunnable: Failed to send response after %d/%d bytes"),
-                   TotalBytesSent, TotalDataSize);
+            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Client %d: response dropped (%d bytes), connection closed"),
+                   Connection->GetConnectionId(), Stats.WireSize);
             return;
         }
 
-        TotalBytesSent += BytesSent;
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Sent %d bytes (%d/%d total)"),
-               BytesSent, TotalBytesSent, TotalDataSize);
-    }
-
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Response sent successfully (%d bytes)"),
-           TotalBytesSent);
-} 
\ No newline at end of file
+        UE_LOG(LogTemp, Verbose, TEXT("MCPServerRunnable: Client %d: sent %d bytes (%s, %s, %d raw, encoded in %.2f ms)"),
+               Connection->GetConnectionId(), Stats.WireSize, FMCPResponseEncoder::LexToString(Format.Encoding),
+               FMCPResponseEncoder::LexToString(Stats.Compression), Stats.RawSize, EncodeMs);
+    });
+}
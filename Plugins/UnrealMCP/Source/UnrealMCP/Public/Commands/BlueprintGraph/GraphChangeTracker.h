@@ -0,0 +1,117 @@
+// Revision tokens and change lists for Blueprint graphs
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+class UEdGraphNode;
+struct FEdGraphEditAction;
+
+/** Nodes of a graph that changed after a given revision */
+struct FGraphChanges
+{
+	/** A node that is no longer in the graph */
+	struct FRemovedNode
+	{
+		FGuid NodeGuid;
+		FString Name;
+	};
+
+	/** Current revision of the graph */
+	int64 Revision = 0;
+
+	/** False when the revision asked about is unknown or too old; the graph must be read in full */
+	bool bComplete = false;
+
+	TArray<UEdGraphNode*> Added;
+	TArray<UEdGraphNode*> Modified;
+	TArray<FRemovedNode> Removed;
+};
+
+/**
+ * Per-graph revision counter and record of which nodes changed at which revision
+ * Graphs are tracked from their first query. Node additions and removals come from the
+ * graph's change notifications, and edits to a node (including its pins and links) from the
+ * node's Modify(), which every undoable change calls. Undo/redo restores state without
+ * either, so it starts every graph over at a new revision. Revisions come from one counter
+ * seeded from the clock, so a token from an earlier editor session or from before a graph
+ * was last tracked is never mistaken for a current one. Game thread only.
+ */
+class UNREALMCP_API FGraphChangeTracker
+{
+public:
+	/** The shared tracker, created on first use */
+	static FGraphChangeTracker& Get();
+
+	/** Destroy the shared tracker (module shutdown) */
+	static void Shutdown();
+
+	~FGraphChangeTracker();
+
+	/**
+	 * Current revision of a graph, tracking it from now on
+	 * @param Graph The graph
+	 * @return Revision token to pass to GetChangesSince later
+	 */
+	int64 GetRevision(UEdGraph* Graph);
+
+	/**
+	 * Nodes added, removed or modified after a revision
+	 * @param Graph The graph
+	 * @param SinceRevision A token from GetRevision (or an earlier GetChangesSince)
+	 * @return The changes; bComplete is false if they cannot be told from SinceRevision
+	 */
+	FGraphChanges GetChangesSince(UEdGraph* Graph, int64 SinceRevision);
+
+private:
+	FGraphChangeTracker();
+
+	/** Latest change of one node */
+	struct FNodeState
+	{
+		FGuid NodeGuid;
+		FString Name;
+
+		/** Revision the node was added at; 0 if it was in the graph when tracking began */
+		int64 AddedRevision = 0;
+		int64 ChangedRevision = 0;
+		bool bRemoved = false;
+	};
+
+	struct FGraphEntry
+	{
+		TWeakObjectPtr<UEdGraph> Graph;
+		FDelegateHandle GraphChangedHandle;
+
+		/** Changes before this revision are not recorded */
+		int64 BaseRevision = 0;
+		int64 Revision = 0;
+
+		/** Nodes changed since BaseRevision */
+		TMap<TWeakObjectPtr<UEdGraphNode>, FNodeState> Nodes;
+	};
+
+	/** Entry for a graph, tracking it on first use */
+	FGraphEntry& GetEntry(UEdGraph* Graph);
+
+	/** Forget recorded changes; older tokens then need a full read */
+	void Restart(FGraphEntry& Entry);
+
+	/** Record a change to a node at a new revision */
+	FNodeState& Touch(FGraphEntry& Entry, const UEdGraphNode* Node);
+
+	/** Drop removed nodes once they outnumber the live ones */
+	void Compact(FGraphEntry& Entry);
+
+	void OnGraphChanged(const FEdGraphEditAction& Action);
+	void OnObjectModified(UObject* Object);
+	void OnUndoRedo();
+
+	TMap<TWeakObjectPtr<UEdGraph>, FGraphEntry> Graphs;
+
+	/** Last revision handed out, across all graphs */
+	int64 LastRevision = 0;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle UndoRedoHandle;
+};
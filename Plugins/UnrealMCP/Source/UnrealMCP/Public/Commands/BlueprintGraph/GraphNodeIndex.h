@@ -0,0 +1,88 @@
+// Shared node and pin lookup for Blueprint graph commands
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphNode.h"
+
+class UEdGraph;
+class UEdGraphNode;
+struct FEdGraphEditAction;
+
+/**
+ * Per-graph index of nodes by NodeGuid and name, and of pins by name
+ * Graphs are indexed on first lookup and kept current through the graph's change
+ * notifications (nodes added/removed). Every hit is checked against the live graph, so a
+ * stale entry is never returned. Nodes are often given their GUID after they are added, so
+ * nodes added since the last lookup miss are re-keyed on a GUID miss; the whole graph is
+ * only re-indexed when a hit turns out stale or its node count shows an edit without
+ * notification. An unknown ID costs a lookup, not a re-index. Game thread only.
+ */
+class UNREALMCP_API FGraphNodeIndex
+{
+public:
+	/** The shared index, created on first use */
+	static FGraphNodeIndex& Get();
+
+	/** Destroy the shared index (module shutdown) */
+	static void Shutdown();
+
+	~FGraphNodeIndex();
+
+	/**
+	 * Find a node by its ID
+	 * @param Graph The graph to search
+	 * @param NodeID NodeGuid string or node object name (case-insensitive)
+	 * @return The node or nullptr
+	 */
+	UEdGraphNode* FindNode(UEdGraph* Graph, const FString& NodeID);
+
+	/**
+	 * Find a pin by name
+	 * @param Node The node owning the pin
+	 * @param PinName Pin name (case-insensitive)
+	 * @param Direction Required direction, EGPD_MAX for any
+	 * @return The pin or nullptr
+	 */
+	UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction = EGPD_MAX);
+
+private:
+	FGraphNodeIndex() = default;
+
+	/** Pin indices of one node by pin name */
+	struct FNodePins
+	{
+		TMultiMap<FName, int32> ByName;
+	};
+
+	struct FGraphEntry
+	{
+		TWeakObjectPtr<UEdGraph> Graph;
+		TMap<FGuid, TWeakObjectPtr<UEdGraphNode>> ByGuid;
+		TMap<FName, TWeakObjectPtr<UEdGraphNode>> ByName;
+		TMap<TWeakObjectPtr<UEdGraphNode>, FNodePins> Pins;
+		FDelegateHandle GraphChangedHandle;
+
+		/** Nodes added since the last GUID miss, with the GUID they were indexed under */
+		TArray<TPair<TWeakObjectPtr<UEdGraphNode>, FGuid>> Added;
+
+		/** Nodes the graph should have if every change was notified */
+		int32 NodeCount = 0;
+	};
+
+	/** Entry for a graph, indexing it on first use */
+	FGraphEntry& GetEntry(UEdGraph* Graph);
+
+	/** Index every node of a graph */
+	static void Rebuild(FGraphEntry& Entry);
+
+	static void AddNode(FGraphEntry& Entry, UEdGraphNode* Node);
+	static void RemoveNode(FGraphEntry& Entry, UEdGraphNode* Node);
+
+	/** Re-key recently added nodes whose GUID was assigned after they were indexed */
+	static void RekeyAddedNodes(FGraphEntry& Entry);
+	static void IndexPins(FNodePins& NodePins, const UEdGraphNode* Node);
+
+	void OnGraphChanged(const FEdGraphEditAction& Action);
+
+	TMap<TWeakObjectPtr<UEdGraph>, FGraphEntry> Graphs;
+};
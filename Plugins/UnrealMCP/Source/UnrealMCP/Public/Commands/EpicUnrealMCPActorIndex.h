@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class UWorld;
+struct FPropertyChangedEvent;
+
+/**
+ * Index of the actors in the current world (GWorld: the editor world, or the PIE world while it is current)
+ *
+ * Built on first use and kept current through actor added/deleted/renamed/relabelled
+ * notifications, so queries never walk the whole level. Actors are indexed by object, so
+ * actors of the same name in different levels are all listed, with lookups by class and tag;
+ * results are returned in path order (name order within a level) and optionally paged with a
+ * cursor (the path of the last actor returned). Game thread only.
+ */
+class FEpicUnrealMCPActorIndex
+{
+public:
+    FEpicUnrealMCPActorIndex();
+    ~FEpicUnrealMCPActorIndex();
+
+    /**
+     * List actors
+     * @param Params - name, label, class, tag (filters), fields, limit, cursor, include_total
+     * @param NamePattern - Extra name filter (find_actors_by_name), empty for none
+     * @return {"actors": [...], "count", "total"?, "next_cursor"?}
+     */
+    TSharedPtr<FJsonObject> Query(const TSharedPtr<FJsonObject>& Params, const FString& NamePattern = FString());
+
+private:
+    struct FActorEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FString Name;
+        FString Path;
+        FString Label;
+        FName Class;
+        TArray<FName> Tags;
+    };
+
+    /** Index the editor world if it changed or the index was dropped */
+    void EnsureBuilt();
+
+    void AddActor(AActor* Actor);
+    void RemoveActor(TObjectKey<AActor> Key);
+
+    /** Drop entries whose actor is gone without a notification */
+    void PruneStale();
+
+    /** Re-read label and tags of an indexed actor */
+    void RefreshActor(AActor* Actor);
+
+    /** True for actors of the indexed world */
+    bool IsIndexed(const AActor* Actor) const;
+
+    void OnActorAdded(AActor* Actor);
+    void OnActorDeleted(AActor* Actor);
+    void OnActorLabelChanged(AActor* Actor);
+    void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName);
+    void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+    /** Drop the index; it is rebuilt on the next query */
+    void MarkDirty();
+
+    /** Actors by object */
+    TMap<TObjectKey<AActor>, FActorEntry> Entries;
+
+    /** Actors by class name and by tag */
+    TMap<FName, TSet<TObjectKey<AActor>>> ByClass;
+    TMap<FName, TSet<TObjectKey<AActor>>> ByTag;
+
+    /** Actors in path order, re-sorted on query after changes */
+    TArray<TObjectKey<AActor>> SortedKeys;
+    bool bSortedKeysDirty = true;
+
+    TWeakObjectPtr<UWorld> IndexedWorld;
+    bool bBuilt = false;
+
+    FDelegateHandle ActorAddedHandle;
+    FDelegateHandle ActorDeletedHandle;
+    FDelegateHandle ActorListChangedHandle;
+    FDelegateHandle ActorLabelChangedHandle;
+    FDelegateHandle ObjectRenamedHandle;
+    FDelegateHandle PropertyChangedHandle;
+    FDelegateHandle MapChangeHandle;
+};
@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/EpicUnrealMCPCommandRegistry.h"
+
+class FEpicUnrealMCPMaterialCatalogue;
 
 /**
  * Handler class for Blueprint-related MCP commands
@@ -11,8 +14,11 @@ class FEpicUnrealMCPBlueprintCommands
 public:
     	FEpicUnrealMCPBlueprintCommands();
 
-    // Handle blueprint commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register blueprint commands (handlers capture this instance)
+    void RegisterCommands(FEpicUnrealMCPCommandRegistry& Registry);
+
+    // Also used by the editor commands' spawn_blueprint_actor
+    TSharedPtr<FJsonObject> HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params);
 
 private:
     // Specific blueprint command handlers (only used functions)
@@ -20,7 +26,8 @@ private:
     TSharedPtr<FJsonObject> HandleAddComponentToBlueprint(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetPhysicsProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleCompileBlueprint(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleBeginEditSession(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleEndEditSession(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetStaticMeshProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetMeshMaterialColor(const TSharedPtr<FJsonObject>& Params);
     
@@ -37,5 +44,7 @@ private:
     TSharedPtr<FJsonObject> HandleGetBlueprintVariableDetails(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleGetBlueprintFunctionDetails(const TSharedPtr<FJsonObject>& Params);
 
+    // Material list served by get_available_materials (created on first use)
+    TSharedPtr<FEpicUnrealMCPMaterialCatalogue> MaterialCatalogue;
 
 }; 
\ No newline at end of file
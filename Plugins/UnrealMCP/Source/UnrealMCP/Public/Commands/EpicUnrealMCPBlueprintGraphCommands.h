@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "Commands/EpicUnrealMCPCommandRegistry.h"
 
 class FEpicUnrealMCPBlueprintGraphCommands
 {
@@ -12,12 +13,10 @@ public:
     ~FEpicUnrealMCPBlueprintGraphCommands();
 
     /**
-     * Main command handler for Blueprint Graph operations
-     * @param CommandType The type of command to execute
-     * @param Params JSON parameters for the command
-     * @return JSON response object
+     * Register the Blueprint Graph commands
+     * @param Registry Registry to add the commands to (handlers capture this instance)
      */
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    void RegisterCommands(FEpicUnrealMCPCommandRegistry& Registry);
 
 private:
     // Add node to Blueprint graph
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UBlueprint;
+struct FAssetData;
+class FPackageReloadedEvent;
+enum class EPackageReloadPhase : uint8;
+
+/**
+ * Shared Blueprint lookup for every command that takes a Blueprint name or path
+ *
+ * Resolved Blueprints are cached by the name the client sent, as weak references, so a
+ * graph editing session that names the same Blueprint hundreds of times resolves it once.
+ * The cache is cleared when a Blueprint asset is renamed, removed or reloaded. Names that
+ * resolved to nothing are remembered too, so a client retrying a wrong name does not scan
+ * the asset registry each time; they are forgotten when any asset is added or renamed.
+ * Game thread only.
+ */
+class UNREALMCP_API FEpicUnrealMCPBlueprintResolver
+{
+public:
+    /** The shared resolver, created on first use */
+    static FEpicUnrealMCPBlueprintResolver& Get();
+
+    /** Destroy the shared resolver (module shutdown) */
+    static void Shutdown();
+
+    ~FEpicUnrealMCPBlueprintResolver();
+
+    /**
+     * Find or load a Blueprint
+     * @param BlueprintName - Asset name (looked up in /Game/Blueprints/, then anywhere), package path or object path
+     * @return The Blueprint, or nullptr if no such asset exists
+     */
+    UBlueprint* Resolve(const FString& BlueprintName);
+
+    /** Forget every resolved Blueprint */
+    void Invalidate();
+
+private:
+    FEpicUnrealMCPBlueprintResolver();
+
+    /** Object path a name or path refers to (/Game/Blueprints/Name.Name for a bare name) */
+    static FString MakeObjectPath(const FString& BlueprintName);
+
+    /** Resolve without the cache */
+    static UBlueprint* ResolveUncached(const FString& BlueprintName);
+
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    void OnPackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event);
+
+    /** Resolved Blueprints by requested name */
+    TMap<FString, TWeakObjectPtr<UBlueprint>> Cache;
+
+    /** Requested names that resolved to no Blueprint */
+    TSet<FString> Misses;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+    FDelegateHandle PackageReloadedHandle;
+};
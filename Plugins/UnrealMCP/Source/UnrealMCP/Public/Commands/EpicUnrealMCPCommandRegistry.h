@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+/** How a command may be executed */
+enum class EMCPCommandFlags : uint8
+{
+    None = 0,
+
+    /** Touches UObjects and must run on the game thread */
+    GameThread = 1 << 0,
+
+    /** Does not modify the editor state */
+    ReadOnly = 1 << 1,
+
+    /** May run as an item of a "batch" command */
+    Batchable = 1 << 2,
+
+    /** Result depends only on editor state and may be answered from the editor snapshot off the game thread */
+    Snapshot = 1 << 3
+};
+ENUM_CLASS_FLAGS(EMCPCommandFlags);
+
+/** Runs a command and returns its result object (or an error response) */
+using FMCPCommandHandler = TFunction<TSharedPtr<FJsonObject>(const TSharedPtr<FJsonObject>&)>;
+
+/**
+ * A registered MCP command
+ */
+struct FMCPCommandInfo
+{
+    FName Name;
+
+    /** Module that registered the command ("editor", "blueprint", ...) */
+    FString Category;
+
+    EMCPCommandFlags Flags = EMCPCommandFlags::None;
+
+    /** Parameter names, reported by "list_commands" */
+    TArray<FString> RequiredParams;
+    TArray<FString> OptionalParams;
+
+    FMCPCommandHandler Handler;
+
+    bool RequiresGameThread() const { return EnumHasAnyFlags(Flags, EMCPCommandFlags::GameThread); }
+    bool IsReadOnly() const { return EnumHasAnyFlags(Flags, EMCPCommandFlags::ReadOnly); }
+    bool IsBatchable() const { return EnumHasAnyFlags(Flags, EMCPCommandFlags::Batchable); }
+    bool IsSnapshot() const { return EnumHasAnyFlags(Flags, EMCPCommandFlags::Snapshot); }
+};
+
+/**
+ * Command registry keyed by FName
+ * Command modules register their handlers once at startup; dispatch is a single map lookup.
+ * The registry is not modified after startup, so lookups are safe from any thread.
+ */
+class UNREALMCP_API FEpicUnrealMCPCommandRegistry
+{
+public:
+    /**
+     * Register a command (replaces an existing command with the same name)
+     * @param Name - Command type sent by clients
+     * @param Category - Module that owns the command
+     * @param Flags - Execution metadata
+     * @param RequiredParams - Parameters the command cannot run without
+     * @param OptionalParams - Parameters with defaults
+     * @param Handler - Function that runs the command
+     */
+    void Register(FName Name, const FString& Category, EMCPCommandFlags Flags,
+        TArray<FString> RequiredParams, TArray<FString> OptionalParams, FMCPCommandHandler Handler);
+
+    /**
+     * Find a command by the type string a client sent
+     * @param CommandType - Command type
+     * @return The command, or nullptr if unknown
+     */
+    const FMCPCommandInfo* Find(const FString& CommandType) const;
+
+    /** Number of registered commands */
+    int32 Num() const { return Commands.Num(); }
+
+    /**
+     * Describe every command for "list_commands"
+     * @return {"commands": [{"name", "category", "game_thread", "read_only", "batchable", "snapshot", "params"}...], "count"}
+     */
+    TSharedPtr<FJsonObject> DescribeCommands() const;
+
+private:
+    TMap<FName, FMCPCommandInfo> Commands;
+};
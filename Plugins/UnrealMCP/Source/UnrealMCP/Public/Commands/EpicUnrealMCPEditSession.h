@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+class UBlueprint;
+
+/**
+ * Deferred Blueprint compilation for runs of MCP edits
+ *
+ * Outside a session, commands compile and refresh Blueprints immediately, as they always did.
+ * Inside a session (begin_edit_session ... end_edit_session, or a batch with defer_compile),
+ * compile requests and structural refreshes are only recorded per Blueprint; when the
+ * outermost session ends, each touched Blueprint gets one structural refresh and one compile.
+ * compile_blueprint compiles a Blueprint at once, in or out of a session.
+ *
+ * Sessions belong to the client whose command is running (see FScopedClient), so one client's
+ * open session never defers another client's compiles. When a client disconnects, its
+ * sessions are closed and their pending compiles run (EndClient). Game thread only.
+ */
+class UNREALMCP_API FEpicUnrealMCPEditSession
+{
+public:
+    /** Makes a client's sessions the current ones while one of its commands runs */
+    class FScopedClient
+    {
+    public:
+        explicit FScopedClient(int32 ClientId);
+        ~FScopedClient();
+
+    private:
+        int32 PreviousClientId;
+    };
+
+    /** Open a session for the current client (sessions nest) */
+    static void Begin();
+
+    /**
+     * Close a session; the outermost one compiles every pending Blueprint
+     * @return {"compiled": [...], "count", "compile_ms", "session_depth"}
+     */
+    static TSharedPtr<FJsonObject> End();
+
+    /** True while the current client has a session open */
+    static bool IsActive();
+
+    /**
+     * Compile now, or when the session ends
+     * @param Blueprint - Blueprint that was edited
+     */
+    static void RequestCompile(UBlueprint* Blueprint);
+
+    /**
+     * Refresh the Blueprint after a structural change now, or once when the session ends
+     * @param Blueprint - Blueprint that was edited
+     */
+    static void MarkStructurallyModified(UBlueprint* Blueprint);
+
+    /**
+     * Compile a Blueprint at once, applying a pending structural refresh first
+     * @param Blueprint - Blueprint to compile
+     * @return {"name", "path", "compile_ms", "status", "errors", "warnings", "coalesced_requests"}
+     */
+    static TSharedPtr<FJsonObject> Compile(UBlueprint* Blueprint);
+
+    /**
+     * Compile every Blueprint pending for the current client
+     * @return {"compiled": [...], "count", "compile_ms"}
+     */
+    static TSharedPtr<FJsonObject> Flush();
+
+    /**
+     * Close every session of a client and compile what they deferred (client disconnected)
+     * @param ClientId - Client whose sessions end
+     * @return {"compiled": [...], "count", "compile_ms"}
+     */
+    static TSharedPtr<FJsonObject> EndClient(int32 ClientId);
+
+    /** Close the sessions of every client and compile what they deferred (shutdown) */
+    static void EndAll();
+};
@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/EpicUnrealMCPCommandRegistry.h"
+
+class FEpicUnrealMCPActorIndex;
 
 /**
  * Handler class for Editor-related MCP commands
@@ -12,8 +15,8 @@ class UNREALMCP_API FEpicUnrealMCPEditorCommands
 public:
     	FEpicUnrealMCPEditorCommands();
 
-    // Handle editor commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register editor commands (handlers capture this instance)
+    void RegisterCommands(FEpicUnrealMCPCommandRegistry& Registry);
 
 private:
     // Actor manipulation commands
@@ -23,9 +26,16 @@ private:
     TSharedPtr<FJsonObject> HandleDeleteActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params);
 
+    // Bulk spawning: arrays of transforms per mesh/material as instanced components or actors
+    TSharedPtr<FJsonObject> HandleSpawnInstancedMeshes(const TSharedPtr<FJsonObject>& Params);
+
     // Blueprint actor spawning
     TSharedPtr<FJsonObject> HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params);
 
     // Asset management
     TSharedPtr<FJsonObject> HandleSaveAll(const TSharedPtr<FJsonObject>& Params);
+
+    // Actor index behind get_actors_in_level and find_actors_by_name (created on first use)
+    FEpicUnrealMCPActorIndex& GetActorIndex();
+    TSharedPtr<FEpicUnrealMCPActorIndex> ActorIndex;
 }; 
\ No newline at end of file
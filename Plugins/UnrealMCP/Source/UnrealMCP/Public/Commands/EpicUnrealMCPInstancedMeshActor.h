@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+class AActor;
+class UStaticMesh;
+class UStaticMeshComponent;
+class UMaterialInterface;
+class UWorld;
+
+/** One mesh/material pair and the transforms placed with it */
+struct FMCPInstancedMeshGroup
+{
+    UStaticMesh* Mesh = nullptr;
+    UMaterialInterface* Material = nullptr;
+    FString MeshPath;
+    FString MaterialPath;
+    TArray<FTransform> Transforms;
+};
+
+/**
+ * Builds a single actor that renders many static meshes through one hierarchical
+ * instanced static mesh component per mesh/material group.
+ * Shared by spawn_instanced_meshes and the structure generators. Game thread only.
+ */
+class UNREALMCP_API FEpicUnrealMCPInstancedMeshActor
+{
+public:
+    /**
+     * Spawn the actor and its instanced components
+     * @param World - World to spawn into
+     * @param ActorName - Name of the new actor; must not be taken
+     * @param ActorTransform - Transform of the new actor
+     * @param Groups - Meshes and their instance transforms; empty groups get no component
+     * @param bWorldSpace - Whether instance transforms are in world space or relative to the actor
+     * @return {"actor", "groups": [...], "instance_count", "actors_spawned", "draw_calls", "draw_calls_as_actors"}, or an error response
+     */
+    static TSharedPtr<FJsonObject> Spawn(UWorld* World, const FString& ActorName, const FTransform& ActorTransform,
+        const TArray<FMCPInstancedMeshGroup>& Groups, bool bWorldSpace);
+
+    /**
+     * Estimated draw calls for one copy of a mesh: one per LOD0 section
+     * @param Mesh - The mesh
+     * @return Section count, at least 1
+     */
+    static int32 DrawCallsPerCopy(const UStaticMesh* Mesh);
+
+    /**
+     * Apply a material to every slot of a mesh component
+     * @param Component - Component to change
+     * @param Material - Material to apply; nothing happens when null
+     */
+    static void ApplyMaterial(UStaticMeshComponent* Component, UMaterialInterface* Material);
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "AssetRegistry/AssetData.h"
+
+/**
+ * Catalogue of every material asset known to the asset registry
+ *
+ * Built once from asset registry data (no asset is loaded) and kept current through the
+ * registry's asset added/removed/renamed events. Entries are keyed by object path, so an
+ * asset is never listed twice. Game thread only.
+ */
+class FEpicUnrealMCPMaterialCatalogue
+{
+public:
+    FEpicUnrealMCPMaterialCatalogue();
+    ~FEpicUnrealMCPMaterialCatalogue();
+
+    /**
+     * List materials
+     * @param Params - search_path, include_engine_materials, name_filter, class_filter, offset, limit
+     * @return {"materials": [...], "count", "total", "offset", "next_offset"?, "search_path_used"}
+     */
+    TSharedPtr<FJsonObject> Query(const TSharedPtr<FJsonObject>& Params);
+
+private:
+    struct FMaterialEntry
+    {
+        FString Name;
+        FString Path;
+        FString Package;
+        FString Class;
+    };
+
+    /** Fill the catalogue from the asset registry on first use */
+    void EnsureBuilt();
+
+    /** Add an asset if its class is a material class */
+    void AddAsset(const FAssetData& AssetData);
+
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    void OnFilesLoaded();
+
+    /** Material entries by object path */
+    TMap<FString, FMaterialEntry> Entries;
+
+    /** Object paths in path order, rebuilt on query after changes */
+    TArray<FString> SortedPaths;
+    bool bSortedPathsDirty = true;
+
+    /** UMaterialInterface and every class derived from it */
+    TSet<FTopLevelAssetPath> MaterialClasses;
+
+    bool bBuilt = false;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+    FDelegateHandle FilesLoadedHandle;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "Commands/EpicUnrealMCPCommandRegistry.h"
+
+/**
+ * Handler class for procedural structure commands
+ * Each generator takes a compact parametric description (footprint, floors, wall style, seed),
+ * computes every block placement natively, in parallel, and emits the result as one actor
+ * with instanced mesh components instead of one actor per block.
+ */
+class UNREALMCP_API FEpicUnrealMCPStructureCommands
+{
+public:
+    FEpicUnrealMCPStructureCommands();
+
+    // Register structure commands (handlers capture this instance)
+    void RegisterCommands(FEpicUnrealMCPCommandRegistry& Registry);
+
+private:
+    // Rectangular multi-storey building with windowed walls, floor slabs and a flat roof
+    TSharedPtr<FJsonObject> HandleGenerateBuilding(const TSharedPtr<FJsonObject>& Params);
+
+    // Round, square or twisted tower built from courses of blocks
+    TSharedPtr<FJsonObject> HandleGenerateTower(const TSharedPtr<FJsonObject>& Params);
+
+    // Straight curtain wall, optionally crenellated
+    TSharedPtr<FJsonObject> HandleGenerateWall(const TSharedPtr<FJsonObject>& Params);
+
+    // Row of piers and arches, in one or more tiers
+    TSharedPtr<FJsonObject> HandleGenerateAqueduct(const TSharedPtr<FJsonObject>& Params);
+};
@@ -11,9 +11,13 @@
 #include "Commands/EpicUnrealMCPEditorCommands.h"
 #include "Commands/EpicUnrealMCPBlueprintCommands.h"
 #include "Commands/EpicUnrealMCPBlueprintGraphCommands.h"
+#include "Commands/EpicUnrealMCPStructureCommands.h"
+#include "Commands/EpicUnrealMCPCommandRegistry.h"
 #include "EpicUnrealMCPBridge.generated.h"
 
 class FMCPServerRunnable;
+class FMCPCommandScheduler;
+class FMCPEditorSnapshot;
 
 /**
  * Editor subsystem for MCP Bridge
@@ -39,14 +43,40 @@ public:
 	void StopServer();
 	bool IsRunning() const { return bIsRunning; }
 
-	// Command execution
-	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	/**
+	 * Queue a command on the game thread without waiting for it
+	 * @param CommandType - Command name
+	 * @param Params - Command parameters
+	 * @param OnComplete - Called with the response ({"status", "result"/"error"}), on the game thread or,
+	 *                     for a command answered from the editor snapshot, on the calling thread.
+	 *                     The response may be shared with the snapshot and must not be modified.
+	 * @param ClientId - Client the command belongs to; clients take turns on the game thread
+	 */
+	void ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TFunction<void(TSharedPtr<FJsonObject>)> OnComplete, int32 ClientId = 0);
+
+	/**
+	 * End a disconnected client's edit sessions once its queued commands have run
+	 * @param ClientId - Client that disconnected
+	 */
+	void HandleClientDisconnected(int32 ClientId);
 
 private:
+	// Run a command and build its response (game thread only)
+	TSharedPtr<FJsonObject> ExecuteCommandOnGameThread(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	// Register ping, list_commands and batch
+	void RegisterBridgeCommands();
+
+	/**
+	 * Run the "batch" command: every sub-command in one game thread task and one undo transaction
+	 * @param Params - {"commands": [{"type", "params"}...], "stop_on_error", "transaction", "description"}
+	 * @return Result with per-item results in order
+	 */
+	TSharedPtr<FJsonObject> ExecuteBatch(const TSharedPtr<FJsonObject>& Params);
+
 	// Server state
 	bool bIsRunning;
 	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ConnectionSocket;
 	FRunnableThread* ServerThread;
 
 	// Server configuration
@@ -57,4 +87,14 @@ private:
 	TSharedPtr<FEpicUnrealMCPEditorCommands> EditorCommands;
 	TSharedPtr<FEpicUnrealMCPBlueprintCommands> BlueprintCommands;
 	TSharedPtr<FEpicUnrealMCPBlueprintGraphCommands> BlueprintGraphCommands;
+	TSharedPtr<FEpicUnrealMCPStructureCommands> StructureCommands;
+
+	// Every command by name; filled once in the constructor
+	TSharedPtr<FEpicUnrealMCPCommandRegistry> CommandRegistry;
+
+	// Runs queued commands on the game thread, taking turns between clients
+	TSharedPtr<FMCPCommandScheduler> CommandScheduler;
+
+	// Inspection results served off the game thread until the editor state changes
+	TSharedPtr<FMCPEditorSnapshot> EditorSnapshot;
 }; 
\ No newline at end of file
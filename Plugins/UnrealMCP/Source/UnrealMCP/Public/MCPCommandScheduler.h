@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Deque.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Fair game thread scheduler for MCP commands
+ *
+ * Every client has its own FIFO queue. Once per frame the scheduler runs commands
+ * round-robin across the clients with pending work, one command per client per turn,
+ * until the queues are empty or the frame budget (MCP.CommandBudgetMs) is used up.
+ * A client pipelining thousands of commands therefore delays another client's
+ * command by at most one command per turn, and never stalls the editor for more
+ * than the budget. Commands of one client always run in the order they were queued.
+ */
+class FMCPCommandScheduler
+{
+public:
+	/** Runs one command of a client on the game thread and returns its response */
+	using FExecuteFunction = TFunction<TSharedPtr<FJsonObject>(int32, const FString&, const TSharedPtr<FJsonObject>&)>;
+
+	/** Receives a command's response on the game thread */
+	using FCompletionFunction = TFunction<void(TSharedPtr<FJsonObject>)>;
+
+	explicit FMCPCommandScheduler(FExecuteFunction InExecute);
+	~FMCPCommandScheduler();
+
+	/**
+	 * Queue a command (thread-safe)
+	 * @param ClientId - Queue the command belongs to
+	 * @param CommandType - Command name
+	 * @param Params - Command parameters
+	 * @param OnComplete - Called on the game thread with the response
+	 */
+	void Enqueue(int32 ClientId, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FCompletionFunction OnComplete);
+
+	/**
+	 * Queue work behind a client's commands (thread-safe)
+	 * @param ClientId - Queue the task belongs to
+	 * @param Task - Run on the game thread once the client's earlier commands have run
+	 */
+	void EnqueueTask(int32 ClientId, TFunction<void()> Task);
+
+	/** Commands waiting to run (thread-safe) */
+	int32 GetNumPending() const;
+
+	/**
+	 * Check whether a client has commands queued or running (thread-safe)
+	 * @param ClientId - Client to check
+	 * @return True until the client's last queued command has completed
+	 */
+	bool HasOutstanding(int32 ClientId) const;
+
+private:
+	struct FQueuedCommand
+	{
+		int32 ClientId = 0;
+		FString CommandType;
+		TSharedPtr<FJsonObject> Params;
+		FCompletionFunction OnComplete;
+
+		/** Set for work queued with EnqueueTask instead of a command */
+		TFunction<void()> Task;
+	};
+
+	struct FClientQueue
+	{
+		int32 ClientId = 0;
+		TDeque<FQueuedCommand> Commands;
+	};
+
+	/** Add a command to its client's queue (caller holds QueueLock) */
+	void Push(FQueuedCommand&& Command);
+
+	/** Run queued commands within the frame budget (game thread) */
+	bool Tick(float DeltaTime);
+
+	/** Pop the next command in round-robin order (caller holds QueueLock) */
+	bool PopNext(FQueuedCommand& OutCommand);
+
+	FExecuteFunction Execute;
+
+	mutable FCriticalSection QueueLock;
+	TArray<FClientQueue> Queues;
+	int32 NextQueue = 0;
+	int32 NumPending = 0;
+
+	/** Queued or running commands per client */
+	TMap<int32, int32> Outstanding;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Immutable snapshot of read-only command results
+ *
+ * Inspection commands (actor lists, Blueprint graphs, variable and function details) are
+ * answered from the snapshot on the client's own thread, in parallel and without waiting
+ * for a game thread frame. Results enter the snapshot the first time a command runs on the
+ * game thread and are never modified afterwards; every change to the editor state (an MCP
+ * command that edits, actors added/removed/moved, property edits, Modify() on an actor or
+ * component of the edited level or on anything inside a Blueprint, Blueprint compiles,
+ * undo/redo, map changes, PIE) throws the whole snapshot away. Results are rebuilt lazily,
+ * by the next request that misses.
+ */
+class FMCPEditorSnapshot
+{
+public:
+	FMCPEditorSnapshot();
+	~FMCPEditorSnapshot();
+
+	/**
+	 * Answer a command from the snapshot (any thread)
+	 * @param CommandType - Command name (must be a snapshot command)
+	 * @param Params - Command parameters
+	 * @param OutResponse - Response ready to send; shared with other readers, so it must not be modified
+	 * @return True if the snapshot held the result
+	 */
+	bool TryGetResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TSharedPtr<FJsonObject>& OutResponse);
+
+	/**
+	 * Keep a successful response computed on the game thread (game thread)
+	 * @param CommandType - Command name
+	 * @param Params - Command parameters
+	 * @param Response - Response; must not be modified afterwards
+	 */
+	void StoreResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& Response);
+
+	/** Discard the snapshot after the editor state changed */
+	void Invalidate();
+
+private:
+	/** Key of one command and its parameters */
+	static FString MakeKey(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	/** Whether a Modify() of this object can change a snapshot result */
+	static bool AffectsSnapshot(const UObject* Object);
+
+	void BindEditorDelegates();
+	void UnbindEditorDelegates();
+
+	mutable FRWLock Lock;
+	TMap<FString, TSharedPtr<FJsonObject>> Responses;
+
+	/** Editor change notifications */
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle UndoRedoHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle BeginPIEHandle;
+	FDelegateHandle EndPIEHandle;
+};
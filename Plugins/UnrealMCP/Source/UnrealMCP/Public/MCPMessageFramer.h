@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Splits the byte stream of an MCP connection into messages
+ *
+ * Messages are newline-delimited JSON. Only a newline outside any object, array or string
+ * ends a message, so pretty-printed multi-line JSON is read whole. A top-level JSON object
+ * that closes without a newline also ends a message, so legacy clients that send one object
+ * and wait are still served.
+ * Received bytes are scanned exactly once: the framer keeps the JSON nesting state of the
+ * partial message between reads, and only a completed message is converted from UTF-8.
+ *
+ * A message longer than the size limit is reported once and its remaining bytes are
+ * discarded up to the end of its top-level value, so the connection stays usable. The
+ * nesting state is kept while discarding, so no part of it is ever read as a message.
+ */
+class FMCPMessageFramer
+{
+public:
+	/** Default per-message limit */
+	static constexpr int32 DefaultMaxMessageSize = 64 * 1024 * 1024;
+
+	explicit FMCPMessageFramer(int32 InMaxMessageSize = DefaultMaxMessageSize);
+
+	/**
+	 * Append received bytes and report every message they complete
+	 * @param Data - Received bytes
+	 * @param Size - Number of bytes
+	 * @param OnMessage - Called with each complete message, in order
+	 * @param OnOversized - Called once for each message over the size limit
+	 */
+	void Feed(const uint8* Data, int32 Size, TFunctionRef<void(FString&&)> OnMessage, TFunctionRef<void(int32 MaxSize)> OnOversized);
+
+	/** Bytes held for the message in progress */
+	int32 GetPendingSize() const { return Buffer.Num(); }
+
+	int32 GetMaxMessageSize() const { return MaxMessageSize; }
+
+private:
+	/** Reset the JSON scanner for the next message */
+	void ResetScanner();
+
+	TArray<uint8> Buffer;
+	int32 MaxMessageSize;
+
+	/** Bytes of Buffer already scanned */
+	int32 ScanOffset = 0;
+
+	/** JSON scanner state of the message in progress */
+	int32 Depth = 0;
+	bool bInString = false;
+	bool bEscaped = false;
+	bool bHasContent = false;
+
+	/** Skipping the rest of an oversized message */
+	bool bDiscarding = false;
+};
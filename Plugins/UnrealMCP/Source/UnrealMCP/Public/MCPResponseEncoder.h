@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FJsonValue;
+
+/** Body encoding of a response */
+enum class EMCPResponseEncoding : uint8
+{
+	Json,
+	MessagePack
+};
+
+/** Compression applied to a framed response body */
+enum class EMCPResponseCompression : uint8
+{
+	None,
+	Zlib
+};
+
+/**
+ * Wire format a client asked for in its request envelope
+ *   {"id": 7, "type": "...", "params": {...}, "encoding": "msgpack", "compression": "zlib"}
+ * Unknown or unsupported values fall back to JSON and no compression.
+ */
+struct FMCPResponseFormat
+{
+	EMCPResponseEncoding Encoding = EMCPResponseEncoding::Json;
+	EMCPResponseCompression Compression = EMCPResponseCompression::None;
+
+	/** Read the format fields of a request envelope */
+	static FMCPResponseFormat FromRequest(const FJsonObject& Message);
+
+	/** Plain JSON lines need no frame header */
+	bool IsFramed() const { return Encoding != EMCPResponseEncoding::Json || Compression != EMCPResponseCompression::None; }
+};
+
+/**
+ * Encodes responses straight from the FJsonObject tree into wire bytes
+ *
+ * The default format is one line of UTF-8 JSON, as before. Any other format is sent as a
+ * frame: a JSON header line followed by exactly "size" bytes of body.
+ *   {"id": 7, "frame": "msgpack", "compression": "zlib", "size": 18234, "raw_size": 90112}\n<body>
+ * Bodies below a size threshold, or that do not shrink, are sent uncompressed and the
+ * header says so. No intermediate FString is built for either encoding.
+ */
+class FMCPResponseEncoder
+{
+public:
+	/** Sizes of one encoded message, for logging */
+	struct FStats
+	{
+		/** Body size before compression */
+		int32 RawSize = 0;
+
+		/** Bytes put on the wire, including any frame header and terminator */
+		int32 WireSize = 0;
+
+		/** Compression actually applied */
+		EMCPResponseCompression Compression = EMCPResponseCompression::None;
+	};
+
+	/**
+	 * Encode a response as one complete wire message
+	 * @param Response - Response to encode
+	 * @param RequestId - Request id to tag the response with, if any
+	 * @param Format - Format the client asked for
+	 * @param OutMessage - Receives the message; existing contents are replaced
+	 * @return Sizes of the message
+	 */
+	static FStats EncodeMessage(const FJsonObject& Response, const TSharedPtr<FJsonValue>& RequestId, const FMCPResponseFormat& Format, TArray<uint8>& OutMessage);
+
+	/**
+	 * Append an object as condensed UTF-8 JSON
+	 * @param Object - Object to write
+	 * @param Out - Buffer to append to
+	 */
+	static void WriteJson(const FJsonObject& Object, TArray<uint8>& Out);
+
+	/**
+	 * Append an object as MessagePack
+	 * @param Object - Object to write
+	 * @param Out - Buffer to append to
+	 */
+	static void WriteMessagePack(const FJsonObject& Object, TArray<uint8>& Out);
+
+	static const TCHAR* LexToString(EMCPResponseEncoding Encoding);
+	static const TCHAR* LexToString(EMCPResponseCompression Compression);
+};
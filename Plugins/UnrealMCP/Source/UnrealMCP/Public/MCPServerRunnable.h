@@ -4,11 +4,95 @@
 #include "HAL/Runnable.h"
 #include "Sockets.h"
 #include "Interfaces/IPv4/IPv4Address.h"
+#include "MCPResponseEncoder.h"
 
 class UEpicUnrealMCPBridge;
+class FRunnableThread;
+class FJsonObject;
+class FJsonValue;
+
+/**
+ * A connected MCP client
+ *
+ * The socket stays open for any number of commands. Responses may be sent from any
+ * thread; sends are serialized so pipelined responses never interleave on the wire.
+ * The socket is destroyed with the last reference, so commands still running on the
+ * game thread can safely answer after the client has gone.
+ */
+class FMCPClientConnection : public TSharedFromThis<FMCPClientConnection, ESPMode::ThreadSafe>
+{
+public:
+	FMCPClientConnection(FSocket* InSocket, int32 InConnectionId);
+	~FMCPClientConnection();
+
+	/** Send one complete wire message, already terminated or framed (thread-safe) */
+	bool SendMessage(const TArray<uint8>& Message);
+
+	/** Stop sending and close the socket (the thread reading the socket, or once nothing else uses it) */
+	void Close();
+
+	/**
+	 * Ask the connection to close from another thread
+	 * The read loop exits on its next wait timeout and a send blocked on a full socket gives up,
+	 * so shutdown never depends on closing a socket another thread is blocked on.
+	 */
+	void RequestClose() { bCloseRequested = true; }
+
+	bool IsOpen() const { return bOpen && !bCloseRequested; }
+	FSocket* GetSocket() const { return Socket; }
+	int32 GetConnectionId() const { return ConnectionId; }
+
+private:
+	/** Send a whole buffer, waiting while the socket is full; any failure closes the connection (caller holds SendLock) */
+	bool SendAll(const uint8* Data, int32 Size);
+
+	FSocket* Socket;
+	int32 ConnectionId;
+	TAtomic<bool> bOpen;
+	TAtomic<bool> bCloseRequested;
+	FCriticalSection SendLock;
+};
+
+class FMCPServerRunnable;
+
+/**
+ * Thread serving one client connection
+ * Reads and dispatches the client's requests until it disconnects or the server stops.
+ */
+class FMCPClientRunnable : public FRunnable
+{
+public:
+	FMCPClientRunnable(FMCPServerRunnable* InServer, const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& InConnection);
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	bool IsFinished() const { return bFinished; }
+	const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& GetConnection() const { return Connection; }
+
+private:
+	FMCPServerRunnable* Server;
+	TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe> Connection;
+	TAtomic<bool> bFinished;
+};
 
 /**
  * Runnable class for the MCP server thread
+ *
+ * Protocol: newline-delimited JSON messages on a persistent connection.
+ *   Request:  {"id": 7, "type": "spawn_actor", "params": {...}}\n
+ *   Response: {"id": 7, "status": "success", "result": {...}}\n
+ * Requests are dispatched to the game thread without waiting for earlier ones, so a client
+ * may keep many requests in flight and match responses by "id". Requests without an "id"
+ * (and legacy clients that send one JSON object without a newline) still get a response.
+ * Framing and the per-message size limit are handled by FMCPMessageFramer.
+ * A request may ask for a MessagePack and/or compressed response with "encoding" and
+ * "compression"; such responses are framed as described in FMCPResponseEncoder.
+ *
+ * The server thread only accepts connections; every client is served on its own
+ * FMCPClientRunnable thread, so several agents can be connected at once. Their requests
+ * share the game thread through the bridge's fair command scheduler.
  */
 class FMCPServerRunnable : public FRunnable
 {
@@ -22,13 +106,49 @@ public:
 	virtual void Stop() override;
 	virtual void Exit() override;
 
+	bool IsRunning() const { return bRunning; }
+
+	/** Read and dispatch requests until the client disconnects or the server stops (client thread) */
+	void HandleClientConnection(const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& Connection);
+
+	/** Let the bridge clean up after a client whose connection has closed (client thread) */
+	void HandleClientDisconnected(int32 ClientId);
+
 protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	void ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message);
+	/**
+	 * Parse one message and dispatch it to the bridge; the response is sent when the command completes
+	 * @param Connection - Client the message came from
+	 * @param Message - The message text
+	 * @param ClientFormat - Format of the client's last readable request; updated from this one, and
+	 *                       used for replies to messages that cannot be read
+	 */
+	void ProcessMessage(const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, const FString& Message, FMCPResponseFormat& ClientFormat);
+
+	/** Encode a response (tagged with the request id, if any) in the requested format and send it off the game thread */
+	static void SendResponse(const TSharedRef<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, TSharedPtr<FJsonObject> Response, TSharedPtr<FJsonValue> RequestId,
+		const FMCPResponseFormat& Format = FMCPResponseFormat());
+
+	/** Start a thread for a newly accepted client */
+	void StartClient(FSocket* AcceptedSocket);
+
+	/** Join the threads of clients that have disconnected */
+	void ReapFinishedClients();
+
+	/** Stop every client thread and wait for it */
+	void StopAllClients();
 
 private:
+	struct FClientThread
+	{
+		TUniquePtr<FMCPClientRunnable> Runnable;
+		FRunnableThread* Thread = nullptr;
+	};
+
 	UEpicUnrealMCPBridge* Bridge;
 	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
-	bool bRunning;
-}; 
\ No newline at end of file
+	TAtomic<bool> bRunning;
+	int32 NextConnectionId;
+
+	/** Client threads (server thread only) */
+	TArray<FClientThread> Clients;
+};
@@ -1,7 +1,15 @@
 // Firing Component Implementation
 
 #include "FiringComponent.h"
+#include "ScannableTargetRegistry.h"
+#include "LagCompensationSubsystem.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
 
@@ -17,12 +25,36 @@ void UFiringComponent::BeginPlay()
 
 	// Initialize bullet cooldown based on rate of fire
 	BulletCooldown = 0.0f;
+
+	// Native tractor pull runs in the physics step
+	if (TractorBeamConfig.bNativePull)
+	{
+		SetAsyncPhysicsTickEnabled(true);
+		bPullTickEnabled = true;
+
+		// The async physics tick only runs with Tick Physics Async on (enabled in DefaultEngine.ini)
+		if (!UPhysicsSettings::Get()->bTickPhysicsAsync)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FiringComponent: bNativePull is set on %s but Tick Physics Async is disabled; the tractor beam will not pull"),
+				*GetNameSafe(GetOwner()));
+		}
+	}
+}
+
+void UFiringComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ClearTractorPullState();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UFiringComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	// Step through fixed-rate aim samples first so each shot uses the aim at its own time
+	const bool bSteppedAimSamples = ProcessQueuedAimSamples();
+
 	// Draw debug trace line whenever firing is active
 	if (bIsFiring && bDrawDebug)
 	{
@@ -80,7 +112,10 @@ void UFiringComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 	switch (CurrentFiringMode)
 	{
 		case EFiringModeType::Bullet:
-			ProcessBulletMode(DeltaTime);
+			if (!bSteppedAimSamples)
+			{
+				ProcessBulletMode(DeltaTime);
+			}
 			break;
 
 		case EFiringModeType::TractorBeam:
@@ -123,6 +158,7 @@ void UFiringComponent::SetFiring(bool bShouldFire)
 			AActor* Target = TractorTarget.Get();
 			OnTractorBeamLost.Broadcast(Target);
 			TractorTarget.Reset();
+			ClearTractorPullState();
 		}
 		else if (CurrentFiringMode == EFiringModeType::Scanner && ScanTarget.IsValid())
 		{
@@ -182,6 +218,7 @@ void UFiringComponent::ResetModeState()
 		OnTractorBeamLost.Broadcast(TractorTarget.Get());
 		TractorTarget.Reset();
 	}
+	ClearTractorPullState();
 
 	// Cancel scan if switching away from scanner
 	if (ScanTarget.IsValid())
@@ -231,6 +268,32 @@ void UFiringComponent::ProcessBulletMode(float DeltaTime)
 	}
 }
 
+bool UFiringComponent::ProcessQueuedAimSamples()
+{
+	if (QueuedAimSamples.Num() == 0)
+	{
+		return false;
+	}
+
+	for (const FFiringAimSample& Sample : QueuedAimSamples)
+	{
+		ApplyImuOrientation(Sample.Orientation);
+
+		if (bQueuedSamplesDriveTrigger)
+		{
+			SetFiring(Sample.bTriggerHeld);
+		}
+
+		if (bIsFiring && CurrentFiringMode == EFiringModeType::Bullet)
+		{
+			ProcessBulletMode(QueuedAimInterval);
+		}
+	}
+
+	QueuedAimSamples.Reset();
+	return true;
+}
+
 void UFiringComponent::FireBullet()
 {
 	FVector Origin = GetFiringOrigin();
@@ -259,7 +322,7 @@ void UFiringComponent::FireBullet()
 		QueryParams.AddIgnoredActor(GetOwner());
 		QueryParams.bTraceComplex = true;
 
-		bool bHit = GetWorld()->LineTraceSingleByChannel(
+		bool bHit = LagCompensatedTrace(
 			HitResult,
 			Origin,
 			TraceEnd,
@@ -343,7 +406,7 @@ void UFiringComponent::ProcessTractorBeamMode(float DeltaTime)
 
 	FVector Origin = GetFiringOrigin();
 
-	// If we have a target, broadcast events
+	// If we have a target, broadcast events and update the native pull
 	if (TractorTarget.IsValid())
 	{
 		AActor* Target = TractorTarget.Get();
@@ -352,6 +415,7 @@ void UFiringComponent::ProcessTractorBeamMode(float DeltaTime)
 		{
 			OnTractorBeamLost.Broadcast(Target);
 			TractorTarget.Reset();
+			ClearTractorPullState();
 			return;
 		}
 
@@ -363,17 +427,29 @@ void UFiringComponent::ProcessTractorBeamMode(float DeltaTime)
 		{
 			OnTractorBeamLost.Broadcast(Target);
 			TractorTarget.Reset();
+			ClearTractorPullState();
 			return;
 		}
 
+		// Hand the current hold point to the physics step
+		UpdateTractorPullState(Target);
+
 		// Broadcast pulling event with distance
-		OnTractorBeamPulling.Broadcast(Target, Distance);
+		if (TractorBeamConfig.bBroadcastPulling)
+		{
+			OnTractorBeamPulling.Broadcast(Target, Distance);
+		}
 
 		// Debug visualization
 		if (bDrawDebug)
 		{
 			DrawDebugLine(GetWorld(), Origin, TargetLocation, FColor::Cyan, false, -1.0f, 1, 3.0f);
 			DrawDebugSphere(GetWorld(), TargetLocation, 20.0f, 8, FColor::Cyan, false, -1.0f);
+			if (TractorBeamConfig.bNativePull)
+			{
+				const FVector HoldPoint = Origin + GetFiringDirection() * TractorBeamConfig.HoldDistance;
+				DrawDebugSphere(GetWorld(), HoldPoint, 10.0f, 8, FColor::Green, false, -1.0f);
+			}
 		}
 	}
 	else
@@ -431,9 +507,164 @@ bool UFiringComponent::CanTractorActor(AActor* Actor) const
 		}
 	}
 
+	// Native pull only moves simulating bodies, and refuses anything heavier than the mass limit
+	if (TractorBeamConfig.bNativePull && TractorBeamConfig.MaxTargetMass > 0.0f)
+	{
+		UPrimitiveComponent* RootPrimitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+		if (RootPrimitive && RootPrimitive->IsSimulatingPhysics() && RootPrimitive->GetMass() > TractorBeamConfig.MaxTargetMass)
+		{
+			return false;
+		}
+	}
+
 	return true;
 }
 
+namespace FiringComponentPull
+{
+	/** The body of a component if it can be pulled right now */
+	static FBodyInstance* ResolveSimulatingBody(UPrimitiveComponent* Component)
+	{
+		if (!Component || !Component->IsSimulatingPhysics())
+		{
+			return nullptr;
+		}
+
+		FBodyInstance* Body = Component->GetBodyInstance();
+		return (Body && Body->IsValidBodyInstance()) ? Body : nullptr;
+	}
+}
+
+void UFiringComponent::UpdateTractorPullState(AActor* Target)
+{
+	// Re-resolved every frame: the body may have been recreated or stopped simulating since the last one
+	UPrimitiveComponent* TargetPrimitive = Target ? Cast<UPrimitiveComponent>(Target->GetRootComponent()) : nullptr;
+	FBodyInstance* TargetBody = FiringComponentPull::ResolveSimulatingBody(TargetPrimitive);
+	if (!TractorBeamConfig.bNativePull || !TargetBody)
+	{
+		ClearTractorPullState();
+		return;
+	}
+
+	// Config can be switched at runtime, so enable the physics step callback on first use
+	if (!bPullTickEnabled)
+	{
+		SetAsyncPhysicsTickEnabled(true);
+		bPullTickEnabled = true;
+	}
+
+	const FVector HoldPoint = GetFiringOrigin() + GetFiringDirection() * TractorBeamConfig.HoldDistance;
+
+	// If the ship itself simulates, store the hold point in its body space so substeps can follow it
+	UPrimitiveComponent* OwnerPrimitive = GetOwner() ? Cast<UPrimitiveComponent>(GetOwner()->GetRootComponent()) : nullptr;
+	FBodyInstance* OwnerBody = FiringComponentPull::ResolveSimulatingBody(OwnerPrimitive);
+
+	BindPullComponent(PullTargetComponent, TargetPrimitive);
+	BindPullComponent(PullOwnerComponent, OwnerBody ? OwnerPrimitive : nullptr);
+
+	const float GravityZ = (TractorBeamConfig.bCounterGravity && TargetPrimitive->IsGravityEnabled() && GetWorld())
+		? GetWorld()->GetGravityZ()
+		: 0.0f;
+
+	FScopeLock Lock(&TractorPullLock);
+	TractorPull.TargetActor = TargetBody->GetPhysicsActorHandle();
+	TractorPull.OwnerActor = OwnerBody ? OwnerBody->GetPhysicsActorHandle() : nullptr;
+	TractorPull.HoldPoint = HoldPoint;
+	TractorPull.LocalHoldPoint = OwnerBody ? OwnerBody->GetUnrealWorldTransform().InverseTransformPosition(HoldPoint) : HoldPoint;
+	TractorPull.Stiffness = TractorBeamConfig.PullStiffness;
+	TractorPull.Damping = TractorBeamConfig.PullDamping;
+	TractorPull.MaxAcceleration = TractorBeamConfig.MaxPullAcceleration;
+	TractorPull.GravityZ = GravityZ;
+	TractorPull.bActive = TractorPull.TargetActor != nullptr;
+}
+
+void UFiringComponent::ClearTractorPullState()
+{
+	BindPullComponent(PullTargetComponent, nullptr);
+	BindPullComponent(PullOwnerComponent, nullptr);
+
+	FScopeLock Lock(&TractorPullLock);
+	TractorPull = FTractorPullState();
+}
+
+void UFiringComponent::BindPullComponent(TWeakObjectPtr<UPrimitiveComponent>& Bound, UPrimitiveComponent* Component)
+{
+	if (Bound.Get() == Component)
+	{
+		return;
+	}
+
+	if (UPrimitiveComponent* Previous = Bound.Get())
+	{
+		Previous->OnComponentPhysicsStateChanged.RemoveDynamic(this, &UFiringComponent::OnPullBodyPhysicsStateChanged);
+	}
+
+	Bound = Component;
+	if (Component)
+	{
+		Component->OnComponentPhysicsStateChanged.AddUniqueDynamic(this, &UFiringComponent::OnPullBodyPhysicsStateChanged);
+	}
+}
+
+void UFiringComponent::OnPullBodyPhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange)
+{
+	if (StateChange != EComponentPhysicsStateChange::Destroyed)
+	{
+		return;
+	}
+
+	// Runs before the body is terminated, so the physics step never sees its proxy again;
+	// the next frame re-resolves the recreated body, if any
+	FScopeLock Lock(&TractorPullLock);
+	TractorPull = FTractorPullState();
+}
+
+void UFiringComponent::AsyncPhysicsTickComponent(float DeltaTime, float SimTime)
+{
+	Super::AsyncPhysicsTickComponent(DeltaTime, SimTime);
+
+	FTractorPullState Pull;
+	{
+		FScopeLock Lock(&TractorPullLock);
+		Pull = TractorPull;
+	}
+
+	if (!Pull.bActive || !Pull.TargetActor)
+	{
+		return;
+	}
+
+	FBodyInstanceAsyncPhysicsTickHandle TargetHandle(Pull.TargetActor->GetPhysicsThreadAPI());
+	if (!TargetHandle.IsValid())
+	{
+		return;
+	}
+
+	// Move the hold point with the ship's current physics state rather than last frame's transform
+	FVector HoldPoint = Pull.HoldPoint;
+	FVector HoldVelocity = FVector::ZeroVector;
+	if (Pull.OwnerActor)
+	{
+		FBodyInstanceAsyncPhysicsTickHandle OwnerHandle(Pull.OwnerActor->GetPhysicsThreadAPI());
+		if (OwnerHandle.IsValid())
+		{
+			const FVector OwnerLocation = OwnerHandle->X();
+			HoldPoint = OwnerLocation + OwnerHandle->R().RotateVector(Pull.LocalHoldPoint);
+			HoldVelocity = OwnerHandle->V() + FVector::CrossProduct(OwnerHandle->W(), HoldPoint - OwnerLocation);
+		}
+	}
+
+	// Mass-normalized spring-damper so the same settings feel identical on light and heavy props
+	FVector Acceleration = (HoldPoint - TargetHandle->X()) * Pull.Stiffness - (TargetHandle->V() - HoldVelocity) * Pull.Damping;
+	if (Pull.MaxAcceleration > 0.0f)
+	{
+		Acceleration = Acceleration.GetClampedToMaxSize(Pull.MaxAcceleration);
+	}
+	Acceleration.Z -= Pull.GravityZ;
+
+	TargetHandle->AddForce(Acceleration * TargetHandle->M());
+}
+
 bool UFiringComponent::HasTractorTarget() const
 {
 	return TractorTarget.IsValid();
@@ -451,6 +682,7 @@ void UFiringComponent::ReleaseTractorTarget()
 		OnTractorBeamLost.Broadcast(TractorTarget.Get());
 		TractorTarget.Reset();
 	}
+	ClearTractorPullState();
 }
 
 // ============================================================================
@@ -481,17 +713,9 @@ void UFiringComponent::ProcessScannerMode(float DeltaTime)
 		}
 
 		FVector TargetLocation = Target->GetActorLocation();
-		float Distance = FVector::Dist(Origin, TargetLocation);
-
-		// Check if target is still in range
-		bool bInRange = Distance <= ScannerConfig.Range;
 
-		// Check if target is still in cone
-		FVector ToTarget = (TargetLocation - Origin).GetSafeNormal();
-		float Angle = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(Direction, ToTarget)));
-		bool bInCone = Angle <= ScannerConfig.ScanConeAngle;
-
-		bool bTargetValid = bInRange && bInCone;
+		// Same cone test as acquisition, so an edge target is not acquired and dropped on alternate ticks
+		bool bTargetValid = IsScanTargetInCone(Target, Origin, Direction);
 
 		if (!bTargetValid)
 		{
@@ -581,6 +805,16 @@ void UFiringComponent::ProcessScannerMode(float DeltaTime)
 
 AActor* UFiringComponent::FindScanTarget()
 {
+	if (ScannerConfig.bUseTargetRegistry)
+	{
+		AActor* RegistryTarget = FindScanTargetInRegistry();
+		if (RegistryTarget)
+		{
+			return RegistryTarget;
+		}
+		// A registry miss still traces - scannable actors without a UScannableComponent are not registered
+	}
+
 	FHitResult HitResult;
 	if (PerformTrace(HitResult, ScannerConfig.Range, ScannerConfig.TraceChannel))
 	{
@@ -593,6 +827,69 @@ AActor* UFiringComponent::FindScanTarget()
 	return nullptr;
 }
 
+AActor* UFiringComponent::FindScanTargetInRegistry() const
+{
+	UWorld* World = GetWorld();
+	UScannableTargetRegistry* Registry = World ? World->GetSubsystem<UScannableTargetRegistry>() : nullptr;
+	if (!Registry || Registry->GetNumRegistered() == 0)
+	{
+		return nullptr;
+	}
+
+	// Resolve the tag filter to a bitmask - no per-candidate tag comparisons
+	uint64 RequiredTagMask = 0;
+	if (ScannerConfig.ScannableTags.Num() > 0)
+	{
+		bool bAnyTagKnown = false;
+		bool bMaskExact = true;
+		RequiredTagMask = Registry->MakeTagMask(ScannerConfig.ScannableTags, bAnyTagKnown, bMaskExact);
+		if (!bMaskExact)
+		{
+			// A required tag has no bit (registry tag limit), so let the trace path find it
+			return nullptr;
+		}
+		if (!bAnyTagKnown)
+		{
+			// No registered actor carries any of the required tags
+			return nullptr;
+		}
+	}
+
+	return Registry->FindBestTargetInCone(
+		GetFiringOrigin(),
+		GetFiringDirection(),
+		ScannerConfig.Range,
+		ScannerConfig.ScanConeAngle,
+		RequiredTagMask,
+		GetOwner()
+	);
+}
+
+bool UFiringComponent::IsScanTargetInCone(const AActor* Target, const FVector& Origin, const FVector& Direction) const
+{
+	UWorld* World = GetWorld();
+	const UScannableTargetRegistry* Registry = (ScannerConfig.bUseTargetRegistry && World) ? World->GetSubsystem<UScannableTargetRegistry>() : nullptr;
+	if (Registry)
+	{
+		// Uses cached bounds for registered targets and live bounds for the rest
+		return Registry->IsTargetInCone(Origin, Direction, ScannerConfig.Range, ScannerConfig.ScanConeAngle, Target);
+	}
+
+	if (!Target)
+	{
+		return false;
+	}
+
+	FVector Location;
+	FVector Extent;
+	Target->GetActorBounds(true, Location, Extent);
+
+	float Angle = 0.0f;
+	float Distance = 0.0f;
+	return UScannableTargetRegistry::IsSphereInCone(Origin, Direction, ScannerConfig.Range, ScannerConfig.ScanConeAngle,
+		Location, Extent.Size(), Angle, Distance);
+}
+
 bool UFiringComponent::CanScanActor(AActor* Actor) const
 {
 	if (!Actor)
@@ -674,7 +971,7 @@ bool UFiringComponent::PerformTrace(FHitResult& OutHit, float Range, ECollisionC
 	QueryParams.AddIgnoredActor(Owner);
 	QueryParams.bTraceComplex = false;
 
-	return GetWorld()->LineTraceSingleByChannel(
+	return LagCompensatedTrace(
 		OutHit,
 		Origin,
 		TraceEnd,
@@ -683,6 +980,45 @@ bool UFiringComponent::PerformTrace(FHitResult& OutHit, float Range, ECollisionC
 	);
 }
 
+bool UFiringComponent::LagCompensatedTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params) const
+{
+	const float RewindTime = GetRewindTime();
+	if (RewindTime > 0.0f)
+	{
+		if (const ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+		{
+			return LagCompensation->RewindLineTrace(OutHit, Start, End, Channel, Params, RewindTime);
+		}
+	}
+
+	return GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, Channel, Params);
+}
+
+float UFiringComponent::GetRewindTime() const
+{
+	if (!bUseLagCompensation || GetNetMode() == NM_Standalone || GetNetMode() == NM_Client)
+	{
+		return 0.0f;
+	}
+
+	// Only shots from remote players need rewinding
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	if (!OwnerPawn || OwnerPawn->IsLocallyControlled())
+	{
+		return 0.0f;
+	}
+
+	const APlayerState* PlayerState = OwnerPawn->GetPlayerState();
+	if (!PlayerState)
+	{
+		return 0.0f;
+	}
+
+	// Ping is round trip: the target state took half to reach the shooter and the shot took half to come back
+	const float RewindTime = PlayerState->GetPingInMilliseconds() * 0.001f + RewindInterpDelay;
+	return FMath::Clamp(RewindTime, 0.0f, MaxRewindTime);
+}
+
 FVector UFiringComponent::GetFiringDirection() const
 {
 	return GetForwardVector();
@@ -745,6 +1081,18 @@ void UFiringComponent::ApplyImuOrientation(const FQuat& RawImuQuat)
 // WEAPON MAG INTEGRATION
 // ============================================================================
 
+void UFiringComponent::QueueAimSamples(const TArray<FFiringAimSample>& Samples, float SampleInterval, bool bApplyTrigger)
+{
+	if (SampleInterval <= 0.0f)
+	{
+		return;
+	}
+
+	QueuedAimSamples.Append(Samples);
+	QueuedAimInterval = SampleInterval;
+	bQueuedSamplesDriveTrigger = bApplyTrigger;
+}
+
 void UFiringComponent::ApplyWeaponMagConfig(
 	bool bActive,
 	uint8 FiringMode,
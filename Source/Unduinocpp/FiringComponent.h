@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
+#include "Components/PrimitiveComponent.h"
 #include "FiringComponent.generated.h"
 
 // Forward declarations
@@ -97,8 +98,9 @@ struct FBulletModeConfig : public FFiringModeConfig
 
 /**
  * Tractor beam mode configuration
- * Note: Tractor beam only performs trace detection and broadcasts delegate events.
- * No physics manipulation (pulling, shrinking, collecting) is performed.
+ * By default the tractor beam only performs trace detection and broadcasts delegate events.
+ * With bNativePull enabled, simulating targets are pulled toward a hold point in front of the
+ * beam by a spring-damper applied every physics step (see UFiringComponent::AsyncPhysicsTickComponent).
  */
 USTRUCT(BlueprintType)
 struct FTractorBeamModeConfig : public FFiringModeConfig
@@ -115,6 +117,38 @@ struct FTractorBeamModeConfig : public FFiringModeConfig
 	/** Tags that objects must have (Actor Tags or Component Tags) to be tractored. Empty = all objects eligible. Checks both Actor->Tags and RootComponent->ComponentTags. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam")
 	TArray<FName> TractorableTags;
+
+	/** Pull simulating targets natively in the physics step. Disable if pulling is handled in Blueprint via OnTractorBeamPulling. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam|Pull")
+	bool bNativePull = false;
+
+	/** Distance in front of the beam origin where targets are held (in cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam|Pull", meta = (ClampMin = "0.0", EditCondition = "bNativePull"))
+	float HoldDistance = 400.0f;
+
+	/** Spring strength toward the hold point (acceleration per cm of offset, mass independent) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam|Pull", meta = (ClampMin = "0.0", EditCondition = "bNativePull"))
+	float PullStiffness = 40.0f;
+
+	/** Damping of velocity relative to the hold point (2 * sqrt(PullStiffness) is critically damped) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam|Pull", meta = (ClampMin = "0.0", EditCondition = "bNativePull"))
+	float PullDamping = 12.0f;
+
+	/** Maximum pull acceleration (in cm/s^2). Limits how hard far-away targets are yanked. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam|Pull", meta = (ClampMin = "0.0", EditCondition = "bNativePull"))
+	float MaxPullAcceleration = 6000.0f;
+
+	/** Heaviest object that can be tractored (in kg, 0 = no limit) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam|Pull", meta = (ClampMin = "0.0", EditCondition = "bNativePull"))
+	float MaxTargetMass = 500.0f;
+
+	/** Cancel gravity on held targets so they float at the hold point instead of sagging below it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam|Pull", meta = (EditCondition = "bNativePull"))
+	bool bCounterGravity = true;
+
+	/** Broadcast OnTractorBeamPulling every tick. Disable when nothing listens to save a Blueprint call per frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tractor Beam")
+	bool bBroadcastPulling = true;
 };
 
 /**
@@ -151,6 +185,28 @@ struct FScannerModeConfig : public FFiringModeConfig
 	/** Time before scan progress resets when target is lost (only if bRequireContinuousLock is false) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scanner", meta = (ClampMin = "0.0", EditCondition = "!bRequireContinuousLock"))
 	float ScanResetDelay = 1.0f;
+
+	/** Acquire targets with a cone query against UScannableTargetRegistry instead of a line trace.
+	 *  Falls back to the line trace when the registry finds nothing, so actors without a UScannableComponent are still acquired. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scanner")
+	bool bUseTargetRegistry = true;
+};
+
+/**
+ * One fixed-rate aim sample for sub-frame firing
+ */
+USTRUCT(BlueprintType)
+struct FFiringAimSample
+{
+	GENERATED_BODY()
+
+	/** Raw IMU orientation at this sample (passed to ApplyImuOrientation) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon IMU")
+	FQuat Orientation = FQuat::Identity;
+
+	/** Trigger state at this sample */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon IMU")
+	bool bTriggerHeld = false;
 };
 
 // ============================================================================
@@ -188,7 +244,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFiringStopped, EFiringModeType, M
  *
  * Features:
  * - Bullet mode: High rate of fire projectile weapon with damage
- * - Tractor beam: Detects targets and broadcasts delegate events (no physics manipulation)
+ * - Tractor beam: Detects targets, broadcasts delegate events and optionally pulls them with a physics-step spring-damper
  * - Scanner: Scans objects over time with progress events
  * - Extensible architecture for custom firing modes
  *
@@ -208,7 +264,9 @@ public:
 
 	// === UActorComponent Interface ===
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void AsyncPhysicsTickComponent(float DeltaTime, float SimTime) override;
 
 	// ============================================================================
 	// FIRING MODE CONFIGURATIONS
@@ -230,6 +288,22 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firing|Scanner Mode")
 	FScannerModeConfig ScannerConfig;
 
+	// ============================================================================
+	// LAG COMPENSATION
+	// ============================================================================
+
+	/** On the server, evaluate bullet and scan traces from remote shooters against rewound target history */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firing|Lag Compensation")
+	bool bUseLagCompensation = true;
+
+	/** Extra rewind added to the shooter's ping, e.g. client interpolation delay (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firing|Lag Compensation", meta = (ClampMin = "0.0", EditCondition = "bUseLagCompensation"))
+	float RewindInterpDelay = 0.0f;
+
+	/** Upper bound on how far a shot can be rewound (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Firing|Lag Compensation", meta = (ClampMin = "0.0", EditCondition = "bUseLagCompensation"))
+	float MaxRewindTime = 0.4f;
+
 	// ============================================================================
 	// DEBUG
 	// ============================================================================
@@ -462,6 +536,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Weapon IMU")
 	void ApplyImuOrientation(const FQuat& RawImuQuat);
 
+	/**
+	 * Queue fixed-rate aim samples covering the time since the last frame
+	 * On the next tick, bullet mode is stepped once per sample with the aim (and optionally
+	 * trigger) of that sample, so bursts between frames are spread along the real aim path.
+	 * @param Samples - Aim samples in time order
+	 * @param SampleInterval - Time between samples (in seconds)
+	 * @param bApplyTrigger - If true, each sample's trigger state drives SetFiring
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon IMU")
+	void QueueAimSamples(const TArray<FFiringAimSample>& Samples, float SampleInterval, bool bApplyTrigger);
+
 	// ============================================================================
 	// WEAPON MAG INTEGRATION
 	// ============================================================================
@@ -502,27 +587,55 @@ protected:
 	/** Process bullet firing mode */
 	void ProcessBulletMode(float DeltaTime);
 
+	/** Step aim, trigger and bullet mode through queued aim samples; returns false if none were queued */
+	bool ProcessQueuedAimSamples();
+
 	/** Fire a single bullet (or burst) */
 	void FireBullet();
 
 	/** Process tractor beam mode */
 	void ProcessTractorBeamMode(float DeltaTime);
 
-	/** Check if an actor can be tractored (tag check) */
+	/** Check if an actor can be tractored (tag check, plus simulation and mass checks for native pull) */
 	bool CanTractorActor(AActor* Actor) const;
 
+	/** Publish the current tractor target and hold point for the physics step */
+	void UpdateTractorPullState(AActor* Target);
+
+	/** Stop applying the native pull (target lost or released) */
+	void ClearTractorPullState();
+
+	/** Watch a pulled body so the pull is dropped before the body is torn down */
+	void BindPullComponent(TWeakObjectPtr<UPrimitiveComponent>& Bound, UPrimitiveComponent* Component);
+
+	/** A pulled body is being destroyed or recreated: stop the physics step from using it */
+	UFUNCTION()
+	void OnPullBodyPhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange);
+
 	/** Process scanner mode */
 	void ProcessScannerMode(float DeltaTime);
 
 	/** Find a valid scan target */
 	AActor* FindScanTarget();
 
+	/** Find a scan target with a cone query against the registry (no physics trace) */
+	AActor* FindScanTargetInRegistry() const;
+
+	/** Whether a scan target is still in the scanner cone (same test as registry acquisition) */
+	bool IsScanTargetInCone(const AActor* Target, const FVector& Origin, const FVector& Direction) const;
+
 	/** Check if an actor can be scanned */
 	bool CanScanActor(AActor* Actor) const;
 
 	/** Perform a line trace from the component */
 	bool PerformTrace(FHitResult& OutHit, float Range, ECollisionChannel Channel) const;
 
+	/** Line trace that is rewound by GetRewindTime() when lag compensation applies */
+	bool LagCompensatedTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params) const;
+
+	/** How far back the shooter's view lags the server (0 for local or standalone shooters) */
+	float GetRewindTime() const;
+
 	/** Get the firing direction (forward vector of component) */
 	FVector GetFiringDirection() const;
 
@@ -542,10 +655,51 @@ private:
 	/** Time until next bullet can be fired */
 	float BulletCooldown = 0.0f;
 
+	/** Fixed-rate aim samples queued for the next tick */
+	TArray<FFiringAimSample> QueuedAimSamples;
+
+	/** Time between queued aim samples */
+	float QueuedAimInterval = 0.0f;
+
+	/** Whether queued samples drive the trigger */
+	bool bQueuedSamplesDriveTrigger = false;
+
 	/** Current tractor beam target */
 	UPROPERTY()
 	TWeakObjectPtr<AActor> TractorTarget;
 
+	/**
+	 * Snapshot of the native pull written on the game thread and read in the physics step.
+	 * The hold point is stored relative to the owner's body so it follows the ship between
+	 * game frames when the physics step is substepped.
+	 */
+	struct FTractorPullState
+	{
+		/** Physics proxies, resolved on the game thread every frame; the physics thread frees them, never the game thread */
+		FPhysicsActorHandle TargetActor = nullptr;
+		FPhysicsActorHandle OwnerActor = nullptr;
+		FVector HoldPoint = FVector::ZeroVector;
+		FVector LocalHoldPoint = FVector::ZeroVector;
+		float Stiffness = 0.0f;
+		float Damping = 0.0f;
+		float MaxAcceleration = 0.0f;
+		float GravityZ = 0.0f;
+		bool bActive = false;
+	};
+
+	/** Guards TractorPull (physics step may run off the game thread) */
+	mutable FCriticalSection TractorPullLock;
+
+	/** Current native pull parameters */
+	FTractorPullState TractorPull;
+
+	/** Components whose bodies the pull uses (game thread only) */
+	TWeakObjectPtr<UPrimitiveComponent> PullTargetComponent;
+	TWeakObjectPtr<UPrimitiveComponent> PullOwnerComponent;
+
+	/** Whether the async physics tick has been enabled for native pull */
+	bool bPullTickEnabled = false;
+
 	/** Current scan target */
 	UPROPERTY()
 	TWeakObjectPtr<AActor> ScanTarget;
@@ -0,0 +1,478 @@
+// Ghost Race Subsystem Implementation
+
+#include "GhostRaceSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInterface.h"
+#include "Async/AsyncFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+
+DECLARE_STATS_GROUP(TEXT("GhostRace"), STATGROUP_GhostRace, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Update Ghosts"), STAT_GhostRaceUpdate, STATGROUP_GhostRace);
+DECLARE_CYCLE_STAT(TEXT("Upload Instances"), STAT_GhostRaceUpload, STATGROUP_GhostRace);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ghosts"), STAT_GhostRaceCount, STATGROUP_GhostRace);
+DECLARE_MEMORY_STAT(TEXT("Resident Memory"), STAT_GhostRaceMemory, STATGROUP_GhostRace);
+
+namespace GhostRace
+{
+	/** Blend factor for the smoothed per-frame timings */
+	static constexpr float TimingSmoothing = 0.05f;
+
+	static FAutoConsoleCommandWithWorld StatsCommand(
+		TEXT("Ghost.Stats"),
+		TEXT("Log memory and CPU measurements for the active ghosts"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (UGhostRaceSubsystem* Ghosts = World ? World->GetSubsystem<UGhostRaceSubsystem>() : nullptr)
+			{
+				Ghosts->LogStats();
+			}
+		}));
+}
+
+void UGhostRaceSubsystem::Deinitialize()
+{
+	for (FGhostPlayback& Ghost : Ghosts)
+	{
+		CloseGhost(Ghost);
+	}
+	Ghosts.Empty();
+	InstanceTransforms.Empty();
+	GhostInstances = nullptr;
+	GhostActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UGhostRaceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGhostRaceSubsystem, STATGROUP_Tickables);
+}
+
+void UGhostRaceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Ghosts.Num() == 0 || !GhostInstances)
+	{
+		return;
+	}
+
+	const uint64 UpdateStart = FPlatformTime::Cycles64();
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GhostRaceUpdate);
+
+		InstanceTransforms.SetNum(Ghosts.Num(), EAllowShrinking::No);
+		for (int32 i = 0; i < Ghosts.Num(); ++i)
+		{
+			UpdateGhost(Ghosts[i], DeltaTime);
+			InstanceTransforms[i] = Ghosts[i].Transform;
+		}
+	}
+	const uint64 UploadStart = FPlatformTime::Cycles64();
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GhostRaceUpload);
+
+		// One batched upload for every ghost
+		GhostInstances->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+	}
+	const uint64 UploadEnd = FPlatformTime::Cycles64();
+
+	const float UpdateMicros = (float)FPlatformTime::ToMilliseconds64(UploadStart - UpdateStart) * 1000.0f / Ghosts.Num();
+	const float UploadMicros = (float)FPlatformTime::ToMilliseconds64(UploadEnd - UploadStart) * 1000.0f;
+	AvgUpdateMicrosPerGhost = FMath::Lerp(AvgUpdateMicrosPerGhost, UpdateMicros, GhostRace::TimingSmoothing);
+	AvgUploadMicros = FMath::Lerp(AvgUploadMicros, UploadMicros, GhostRace::TimingSmoothing);
+
+#if STATS
+	int32 ResidentBytes = 0;
+	for (const FGhostPlayback& Ghost : Ghosts)
+	{
+		ResidentBytes += GetResidentBytes(Ghost);
+	}
+	SET_DWORD_STAT(STAT_GhostRaceCount, Ghosts.Num());
+	SET_MEMORY_STAT(STAT_GhostRaceMemory, ResidentBytes);
+#endif
+}
+
+// ============================================================================
+// GHOSTS
+// ============================================================================
+
+UInstancedStaticMeshComponent* UGhostRaceSubsystem::GetOrCreateInstances()
+{
+	if (GhostInstances)
+	{
+		return GhostInstances;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	GhostActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!GhostActor)
+	{
+		return nullptr;
+	}
+
+	// Ghosts are visual only: no collision, physics, overlaps or navigation
+	GhostInstances = NewObject<UInstancedStaticMeshComponent>(GhostActor, TEXT("GhostInstances"));
+	GhostInstances->SetMobility(EComponentMobility::Movable);
+	GhostInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GhostInstances->SetGenerateOverlapEvents(false);
+	GhostInstances->SetCanEverAffectNavigation(false);
+	GhostInstances->SetCastShadow(false);
+	GhostActor->SetRootComponent(GhostInstances);
+	GhostInstances->RegisterComponent();
+
+	SetGhostMesh(GhostMesh, GhostMaterial);
+
+	return GhostInstances;
+}
+
+void UGhostRaceSubsystem::SetGhostMesh(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	GhostMesh = Mesh;
+	GhostMaterial = Material;
+
+	if (!GhostInstances || !Mesh)
+	{
+		return;
+	}
+
+	GhostInstances->SetStaticMesh(Mesh);
+	if (Material)
+	{
+		for (int32 i = 0; i < GhostInstances->GetNumMaterials(); ++i)
+		{
+			GhostInstances->SetMaterial(i, Material);
+		}
+	}
+}
+
+int32 UGhostRaceSubsystem::AddGhost(const FString& Name)
+{
+	UInstancedStaticMeshComponent* Instances = GetOrCreateInstances();
+	if (!Instances)
+	{
+		return INDEX_NONE;
+	}
+
+	const FString Path = GhostReplay::GetGhostPath(Name);
+
+	// Only the header is read up front; samples are streamed during playback
+	FGhostPlayback Ghost;
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+		if (!Reader)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("GhostRaceSubsystem: Ghost '%s' not found"), *Path);
+			return INDEX_NONE;
+		}
+
+		Ghost.FileSize = Reader->TotalSize();
+		if (!Ghost.Header.Serialize(*Reader) || Ghost.Header.NumSamples == 0
+			|| Ghost.Header.DataOffset + Ghost.Header.GetDataSize() > Ghost.FileSize)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("GhostRaceSubsystem: '%s' is not a valid ghost"), *Path);
+			return INDEX_NONE;
+		}
+	}
+
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	if (Ghost.Header.MapName != MapName)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GhostRaceSubsystem: Ghost '%s' was recorded on '%s' (current map '%s')"),
+			*Path, *Ghost.Header.MapName, *MapName);
+	}
+
+	Ghost.FileHandle = FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*Path);
+	if (!Ghost.FileHandle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GhostRaceSubsystem: Could not open '%s' for streaming"), *Path);
+		return INDEX_NONE;
+	}
+
+	Ghost.Id = NextGhostId++;
+	Ghost.Path = Path;
+
+	// Show the start pose immediately
+	RequestChunk(Ghost, 0);
+	PollPendingRead(Ghost, true);
+	UpdateGhost(Ghost, 0.0f);
+
+	Instances->AddInstance(Ghost.Transform, true);
+	Ghosts.Add(MoveTemp(Ghost));
+
+	return Ghosts.Last().Id;
+}
+
+void UGhostRaceSubsystem::RemoveGhost(int32 GhostId)
+{
+	const int32 Index = FindGhostIndex(GhostId);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	CloseGhost(Ghosts[Index]);
+	Ghosts.RemoveAt(Index);
+
+	// ISM removal keeps instance order, so instance index stays equal to array index
+	if (GhostInstances)
+	{
+		GhostInstances->RemoveInstance(Index);
+	}
+}
+
+void UGhostRaceSubsystem::ClearGhosts()
+{
+	for (FGhostPlayback& Ghost : Ghosts)
+	{
+		CloseGhost(Ghost);
+	}
+	Ghosts.Reset();
+
+	if (GhostInstances)
+	{
+		GhostInstances->ClearInstances();
+	}
+}
+
+void UGhostRaceSubsystem::StartGhosts()
+{
+	for (FGhostPlayback& Ghost : Ghosts)
+	{
+		Ghost.Time = 0.0;
+		Ghost.bPlaying = true;
+
+		// Make sure the first chunk is resident before the first frame
+		PollPendingRead(Ghost, true);
+		RequestChunk(Ghost, 0);
+		PollPendingRead(Ghost, true);
+	}
+}
+
+bool UGhostRaceSubsystem::GetGhostTransform(int32 GhostId, FTransform& OutTransform) const
+{
+	const int32 Index = FindGhostIndex(GhostId);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutTransform = Ghosts[Index].Transform;
+	return true;
+}
+
+bool UGhostRaceSubsystem::GetGhostInput(int32 GhostId, FHoverInputSample& OutInput) const
+{
+	const int32 Index = FindGhostIndex(GhostId);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutInput = Ghosts[Index].Input;
+	return true;
+}
+
+int32 UGhostRaceSubsystem::FindGhostIndex(int32 GhostId) const
+{
+	return Ghosts.IndexOfByPredicate([GhostId](const FGhostPlayback& Ghost) { return Ghost.Id == GhostId; });
+}
+
+// ============================================================================
+// STREAMING
+// ============================================================================
+
+void UGhostRaceSubsystem::UpdateGhost(FGhostPlayback& Ghost, float DeltaTime)
+{
+	PollPendingRead(Ghost, false);
+
+	const FGhostReplayHeader& Header = Ghost.Header;
+	if (Ghost.bPlaying)
+	{
+		Ghost.Time += DeltaTime;
+		if (Ghost.Time >= Header.GetDuration())
+		{
+			Ghost.Time = Header.GetDuration();
+			Ghost.bPlaying = false;
+		}
+	}
+
+	const double SamplePosition = Ghost.Time * Header.SampleRate;
+	const int32 Index0 = FMath::Clamp(FMath::FloorToInt32(SamplePosition), 0, Header.NumSamples - 1);
+	const int32 Index1 = FMath::Min(Index0 + 1, Header.NumSamples - 1);
+	const float Alpha = FMath::Clamp((float)(SamplePosition - Index0), 0.0f, 1.0f);
+
+	const FGhostSample* A = GetSample(Ghost, Index0);
+	const FGhostSample* B = GetSample(Ghost, Index1);
+
+	if (A && B)
+	{
+		Ghost.Transform = FTransform(FQuat::Slerp(A->Rotation, B->Rotation, Alpha), FMath::Lerp(A->Location, B->Location, Alpha));
+		Ghost.Input.Throttle = FMath::Lerp(A->Input.Throttle, B->Input.Throttle, Alpha);
+		Ghost.Input.Steering = FMath::Lerp(A->Input.Steering, B->Input.Steering, Alpha);
+		Ghost.Input.Strafe = FMath::Lerp(A->Input.Strafe, B->Input.Strafe, Alpha);
+	}
+	else if (A)
+	{
+		Ghost.Transform = FTransform(A->Rotation, A->Location);
+		Ghost.Input = A->Input;
+	}
+	// Otherwise hold the last pose until the chunk arrives
+
+	// Keep one chunk of read-ahead in flight
+	RequestChunk(Ghost, Index0 / Header.SamplesPerChunk + 1);
+}
+
+const FGhostSample* UGhostRaceSubsystem::GetSample(FGhostPlayback& Ghost, int32 SampleIndex)
+{
+	const int32 Chunk = SampleIndex / Ghost.Header.SamplesPerChunk;
+	const int32 Slot = Chunk % 2;
+
+	if (Ghost.DecodedChunk[Slot] == Chunk)
+	{
+		const int32 Local = SampleIndex - Chunk * Ghost.Header.SamplesPerChunk;
+		return Ghost.Decoded[Slot].IsValidIndex(Local) ? &Ghost.Decoded[Slot][Local] : nullptr;
+	}
+
+	RequestChunk(Ghost, Chunk);
+	return nullptr;
+}
+
+void UGhostRaceSubsystem::RequestChunk(FGhostPlayback& Ghost, int32 Chunk)
+{
+	if (Ghost.PendingRead || !Ghost.FileHandle || Chunk < 0 || Chunk >= Ghost.Header.GetNumChunks()
+		|| Ghost.DecodedChunk[Chunk % 2] == Chunk)
+	{
+		return;
+	}
+
+	Ghost.PendingRead = Ghost.FileHandle->ReadRequest(
+		Ghost.Header.DataOffset + Ghost.Header.ChunkOffsets[Chunk],
+		Ghost.Header.GetChunkBytes(Chunk),
+		AIOP_Normal);
+	Ghost.PendingChunk = Chunk;
+}
+
+void UGhostRaceSubsystem::PollPendingRead(FGhostPlayback& Ghost, bool bWait)
+{
+	if (!Ghost.PendingRead)
+	{
+		return;
+	}
+
+	if (bWait)
+	{
+		Ghost.PendingRead->WaitCompletion();
+	}
+	else if (!Ghost.PendingRead->PollCompletion())
+	{
+		return;
+	}
+
+	const int32 Chunk = Ghost.PendingChunk;
+	const int32 Slot = Chunk % 2;
+
+	if (uint8* Bytes = Ghost.PendingRead->GetReadResults())
+	{
+		if (GhostReplay::DecodeChunk(Ghost.Header, Chunk, Bytes, Ghost.Header.GetChunkBytes(Chunk), Ghost.Decoded[Slot]))
+		{
+			Ghost.DecodedChunk[Slot] = Chunk;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("GhostRaceSubsystem: Corrupt chunk %d in '%s'"), Chunk, *Ghost.Path);
+			Ghost.DecodedChunk[Slot] = INDEX_NONE;
+		}
+		FMemory::Free(Bytes);
+	}
+
+	delete Ghost.PendingRead;
+	Ghost.PendingRead = nullptr;
+	Ghost.PendingChunk = INDEX_NONE;
+}
+
+void UGhostRaceSubsystem::CloseGhost(FGhostPlayback& Ghost)
+{
+	if (Ghost.PendingRead)
+	{
+		Ghost.PendingRead->WaitCompletion();
+		if (uint8* Bytes = Ghost.PendingRead->GetReadResults())
+		{
+			FMemory::Free(Bytes);
+		}
+		delete Ghost.PendingRead;
+		Ghost.PendingRead = nullptr;
+	}
+
+	delete Ghost.FileHandle;
+	Ghost.FileHandle = nullptr;
+}
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+int32 UGhostRaceSubsystem::GetResidentBytes(const FGhostPlayback& Ghost)
+{
+	int64 Bytes = sizeof(FGhostPlayback)
+		+ Ghost.Path.GetAllocatedSize()
+		+ Ghost.Header.MapName.GetAllocatedSize()
+		+ Ghost.Header.ChunkOffsets.GetAllocatedSize()
+		+ Ghost.Decoded[0].GetAllocatedSize()
+		+ Ghost.Decoded[1].GetAllocatedSize();
+
+	if (Ghost.PendingRead)
+	{
+		Bytes += Ghost.Header.GetChunkBytes(Ghost.PendingChunk);
+	}
+
+	return (int32)Bytes;
+}
+
+FGhostRaceStats UGhostRaceSubsystem::GetStats() const
+{
+	FGhostRaceStats Stats;
+	Stats.NumGhosts = Ghosts.Num();
+	Stats.UpdateMicrosPerGhost = AvgUpdateMicrosPerGhost;
+	Stats.InstanceUploadMicros = AvgUploadMicros;
+
+	int64 TotalFileBytes = 0;
+	double TotalDuration = 0.0;
+	for (const FGhostPlayback& Ghost : Ghosts)
+	{
+		Stats.ResidentBytes += GetResidentBytes(Ghost);
+		TotalFileBytes += Ghost.FileSize;
+		TotalDuration += Ghost.Header.GetDuration();
+	}
+
+	if (Ghosts.Num() > 0)
+	{
+		Stats.AvgBytesPerLap = (int32)(TotalFileBytes / Ghosts.Num());
+	}
+	if (TotalDuration > 0.0)
+	{
+		Stats.AvgBytesPerSecond = (float)(TotalFileBytes / TotalDuration);
+	}
+
+	return Stats;
+}
+
+void UGhostRaceSubsystem::LogStats() const
+{
+	const FGhostRaceStats Stats = GetStats();
+	UE_LOG(LogTemp, Log, TEXT("GhostRaceSubsystem: %d ghosts - %.2f us/ghost update, %.2f us instance upload, %d bytes resident (%d per ghost), %d bytes/lap on disk (%.0f B/s)"),
+		Stats.NumGhosts, Stats.UpdateMicrosPerGhost, Stats.InstanceUploadMicros, Stats.ResidentBytes,
+		Stats.NumGhosts > 0 ? Stats.ResidentBytes / Stats.NumGhosts : 0, Stats.AvgBytesPerLap, Stats.AvgBytesPerSecond);
+}
@@ -0,0 +1,219 @@
+// Ghost Race Subsystem - Streams recorded ghost laps from disk and draws them as instances
+// One manager and one instanced mesh for every ghost in the world
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GhostReplay.h"
+#include "GhostRaceSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+class IAsyncReadFileHandle;
+class IAsyncReadRequest;
+
+/**
+ * Memory and CPU measurements for the active ghosts
+ */
+USTRUCT(BlueprintType)
+struct UNDUINOCPP_API FGhostRaceStats
+{
+	GENERATED_BODY()
+
+	/** Ghosts loaded */
+	UPROPERTY(BlueprintReadOnly, Category = "Ghost")
+	int32 NumGhosts = 0;
+
+	/** Average game thread time per ghost per frame (streaming, decoding and interpolation, in microseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Ghost")
+	float UpdateMicrosPerGhost = 0.0f;
+
+	/** Average time to upload all instance transforms per frame (in microseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Ghost")
+	float InstanceUploadMicros = 0.0f;
+
+	/** Memory held by ghost playback state, decoded chunks and pending reads (in bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Ghost")
+	int32 ResidentBytes = 0;
+
+	/** Average compressed size of a loaded lap on disk (in bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Ghost")
+	int32 AvgBytesPerLap = 0;
+
+	/** Average compressed bytes per second of lap */
+	UPROPERTY(BlueprintReadOnly, Category = "Ghost")
+	float AvgBytesPerSecond = 0.0f;
+};
+
+/**
+ * Ghost Race Subsystem
+ *
+ * Plays back ghost files written by UGhostRecorderComponent. Only the file header is read
+ * up front; chunks are read asynchronously one ahead of the playhead and decoded into a
+ * two-chunk window per ghost, so a ghost costs a few KB however long the lap is.
+ *
+ * Ghosts are not actors: every ghost is one instance of a single non-colliding
+ * UInstancedStaticMeshComponent, updated with one batched transform upload per frame.
+ * Decoded movement input is exposed per ghost (GetGhostInput) for thruster effects.
+ *
+ * Measurements are available from GetStats(), the "stat GhostRace" group and the
+ * Ghost.Stats console command.
+ */
+UCLASS()
+class UNDUINOCPP_API UGhostRaceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// === USubsystem / FTickableGameObject Interface ===
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ============================================================================
+	// GHOSTS
+	// ============================================================================
+
+	/**
+	 * Set the mesh (and optional material) used to draw ghosts
+	 * @param Mesh - Ghost mesh
+	 * @param Material - Override material (e.g. translucent), or nullptr for the mesh's own
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	void SetGhostMesh(UStaticMesh* Mesh, UMaterialInterface* Material = nullptr);
+
+	/**
+	 * Load a ghost (header only) and add it to the race, paused at its start pose
+	 * @param Name - Ghost name or path
+	 * @return Ghost handle, or -1 if the file could not be loaded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	int32 AddGhost(const FString& Name);
+
+	/**
+	 * Remove a ghost
+	 * @param GhostId - Handle from AddGhost
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	void RemoveGhost(int32 GhostId);
+
+	/**
+	 * Remove all ghosts
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	void ClearGhosts();
+
+	/**
+	 * Start (or restart) every ghost from the beginning of its lap
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghost")
+	void StartGhosts();
+
+	/**
+	 * Get a ghost's current transform
+	 * @param GhostId - Handle from AddGhost
+	 * @param OutTransform - Receives the transform
+	 * @return True if the ghost exists
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ghost")
+	bool GetGhostTransform(int32 GhostId, FTransform& OutTransform) const;
+
+	/**
+	 * Get a ghost's recorded movement input at its current time
+	 * @param GhostId - Handle from AddGhost
+	 * @param OutInput - Receives the input
+	 * @return True if the ghost exists
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ghost")
+	bool GetGhostInput(int32 GhostId, FHoverInputSample& OutInput) const;
+
+	/**
+	 * Get memory and CPU measurements for the current ghosts
+	 * @return Stats
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ghost")
+	FGhostRaceStats GetStats() const;
+
+	/** Log GetStats() */
+	void LogStats() const;
+
+private:
+	/** Playback state of one ghost */
+	struct FGhostPlayback
+	{
+		int32 Id = INDEX_NONE;
+		FString Path;
+		FGhostReplayHeader Header;
+		int64 FileSize = 0;
+
+		/** Async file handle for chunk reads */
+		IAsyncReadFileHandle* FileHandle = nullptr;
+
+		/** Outstanding read and the chunk it is for */
+		IAsyncReadRequest* PendingRead = nullptr;
+		int32 PendingChunk = INDEX_NONE;
+
+		/** Two-chunk decoded window (slot = chunk % 2) */
+		TArray<FGhostSample> Decoded[2];
+		int32 DecodedChunk[2] = { INDEX_NONE, INDEX_NONE };
+
+		/** Playback time (in seconds) */
+		double Time = 0.0;
+		bool bPlaying = false;
+
+		FTransform Transform;
+		FHoverInputSample Input;
+	};
+
+	/** Active ghosts (instance index == array index) */
+	TArray<FGhostPlayback> Ghosts;
+
+	int32 NextGhostId = 0;
+
+	/** Mesh and material used for ghosts */
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> GhostMesh;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialInterface> GhostMaterial;
+
+	/** Actor owning the instanced mesh */
+	UPROPERTY()
+	TObjectPtr<AActor> GhostActor;
+
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> GhostInstances;
+
+	/** Scratch buffer for the per-frame transform upload */
+	TArray<FTransform> InstanceTransforms;
+
+	/** Smoothed measurements */
+	float AvgUpdateMicrosPerGhost = 0.0f;
+	float AvgUploadMicros = 0.0f;
+
+	/** Create the ghost actor and instanced mesh if needed */
+	UInstancedStaticMeshComponent* GetOrCreateInstances();
+
+	/** Find a ghost by handle */
+	int32 FindGhostIndex(int32 GhostId) const;
+
+	/** Advance one ghost and update its pose */
+	void UpdateGhost(FGhostPlayback& Ghost, float DeltaTime);
+
+	/** Get a decoded sample, streaming its chunk if needed (nullptr if not resident yet) */
+	const FGhostSample* GetSample(FGhostPlayback& Ghost, int32 SampleIndex);
+
+	/** Start an async read of a chunk if nothing is pending */
+	void RequestChunk(FGhostPlayback& Ghost, int32 Chunk);
+
+	/** Complete a finished read into the decoded window */
+	void PollPendingRead(FGhostPlayback& Ghost, bool bWait);
+
+	/** Release file handles and pending reads */
+	static void CloseGhost(FGhostPlayback& Ghost);
+
+	/** Bytes held by one ghost */
+	static int32 GetResidentBytes(const FGhostPlayback& Ghost);
+};
@@ -0,0 +1,143 @@
+// Ghost Recorder Component Implementation
+
+#include "GhostRecorderComponent.h"
+#include "HoverMovementComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UGhostRecorderComponent::UGhostRecorderComponent()
+{
+	// Sample after physics so the recorded transform matches what was rendered
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UGhostRecorderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelRecording();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FGhostSample UGhostRecorderComponent::CapturePose() const
+{
+	FGhostSample Pose;
+
+	if (AActor* Owner = GetOwner())
+	{
+		Pose.Location = Owner->GetActorLocation();
+		Pose.Rotation = Owner->GetActorQuat();
+	}
+
+	if (MovementComponent)
+	{
+		Pose.Input.Throttle = MovementComponent->GetCurrentThrottle();
+		Pose.Input.Steering = MovementComponent->GetCurrentSteering();
+		Pose.Input.Strafe = MovementComponent->GetCurrentStrafe();
+	}
+
+	return Pose;
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+void UGhostRecorderComponent::StartRecording()
+{
+	if (!MovementComponent && GetOwner())
+	{
+		MovementComponent = GetOwner()->FindComponentByClass<UHoverMovementComponent>();
+	}
+
+	Encoder = MakeUnique<FGhostEncoder>(SampleRate, PositionPrecision, SamplesPerChunk);
+	RecordTime = 0.0;
+	NextSampleTime = 0.0;
+	PreviousPose = CapturePose();
+
+	// First sample is the start pose
+	Encoder->AddSample(PreviousPose);
+	NextSampleTime = 1.0 / SampleRate;
+
+	SetComponentTickEnabled(true);
+}
+
+void UGhostRecorderComponent::CancelRecording()
+{
+	Encoder.Reset();
+	SetComponentTickEnabled(false);
+}
+
+int32 UGhostRecorderComponent::GetRecordedBytes() const
+{
+	return Encoder.IsValid() ? Encoder->GetEncodedSize() : 0;
+}
+
+bool UGhostRecorderComponent::StopRecording(const FString& Name, float LapTime)
+{
+	if (!Encoder.IsValid())
+	{
+		return false;
+	}
+
+	TUniquePtr<FGhostEncoder> Finished = MoveTemp(Encoder);
+	SetComponentTickEnabled(false);
+
+	UWorld* World = GetWorld();
+	const FString MapName = World ? UWorld::RemovePIEPrefix(World->GetMapName()) : FString();
+	const float StoredLapTime = LapTime >= 0.0f ? LapTime : (float)RecordTime;
+	const FString Path = GhostReplay::GetGhostPath(Name);
+
+	int64 FileSize = 0;
+	if (!Finished->SaveToFile(Path, MapName, StoredLapTime, FileSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("GhostRecorderComponent: Failed to write '%s'"), *Path);
+		return false;
+	}
+
+	// Memory per lap: file size vs. the decoded samples it replaces
+	const int32 NumSamples = Finished->GetNumSamples();
+	const int64 RawSize = (int64)NumSamples * sizeof(FGhostSample);
+	UE_LOG(LogTemp, Log, TEXT("GhostRecorderComponent: Saved '%s' - %d samples over %.1fs, %lld bytes (%.0f B/s, %.1f B/sample, %.1fx smaller than %lld bytes decoded)"),
+		*Path, NumSamples, StoredLapTime, FileSize,
+		StoredLapTime > 0.0f ? FileSize / StoredLapTime : 0.0f,
+		NumSamples > 0 ? (float)Finished->GetEncodedSize() / NumSamples : 0.0f,
+		FileSize > 0 ? (float)RawSize / FileSize : 0.0f, RawSize);
+
+	return true;
+}
+
+void UGhostRecorderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!Encoder.IsValid() || DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	const double FrameStart = RecordTime;
+	RecordTime += DeltaTime;
+
+	const FGhostSample CurrentPose = CapturePose();
+	const double SampleInterval = 1.0 / SampleRate;
+
+	// Emit every fixed-rate sample that fell inside this frame, interpolated between the two poses
+	while (NextSampleTime <= RecordTime)
+	{
+		const float Alpha = (float)((NextSampleTime - FrameStart) / DeltaTime);
+
+		FGhostSample Sample;
+		Sample.Location = FMath::Lerp(PreviousPose.Location, CurrentPose.Location, Alpha);
+		Sample.Rotation = FQuat::Slerp(PreviousPose.Rotation, CurrentPose.Rotation, Alpha);
+		Sample.Input.Throttle = FMath::Lerp(PreviousPose.Input.Throttle, CurrentPose.Input.Throttle, Alpha);
+		Sample.Input.Steering = FMath::Lerp(PreviousPose.Input.Steering, CurrentPose.Input.Steering, Alpha);
+		Sample.Input.Strafe = FMath::Lerp(PreviousPose.Input.Strafe, CurrentPose.Input.Strafe, Alpha);
+		Encoder->AddSample(Sample);
+
+		NextSampleTime += SampleInterval;
+	}
+
+	PreviousPose = CurrentPose;
+}
@@ -0,0 +1,111 @@
+// Ghost Recorder Component - Records the owning hovercraft's lap as a compressed ghost file
+// Samples transform and movement input at a fixed rate for UGhostRaceSubsystem playback
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GhostReplay.h"
+#include "GhostRecorderComponent.generated.h"
+
+class UHoverMovementComponent;
+
+/**
+ * Ghost Recorder Component
+ *
+ * Samples the owner's transform and UHoverMovementComponent's smoothed input at a fixed
+ * rate (interpolating between frames, so the frame rate does not matter) and encodes them
+ * on the fly with FGhostEncoder. Only the compressed stream is held in memory.
+ *
+ * Usage:
+ *   1. Add UGhostRecorderComponent to the hovercraft
+ *   2. Call StartRecording() when the lap starts
+ *   3. Call StopRecording("HoverTrack_Best") when it ends; the size is logged
+ */
+UCLASS(ClassGroup=(Movement), meta=(BlueprintSpawnableComponent), BlueprintType, Blueprintable)
+class UNDUINOCPP_API UGhostRecorderComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UGhostRecorderComponent();
+
+	// === UActorComponent Interface ===
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// ============================================================================
+	// CONFIGURATION
+	// ============================================================================
+
+	/** Samples per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost|Recording", meta = (ClampMin = "5.0", ClampMax = "120.0"))
+	float SampleRate = 30.0f;
+
+	/** Position precision (in cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost|Recording", meta = (ClampMin = "0.1", ClampMax = "10.0"))
+	float PositionPrecision = 1.0f;
+
+	/** Samples per independently decodable chunk (the streaming unit) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost|Recording", meta = (ClampMin = "8", ClampMax = "1024"))
+	int32 SamplesPerChunk = 64;
+
+	/** Movement component whose input is recorded (found on the owner if not set) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ghost|Recording")
+	TObjectPtr<UHoverMovementComponent> MovementComponent;
+
+	// ============================================================================
+	// RECORDING
+	// ============================================================================
+
+	/**
+	 * Start recording a lap (discards any recording in progress)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghost|Recording")
+	void StartRecording();
+
+	/**
+	 * Stop recording and save the ghost
+	 * @param Name - Ghost name or path (relative names go to Saved/Ghosts)
+	 * @param LapTime - Lap time to store (negative = recorded duration)
+	 * @return True if the ghost was saved
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghost|Recording")
+	bool StopRecording(const FString& Name, float LapTime = -1.0f);
+
+	/**
+	 * Stop recording without saving
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghost|Recording")
+	void CancelRecording();
+
+	/**
+	 * Check if a lap is being recorded
+	 * @return True while recording
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ghost|Recording")
+	bool IsRecording() const { return Encoder.IsValid(); }
+
+	/**
+	 * Get the compressed size of the recording so far
+	 * @return Encoded bytes
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ghost|Recording")
+	int32 GetRecordedBytes() const;
+
+private:
+	/** Encoder for the lap in progress */
+	TUniquePtr<FGhostEncoder> Encoder;
+
+	/** Recording time of the next sample */
+	double NextSampleTime = 0.0;
+
+	/** Recording time elapsed */
+	double RecordTime = 0.0;
+
+	/** Pose at the previous tick, for interpolating samples between frames */
+	FGhostSample PreviousPose;
+
+	/** Capture the owner's current pose and input */
+	FGhostSample CapturePose() const;
+};
@@ -0,0 +1,314 @@
+// Ghost Replay Implementation
+
+#include "GhostReplay.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace GhostReplay
+{
+	static uint32 ZigZag(int32 Value)
+	{
+		return ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+	}
+
+	static int32 UnZigZag(uint32 Value)
+	{
+		return (int32)(Value >> 1) ^ -(int32)(Value & 1);
+	}
+
+	static void WriteVarUInt(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add((uint8)(Value | 0x80));
+			Value >>= 7;
+		}
+		Out.Add((uint8)Value);
+	}
+
+	static bool ReadVarUInt(const uint8*& Cursor, const uint8* End, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35 && Cursor < End; Shift += 7)
+		{
+			const uint8 Byte = *Cursor++;
+			OutValue |= (uint32)(Byte & 0x7F) << Shift;
+			if (!(Byte & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static int8 QuantizeInput(float Value)
+	{
+		return (int8)FMath::RoundToInt(FMath::Clamp(Value, -1.0f, 1.0f) * 127.0f);
+	}
+
+	static float DequantizeInput(int8 Value)
+	{
+		return Value / 127.0f;
+	}
+
+	FString GetGhostPath(const FString& Name)
+	{
+		FString Path = Name;
+		if (FPaths::GetExtension(Path).IsEmpty())
+		{
+			Path += TEXT(".ghost");
+		}
+		if (FPaths::IsRelative(Path))
+		{
+			Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Ghosts"), Path);
+		}
+		return Path;
+	}
+
+	bool DecodeChunk(const FGhostReplayHeader& Header, int32 Chunk, const uint8* Bytes, int32 NumBytes, TArray<FGhostSample>& OutSamples)
+	{
+		const int32 NumSamples = Header.GetChunkSamples(Chunk);
+		OutSamples.SetNum(FMath::Max(NumSamples, 0), EAllowShrinking::No);
+
+		const uint8* Cursor = Bytes;
+		const uint8* End = Bytes + NumBytes;
+
+		int32 Pos[3] = {};
+		int32 PrevPos[2][3] = {};
+		uint16 Rot[3] = {};
+		int8 Input[3] = {};
+
+		for (int32 Index = 0; Index < NumSamples; ++Index)
+		{
+			uint32 Value = 0;
+
+			if (Index == 0)
+			{
+				// Keyframe
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					if (!ReadVarUInt(Cursor, End, Value))
+					{
+						return false;
+					}
+					Pos[Axis] = UnZigZag(Value);
+				}
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					if (!ReadVarUInt(Cursor, End, Value))
+					{
+						return false;
+					}
+					Rot[Axis] = (uint16)Value;
+				}
+				if (End - Cursor < 3)
+				{
+					return false;
+				}
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Input[Axis] = (int8)*Cursor++;
+				}
+			}
+			else
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					if (!ReadVarUInt(Cursor, End, Value))
+					{
+						return false;
+					}
+					const int32 Predicted = Index >= 2 ? 2 * PrevPos[0][Axis] - PrevPos[1][Axis] : PrevPos[0][Axis];
+					Pos[Axis] = Predicted + UnZigZag(Value);
+				}
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					if (!ReadVarUInt(Cursor, End, Value))
+					{
+						return false;
+					}
+					Rot[Axis] = (uint16)(Rot[Axis] + UnZigZag(Value));
+				}
+				if (Cursor >= End)
+				{
+					return false;
+				}
+				const uint8 Flags = *Cursor++;
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					if (Flags & (1 << Axis))
+					{
+						if (Cursor >= End)
+						{
+							return false;
+						}
+						Input[Axis] = (int8)*Cursor++;
+					}
+				}
+			}
+
+			FMemory::Memcpy(PrevPos[1], PrevPos[0], sizeof(PrevPos[0]));
+			FMemory::Memcpy(PrevPos[0], Pos, sizeof(Pos));
+
+			FGhostSample& Sample = OutSamples[Index];
+			Sample.Location = FVector(Pos[0], Pos[1], Pos[2]) * Header.PositionQuantum;
+			Sample.Rotation = FRotator(
+				FRotator::DecompressAxisFromShort(Rot[0]),
+				FRotator::DecompressAxisFromShort(Rot[1]),
+				FRotator::DecompressAxisFromShort(Rot[2])).Quaternion();
+			Sample.Input.Throttle = DequantizeInput(Input[0]);
+			Sample.Input.Steering = DequantizeInput(Input[1]);
+			Sample.Input.Strafe = DequantizeInput(Input[2]);
+		}
+
+		return true;
+	}
+}
+
+// ============================================================================
+// HEADER
+// ============================================================================
+
+bool FGhostReplayHeader::Serialize(FArchive& Ar)
+{
+	uint32 Magic = FileMagic;
+	int32 Version = FileVersion;
+	Ar << Magic;
+	Ar << Version;
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	Ar << SampleRate;
+	Ar << PositionQuantum;
+	Ar << SamplesPerChunk;
+	Ar << NumSamples;
+	Ar << LapTime;
+	Ar << MapName;
+	Ar << ChunkOffsets;
+
+	if (Ar.IsLoading())
+	{
+		const int32 ExpectedChunks = SamplesPerChunk > 0 ? FMath::DivideAndRoundUp(NumSamples, SamplesPerChunk) : -1;
+		bool bValid = SampleRate > 0.0f && PositionQuantum > 0.0f && NumSamples >= 0
+			&& ExpectedChunks >= 0 && ChunkOffsets.Num() == ExpectedChunks + 1;
+		for (int32 i = 1; bValid && i < ChunkOffsets.Num(); ++i)
+		{
+			bValid = ChunkOffsets[i] >= ChunkOffsets[i - 1];
+		}
+		if (!bValid)
+		{
+			Ar.SetError();
+		}
+		DataOffset = Ar.Tell();
+	}
+
+	return !Ar.IsError();
+}
+
+// ============================================================================
+// ENCODER
+// ============================================================================
+
+FGhostEncoder::FGhostEncoder(float InSampleRate, float InPositionQuantum, int32 InSamplesPerChunk)
+{
+	Header.SampleRate = FMath::Max(InSampleRate, 1.0f);
+	Header.PositionQuantum = FMath::Max(InPositionQuantum, 0.01f);
+	Header.SamplesPerChunk = FMath::Max(InSamplesPerChunk, 2);
+}
+
+void FGhostEncoder::AddSample(const FGhostSample& Sample)
+{
+	using namespace GhostReplay;
+
+	int32 Pos[3];
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		Pos[Axis] = FMath::RoundToInt(Sample.Location[Axis] / Header.PositionQuantum);
+	}
+
+	const FRotator Rotator = Sample.Rotation.Rotator();
+	const uint16 Rot[3] = {
+		FRotator::CompressAxisToShort(Rotator.Pitch),
+		FRotator::CompressAxisToShort(Rotator.Yaw),
+		FRotator::CompressAxisToShort(Rotator.Roll)
+	};
+
+	const int8 Input[3] = {
+		QuantizeInput(Sample.Input.Throttle),
+		QuantizeInput(Sample.Input.Steering),
+		QuantizeInput(Sample.Input.Strafe)
+	};
+
+	const int32 IndexInChunk = Header.NumSamples % Header.SamplesPerChunk;
+	if (IndexInChunk == 0)
+	{
+		// Keyframe: absolute values so the chunk decodes without its predecessors
+		Header.ChunkOffsets.Add(Data.Num());
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			WriteVarUInt(Data, ZigZag(Pos[Axis]));
+		}
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			WriteVarUInt(Data, Rot[Axis]);
+		}
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Data.Add((uint8)Input[Axis]);
+		}
+	}
+	else
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const int32 Predicted = IndexInChunk >= 2 ? 2 * PrevPos[0][Axis] - PrevPos[1][Axis] : PrevPos[0][Axis];
+			WriteVarUInt(Data, ZigZag(Pos[Axis] - Predicted));
+		}
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			WriteVarUInt(Data, ZigZag((int16)(Rot[Axis] - PrevRot[Axis])));
+		}
+
+		uint8 Flags = 0;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Flags |= (Input[Axis] != PrevInput[Axis]) ? (1 << Axis) : 0;
+		}
+		Data.Add(Flags);
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (Flags & (1 << Axis))
+			{
+				Data.Add((uint8)Input[Axis]);
+			}
+		}
+	}
+
+	FMemory::Memcpy(PrevPos[1], PrevPos[0], sizeof(PrevPos[0]));
+	FMemory::Memcpy(PrevPos[0], Pos, sizeof(Pos));
+	FMemory::Memcpy(PrevRot, Rot, sizeof(Rot));
+	FMemory::Memcpy(PrevInput, Input, sizeof(Input));
+
+	++Header.NumSamples;
+}
+
+bool FGhostEncoder::SaveToFile(const FString& Path, const FString& MapName, float LapTime, int64& OutFileSize)
+{
+	FGhostReplayHeader FileHeader = Header;
+	FileHeader.MapName = MapName;
+	FileHeader.LapTime = LapTime;
+	FileHeader.ChunkOffsets.Add(Data.Num());
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	FileHeader.Serialize(Writer);
+	Bytes.Append(Data);
+
+	OutFileSize = Bytes.Num();
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
@@ -0,0 +1,126 @@
+// Ghost Replay - Compact fixed-rate format for recorded hovercraft laps
+// Shared by UGhostRecorderComponent (writing) and UGhostRaceSubsystem (streaming playback)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HoverMovementComponent.h"
+
+/**
+ * One decoded ghost sample
+ */
+struct UNDUINOCPP_API FGhostSample
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+
+	/** Smoothed movement input at the time of the sample */
+	FHoverInputSample Input;
+};
+
+/**
+ * Ghost file header
+ *
+ * Samples are stored in chunks of SamplesPerChunk. Each chunk starts with an absolute
+ * keyframe so it can be decoded on its own; the rest of the chunk is delta encoded:
+ * - Location: 1 cm grid (PositionQuantum), residual against linear extrapolation, zigzag varint
+ * - Rotation: 16 bits per axis, wrapping delta, zigzag varint
+ * - Input: 8 bits per axis, only axes that changed (flag byte)
+ * A straight lap at speed costs roughly 7 bytes per sample.
+ */
+struct UNDUINOCPP_API FGhostReplayHeader
+{
+	static constexpr uint32 FileMagic = 0x54534847; // "GHST"
+	static constexpr int32 FileVersion = 1;
+
+	/** Samples per second */
+	float SampleRate = 30.0f;
+
+	/** Position grid size (in cm) */
+	float PositionQuantum = 1.0f;
+
+	/** Samples per independently decodable chunk */
+	int32 SamplesPerChunk = 64;
+
+	/** Total samples */
+	int32 NumSamples = 0;
+
+	/** Lap time (in seconds) */
+	float LapTime = 0.0f;
+
+	/** Map the lap was recorded on */
+	FString MapName;
+
+	/** Start of each chunk relative to DataOffset, plus the end of the last chunk */
+	TArray<uint32> ChunkOffsets;
+
+	/** File offset of the chunk data (set when reading) */
+	int64 DataOffset = 0;
+
+	/** Write or read the header */
+	bool Serialize(FArchive& Ar);
+
+	int32 GetNumChunks() const { return FMath::Max(ChunkOffsets.Num() - 1, 0); }
+	int32 GetChunkBytes(int32 Chunk) const { return ChunkOffsets[Chunk + 1] - ChunkOffsets[Chunk]; }
+	int32 GetChunkSamples(int32 Chunk) const { return FMath::Min(SamplesPerChunk, NumSamples - Chunk * SamplesPerChunk); }
+	uint32 GetDataSize() const { return ChunkOffsets.Num() > 0 ? ChunkOffsets.Last() : 0; }
+	float GetDuration() const { return NumSamples > 1 ? (NumSamples - 1) / SampleRate : 0.0f; }
+};
+
+/**
+ * Ghost Encoder
+ *
+ * Quantizes and delta-encodes samples as they are added; only the compressed stream is kept.
+ */
+class UNDUINOCPP_API FGhostEncoder
+{
+public:
+	FGhostEncoder(float InSampleRate, float InPositionQuantum = 1.0f, int32 InSamplesPerChunk = 64);
+
+	/** Append the next fixed-rate sample */
+	void AddSample(const FGhostSample& Sample);
+
+	/** Number of samples added */
+	int32 GetNumSamples() const { return Header.NumSamples; }
+
+	/** Size of the encoded sample data (in bytes) */
+	int32 GetEncodedSize() const { return Data.Num(); }
+
+	/**
+	 * Write the ghost file
+	 * @param Path - Destination file
+	 * @param MapName - Map the lap was recorded on
+	 * @param LapTime - Lap time (in seconds)
+	 * @param OutFileSize - Receives the written file size
+	 * @return True if the file was written
+	 */
+	bool SaveToFile(const FString& Path, const FString& MapName, float LapTime, int64& OutFileSize);
+
+private:
+	FGhostReplayHeader Header;
+
+	/** Encoded chunks */
+	TArray<uint8> Data;
+
+	/** Quantized previous two samples (for prediction) */
+	int32 PrevPos[2][3] = {};
+	uint16 PrevRot[3] = {};
+	int8 PrevInput[3] = {};
+};
+
+namespace GhostReplay
+{
+	/**
+	 * Decode one chunk
+	 * @param Header - Header of the file the chunk came from
+	 * @param Chunk - Chunk index
+	 * @param Bytes - Chunk data
+	 * @param NumBytes - Chunk size
+	 * @param OutSamples - Receives the decoded samples
+	 * @return True if the chunk decoded cleanly
+	 */
+	UNDUINOCPP_API bool DecodeChunk(const FGhostReplayHeader& Header, int32 Chunk, const uint8* Bytes, int32 NumBytes, TArray<FGhostSample>& OutSamples);
+
+	/** Resolve a ghost name to a file path (relative names go to Saved/Ghosts) */
+	UNDUINOCPP_API FString GetGhostPath(const FString& Name);
+}
@@ -72,8 +72,27 @@ void UHoverMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType
 		}
 	}
 
-	// Update smoothed input values
-	UpdateInputSmoothing(DeltaTime);
+	// Update smoothed input values, stepping through fixed-rate samples when we have them
+	float AverageThrottle = 0.0f;
+	float AverageSteering = 0.0f;
+	float AverageStrafe = 0.0f;
+	const bool bIntegratedSamples = IntegrateQueuedSamples(AverageThrottle, AverageSteering, AverageStrafe);
+	if (!bIntegratedSamples)
+	{
+		UpdateInputSmoothing(DeltaTime);
+	}
+
+	// Forces are applied once per frame, so use the input averaged over the frame's samples.
+	// This is exact for the input-linear terms; speed-dependent ones see only this frame's velocity.
+	const float SmoothedThrottle = CurrentThrottle;
+	const float SmoothedSteering = CurrentSteering;
+	const float SmoothedStrafe = CurrentStrafe;
+	if (bIntegratedSamples)
+	{
+		CurrentThrottle = AverageThrottle;
+		CurrentSteering = AverageSteering;
+		CurrentStrafe = AverageStrafe;
+	}
 
 	// Apply forces
 	ApplyThrust(DeltaTime);
@@ -85,6 +104,11 @@ void UHoverMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType
 	}
 
 	ApplyDrag(DeltaTime);
+
+	// Keep the smoothing state continuous into the next frame
+	CurrentThrottle = SmoothedThrottle;
+	CurrentSteering = SmoothedSteering;
+	CurrentStrafe = SmoothedStrafe;
 }
 
 // ============================================================================
@@ -123,6 +147,17 @@ void UHoverMovementComponent::SetStrafeInput(float Value)
 	}
 }
 
+void UHoverMovementComponent::QueueInputSamples(const TArray<FHoverInputSample>& Samples, float SampleInterval)
+{
+	if (!bMovementEnabled || SampleInterval <= 0.0f)
+	{
+		return;
+	}
+
+	QueuedInputSamples.Append(Samples);
+	QueuedSampleInterval = SampleInterval;
+}
+
 // ============================================================================
 // INPUT FUNCTIONS - Digital
 // ============================================================================
@@ -300,6 +335,7 @@ void UHoverMovementComponent::ResetInput()
 	CurrentThrottle = 0.0f;
 	CurrentSteering = 0.0f;
 	CurrentStrafe = 0.0f;
+	QueuedInputSamples.Reset();
 
 	bForwardPressed = false;
 	bBackwardPressed = false;
@@ -384,6 +420,67 @@ void UHoverMovementComponent::UpdateInputSmoothing(float DeltaTime)
 	}
 }
 
+bool UHoverMovementComponent::IntegrateQueuedSamples(float& OutThrottle, float& OutSteering, float& OutStrafe)
+{
+	if (QueuedInputSamples.Num() == 0)
+	{
+		return false;
+	}
+
+	const float OldThrottle = RawThrottleInput;
+	const float OldSteering = RawSteeringInput;
+
+	float ThrottleSum = 0.0f;
+	float SteeringSum = 0.0f;
+	float StrafeSum = 0.0f;
+
+	for (const FHoverInputSample& Sample : QueuedInputSamples)
+	{
+		// Axes the sample does not carry keep whatever input drove them last
+		if (Sample.bHasThrottle)
+		{
+			RawThrottleInput = FMath::Clamp(Sample.Throttle, -1.0f, 1.0f);
+		}
+		if (Sample.bHasSteering)
+		{
+			RawSteeringInput = FMath::Clamp(Sample.Steering, -1.0f, 1.0f);
+		}
+		if (bEnableStrafe && Sample.bHasStrafe)
+		{
+			RawStrafeInput = FMath::Clamp(Sample.Strafe, -1.0f, 1.0f);
+		}
+
+		UpdateInputSmoothing(QueuedSampleInterval);
+
+		ThrottleSum += CurrentThrottle;
+		SteeringSum += CurrentSteering;
+		StrafeSum += CurrentStrafe;
+	}
+
+	const float InvNum = 1.0f / QueuedInputSamples.Num();
+	OutThrottle = ThrottleSum * InvNum;
+	OutSteering = SteeringSum * InvNum;
+	OutStrafe = StrafeSum * InvNum;
+
+	QueuedInputSamples.Reset();
+
+	// Broadcast once per frame rather than once per sample
+	if (OldThrottle != RawThrottleInput)
+	{
+		OnThrottleChanged.Broadcast(RawThrottleInput);
+	}
+	if (OldSteering != RawSteeringInput)
+	{
+		OnSteeringChanged.Broadcast(RawSteeringInput);
+	}
+	if (OldThrottle != RawThrottleInput || OldSteering != RawSteeringInput)
+	{
+		OnMovementInputChanged.Broadcast(RawThrottleInput, RawSteeringInput);
+	}
+
+	return true;
+}
+
 void UHoverMovementComponent::ApplyThrust(float DeltaTime)
 {
 	if (FMath::IsNearlyZero(CurrentThrottle))
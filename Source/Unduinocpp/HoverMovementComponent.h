@@ -15,6 +15,39 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMovementInputChanged, float, Thr
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnThrottleChanged, float, NewThrottle);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSteeringChanged, float, NewSteering);
 
+/**
+ * One fixed-rate input sample for sub-frame integration
+ */
+USTRUCT(BlueprintType)
+struct FHoverInputSample
+{
+	GENERATED_BODY()
+
+	/** Throttle input (-1 to +1) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Movement|Input")
+	float Throttle = 0.0f;
+
+	/** Steering input (-1 to +1) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Movement|Input")
+	float Steering = 0.0f;
+
+	/** Strafe input (-1 to +1, ignored unless strafe is enabled) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Movement|Input")
+	float Strafe = 0.0f;
+
+	/** Whether this sample carries throttle; if not, the current throttle input is kept */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Movement|Input")
+	bool bHasThrottle = true;
+
+	/** Whether this sample carries steering; if not, the current steering input is kept */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Movement|Input")
+	bool bHasSteering = true;
+
+	/** Whether this sample carries strafe; if not, the current strafe input is kept */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hover Movement|Input")
+	bool bHasStrafe = true;
+};
+
 /**
  * Hover Movement Component
  *
@@ -185,6 +218,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Hover Movement|Input")
 	void SetStrafeInput(float Value);
 
+	/**
+	 * Queue fixed-rate input samples covering the time since the last frame
+	 * On the next tick, smoothing is stepped once per sample and forces use the
+	 * average smoothed input over the samples, so handling does not depend on frame rate.
+	 * Axes a sample does not carry keep their current input, so other devices can drive them.
+	 * Forces are still applied once per frame: speed-dependent terms (turn scaling, drag) use
+	 * the frame's velocity, not one per sample.
+	 * @param Samples - Input samples in time order
+	 * @param SampleInterval - Time between samples (in seconds)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hover Movement|Input")
+	void QueueInputSamples(const TArray<FHoverInputSample>& Samples, float SampleInterval);
+
 	// ============================================================================
 	// INPUT FUNCTIONS - Digital Input (Keyboard, Buttons)
 	// ============================================================================
@@ -360,6 +406,9 @@ protected:
 	/** Update input smoothing */
 	void UpdateInputSmoothing(float DeltaTime);
 
+	/** Step smoothing through queued samples; returns true and sets the frame-average input if any were queued */
+	bool IntegrateQueuedSamples(float& OutThrottle, float& OutSteering, float& OutStrafe);
+
 	/** Get the primitive component for physics operations */
 	UPrimitiveComponent* GetPhysicsComponent() const;
 
@@ -384,6 +433,12 @@ private:
 	float CurrentSteering = 0.0f;
 	float CurrentStrafe = 0.0f;
 
+	/** Fixed-rate samples queued for the next tick */
+	TArray<FHoverInputSample> QueuedInputSamples;
+
+	/** Time between queued samples */
+	float QueuedSampleInterval = 0.0f;
+
 	/** Digital input tracking */
 	bool bForwardPressed = false;
 	bool bBackwardPressed = false;
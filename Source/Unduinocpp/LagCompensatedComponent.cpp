@@ -0,0 +1,39 @@
+// Lag Compensated Component Implementation
+
+#include "LagCompensatedComponent.h"
+#include "LagCompensationSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+ULagCompensatedComponent::ULagCompensatedComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void ULagCompensatedComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	RefreshRegistration();
+}
+
+void ULagCompensatedComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UWorld* World = GetWorld();
+	if (ULagCompensationSubsystem* LagCompensation = World ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr)
+	{
+		LagCompensation->UnregisterActor(GetOwner());
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ULagCompensatedComponent::RefreshRegistration()
+{
+	UWorld* World = GetWorld();
+	if (ULagCompensationSubsystem* LagCompensation = World ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr)
+	{
+		LagCompensation->UnregisterActor(GetOwner());
+		LagCompensation->RegisterActor(GetOwner());
+	}
+}
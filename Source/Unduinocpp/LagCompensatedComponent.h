@@ -0,0 +1,37 @@
+// Lag Compensated Component - Registers the owning actor with the lag compensation subsystem
+// Add to any actor that lag compensated UFiringComponent traces should be able to hit
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "LagCompensatedComponent.generated.h"
+
+/**
+ * Lag Compensated Component
+ *
+ * Registers its owner with ULagCompensationSubsystem on BeginPlay and removes it on EndPlay.
+ * The owner's root transform is then recorded every server frame, so bullet and scan traces
+ * from remote shooters are evaluated against where the owner was on their screen.
+ *
+ * The bounding radius is cached at registration, so call RefreshRegistration() after
+ * the owner's collision changes size.
+ */
+UCLASS(ClassGroup=(Weapon), meta=(BlueprintSpawnableComponent), BlueprintType, Blueprintable)
+class UNDUINOCPP_API ULagCompensatedComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	ULagCompensatedComponent();
+
+	// === UActorComponent Interface ===
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Re-register the owner so bounds changes are picked up
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Firing|Lag Compensation")
+	void RefreshRegistration();
+};
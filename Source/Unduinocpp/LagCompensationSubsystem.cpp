@@ -0,0 +1,358 @@
+// Lag Compensation Subsystem Implementation
+
+#include "LagCompensationSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+void ULagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FrameTimes.SetNumZeroed(HistoryLength);
+}
+
+void ULagCompensationSubsystem::Deinitialize()
+{
+	SlotActors.Empty();
+	SlotKeys.Empty();
+	SlotRadii.Empty();
+	SlotInUse.Empty();
+	FreeSlots.Empty();
+	ActorToSlot.Empty();
+	Positions.Empty();
+	Rotations.Empty();
+	FrameTimes.Empty();
+	SlotCapacity = 0;
+	NewestFrame = INDEX_NONE;
+	NumFrames = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsRecording() || SlotCapacity == 0)
+	{
+		return;
+	}
+
+	NewestFrame = (NewestFrame + 1) % HistoryLength;
+	NumFrames = FMath::Min(NumFrames + 1, HistoryLength);
+	FrameTimes[NewestFrame] = GetWorld()->GetTimeSeconds();
+
+	FVector3f* FramePositions = Positions.GetData() + NewestFrame * SlotCapacity;
+	FQuat4f* FrameRotations = Rotations.GetData() + NewestFrame * SlotCapacity;
+
+	TArray<int32, TInlineAllocator<8>> StaleSlots;
+	for (TConstSetBitIterator<> It(SlotInUse); It; ++It)
+	{
+		const int32 Slot = It.GetIndex();
+		AActor* Actor = SlotActors[Slot].Get();
+		if (!Actor)
+		{
+			// Destroyed without unregistering
+			StaleSlots.Add(Slot);
+			continue;
+		}
+
+		FramePositions[Slot] = FVector3f(Actor->GetActorLocation());
+		FrameRotations[Slot] = FQuat4f(Actor->GetActorQuat());
+	}
+
+	for (int32 Slot : StaleSlots)
+	{
+		ReleaseSlot(Slot);
+	}
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void ULagCompensationSubsystem::RegisterActor(AActor* Actor)
+{
+	if (!Actor || ActorToSlot.Contains(Actor))
+	{
+		return;
+	}
+
+	if (FreeSlots.Num() == 0)
+	{
+		GrowSlots(FMath::Max(SlotCapacity * 2, 64));
+	}
+
+	const int32 Slot = FreeSlots.Pop(EAllowShrinking::No);
+	SlotActors[Slot] = Actor;
+	SlotKeys[Slot] = Actor;
+	SlotInUse[Slot] = true;
+	ActorToSlot.Add(Actor, Slot);
+
+	// Bounding sphere around the actor location (not the bounds centre) so only one point is stored per frame
+	FVector BoundsOrigin;
+	FVector BoundsExtent;
+	Actor->GetActorBounds(true, BoundsOrigin, BoundsExtent);
+	SlotRadii[Slot] = BoundsExtent.Size() + FVector::Dist(BoundsOrigin, Actor->GetActorLocation());
+
+	// No history yet, so every frame starts at the current transform
+	const FVector3f Location(Actor->GetActorLocation());
+	const FQuat4f Rotation(Actor->GetActorQuat());
+	for (int32 Frame = 0; Frame < HistoryLength; ++Frame)
+	{
+		Positions[Frame * SlotCapacity + Slot] = Location;
+		Rotations[Frame * SlotCapacity + Slot] = Rotation;
+	}
+}
+
+void ULagCompensationSubsystem::UnregisterActor(AActor* Actor)
+{
+	if (const int32* Slot = ActorToSlot.Find(Actor))
+	{
+		ReleaseSlot(*Slot);
+	}
+}
+
+int32 ULagCompensationSubsystem::GetNumRegistered() const
+{
+	return ActorToSlot.Num();
+}
+
+bool ULagCompensationSubsystem::IsRecording() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	const ENetMode NetMode = World->GetNetMode();
+	return NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+}
+
+float ULagCompensationSubsystem::GetRecordedHistoryTime() const
+{
+	if (NumFrames < 2)
+	{
+		return 0.0f;
+	}
+
+	const int32 OldestFrame = (NewestFrame - NumFrames + 1 + HistoryLength) % HistoryLength;
+	return static_cast<float>(FrameTimes[NewestFrame] - FrameTimes[OldestFrame]);
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+bool ULagCompensationSubsystem::RewindLineTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, float RewindTime) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	int32 Older = INDEX_NONE;
+	int32 Newer = INDEX_NONE;
+	float Alpha = 0.0f;
+	if (RewindTime <= 0.0f || ActorToSlot.Num() == 0 || !FindFrames(World->GetTimeSeconds() - RewindTime, Older, Newer, Alpha))
+	{
+		return World->LineTraceSingleByChannel(OutHit, Start, End, Channel, Params);
+	}
+
+	const FVector Delta = End - Start;
+	const float Length = Delta.Size();
+	if (Length <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+	const FVector Direction = Delta / Length;
+
+	// Split recorded actors into those near the ray now (hidden from the world trace)
+	// and those near the ray in the past (traced individually in rewound space)
+	TArray<int32, TInlineAllocator<8>> Candidates;
+	FCollisionQueryParams WorldParams = Params;
+
+	for (TConstSetBitIterator<> It(SlotInUse); It; ++It)
+	{
+		const int32 Slot = It.GetIndex();
+		AActor* Actor = SlotActors[Slot].Get();
+		if (!Actor || Params.GetIgnoredActors().Contains(Actor->GetUniqueID()))
+		{
+			continue;
+		}
+
+		const float Radius = SlotRadii[Slot];
+
+		if (SegmentTouchesSphere(Start, Direction, Length, Actor->GetActorLocation(), Radius))
+		{
+			WorldParams.AddIgnoredActor(Actor);
+		}
+
+		if (SegmentTouchesSphere(Start, Direction, Length, GetHistoricalLocation(Slot, Older, Newer, Alpha), Radius))
+		{
+			WorldParams.AddIgnoredActor(Actor);
+			Candidates.Add(Slot);
+		}
+	}
+
+	bool bHit = World->LineTraceSingleByChannel(OutHit, Start, End, Channel, WorldParams);
+
+	for (int32 Slot : Candidates)
+	{
+		AActor* Actor = SlotActors[Slot].Get();
+		const FTransform Current = Actor->GetActorTransform();
+		const FTransform Historical(GetHistoricalRotation(Slot, Older, Newer, Alpha), GetHistoricalLocation(Slot, Older, Newer, Alpha), Current.GetScale3D());
+
+		// Move the ray instead of the actor: historical space -> actor local -> current space
+		const FVector LocalStart = Current.TransformPosition(Historical.InverseTransformPosition(Start));
+		const FVector LocalEnd = Current.TransformPosition(Historical.InverseTransformPosition(End));
+
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [&](UPrimitiveComponent* Primitive)
+		{
+			if (!Primitive->IsQueryCollisionEnabled() || Primitive->GetCollisionResponseToChannel(Channel) != ECR_Block)
+			{
+				return;
+			}
+
+			FHitResult ComponentHit;
+			if (!Primitive->LineTraceComponent(ComponentHit, LocalStart, LocalEnd, Params))
+			{
+				return;
+			}
+
+			// Rigid transforms preserve the hit fraction, so Time is comparable with the world trace
+			if (bHit && ComponentHit.Time >= OutHit.Time)
+			{
+				return;
+			}
+
+			ComponentHit.TraceStart = Start;
+			ComponentHit.TraceEnd = End;
+			ComponentHit.Location = Historical.TransformPosition(Current.InverseTransformPosition(ComponentHit.Location));
+			ComponentHit.ImpactPoint = Historical.TransformPosition(Current.InverseTransformPosition(ComponentHit.ImpactPoint));
+			ComponentHit.Normal = Historical.TransformVectorNoScale(Current.InverseTransformVectorNoScale(ComponentHit.Normal));
+			ComponentHit.ImpactNormal = Historical.TransformVectorNoScale(Current.InverseTransformVectorNoScale(ComponentHit.ImpactNormal));
+			ComponentHit.bBlockingHit = true;
+
+			OutHit = ComponentHit;
+			bHit = true;
+		});
+	}
+
+	return bHit;
+}
+
+// ============================================================================
+// INTERNAL
+// ============================================================================
+
+void ULagCompensationSubsystem::GrowSlots(int32 NewCapacity)
+{
+	check(NewCapacity > SlotCapacity);
+
+	// Re-layout every frame row at the new stride
+	TArray<FVector3f> NewPositions;
+	TArray<FQuat4f> NewRotations;
+	NewPositions.SetNumZeroed(HistoryLength * NewCapacity);
+	NewRotations.SetNumZeroed(HistoryLength * NewCapacity);
+
+	if (SlotCapacity > 0)
+	{
+		for (int32 Frame = 0; Frame < HistoryLength; ++Frame)
+		{
+			FMemory::Memcpy(&NewPositions[Frame * NewCapacity], &Positions[Frame * SlotCapacity], SlotCapacity * sizeof(FVector3f));
+			FMemory::Memcpy(&NewRotations[Frame * NewCapacity], &Rotations[Frame * SlotCapacity], SlotCapacity * sizeof(FQuat4f));
+		}
+	}
+
+	Positions = MoveTemp(NewPositions);
+	Rotations = MoveTemp(NewRotations);
+
+	SlotActors.SetNum(NewCapacity);
+	SlotKeys.SetNum(NewCapacity);
+	SlotRadii.SetNumZeroed(NewCapacity);
+	SlotInUse.Add(false, NewCapacity - SlotCapacity);
+
+	// Hand out low slots first
+	for (int32 Slot = NewCapacity - 1; Slot >= SlotCapacity; --Slot)
+	{
+		FreeSlots.Add(Slot);
+	}
+
+	SlotCapacity = NewCapacity;
+}
+
+void ULagCompensationSubsystem::ReleaseSlot(int32 Slot)
+{
+	if (!SlotInUse.IsValidIndex(Slot) || !SlotInUse[Slot])
+	{
+		return;
+	}
+
+	ActorToSlot.Remove(SlotKeys[Slot]);
+
+	SlotActors[Slot].Reset();
+	SlotKeys[Slot] = TObjectKey<AActor>();
+	SlotInUse[Slot] = false;
+	FreeSlots.Add(Slot);
+}
+
+bool ULagCompensationSubsystem::FindFrames(double Time, int32& OutOlder, int32& OutNewer, float& OutAlpha) const
+{
+	if (NumFrames == 0)
+	{
+		return false;
+	}
+
+	// Walk back from the newest frame until we pass the requested time
+	int32 NewerFrame = NewestFrame;
+	for (int32 Step = 0; Step < NumFrames; ++Step)
+	{
+		const int32 Frame = (NewestFrame - Step + HistoryLength) % HistoryLength;
+		if (FrameTimes[Frame] <= Time)
+		{
+			OutOlder = Frame;
+			OutNewer = NewerFrame;
+
+			const double Span = FrameTimes[NewerFrame] - FrameTimes[Frame];
+			OutAlpha = Span > 0.0 ? static_cast<float>((Time - FrameTimes[Frame]) / Span) : 0.0f;
+			return true;
+		}
+		NewerFrame = Frame;
+	}
+
+	// Older than the buffer reaches: clamp to the oldest frame
+	OutOlder = NewerFrame;
+	OutNewer = NewerFrame;
+	OutAlpha = 0.0f;
+	return true;
+}
+
+FVector ULagCompensationSubsystem::GetHistoricalLocation(int32 Slot, int32 Older, int32 Newer, float Alpha) const
+{
+	const FVector3f& A = Positions[Older * SlotCapacity + Slot];
+	const FVector3f& B = Positions[Newer * SlotCapacity + Slot];
+	return FVector(FMath::Lerp(A, B, Alpha));
+}
+
+FQuat ULagCompensationSubsystem::GetHistoricalRotation(int32 Slot, int32 Older, int32 Newer, float Alpha) const
+{
+	const FQuat4f& A = Rotations[Older * SlotCapacity + Slot];
+	const FQuat4f& B = Rotations[Newer * SlotCapacity + Slot];
+	return FQuat(FQuat4f::Slerp(A, B, Alpha));
+}
+
+bool ULagCompensationSubsystem::SegmentTouchesSphere(const FVector& Start, const FVector& Direction, float Length, const FVector& Center, float Radius)
+{
+	const FVector ToCenter = Center - Start;
+	const float Along = FMath::Clamp(static_cast<float>(FVector::DotProduct(ToCenter, Direction)), 0.0f, Length);
+	return FVector::DistSquared(Start + Direction * Along, Center) <= FMath::Square(Radius);
+}
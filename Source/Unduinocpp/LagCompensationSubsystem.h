@@ -0,0 +1,154 @@
+// Lag Compensation Subsystem - Server-side transform history for rewinding hit traces
+// Lets shots be evaluated against where targets were on the shooter's screen
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "LagCompensationSubsystem.generated.h"
+
+/**
+ * Lag Compensation Subsystem
+ *
+ * World subsystem that records the root transform of every actor registered through
+ * ULagCompensatedComponent once per frame (listen/dedicated servers only), and can
+ * evaluate a line trace against a rewound snapshot of that history.
+ *
+ * History is stored frame-major in flat arrays (one FVector3f + FQuat4f per actor slot
+ * per frame), so recording a frame is a single contiguous write and a query over all
+ * actors reads two contiguous frame rows. At the default history length this is about
+ * 3.5 KB per actor.
+ *
+ * Rewinding never moves actors. The world is traced with nearby lag compensated actors
+ * ignored, then only actors whose historical bounds touch the shot ray are traced
+ * individually with the ray transformed into their current space.
+ */
+UCLASS()
+class UNDUINOCPP_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Number of frames kept in the ring buffer (~1 second at 128 Hz server tick) */
+	static constexpr int32 HistoryLength = 128;
+
+	// === USubsystem / FTickableGameObject Interface ===
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ============================================================================
+	// REGISTRATION
+	// ============================================================================
+
+	/**
+	 * Register an actor whose transform should be recorded
+	 * Existing history for the slot is filled with the actor's current transform.
+	 * @param Actor - The actor to register
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Firing|Lag Compensation")
+	void RegisterActor(AActor* Actor);
+
+	/**
+	 * Stop recording an actor
+	 * @param Actor - The actor to unregister
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Firing|Lag Compensation")
+	void UnregisterActor(AActor* Actor);
+
+	/**
+	 * Get the number of recorded actors
+	 * @return Registered actor count
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firing|Lag Compensation")
+	int32 GetNumRegistered() const;
+
+	/**
+	 * Check whether history is being recorded (only on listen or dedicated servers)
+	 * @return True if rewound traces are available
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firing|Lag Compensation")
+	bool IsRecording() const;
+
+	/**
+	 * Get how far back the recorded history reaches
+	 * @return Seconds between the oldest and newest recorded frame
+	 */
+	UFUNCTION(BlueprintPure, Category = "Firing|Lag Compensation")
+	float GetRecordedHistoryTime() const;
+
+	// ============================================================================
+	// QUERIES
+	// ============================================================================
+
+	/**
+	 * Line trace against the world as it was RewindTime seconds ago
+	 * Falls back to a regular trace when nothing is recorded or RewindTime is zero.
+	 * Hit locations and normals are reported in the rewound (historical) space.
+	 * @param OutHit - Closest blocking hit
+	 * @param Start - Trace start
+	 * @param End - Trace end
+	 * @param Channel - Trace channel
+	 * @param Params - Query params (ignored actors are respected)
+	 * @param RewindTime - How far back to rewind (in seconds)
+	 * @return True if something was hit
+	 */
+	bool RewindLineTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, float RewindTime) const;
+
+private:
+	/** Actor recorded in each slot */
+	TArray<TWeakObjectPtr<AActor>> SlotActors;
+
+	/** Lookup key for each slot (still valid for removal after the actor is destroyed) */
+	TArray<TObjectKey<AActor>> SlotKeys;
+
+	/** Bounding sphere radius around the actor location for each slot */
+	TArray<float> SlotRadii;
+
+	/** Which slots are currently assigned */
+	TBitArray<> SlotInUse;
+
+	/** Unassigned slots available for reuse */
+	TArray<int32> FreeSlots;
+
+	/** Actor -> slot lookup */
+	TMap<TObjectKey<AActor>, int32> ActorToSlot;
+
+	/** Recorded locations, indexed [Frame * SlotCapacity + Slot] */
+	TArray<FVector3f> Positions;
+
+	/** Recorded rotations, indexed [Frame * SlotCapacity + Slot] */
+	TArray<FQuat4f> Rotations;
+
+	/** World time of each recorded frame */
+	TArray<double> FrameTimes;
+
+	/** Number of slots per frame row */
+	int32 SlotCapacity = 0;
+
+	/** Ring buffer index of the newest recorded frame */
+	int32 NewestFrame = INDEX_NONE;
+
+	/** Number of valid frames in the ring buffer */
+	int32 NumFrames = 0;
+
+	/** Grow every frame row to a new slot capacity */
+	void GrowSlots(int32 NewCapacity);
+
+	/** Free a slot (history is left in place and overwritten on reuse) */
+	void ReleaseSlot(int32 Slot);
+
+	/** Find the two frames bracketing a world time and the blend between them */
+	bool FindFrames(double Time, int32& OutOlder, int32& OutNewer, float& OutAlpha) const;
+
+	/** Interpolated location of a slot between two frames */
+	FVector GetHistoricalLocation(int32 Slot, int32 Older, int32 Newer, float Alpha) const;
+
+	/** Interpolated rotation of a slot between two frames */
+	FQuat GetHistoricalRotation(int32 Slot, int32 Older, int32 Newer, float Alpha) const;
+
+	/** Check if a segment passes within Radius of Center */
+	static bool SegmentTouchesSphere(const FVector& Start, const FVector& Direction, float Length, const FVector& Center, float Radius);
+};
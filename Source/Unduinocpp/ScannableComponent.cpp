@@ -0,0 +1,38 @@
+// Scannable Component Implementation
+
+#include "ScannableComponent.h"
+#include "ScannableTargetRegistry.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UScannableComponent::UScannableComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UScannableComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	RefreshRegistration();
+}
+
+void UScannableComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UWorld* World = GetWorld();
+	if (UScannableTargetRegistry* Registry = World ? World->GetSubsystem<UScannableTargetRegistry>() : nullptr)
+	{
+		Registry->UnregisterActor(GetOwner());
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UScannableComponent::RefreshRegistration()
+{
+	UWorld* World = GetWorld();
+	if (UScannableTargetRegistry* Registry = World ? World->GetSubsystem<UScannableTargetRegistry>() : nullptr)
+	{
+		Registry->RegisterActor(GetOwner());
+	}
+}
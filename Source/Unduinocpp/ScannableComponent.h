@@ -0,0 +1,38 @@
+// Scannable Component - Registers the owning actor with the scannable target registry
+// Add to any actor that scanner-mode UFiringComponents should be able to acquire
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ScannableComponent.generated.h"
+
+/**
+ * Scannable Component
+ *
+ * Registers its owner with UScannableTargetRegistry on BeginPlay and removes it on EndPlay.
+ * The registry caches the owner's Actor Tags and root Component Tags at registration,
+ * so call RefreshRegistration() after changing tags at runtime.
+ *
+ * Usage:
+ *   1. Add UScannableComponent to the actor
+ *   2. Give the actor (or its root component) one of the scanner's ScannableTags
+ */
+UCLASS(ClassGroup=(Weapon), meta=(BlueprintSpawnableComponent), BlueprintType, Blueprintable)
+class UNDUINOCPP_API UScannableComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UScannableComponent();
+
+	// === UActorComponent Interface ===
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Re-register the owner so tag and bounds changes are picked up
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Scanner")
+	void RefreshRegistration();
+};
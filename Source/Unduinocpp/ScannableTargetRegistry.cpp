@@ -0,0 +1,354 @@
+// Scannable Target Registry Implementation
+
+#include "ScannableTargetRegistry.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+
+void UScannableTargetRegistry::Deinitialize()
+{
+	Entries.Empty();
+	ActorToEntry.Empty();
+	Cells.Empty();
+	TagBits.Empty();
+	OverflowTags.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UScannableTargetRegistry::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UScannableTargetRegistry, STATGROUP_Tickables);
+}
+
+void UScannableTargetRegistry::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Refresh movable entries and drop actors that were destroyed without unregistering
+	TArray<int32, TInlineAllocator<16>> StaleEntries;
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		FScannableTargetEntry& Entry = *It;
+		AActor* Actor = Entry.Actor.Get();
+		if (!Actor)
+		{
+			StaleEntries.Add(It.GetIndex());
+			continue;
+		}
+
+		if (!Entry.bMovable)
+		{
+			continue;
+		}
+
+		FVector Extent;
+		Actor->GetActorBounds(true, Entry.Location, Extent);
+		Entry.Radius = Extent.Size();
+
+		FIntVector NewCell = LocationToCell(Entry.Location);
+		if (NewCell != Entry.Cell)
+		{
+			RemoveFromCell(It.GetIndex(), Entry.Cell);
+			Cells.FindOrAdd(NewCell).Add(It.GetIndex());
+			Entry.Cell = NewCell;
+		}
+	}
+
+	for (int32 EntryIndex : StaleEntries)
+	{
+		RemoveEntry(EntryIndex);
+	}
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void UScannableTargetRegistry::RegisterActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	// Re-registering refreshes cached data, so remove any previous entry first
+	if (const int32* ExistingIndex = ActorToEntry.Find(Actor))
+	{
+		RemoveEntry(*ExistingIndex);
+	}
+
+	FScannableTargetEntry NewEntry;
+	NewEntry.Actor = Actor;
+	NewEntry.ActorKey = Actor;
+
+	FVector Extent;
+	Actor->GetActorBounds(true, NewEntry.Location, Extent);
+	NewEntry.Radius = Extent.Size();
+	NewEntry.Cell = LocationToCell(NewEntry.Location);
+
+	USceneComponent* Root = Actor->GetRootComponent();
+	NewEntry.bMovable = !Root || Root->Mobility == EComponentMobility::Movable;
+
+	// Precompute tag eligibility from both Actor Tags and root Component Tags
+	for (const FName& Tag : Actor->Tags)
+	{
+		NewEntry.TagMask |= GetOrAddTagBit(Tag);
+	}
+	if (Root)
+	{
+		for (const FName& Tag : Root->ComponentTags)
+		{
+			NewEntry.TagMask |= GetOrAddTagBit(Tag);
+		}
+	}
+
+	const int32 EntryIndex = Entries.Add(NewEntry);
+	ActorToEntry.Add(Actor, EntryIndex);
+	Cells.FindOrAdd(NewEntry.Cell).Add(EntryIndex);
+}
+
+void UScannableTargetRegistry::UnregisterActor(AActor* Actor)
+{
+	if (const int32* ExistingIndex = ActorToEntry.Find(Actor))
+	{
+		RemoveEntry(*ExistingIndex);
+	}
+}
+
+int32 UScannableTargetRegistry::GetNumRegistered() const
+{
+	return Entries.Num();
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+uint64 UScannableTargetRegistry::MakeTagMask(const TArray<FName>& Tags, bool& bOutAnyKnown, bool& bOutExact) const
+{
+	uint64 Mask = 0;
+	bOutExact = true;
+	for (const FName& Tag : Tags)
+	{
+		if (const int32* Bit = TagBits.Find(Tag))
+		{
+			Mask |= (1ull << *Bit);
+		}
+		else if (OverflowTags.Contains(Tag))
+		{
+			bOutExact = false;
+		}
+	}
+	bOutAnyKnown = Mask != 0;
+	return Mask;
+}
+
+bool UScannableTargetRegistry::IsSphereInCone(const FVector& Origin, const FVector& Direction, float Range, float ConeHalfAngle,
+	const FVector& Location, float Radius, float& OutAngle, float& OutDistance)
+{
+	const float ConeRad = FMath::DegreesToRadians(FMath::Clamp(ConeHalfAngle, 0.0f, 89.0f));
+
+	const FVector ToTarget = Location - Origin;
+	OutDistance = ToTarget.Size();
+	OutAngle = 0.0f;
+	if (OutDistance > Range + Radius)
+	{
+		return false;
+	}
+
+	// Angle from the cone axis, reduced by the angle the target's bounds subtend
+	if (OutDistance > Radius)
+	{
+		const float CosAngle = FMath::Clamp(FVector::DotProduct(Direction, ToTarget / OutDistance), -1.0f, 1.0f);
+		OutAngle = FMath::Max(0.0f, FMath::Acos(CosAngle) - FMath::Asin(Radius / OutDistance));
+	}
+
+	return OutAngle <= ConeRad;
+}
+
+bool UScannableTargetRegistry::IsTargetInCone(const FVector& Origin, const FVector& Direction, float Range, float ConeHalfAngle, const AActor* Target) const
+{
+	if (!Target)
+	{
+		return false;
+	}
+
+	FVector Location;
+	float Radius = 0.0f;
+	if (const int32* EntryIndex = ActorToEntry.Find(Target))
+	{
+		Location = Entries[*EntryIndex].Location;
+		Radius = Entries[*EntryIndex].Radius;
+	}
+	else
+	{
+		FVector Extent;
+		Target->GetActorBounds(true, Location, Extent);
+		Radius = Extent.Size();
+	}
+
+	float Angle = 0.0f;
+	float Distance = 0.0f;
+	return IsSphereInCone(Origin, Direction, Range, ConeHalfAngle, Location, Radius, Angle, Distance);
+}
+
+AActor* UScannableTargetRegistry::FindBestTargetInCone(const FVector& Origin, const FVector& Direction, float Range, float ConeHalfAngle, uint64 RequiredTagMask, const AActor* IgnoreActor) const
+{
+	if (Entries.Num() == 0 || Range <= 0.0f)
+	{
+		return nullptr;
+	}
+
+	const float ConeRad = FMath::DegreesToRadians(FMath::Clamp(ConeHalfAngle, 0.0f, 89.0f));
+	const float SafeConeRad = FMath::Max(ConeRad, KINDA_SMALL_NUMBER);
+
+	// Bounding box of the cone: apex plus the end cap disc
+	const FVector End = Origin + Direction * Range;
+	const float EndRadius = Range * FMath::Tan(ConeRad);
+	FBox ConeBounds(Origin, Origin);
+	ConeBounds += End - FVector(EndRadius);
+	ConeBounds += End + FVector(EndRadius);
+
+	const FIntVector MinCell = LocationToCell(ConeBounds.Min);
+	const FIntVector MaxCell = LocationToCell(ConeBounds.Max);
+	const int64 CellsInBounds =
+		int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+
+	AActor* BestActor = nullptr;
+	float BestScore = TNumericLimits<float>::Max();
+
+	auto ScoreBucket = [&](const TArray<int32>& Bucket)
+	{
+		for (int32 EntryIndex : Bucket)
+		{
+			const FScannableTargetEntry& Entry = Entries[EntryIndex];
+
+			if (RequiredTagMask != 0 && (Entry.TagMask & RequiredTagMask) == 0)
+			{
+				continue;
+			}
+
+			AActor* Actor = Entry.Actor.Get();
+			if (!Actor || Actor == IgnoreActor)
+			{
+				continue;
+			}
+
+			float Angle = 0.0f;
+			float Distance = 0.0f;
+			if (!IsSphereInCone(Origin, Direction, Range, ConeHalfAngle, Entry.Location, Entry.Radius, Angle, Distance))
+			{
+				continue;
+			}
+
+			// Prefer targets near the cone axis, then closer targets
+			const float Score = (Angle / SafeConeRad) + 0.25f * (Distance / Range);
+			if (Score < BestScore)
+			{
+				BestScore = Score;
+				BestActor = Actor;
+			}
+		}
+	};
+
+	if (CellsInBounds > Cells.Num())
+	{
+		// Sparse world: walking occupied buckets is cheaper than walking the box
+		for (const TPair<FIntVector, TArray<int32>>& Pair : Cells)
+		{
+			const FIntVector& Cell = Pair.Key;
+			if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X &&
+				Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y &&
+				Cell.Z >= MinCell.Z && Cell.Z <= MaxCell.Z)
+			{
+				ScoreBucket(Pair.Value);
+			}
+		}
+	}
+	else
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+				{
+					if (const TArray<int32>* Bucket = Cells.Find(FIntVector(X, Y, Z)))
+					{
+						ScoreBucket(*Bucket);
+					}
+				}
+			}
+		}
+	}
+
+	return BestActor;
+}
+
+// ============================================================================
+// INTERNAL
+// ============================================================================
+
+FIntVector UScannableTargetRegistry::LocationToCell(const FVector& Location)
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize)
+	);
+}
+
+uint64 UScannableTargetRegistry::GetOrAddTagBit(FName Tag)
+{
+	if (Tag.IsNone())
+	{
+		return 0;
+	}
+
+	if (const int32* Bit = TagBits.Find(Tag))
+	{
+		return 1ull << *Bit;
+	}
+
+	if (TagBits.Num() >= 64)
+	{
+		// Scanners filtering on an overflowed tag fall back to traces (see MakeTagMask)
+		bool bAlreadyOverflowed = false;
+		OverflowTags.Add(Tag, &bAlreadyOverflowed);
+		if (!bAlreadyOverflowed)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ScannableTargetRegistry: Tag limit (64) reached, tag '%s' is not indexed"), *Tag.ToString());
+		}
+		return 0;
+	}
+
+	const int32 NewBit = TagBits.Num();
+	TagBits.Add(Tag, NewBit);
+	return 1ull << NewBit;
+}
+
+void UScannableTargetRegistry::RemoveFromCell(int32 EntryIndex, const FIntVector& Cell)
+{
+	if (TArray<int32>* Bucket = Cells.Find(Cell))
+	{
+		Bucket->RemoveSingleSwap(EntryIndex);
+		if (Bucket->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UScannableTargetRegistry::RemoveEntry(int32 EntryIndex)
+{
+	if (!Entries.IsValidIndex(EntryIndex))
+	{
+		return;
+	}
+
+	const FScannableTargetEntry& Entry = Entries[EntryIndex];
+	RemoveFromCell(EntryIndex, Entry.Cell);
+
+	ActorToEntry.Remove(Entry.ActorKey);
+	Entries.RemoveAt(EntryIndex);
+}
@@ -0,0 +1,172 @@
+// Scannable Target Registry - Spatially hashed registry of scannable actors
+// Lets the scanner pick targets with a cone query instead of physics traces
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ScannableTargetRegistry.generated.h"
+
+/**
+ * A single registered scannable actor
+ * Tag eligibility is resolved to a bitmask once at registration so queries
+ * never compare tag names.
+ */
+struct FScannableTargetEntry
+{
+	/** The registered actor */
+	TWeakObjectPtr<AActor> Actor;
+
+	/** Lookup key (still valid for removal after the actor is destroyed) */
+	TObjectKey<AActor> ActorKey;
+
+	/** Cached bounds centre (refreshed each frame for movable actors) */
+	FVector Location = FVector::ZeroVector;
+
+	/** Cached bounds radius - lets small targets be picked slightly outside the cone centre line */
+	float Radius = 0.0f;
+
+	/** Bitmask of interned tags (Actor Tags + RootComponent ComponentTags) */
+	uint64 TagMask = 0;
+
+	/** Spatial hash cell the entry currently lives in */
+	FIntVector Cell = FIntVector::ZeroValue;
+
+	/** Whether the actor can move (static actors are never re-hashed) */
+	bool bMovable = false;
+};
+
+/**
+ * Scannable Target Registry
+ *
+ * World subsystem holding every actor registered through UScannableComponent,
+ * bucketed in a uniform spatial hash grid. UFiringComponent uses FindBestTargetInCone
+ * to acquire scanner targets without a line trace, which makes scanning robust for
+ * small or partially occluded targets and removes per-frame tag string comparisons.
+ *
+ * Tags are interned into bit indices the first time they are seen (up to 64 distinct tags).
+ */
+UCLASS()
+class UNDUINOCPP_API UScannableTargetRegistry : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Edge length of one spatial hash cell (in cm) */
+	static constexpr float CellSize = 2000.0f;
+
+	// === USubsystem / FTickableGameObject Interface ===
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ============================================================================
+	// REGISTRATION
+	// ============================================================================
+
+	/**
+	 * Register an actor as scannable (or refresh its cached tags/bounds if already registered)
+	 * @param Actor - The actor to register
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Scanner|Registry")
+	void RegisterActor(AActor* Actor);
+
+	/**
+	 * Remove an actor from the registry
+	 * @param Actor - The actor to unregister
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Scanner|Registry")
+	void UnregisterActor(AActor* Actor);
+
+	/**
+	 * Get the number of registered actors
+	 * @return Registered actor count
+	 */
+	UFUNCTION(BlueprintPure, Category = "Scanner|Registry")
+	int32 GetNumRegistered() const;
+
+	// ============================================================================
+	// QUERIES
+	// ============================================================================
+
+	/**
+	 * Build a tag mask for a list of required tags
+	 * @param Tags - Tags to look up (unknown tags are ignored)
+	 * @param bOutAnyKnown - True if at least one tag has been seen by the registry
+	 * @param bOutExact - False if a tag was dropped by the 64 tag limit, so the mask misses actors carrying it
+	 * @return Bitmask usable with FindBestTargetInCone
+	 */
+	uint64 MakeTagMask(const TArray<FName>& Tags, bool& bOutAnyKnown, bool& bOutExact) const;
+
+	/**
+	 * Test a bounding sphere against a scan cone
+	 * The one test used both to acquire targets and to keep them locked, so a target near the
+	 * edge is never acquired on one tick and dropped on the next.
+	 * @param Origin - Cone apex
+	 * @param Direction - Cone axis (normalized)
+	 * @param Range - Cone length (in cm); the sphere may reach into it from beyond
+	 * @param ConeHalfAngle - Half angle of the cone (in degrees)
+	 * @param Location - Sphere centre
+	 * @param Radius - Sphere radius; widens the cone by the angle the sphere subtends
+	 * @param OutAngle - Angle from the axis, less the subtended angle (in radians)
+	 * @param OutDistance - Distance from the apex to the sphere centre
+	 * @return True if the sphere is in the cone
+	 */
+	static bool IsSphereInCone(const FVector& Origin, const FVector& Direction, float Range, float ConeHalfAngle,
+		const FVector& Location, float Radius, float& OutAngle, float& OutDistance);
+
+	/**
+	 * Test an actor against a scan cone with the same rules as FindBestTargetInCone
+	 * Registered actors use their cached bounds, others their current bounds.
+	 * @param Origin - Cone apex
+	 * @param Direction - Cone axis (normalized)
+	 * @param Range - Cone length (in cm)
+	 * @param ConeHalfAngle - Half angle of the cone (in degrees)
+	 * @param Target - The actor to test
+	 * @return True if the actor is in the cone
+	 */
+	bool IsTargetInCone(const FVector& Origin, const FVector& Direction, float Range, float ConeHalfAngle, const AActor* Target) const;
+
+	/**
+	 * Find the best registered target inside a cone
+	 * Targets are scored by angular offset from the cone axis (normalized by cone angle)
+	 * with a small bias toward closer targets.
+	 * @param Origin - Cone apex
+	 * @param Direction - Cone axis (normalized)
+	 * @param Range - Cone length (in cm)
+	 * @param ConeHalfAngle - Half angle of the cone (in degrees)
+	 * @param RequiredTagMask - Target must have at least one of these tags (0 = any target)
+	 * @param IgnoreActor - Actor to skip (usually the shooter)
+	 * @return Best target, or nullptr if none are in the cone
+	 */
+	AActor* FindBestTargetInCone(const FVector& Origin, const FVector& Direction, float Range, float ConeHalfAngle, uint64 RequiredTagMask, const AActor* IgnoreActor) const;
+
+private:
+	/** Registered entries (indices are stable while registered) */
+	TSparseArray<FScannableTargetEntry> Entries;
+
+	/** Actor -> entry index lookup */
+	TMap<TObjectKey<AActor>, int32> ActorToEntry;
+
+	/** Spatial hash: cell -> entry indices */
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	/** Tag name -> bit index */
+	TMap<FName, int32> TagBits;
+
+	/** Tags seen after the 64 tag limit was reached (they have no bit) */
+	TSet<FName> OverflowTags;
+
+	/** Convert a world location to a hash cell */
+	static FIntVector LocationToCell(const FVector& Location);
+
+	/** Intern a tag and return its bit (0 if the 64 tag limit is exceeded) */
+	uint64 GetOrAddTagBit(FName Tag);
+
+	/** Remove an entry index from its cell bucket */
+	void RemoveFromCell(int32 EntryIndex, const FIntVector& Cell);
+
+	/** Remove an entry entirely */
+	void RemoveEntry(int32 EntryIndex);
+};